@@ -0,0 +1,16 @@
+// allocation_tracker.cpp
+#include "allocation_tracker.h"
+
+namespace CoreUtils {
+
+namespace detail {
+constinit thread_local uint32_t hot_path_depth = 0;
+constinit thread_local uint64_t hot_path_allocations = 0;
+constinit bool allocation_hooks_installed = false;
+} // namespace detail
+
+bool allocationHooksInstalled() noexcept {
+    return detail::allocation_hooks_installed;
+}
+
+} // namespace CoreUtils
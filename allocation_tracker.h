@@ -0,0 +1,62 @@
+// allocation_tracker.h
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <cstdint>
+
+namespace CoreUtils {
+
+namespace detail {
+extern constinit thread_local uint32_t hot_path_depth;
+extern constinit thread_local uint64_t hot_path_allocations;
+extern constinit bool allocation_hooks_installed;
+
+/** @brief Called by the replacement `operator new` of `taifex_allocation_hooks` for every allocation. */
+inline void countAllocation() noexcept {
+    if (hot_path_depth != 0) {
+        ++hot_path_allocations;
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Marks the calling thread as being on the hot path for its lifetime. Heap allocations made
+ *        meanwhile are counted (see `hotPathAllocations`). Scopes nest.
+ */
+class HotPathScope {
+public:
+    HotPathScope() noexcept { ++detail::hot_path_depth; }
+    ~HotPathScope() { --detail::hot_path_depth; }
+    HotPathScope(const HotPathScope&) = delete;
+    HotPathScope& operator=(const HotPathScope&) = delete;
+};
+
+/**
+ * @brief Suspends counting inside a `HotPathScope`, for setup work that is expected to allocate
+ *        (new products, new books, recovery paths).
+ */
+class ColdPathScope {
+public:
+    ColdPathScope() noexcept : saved_depth_(detail::hot_path_depth) { detail::hot_path_depth = 0; }
+    ~ColdPathScope() { detail::hot_path_depth = saved_depth_; }
+    ColdPathScope(const ColdPathScope&) = delete;
+    ColdPathScope& operator=(const ColdPathScope&) = delete;
+
+private:
+    uint32_t saved_depth_;
+};
+
+/** @brief Allocations counted on the calling thread inside `HotPathScope`s so far. */
+inline uint64_t hotPathAllocations() noexcept {
+    return detail::hot_path_allocations;
+}
+
+/**
+ * @brief True if the program links `taifex_allocation_hooks`. Without it nothing is counted and
+ *        `hotPathAllocations` stays 0.
+ */
+bool allocationHooksInstalled() noexcept;
+
+} // namespace CoreUtils
+
+#endif // ALLOCATION_TRACKER_H
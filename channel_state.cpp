@@ -0,0 +1,25 @@
+// channel_state.cpp
+#include "channel_state.h"
+
+namespace CoreUtils {
+
+ChannelStateTable::ChannelStateTable()
+    : states_(new ChannelState[CHANNEL_COUNT]) {
+}
+
+void ChannelStateTable::reset_all() {
+    for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+        ChannelState& state = states_[i];
+        state.synced = false;
+        state.expected_seq = 0;
+        state.last_receive_ns.store(0, std::memory_order_relaxed);
+        state.packets_received.store(0, std::memory_order_relaxed);
+        state.duplicates.store(0, std::memory_order_relaxed);
+        state.gaps_detected.store(0, std::memory_order_relaxed);
+        state.gaps_recovered.store(0, std::memory_order_relaxed);
+        state.gaps_abandoned.store(0, std::memory_order_relaxed);
+        state.reset_epoch.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace CoreUtils
@@ -0,0 +1,77 @@
+// channel_state.h
+#ifndef CHANNEL_STATE_H
+#define CHANNEL_STATE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace CoreUtils {
+
+/**
+ * @brief Per-channel sequencing state and counters, one cache line per channel.
+ *
+ * Sequencing fields (`synced`, `expected_seq`) are owned by the thread running
+ * `TaifexSdk::process_message`. The remaining fields are atomics written with relaxed ordering
+ * so that `Networking::NetworkManager` receive threads can stamp them and any thread can read
+ * them as statistics.
+ */
+struct alignas(64) ChannelState {
+    /** @brief True once a message has established the channel's baseline (cleared by I002). */
+    bool synced = false;
+    /** @brief Number of Sequence Resets (I002) received for the channel. */
+    std::atomic<uint32_t> reset_epoch{0};
+    /** @brief The next CHANNEL-SEQ the SDK will apply. Meaningful only when `synced`. */
+    uint64_t expected_seq = 0;
+
+    /** @brief steady_clock time (ns since epoch) of the last packet received for the channel. */
+    std::atomic<int64_t> last_receive_ns{0};
+    /** @brief Packets received from the network (before dual-feed deduplication). */
+    std::atomic<uint64_t> packets_received{0};
+    /** @brief Frames dropped because their CHANNEL-SEQ had already been applied. */
+    std::atomic<uint64_t> duplicates{0};
+    /** @brief Gaps opened (frames arrived ahead of `expected_seq`). */
+    std::atomic<uint64_t> gaps_detected{0};
+    /** @brief Gaps closed by retransmitted frames. */
+    std::atomic<uint64_t> gaps_recovered{0};
+    /** @brief Gaps skipped after the recovery timeout or reorder buffer overflow. */
+    std::atomic<uint64_t> gaps_abandoned{0};
+};
+
+static_assert(sizeof(ChannelState) == 64, "ChannelState is expected to fit one cache line.");
+
+/**
+ * @brief Flat table of `ChannelState` indexed directly by CHANNEL-ID.
+ *
+ * CHANNEL-ID is BCD 9(4), so every possible channel (0-9999) has a preallocated slot and lookups
+ * are a bounds check plus an index.
+ */
+class ChannelStateTable {
+public:
+    /** @brief Number of addressable channels; CHANNEL-ID is 9(4). */
+    static constexpr size_t CHANNEL_COUNT = 10000;
+
+    ChannelStateTable();
+
+    ChannelStateTable(const ChannelStateTable&) = delete;
+    ChannelStateTable& operator=(const ChannelStateTable&) = delete;
+
+    /** @return The channel's state, or nullptr if `channel_id` is outside 0-9999. */
+    ChannelState* find(uint32_t channel_id) {
+        return channel_id < CHANNEL_COUNT ? &states_[channel_id] : nullptr;
+    }
+    const ChannelState* find(uint32_t channel_id) const {
+        return channel_id < CHANNEL_COUNT ? &states_[channel_id] : nullptr;
+    }
+
+    /** @brief Clears sequencing state and counters of every channel. */
+    void reset_all();
+
+private:
+    std::unique_ptr<ChannelState[]> states_;
+};
+
+} // namespace CoreUtils
+
+#endif // CHANNEL_STATE_H
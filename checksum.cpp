@@ -34,4 +34,13 @@ bool verifyXorChecksum(const std::vector<unsigned char>& data, unsigned char exp
     return verifyXorChecksum(std::as_bytes(std::span<const unsigned char>(data)), expected_checksum);
 }
 
+uint64_t calculateFnv1a64(std::span<const std::byte> data_segment) {
+    uint64_t hash = 0xcbf29ce484222325ULL; // FNV offset basis
+    for (std::byte b : data_segment) {
+        hash ^= static_cast<uint64_t>(b);
+        hash *= 0x100000001b3ULL;          // FNV prime
+    }
+    return hash;
+}
+
 } // namespace CoreUtils
@@ -6,6 +6,7 @@
 #include <numeric> // For std::accumulate if used, though direct XOR loop is fine
 #include <cstddef> // For size_t and std::byte
 #include <span>    // For std::span
+#include <cstdint> // For uint64_t
 
 namespace CoreUtils {
 
@@ -61,6 +62,17 @@ bool verifyXorChecksum(std::span<const std::byte> data_segment, unsigned char ex
  */
 bool verifyXorChecksum(const std::vector<unsigned char>& data, unsigned char expected_checksum);
 
+/**
+ * @brief Calculates the 64-bit FNV-1a hash of a data segment.
+ *
+ * Not part of the TAIFEX framing; used to recognise byte-identical message bodies
+ * (e.g. the periodically rebroadcast I010) without parsing them.
+ *
+ * @param data_segment A std::span representing the data to hash.
+ * @return The 64-bit hash. An empty span yields the FNV offset basis.
+ */
+uint64_t calculateFnv1a64(std::span<const std::byte> data_segment);
+
 } // namespace CoreUtils
 
 #endif // CHECKSUM_H
@@ -50,10 +50,9 @@ bool CommonHeader::parse(const unsigned char* buffer, size_t buffer_len, CommonH
 // Helper template for BCD array to string conversion
 template<size_t N>
 static std::string bcdArrayToNumericString(const std::array<unsigned char, N>& bcd_array, size_t num_digits, const char* field_name) {
-    std::vector<unsigned char> bcd_vec(bcd_array.begin(), bcd_array.end());
     try {
         // Assuming packBcdToAscii is robust and throws on invalid BCD format for the given num_digits.
-        return packBcdToAscii(bcd_vec, num_digits);
+        return packBcdToAscii(bcd_array.data(), bcd_array.size(), num_digits);
     } catch (const CoreUtils::ParsingError& e) { // If packBcdToAscii itself throws ParsingError
         throw CoreUtils::ParsingError(std::string("Failed to decode BCD for ") + field_name + ": " + e.what());
     } catch (const std::runtime_error& e) { // Catch other runtime errors from packBcdToAscii (like its own invalid_argument for non-digits)
@@ -64,9 +63,8 @@ static std::string bcdArrayToNumericString(const std::array<unsigned char, N>& b
 }
 // Special case for single byte BCD
 static std::string bcdByteToNumericString(unsigned char bcd_byte, size_t num_digits, const char* field_name) {
-    std::vector<unsigned char> bcd_vec = {bcd_byte};
      try {
-        return packBcdToAscii(bcd_vec, num_digits);
+        return packBcdToAscii(&bcd_byte, 1, num_digits);
     } catch (const CoreUtils::ParsingError& e) {
         throw CoreUtils::ParsingError(std::string("Failed to decode BCD for ") + field_name + ": " + e.what());
     } catch (const std::runtime_error& e) {
@@ -80,6 +78,23 @@ std::string CommonHeader::getInformationTimeString() const {
     return bcdArrayToNumericString(information_time_bcd, 12, "INFORMATION-TIME");
 }
 
+uint64_t CommonHeader::getInformationTimeMicros() const {
+    uint64_t digits = 0; // HHMMSSmmmuuu
+    for (unsigned char byte : information_time_bcd) {
+        const unsigned high = byte >> 4;
+        const unsigned low = byte & 0x0F;
+        if (high > 9 || low > 9) {
+            throw CoreUtils::ParsingError("Failed to decode BCD for INFORMATION-TIME: nibble > 9");
+        }
+        digits = digits * 100 + high * 10 + low;
+    }
+    const uint64_t hours = digits / 10000000000ULL;
+    const uint64_t minutes = digits / 100000000ULL % 100;
+    const uint64_t seconds = digits / 1000000ULL % 100;
+    const uint64_t micros = digits % 1000000ULL;
+    return ((hours * 60 + minutes) * 60 + seconds) * 1000000ULL + micros;
+}
+
 uint32_t CommonHeader::getChannelId() const {
     // $9(4)$ -> 4 digits
     std::string s = bcdArrayToNumericString(channel_id_bcd, 4, "CHANNEL-ID");
@@ -56,6 +56,12 @@ struct CommonHeader {
     /** @return INFORMATION-TIME as a 12-digit string (HHMMSSmmmSSS). Throws CoreUtils::ParsingError on failure. */
     std::string getInformationTimeString() const;
 
+    /**
+     * @return INFORMATION-TIME (HHMMSSmmmuuu) as microseconds since midnight, decoded without
+     *         allocating. Throws CoreUtils::ParsingError on an invalid BCD digit.
+     */
+    uint64_t getInformationTimeMicros() const;
+
     /** @return CHANNEL-ID as uint32_t. Throws CoreUtils::ParsingError on failure. $9(4) -> 0-9999 */
     uint32_t getChannelId() const;
 
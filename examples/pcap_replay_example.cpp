@@ -10,13 +10,27 @@
 
 
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <log_file_path>" << std::endl;
+    // <log_file_path> [--journal <file>]: replay a capture, optionally journaling its normalized events.
+    // --replay-journal <file>: replay a journal written that way instead of a capture.
+    std::string log_filepath;
+    std::string journal_path;
+    std::string replay_journal_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--journal" && i + 1 < argc) {
+            journal_path = argv[++i];
+        } else if (arg == "--replay-journal" && i + 1 < argc) {
+            replay_journal_path = argv[++i];
+        } else {
+            log_filepath = arg;
+        }
+    }
+    if (log_filepath.empty() == replay_journal_path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <log_file_path> [--journal <file>]" << std::endl
+                  << "       " << argv[0] << " --replay-journal <file>" << std::endl;
         return 1;
     }
 
-    std::string log_filepath = argv[1];
-
     // Optional: Configure logger level for more verbose output during replay
     CoreUtils::setLogLevel(CoreUtils::LogLevel::INFO); // Or DEBUG for more details
 
@@ -30,6 +44,26 @@ int main(int argc, char* argv[]) {
     }
     LOG_INFO << "TaifexSdk initialized.";
 
+    if (!replay_journal_path.empty()) {
+        const auto start = std::chrono::steady_clock::now();
+        if (!sdk.replay_journal(replay_journal_path)) {
+            LOG_ERROR << "Failed to replay journal: " + replay_journal_path;
+            return 1;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        LOG_INFO << "Replayed journal " + replay_journal_path + " in " + std::to_string(elapsed.count()) + " ms.";
+        return 0;
+    }
+    if (!journal_path.empty()) {
+        Taifex::EventJournalConfig journal_config;
+        journal_config.path = journal_path;
+        if (!sdk.journal_events(journal_config)) {
+            LOG_ERROR << "Failed to open event journal: " + journal_path;
+            return 1;
+        }
+        LOG_INFO << "Journaling normalized events to " + journal_path;
+    }
+
     // 2. Instantiate the LogFilePacketSimulator
     // Assuming constructor with default header sizes is used, or adjust if specific sizes are needed for the pcap.
     Utils::LogFilePacketSimulator simulator(log_filepath);
@@ -77,6 +111,7 @@ int main(int argc, char* argv[]) {
 
     // 4. Close the simulator (which closes the file)
     simulator.close();
+    sdk.close_event_journal();
 
     // Example: Retrieve and print some info after processing
     // This part depends on what product IDs are in the log file.
@@ -0,0 +1,160 @@
+// latency_histogram.cpp
+#include "latency_histogram.h"
+#include "allocation_tracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace CoreUtils {
+
+double tscNanosPerTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const double nanos_per_tick = [] {
+        const auto wall_start = std::chrono::steady_clock::now();
+        const uint64_t tsc_start = readTsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const uint64_t tsc_end = readTsc();
+        const auto wall_end = std::chrono::steady_clock::now();
+        const double elapsed_ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start).count());
+        return (tsc_end > tsc_start) ? elapsed_ns / static_cast<double>(tsc_end - tsc_start) : 1.0;
+    }();
+    return nanos_per_tick;
+#else
+    return 1.0; // readTsc() already returns nanoseconds.
+#endif
+}
+
+size_t LatencyHistogram::bucket_index(uint64_t value) {
+    value = std::min(value, MAX_VALUE);
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    const unsigned top_bit = 63u - static_cast<unsigned>(__builtin_clzll(value));
+    const unsigned shift = top_bit - SUB_BUCKET_BITS + 1; // Keep the top SUB_BUCKET_BITS bits.
+    const uint64_t mantissa = value >> shift;             // In [SUB_BUCKET_HALF, SUB_BUCKET_COUNT)
+    return static_cast<size_t>(SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + (mantissa - SUB_BUCKET_HALF));
+}
+
+uint64_t LatencyHistogram::bucket_upper_value(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const uint64_t offset = index - SUB_BUCKET_COUNT;
+    const unsigned shift = static_cast<unsigned>(offset / SUB_BUCKET_HALF) + 1;
+    const uint64_t mantissa = SUB_BUCKET_HALF + offset % SUB_BUCKET_HALF;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::value_at_percentile(double percentile) const {
+    const uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * total)));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += buckets_[i].load(std::memory_order_relaxed);
+        if (cumulative >= target) {
+            return std::min(bucket_upper_value(i), max());
+        }
+    }
+    return max(); // Only reachable while a concurrent record is half done.
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+const char* latencyStageName(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::VALIDATION:    return "validation";
+        case LatencyStage::HEADER_DECODE: return "header_decode";
+        case LatencyStage::DISPATCH:      return "dispatch";
+        case LatencyStage::BODY_PARSE:    return "body_parse";
+        case LatencyStage::BOOK_APPLY:    return "book_apply";
+        case LatencyStage::CALLBACKS:     return "callbacks";
+        case LatencyStage::TOTAL:         return "total";
+        case LatencyStage::COUNT:         break;
+    }
+    return "unknown";
+}
+
+LatencyRecorder::~LatencyRecorder() {
+    for (auto& slot : by_type_) {
+        delete slot.load(std::memory_order_relaxed);
+    }
+}
+
+void LatencyRecorder::commit(MessageType type, LatencyProbe& probe) {
+    auto& slot = by_type_[messageTypeSlot(type)];
+    StageHistograms* histograms = slot.load(std::memory_order_relaxed);
+    if (histograms == nullptr) [[unlikely]] {
+        ColdPathScope cold_path; // Once per message type.
+        histograms = new StageHistograms();
+        slot.store(histograms, std::memory_order_release);
+    }
+
+    const uint64_t now = readTsc();
+    for (size_t i = 0; i < static_cast<size_t>(LatencyStage::TOTAL); ++i) {
+        if ((probe.marked_ >> i) & 1u) {
+            (*histograms)[i].record(probe.ticks_[i]);
+        }
+    }
+    (*histograms)[static_cast<size_t>(LatencyStage::TOTAL)].record(now - probe.start_);
+
+    // The next frame (e.g. one drained from the reorder buffer) is timed from here.
+    probe.start_ = probe.last_ = now;
+    probe.marked_ = 0;
+}
+
+const LatencyHistogram* LatencyRecorder::histogram(MessageType type, LatencyStage stage) const {
+    const StageHistograms* histograms = by_type_[messageTypeSlot(type)].load(std::memory_order_acquire);
+    if (histograms == nullptr || stage == LatencyStage::COUNT) {
+        return nullptr;
+    }
+    return &(*histograms)[static_cast<size_t>(stage)];
+}
+
+double LatencyRecorder::percentile_ns(MessageType type, LatencyStage stage, double percentile) const {
+    const LatencyHistogram* hist = histogram(type, stage);
+    if (hist == nullptr || hist->count() == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(hist->value_at_percentile(percentile)) * tscNanosPerTick();
+}
+
+LatencySummary LatencyRecorder::summary(MessageType type, LatencyStage stage) const {
+    LatencySummary result;
+    const LatencyHistogram* hist = histogram(type, stage);
+    if (hist == nullptr || hist->count() == 0) {
+        return result;
+    }
+    const double nanos_per_tick = tscNanosPerTick();
+    result.count = hist->count();
+    result.p50_ns = static_cast<double>(hist->value_at_percentile(50.0)) * nanos_per_tick;
+    result.p90_ns = static_cast<double>(hist->value_at_percentile(90.0)) * nanos_per_tick;
+    result.p99_ns = static_cast<double>(hist->value_at_percentile(99.0)) * nanos_per_tick;
+    result.p999_ns = static_cast<double>(hist->value_at_percentile(99.9)) * nanos_per_tick;
+    result.max_ns = static_cast<double>(hist->max()) * nanos_per_tick;
+    return result;
+}
+
+void LatencyRecorder::reset() {
+    for (auto& slot : by_type_) {
+        if (StageHistograms* histograms = slot.load(std::memory_order_acquire)) {
+            for (auto& hist : *histograms) {
+                hist.reset();
+            }
+        }
+    }
+}
+
+} // namespace CoreUtils
@@ -0,0 +1,181 @@
+// latency_histogram.h
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "message_identifier.h" // For CoreUtils::MessageType
+#include "metrics.h"            // For CoreUtils::messageTypeSlot, MESSAGE_TYPE_SLOTS
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace CoreUtils {
+
+/** @return The CPU timestamp counter, or steady_clock nanoseconds where no TSC is available. */
+inline uint64_t readTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @brief Nanoseconds per `readTsc()` tick. Calibrated against steady_clock on first call (a few
+ *        milliseconds), so call it off the hot path.
+ */
+double tscNanosPerTick();
+
+/**
+ * @brief Log-linear (HDR-style) histogram of tick counts.
+ *
+ * Values below 32 are recorded exactly; above that, each power-of-two range is split into 16
+ * linear sub-buckets, bounding the relative error of any reported value to ~6%. Values beyond
+ * 2^40 ticks are clamped. Single writer; buckets are relaxed atomics so any thread may read.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1ull << SUB_BUCKET_BITS;      // 32
+    static constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;          // 16
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr uint64_t MAX_VALUE = (1ull << MAX_VALUE_BITS) - 1;
+    static constexpr size_t BUCKET_COUNT =
+        SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+
+    static size_t bucket_index(uint64_t value);
+    /** @return The highest value that maps to `index`. */
+    static uint64_t bucket_upper_value(size_t index);
+
+    void record(uint64_t value) {
+        bump(buckets_[bucket_index(value)], 1);
+        bump(count_, 1);
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    /**
+     * @param percentile In [0, 100].
+     * @return The value at or below which `percentile` percent of recorded values fall (to bucket
+     *         precision), or 0 if nothing has been recorded.
+     */
+    uint64_t value_at_percentile(double percentile) const;
+
+    void reset();
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+/** @brief Stages of `Taifex::TaifexSdk::process_message`, in pipeline order. */
+enum class LatencyStage : uint8_t {
+    VALIDATION,    ///< Length, BODY-LENGTH and checksum checks.
+    HEADER_DECODE, ///< CHANNEL-ID/SEQ decode, sequencing and message type identification.
+    DISPATCH,      ///< Handler selection, up to the start of body parsing.
+    BODY_PARSE,    ///< Specific message body parser.
+    BOOK_APPLY,    ///< Applying the message to the order book or product registry.
+    CALLBACKS,     ///< User callbacks.
+    TOTAL,         ///< Whole frame, from receipt (or release from the reorder buffer) to return.
+    COUNT
+};
+
+constexpr size_t LATENCY_STAGE_COUNT = static_cast<size_t>(LatencyStage::COUNT);
+
+/** @return A stable name for the stage (e.g. "body_parse"). */
+const char* latencyStageName(LatencyStage stage);
+
+/**
+ * @brief Stage timestamps for the frame currently being processed.
+ *
+ * `mark(stage)` charges the ticks since the previous mark to `stage`. Stages a frame never reaches
+ * (e.g. BOOK_APPLY for a heartbeat) are not recorded for it.
+ */
+class LatencyProbe {
+public:
+    void begin() {
+        start_ = last_ = readTsc();
+        marked_ = 0;
+    }
+
+    void mark(LatencyStage stage) {
+        const uint64_t now = readTsc();
+        const auto index = static_cast<size_t>(stage);
+        ticks_[index] = ((marked_ >> index) & 1u) ? ticks_[index] + (now - last_) : now - last_;
+        marked_ |= 1u << index;
+        last_ = now;
+    }
+
+private:
+    friend class LatencyRecorder;
+
+    uint64_t start_ = 0;
+    uint64_t last_ = 0;
+    uint32_t marked_ = 0;
+    std::array<uint64_t, LATENCY_STAGE_COUNT> ticks_{};
+};
+
+/** @brief Percentiles of one stage/message type, in nanoseconds. */
+struct LatencySummary {
+    uint64_t count = 0;
+    double p50_ns = 0;
+    double p90_ns = 0;
+    double p99_ns = 0;
+    double p999_ns = 0;
+    double max_ns = 0;
+};
+
+/**
+ * @brief Per-message-type, per-stage latency histograms.
+ *
+ * Histograms for a message type are allocated the first time a frame of that type is committed.
+ * `commit` must be called from a single thread; the read methods may be called from any thread.
+ */
+class LatencyRecorder {
+public:
+    LatencyRecorder() = default;
+    ~LatencyRecorder();
+
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    /** @brief Records the probe's marked stages and TOTAL under `type`, then restarts the probe. */
+    void commit(MessageType type, LatencyProbe& probe);
+
+    /** @return The stage's histogram for `type`, or nullptr if no frame of that type was committed. */
+    const LatencyHistogram* histogram(MessageType type, LatencyStage stage) const;
+
+    /** @return The stage latency in nanoseconds at `percentile`, or 0 with no samples. */
+    double percentile_ns(MessageType type, LatencyStage stage, double percentile) const;
+
+    LatencySummary summary(MessageType type, LatencyStage stage) const;
+
+    /** @brief Clears all histograms. Samples committed concurrently may survive the reset. */
+    void reset();
+
+private:
+    using StageHistograms = std::array<LatencyHistogram, LATENCY_STAGE_COUNT>;
+
+    std::array<std::atomic<StageHistograms*>, MESSAGE_TYPE_SLOTS> by_type_{};
+};
+
+} // namespace CoreUtils
+
+#endif // LATENCY_HISTOGRAM_H
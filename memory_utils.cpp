@@ -0,0 +1,54 @@
+// memory_utils.cpp
+#include "memory_utils.h"
+
+#include "logger.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace CoreUtils {
+
+static size_t pageSize() {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+size_t prefaultMemory(void* data, size_t length) {
+    if (data == nullptr || length == 0) {
+        return 0;
+    }
+    const size_t page = pageSize();
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(data);
+    const uintptr_t first_page = begin & ~(page - 1);
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(reinterpret_cast<void*>(first_page), begin + length - first_page, MADV_POPULATE_WRITE) == 0) {
+        return length;
+    }
+#endif
+    // Older kernels: a write fault per page. The byte written back is the one read, so data
+    // already in use is unchanged.
+    volatile unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (uintptr_t page_start = first_page; page_start < begin + length; page_start += page) {
+        const size_t offset = page_start < begin ? 0 : page_start - begin;
+        bytes[offset] = bytes[offset];
+    }
+    return length;
+}
+
+size_t lockMemory(const void* data, size_t length) {
+    if (data == nullptr || length == 0) {
+        return 0;
+    }
+    if (mlock(data, length) != 0) {
+        LOG_WARNING << "Could not lock " << length << " bytes: " << std::strerror(errno)
+                    << " (raise RLIMIT_MEMLOCK).";
+        return 0;
+    }
+    return length;
+}
+
+} // namespace CoreUtils
@@ -0,0 +1,25 @@
+// memory_utils.h
+#ifndef MEMORY_UTILS_H
+#define MEMORY_UTILS_H
+
+#include <cstddef>
+
+namespace CoreUtils {
+
+/**
+ * @brief Faults in every page of `[data, data + length)` for writing, keeping its contents:
+ *        `MADV_POPULATE_WRITE` where the kernel has it, otherwise one read and write back of a
+ *        byte per page. The caller must be the only writer of the range meanwhile.
+ * @return Bytes covered.
+ */
+size_t prefaultMemory(void* data, size_t length);
+
+/**
+ * @brief `mlock`s `[data, data + length)`.
+ * @return Bytes locked; 0 (logged) if the kernel refused, typically over RLIMIT_MEMLOCK.
+ */
+size_t lockMemory(const void* data, size_t length);
+
+} // namespace CoreUtils
+
+#endif // MEMORY_UTILS_H
@@ -3,10 +3,41 @@
 #define MESSAGE_IDENTIFIER_H
 
 #include <string>
+#include <cstdint>
 #include "common_header.h" // For CoreUtils::CommonHeader
 
 namespace CoreUtils {
 
+/**
+ * @brief Numeric message type, using the four-digit code from the message table
+ *        (e.g., 1010 for I010). UNKNOWN is returned for unrecognised TC/MK pairs.
+ */
+enum class MessageType : uint16_t {
+    UNKNOWN                    = 0,
+    I001_HEARTBEAT             = 1001,
+    I002_SEQUENCE_RESET        = 1002,
+    I010_PRODUCT_BASIC_DATA    = 1010,
+    I011_CONTRACT_BASIC_DATA   = 1011,
+    I012_PRICE_LIMIT_INFO      = 1012,
+    I024_MATCH_INFO            = 1024,
+    I025_HIGH_LOW_PRICE        = 1025,
+    I030_ORDER_QTY_ACCUMULATED = 1030,
+    I050_ANNOUNCEMENT          = 1050,
+    I060_UNDERLYING_INFO       = 1060,
+    I064_UNDERLYING_TRIAL      = 1064,
+    I070_CLOSING_DATA          = 1070,
+    I071_CLOSING_SETTLEMENT    = 1071,
+    I072_CLOSING_OPEN_INTEREST = 1072,
+    I073_COMBO_CLOSING_DATA    = 1073,
+    I081_ORDER_BOOK_UPDATE     = 1081,
+    I083_ORDER_BOOK_SNAPSHOT   = 1083,
+    I084_SNAPSHOT_REFRESH      = 1084,
+    I100_QUOTE_REQUEST         = 1100,
+    I120_UNDERLYING_MAPPING    = 1120,
+    I130_CONTRACT_ADJUSTMENT   = 1130,
+    I140_SYSTEM_MESSAGE        = 1140
+};
+
 /**
  * @brief Identifies the message ID string based on the transmission code and message kind
  *        from the provided CommonHeader.
@@ -21,6 +52,37 @@ namespace CoreUtils {
  */
 std::string identifyMessageId(const CommonHeader& header);
 
+/**
+ * @brief Identifies the numeric MessageType for the header's transmission code and message kind.
+ *
+ * Uses the same mapping table as identifyMessageId, without building a string.
+ *
+ * @param header The parsed CommonHeader object.
+ * @return The MessageType, or MessageType::UNKNOWN if the combination is not recognized.
+ */
+MessageType identifyMessageType(const CommonHeader& header);
+
+/**
+ * @brief Market segment of a frame, from its transmission code. The segments never share products.
+ */
+enum class MarketSegment : uint8_t {
+    NONE    = 0, ///< TC '0': heartbeat and sequence reset, carried on the channels of both segments.
+    FUTURES = 1, ///< TC '1'-'3'.
+    OPTIONS = 2  ///< TC '4'-'5'.
+};
+
+/**
+ * @brief Identifies the market segment from the header's transmission code.
+ * @return MarketSegment::NONE for TC '0' and unrecognised codes.
+ */
+MarketSegment identifyMarketSegment(const CommonHeader& header);
+
+/**
+ * @brief Converts a MessageType to its message ID string (e.g., "I010", "M1001").
+ * @return The message ID string, or an empty string for MessageType::UNKNOWN.
+ */
+std::string messageTypeToString(MessageType type);
+
 } // namespace CoreUtils
 
 #endif // MESSAGE_IDENTIFIER_H
@@ -0,0 +1,121 @@
+#include "message_events.h"
+#include "message_parser_utils.h" // For bcdBytesToUint64
+
+#include <cstdint> // For UINT32_MAX
+
+namespace SpecificMessageParsers {
+
+namespace {
+
+const size_t PROD_ID_LEN = 20;
+const size_t PROD_MSG_SEQ_BCD_LEN = 5;
+
+// Decodes the fields shared by every I081/I083 entry after MD-ENTRY-TYPE: SIGN (1),
+// MD-ENTRY-PX 9(9) L5, MD-ENTRY-SIZE 9(8) L4 and MD-PRICE-LEVEL 9(2) L1 (12 bytes with the type).
+bool decode_entry_values(const unsigned char* entry, CoreUtils::NormalizedEvent& event) {
+    uint64_t price;
+    uint64_t size;
+    uint64_t level;
+    if (!bcdBytesToUint64(entry + 2, 5, price) || !bcdBytesToUint64(entry + 7, 4, size) ||
+        !bcdBytesToUint64(entry + 11, 1, level)) {
+        return false;
+    }
+    price %= 1000000000ULL; // 9 digits in 10 nibbles: the leading one is padding.
+    event.side = CoreUtils::eventSideFromEntryType(static_cast<char>(entry[0]));
+    event.price = entry[1] == '-' ? -static_cast<int64_t>(price) : static_cast<int64_t>(price);
+    event.quantity = static_cast<int64_t>(size);
+    event.level = static_cast<uint8_t>(level);
+    return true;
+}
+
+// PROD-ID and PROD-MSG-SEQ lead both bodies.
+bool decode_identity(const unsigned char* body_data, BookMessageEvents& decoded) {
+    uint64_t prod_msg_seq;
+    if (!bcdBytesToUint64(body_data + PROD_ID_LEN, PROD_MSG_SEQ_BCD_LEN, prod_msg_seq) || prod_msg_seq > UINT32_MAX) {
+        return false;
+    }
+    decoded.prod_id = std::string_view(reinterpret_cast<const char*>(body_data), PROD_ID_LEN);
+    decoded.prod_msg_seq = static_cast<uint32_t>(prod_msg_seq);
+    decoded.event_count = 0;
+    return true;
+}
+
+} // namespace
+
+bool decode_i081_events(const unsigned char* body_data,
+                        uint16_t body_length,
+                        const CoreUtils::NormalizedEvent& stamp,
+                        std::span<CoreUtils::NormalizedEvent> out,
+                        BookMessageEvents& decoded) {
+    // PROD-ID (20) + PROD-MSG-SEQ (5) + NO-MD-ENTRIES (1), then 13 bytes per entry:
+    // MD-UPDATE-ACTION (1) followed by the 12 shared with I083.
+    const size_t FIXED_PART_LEN = 26;
+    const size_t MD_ENTRY_SIZE_BYTES = 13;
+    if (!body_data || body_length < FIXED_PART_LEN || !decode_identity(body_data, decoded)) {
+        return false;
+    }
+    uint64_t entries;
+    if (!bcdBytesToUint64(body_data + 25, 1, entries) || entries > out.size() ||
+        body_length < FIXED_PART_LEN + entries * MD_ENTRY_SIZE_BYTES) {
+        return false;
+    }
+
+    const unsigned char* entry = body_data + FIXED_PART_LEN;
+    for (uint64_t i = 0; i < entries; ++i, entry += MD_ENTRY_SIZE_BYTES) {
+        const CoreUtils::EventType type = CoreUtils::eventTypeFromUpdateAction(static_cast<char>(entry[0]));
+        if (type == CoreUtils::EventType::NONE) {
+            continue;
+        }
+        CoreUtils::NormalizedEvent& event = out[decoded.event_count];
+        event = stamp;
+        event.type = type;
+        event.prod_msg_seq = decoded.prod_msg_seq;
+        if (!decode_entry_values(entry + 1, event)) {
+            return false;
+        }
+        ++decoded.event_count;
+    }
+    return true;
+}
+
+bool decode_i083_events(const unsigned char* body_data,
+                        uint16_t body_length,
+                        const CoreUtils::NormalizedEvent& stamp,
+                        std::span<CoreUtils::NormalizedEvent> out,
+                        BookMessageEvents& decoded) {
+    // PROD-ID (20) + PROD-MSG-SEQ (5) + CALCULATED-FLAG (1) + NO-MD-ENTRIES (1), then 12 bytes per entry.
+    const size_t FIXED_PART_LEN = 27;
+    const size_t MD_ENTRY_SIZE_BYTES = 12;
+    if (!body_data || body_length < FIXED_PART_LEN || out.empty() || !decode_identity(body_data, decoded)) {
+        return false;
+    }
+    uint64_t entries;
+    if (!bcdBytesToUint64(body_data + 26, 1, entries) || entries + 1 > out.size() ||
+        body_length < FIXED_PART_LEN + entries * MD_ENTRY_SIZE_BYTES) {
+        return false;
+    }
+    const uint8_t flags = body_data[25] != '0' ? CoreUtils::NormalizedEvent::FLAG_CALCULATED : 0;
+
+    CoreUtils::NormalizedEvent& clear = out[0];
+    clear = stamp;
+    clear.type = CoreUtils::EventType::BOOK_CLEAR;
+    clear.prod_msg_seq = decoded.prod_msg_seq;
+    clear.flags |= flags;
+    decoded.event_count = 1;
+
+    const unsigned char* entry = body_data + FIXED_PART_LEN;
+    for (uint64_t i = 0; i < entries; ++i, entry += MD_ENTRY_SIZE_BYTES) {
+        CoreUtils::NormalizedEvent& event = out[decoded.event_count];
+        event = stamp;
+        event.type = CoreUtils::EventType::SNAPSHOT_LEVEL;
+        event.prod_msg_seq = decoded.prod_msg_seq;
+        event.flags |= flags;
+        if (!decode_entry_values(entry, event)) {
+            return false;
+        }
+        ++decoded.event_count;
+    }
+    return true;
+}
+
+} // namespace SpecificMessageParsers
@@ -0,0 +1,60 @@
+#ifndef MESSAGE_EVENTS_H
+#define MESSAGE_EVENTS_H
+
+#include <cstddef>     // For size_t
+#include <cstdint>     // For uint16_t, uint32_t
+#include <span>        // For std::span
+#include <string_view> // For std::string_view
+
+#include "normalized_event.h"
+
+namespace SpecificMessageParsers {
+
+/** @brief Most events one I081/I083 body decodes to: 99 MD entries plus an I083's BOOK_CLEAR. */
+constexpr size_t MAX_BOOK_MESSAGE_EVENTS = 100;
+
+/**
+ * @brief Identity of a book message decoded by `decode_i081_events`/`decode_i083_events`.
+ */
+struct BookMessageEvents {
+    /** @brief X(20) PROD-ID, space padded, pointing into the decoded body. */
+    std::string_view prod_id;
+    /** @brief 9(10) PROD-MSG-SEQ. */
+    uint32_t prod_msg_seq = 0;
+    /** @brief Events written to the output span. */
+    size_t event_count = 0;
+};
+
+/**
+ * @brief Decodes an I081 body straight into `NormalizedEvent`s, one per MD entry, without
+ *        building a `MessageI081` (no strings, no allocation).
+ * @details Every event starts as a copy of `stamp`, which carries the header fields (channel,
+ *          sequence, INFORMATION-TIME) and, when known, the book identity; the decoder fills in
+ *          type, side, signed price, quantity, level and PROD-MSG-SEQ. Entries with an unknown
+ *          MD-UPDATE-ACTION are skipped. `FLAG_END_OF_MESSAGE` is left to the caller.
+ * @param body_data Pointer to the raw byte data of the message body.
+ * @param body_length The length of the message body, obtained from the common header.
+ * @param stamp Template copied into every event.
+ * @param out Receives the events; `MAX_BOOK_MESSAGE_EVENTS` entries always suffice.
+ * @param decoded Receives PROD-ID, PROD-MSG-SEQ and the number of events.
+ * @return False on insufficient length, a non-BCD digit, or too small an output span.
+ */
+bool decode_i081_events(const unsigned char* body_data,
+                        uint16_t body_length,
+                        const CoreUtils::NormalizedEvent& stamp,
+                        std::span<CoreUtils::NormalizedEvent> out,
+                        BookMessageEvents& decoded);
+
+/**
+ * @brief Decodes an I083 body straight into a BOOK_CLEAR followed by one SNAPSHOT_LEVEL per MD
+ *        entry. Same contract as `decode_i081_events`; in a trial-matching snapshot every event also
+ *        carries `NormalizedEvent::FLAG_CALCULATED` (any CALCULATED-FLAG other than 0).
+ */
+bool decode_i083_events(const unsigned char* body_data,
+                        uint16_t body_length,
+                        const CoreUtils::NormalizedEvent& stamp,
+                        std::span<CoreUtils::NormalizedEvent> out,
+                        BookMessageEvents& decoded);
+
+} // namespace SpecificMessageParsers
+#endif // MESSAGE_EVENTS_H
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <cstddef> // For size_t and std::byte
+#include <cstdint> // For uint64_t
 #include <span>    // For std::span
 
 // Forward declaration for CoreUtils::packBcdToAscii (if needed, but usually not for .h)
@@ -25,6 +26,27 @@ namespace SpecificMessageParsers {
  */
 std::string bcdBytesToAsciiStringHelper(std::span<const std::byte> bcd_data_view, size_t num_digits);
 
+/**
+ * @brief Decodes packed BCD straight to an integer, without the intermediate string.
+ * @param bcd_data Raw BCD bytes; every nibble must be a digit.
+ * @param length Number of bytes (at most 9, i.e. 18 digits).
+ * @param out Receives the value.
+ * @return False if a nibble is not a decimal digit.
+ */
+inline bool bcdBytesToUint64(const unsigned char* bcd_data, size_t length, uint64_t& out) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const unsigned high = bcd_data[i] >> 4;
+        const unsigned low = bcd_data[i] & 0x0F;
+        if (high > 9 || low > 9) {
+            return false;
+        }
+        value = value * 100 + high * 10 + low;
+    }
+    out = value;
+    return true;
+}
+
 } // namespace SpecificMessageParsers
 
 #endif // MESSAGE_PARSER_UTILS_H
@@ -0,0 +1,180 @@
+// metrics.cpp
+#include "metrics.h"
+#include "allocation_tracker.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace CoreUtils {
+
+namespace {
+
+// Owns every block ever handed out. Blocks of exited threads go to a free list and are reused by
+// new threads, keeping their counts, so totals never go backwards.
+class MetricsRegistry {
+public:
+    MetricsBlock* acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_blocks_.empty()) {
+            MetricsBlock* block = free_blocks_.back();
+            free_blocks_.pop_back();
+            return block;
+        }
+        blocks_.push_back(std::make_unique<MetricsBlock>());
+        return blocks_.back().get();
+    }
+
+    void release(MetricsBlock* block) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_blocks_.push_back(block);
+    }
+
+    MetricsSnapshot snapshot() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        MetricsSnapshot result = sum_locked();
+        for (size_t i = 0; i < METRIC_COUNT; ++i) {
+            result.counters[i] -= baseline_.counters[i];
+        }
+        for (size_t i = 0; i < MESSAGE_TYPE_SLOTS; ++i) {
+            result.messages_by_type[i] -= baseline_.messages_by_type[i];
+        }
+        return result;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        baseline_ = sum_locked();
+    }
+
+private:
+    MetricsSnapshot sum_locked() const {
+        MetricsSnapshot sum;
+        for (const auto& block : blocks_) {
+            for (size_t i = 0; i < METRIC_COUNT; ++i) {
+                sum.counters[i] += block->counters[i].load(std::memory_order_relaxed);
+            }
+            for (size_t i = 0; i < MESSAGE_TYPE_SLOTS; ++i) {
+                sum.messages_by_type[i] += block->messages_by_type[i].load(std::memory_order_relaxed);
+            }
+        }
+        return sum;
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<MetricsBlock>> blocks_;
+    std::vector<MetricsBlock*> free_blocks_;
+    MetricsSnapshot baseline_;
+};
+
+MetricsRegistry& registry() {
+    static MetricsRegistry* instance = new MetricsRegistry(); // Never destroyed: threads may outlive statics.
+    return *instance;
+}
+
+// Returns the thread's block to the registry when the thread exits.
+struct ThreadBlockReleaser {
+    MetricsBlock* block = nullptr;
+    ~ThreadBlockReleaser() {
+        if (block) {
+            detail::tls_metrics_block = nullptr;
+            registry().release(block);
+        }
+    }
+};
+
+} // namespace
+
+namespace detail {
+
+constinit thread_local MetricsBlock* tls_metrics_block = nullptr;
+
+MetricsBlock* acquireMetricsBlock() {
+    ColdPathScope cold_path; // Once per thread.
+    static thread_local ThreadBlockReleaser releaser;
+    MetricsBlock* block = registry().acquire();
+    releaser.block = block;
+    tls_metrics_block = block;
+    return block;
+}
+
+} // namespace detail
+
+const char* metricName(Metric metric) {
+    switch (metric) {
+        case Metric::MULTICAST_PACKETS_RECEIVED:      return "multicast_packets_received";
+        case Metric::MULTICAST_BYTES_RECEIVED:        return "multicast_bytes_received";
+        case Metric::RETRANSMISSION_REQUESTS_SENT:    return "retransmission_requests_sent";
+        case Metric::RETRANSMITTED_MESSAGES_RECEIVED: return "retransmitted_messages_received";
+        case Metric::RETRANSMITTED_BYTES_RECEIVED:    return "retransmitted_bytes_received";
+        case Metric::DUAL_FEED_DUPLICATES:            return "dual_feed_duplicates";
+        case Metric::SEGMENT_QUEUE_OVERFLOWS:         return "segment_queue_overflows";
+        case Metric::HEADER_ERRORS:                   return "header_errors";
+        case Metric::LENGTH_MISMATCHES:               return "length_mismatches";
+        case Metric::CHECKSUM_FAILURES:               return "checksum_failures";
+        case Metric::BYTES_PROCESSED:                 return "bytes_processed";
+        case Metric::SEQUENCE_GAPS:                   return "sequence_gaps";
+        case Metric::SEQUENCE_DUPLICATES:             return "sequence_duplicates";
+        case Metric::PRODUCT_SEQUENCE_GAPS:           return "product_sequence_gaps";
+        case Metric::FILTERED_MESSAGES:               return "filtered_messages";
+        case Metric::ORDER_BOOKS_CREATED:             return "order_books_created";
+        case Metric::PENDING_FRAMES_QUEUED:           return "pending_frames_queued";
+        case Metric::PENDING_FRAMES_REPLAYED:         return "pending_frames_replayed";
+        case Metric::PENDING_FRAMES_DROPPED:          return "pending_frames_dropped";
+        case Metric::HOT_PATH_ALLOCATIONS:            return "hot_path_allocations";
+        case Metric::FANOUT_BYTES_SENT:               return "fanout_bytes_sent";
+        case Metric::FANOUT_UPDATES_CONFLATED:        return "fanout_updates_conflated";
+        case Metric::FANOUT_CLIENTS_DISCONNECTED:     return "fanout_clients_disconnected";
+        case Metric::SEQUENCE_RESETS:                 return "sequence_resets";
+        case Metric::SEQUENCE_RESET_BOOKS:            return "sequence_reset_books";
+        case Metric::SEQUENCE_RESET_NANOS:            return "sequence_reset_nanos";
+        case Metric::STALE_CHANNELS:                  return "stale_channels";
+        case Metric::STALE_PRODUCTS:                  return "stale_products";
+        case Metric::RETRANSMISSION_RETRIES:          return "retransmission_retries";
+        case Metric::PAGE_FAULTS:                     return "page_faults";
+        case Metric::COUNT:                           break;
+    }
+    return "unknown";
+}
+
+uint64_t MetricsSnapshot::total_messages() const {
+    uint64_t total = 0;
+    for (uint64_t count : messages_by_type) {
+        total += count;
+    }
+    return total;
+}
+
+MetricsSnapshot getMetricsSnapshot() {
+    return registry().snapshot();
+}
+
+void resetMetrics() {
+    registry().reset();
+}
+
+uint64_t processPageFaults() {
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(usage.ru_minflt) + static_cast<uint64_t>(usage.ru_majflt);
+}
+
+void samplePageFaults() {
+    static std::atomic<uint64_t> last_sample{0}; // 0 until the first call.
+    const uint64_t total = processPageFaults();
+    uint64_t previous = last_sample.load(std::memory_order_relaxed);
+    do {
+        if (total <= previous) {
+            return; // A concurrent sampler already counted up to here.
+        }
+    } while (!last_sample.compare_exchange_weak(previous, total, std::memory_order_relaxed));
+    if (previous != 0) {
+        incrementMetric(Metric::PAGE_FAULTS, total - previous);
+    }
+}
+
+} // namespace CoreUtils
@@ -0,0 +1,142 @@
+// metrics.h
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "message_identifier.h" // For CoreUtils::MessageType
+
+namespace CoreUtils {
+
+/**
+ * @brief Process-wide feed counters. Each is incremented by the component named in its comment.
+ */
+enum class Metric : uint8_t {
+    MULTICAST_PACKETS_RECEIVED,       ///< Networking::MulticastReceiver, every datagram.
+    MULTICAST_BYTES_RECEIVED,         ///< Networking::MulticastReceiver.
+    RETRANSMISSION_REQUESTS_SENT,     ///< Networking::RetransmissionClient, DataRequest101 sent.
+    RETRANSMITTED_MESSAGES_RECEIVED,  ///< Networking::RetransmissionClient, market data frames from the TCP stream.
+    RETRANSMITTED_BYTES_RECEIVED,     ///< Networking::RetransmissionClient.
+    DUAL_FEED_DUPLICATES,             ///< Networking::NetworkManager, copies dropped by A/B feed arbitration.
+    SEGMENT_QUEUE_OVERFLOWS,          ///< Networking::NetworkManager, frames dropped because a segment engine's queue was full.
+    HEADER_ERRORS,                    ///< NetworkManager / TaifexSdk, unparseable header fields.
+    LENGTH_MISMATCHES,                ///< TaifexSdk, frame length differs from BODY-LENGTH.
+    CHECKSUM_FAILURES,                ///< TaifexSdk, XOR checksum mismatch.
+    BYTES_PROCESSED,                  ///< TaifexSdk, bytes of frames applied in channel order.
+    SEQUENCE_GAPS,                    ///< TaifexSdk, CHANNEL-SEQ gaps opened.
+    SEQUENCE_DUPLICATES,              ///< TaifexSdk, frames dropped for an already applied CHANNEL-SEQ.
+    PRODUCT_SEQUENCE_GAPS,            ///< TaifexSdk, PROD-MSG-SEQ gaps that marked a book stale.
+    FILTERED_MESSAGES,                ///< TaifexSdk, valid frames dropped without a handler.
+    ORDER_BOOKS_CREATED,              ///< TaifexSdk.
+    PENDING_FRAMES_QUEUED,            ///< TaifexSdk, I081/I083 held until their product's I010.
+    PENDING_FRAMES_REPLAYED,          ///< TaifexSdk, held frames applied once the I010 arrived.
+    PENDING_FRAMES_DROPPED,           ///< TaifexSdk, held frames lost to the pending buffer bounds.
+    HOT_PATH_ALLOCATIONS,             ///< TaifexSdk, heap allocations while applying frames (AllocationCheck::REPORT).
+    FANOUT_BYTES_SENT,                ///< Taifex::UdsFanoutServer, bytes written to client sockets.
+    FANOUT_UPDATES_CONFLATED,         ///< Taifex::UdsFanoutServer, book frames a lagging client skipped for a later image.
+    FANOUT_CLIENTS_DISCONNECTED,      ///< Taifex::UdsFanoutServer, clients closed or dropped on a send error.
+    SEQUENCE_RESETS,                  ///< TaifexSdk, I002 Sequence Resets applied.
+    SEQUENCE_RESET_BOOKS,             ///< TaifexSdk, books cleared by I002 (only the resetting channel's books).
+    SEQUENCE_RESET_NANOS,             ///< TaifexSdk, time spent clearing books for I002, in nanoseconds.
+    STALE_CHANNELS,                   ///< TaifexSdk, channels that went quiet past LivenessConfig::channel_timeout.
+    STALE_PRODUCTS,                   ///< TaifexSdk, books that went quiet past LivenessConfig::product_timeout.
+    RETRANSMISSION_RETRIES,           ///< TaifexSdk, missing ranges requested again after GapRecoveryConfig::retransmission_timeout.
+    PAGE_FAULTS,                      ///< samplePageFaults, minor and major page faults of the process.
+    COUNT
+};
+
+constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::COUNT);
+
+/**
+ * @brief Number of per-message-type slots. MessageType codes run from 1001 to 1140, so slot
+ *        `code - 1000` addresses each one directly; slot 0 holds MessageType::UNKNOWN.
+ */
+constexpr size_t MESSAGE_TYPE_SLOTS = 141;
+
+constexpr size_t messageTypeSlot(MessageType type) {
+    const auto code = static_cast<size_t>(type);
+    return (code > 1000 && code < 1000 + MESSAGE_TYPE_SLOTS) ? code - 1000 : 0;
+}
+
+/** @return A stable name for the metric (e.g. "checksum_failures"). */
+const char* metricName(Metric metric);
+
+/**
+ * @brief Counters of a single thread, on their own cache lines.
+ *
+ * Only the owning thread writes a block, so increments are a relaxed load and store with no
+ * read-modify-write; readers aggregate with relaxed loads.
+ */
+struct alignas(64) MetricsBlock {
+    std::array<std::atomic<uint64_t>, METRIC_COUNT> counters{};
+    std::array<std::atomic<uint64_t>, MESSAGE_TYPE_SLOTS> messages_by_type{};
+};
+
+/** @brief Point-in-time sum of all threads' counters since the last `resetMetrics()`. */
+struct MetricsSnapshot {
+    std::array<uint64_t, METRIC_COUNT> counters{};
+    std::array<uint64_t, MESSAGE_TYPE_SLOTS> messages_by_type{};
+
+    uint64_t get(Metric metric) const { return counters[static_cast<size_t>(metric)]; }
+    uint64_t messages(MessageType type) const { return messages_by_type[messageTypeSlot(type)]; }
+    /** @return Frames applied by TaifexSdk, all message types. */
+    uint64_t total_messages() const;
+};
+
+namespace detail {
+extern constinit thread_local MetricsBlock* tls_metrics_block;
+/** @brief Registers a block for the calling thread. Slow path, runs once per thread. */
+MetricsBlock* acquireMetricsBlock();
+
+inline MetricsBlock& threadMetricsBlock() {
+    MetricsBlock* block = tls_metrics_block;
+    if (block == nullptr) [[unlikely]] {
+        block = acquireMetricsBlock();
+    }
+    return *block;
+}
+
+inline void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+} // namespace detail
+
+/** @brief Adds `amount` to `metric` in the calling thread's block. Lock-free, no shared writes. */
+inline void incrementMetric(Metric metric, uint64_t amount = 1) {
+    detail::bump(detail::threadMetricsBlock().counters[static_cast<size_t>(metric)], amount);
+}
+
+/** @brief Counts one applied frame of the given type and its length in bytes. */
+inline void countMessage(MessageType type, size_t frame_length) {
+    MetricsBlock& block = detail::threadMetricsBlock();
+    detail::bump(block.messages_by_type[messageTypeSlot(type)], 1);
+    detail::bump(block.counters[static_cast<size_t>(Metric::BYTES_PROCESSED)], frame_length);
+}
+
+/**
+ * @brief Sums every thread's counters, including threads that have exited.
+ *
+ * Takes the registry lock, which only contends with thread registration; counter writers never
+ * block. Values from other threads may lag by a few increments.
+ */
+MetricsSnapshot getMetricsSnapshot();
+
+/** @brief Makes subsequent snapshots count from zero. Writers are not touched. */
+void resetMetrics();
+
+/** @return Minor plus major page faults of the whole process so far (`getrusage`). */
+uint64_t processPageFaults();
+
+/**
+ * @brief Adds the process's page faults since the previous call to `Metric::PAGE_FAULTS`. The
+ *        first call only sets the starting point, so the metric counts faults from then on.
+ *        One system call; meant for cold paths (initialization, timers, metric reads).
+ */
+void samplePageFaults();
+
+} // namespace CoreUtils
+
+#endif // METRICS_H
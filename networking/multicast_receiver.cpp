@@ -1,5 +1,6 @@
 #include "networking/multicast_receiver.h"
 
+#include "metrics.h"
 #include "logger.h" // Assuming a logger is available (Removed core_utils/ prefix)
 
 
@@ -15,6 +16,10 @@
 
 namespace Networking {
 
+MulticastReceiver::ActiveSubscription::ActiveSubscription(const MulticastGroupSubscription& cfg)
+    : config(cfg) {
+}
+
 // ActiveSubscription Destructor - needed if unique_ptr owns it and thread needs explicit joining here.
 // However, MulticastReceiver::stop() is designed to join threads, so this might be simple.
 MulticastReceiver::ActiveSubscription::~ActiveSubscription() {
@@ -202,6 +207,8 @@ void MulticastReceiver::receive_loop(ActiveSubscription* sub_ptr) {
             continue;
         }
 
+        CoreUtils::incrementMetric(CoreUtils::Metric::MULTICAST_PACKETS_RECEIVED);
+        CoreUtils::incrementMetric(CoreUtils::Metric::MULTICAST_BYTES_RECEIVED, static_cast<uint64_t>(bytes_received));
         if (bytes_received > 0 && data_callback_) {
             data_callback_(buffer.data(), static_cast<size_t>(bytes_received),
                            sub_ptr->config.group_ip, sub_ptr->config.port);
@@ -1,14 +1,20 @@
 #include "networking/network_manager.h"
 #include "networking/multicast_receiver.h"
 #include "networking/retransmission_client.h"
+#include "networking/segment_worker.h"
 #include "sdk/taifex_sdk.h"
 
 #include "common_header.h" // Removed core_utils/ prefix
+#include "channel_state.h"
+#include "message_identifier.h"
+#include "error_codes.h"
+#include "metrics.h"
 #include "../logger.h"     // Corrected path to root
 
 #include "networking/retransmission_protocol.h" // For TaifexRetransmission::DataResponse102 etc.
 
 #include <algorithm> // For std::find_if if needed
+#include <utility>
 
 namespace Networking {
 
@@ -26,6 +32,19 @@ NetworkManager::NetworkManager(Taifex::TaifexSdk* sdk_core_logic)
     LOG_INFO << "NetworkManager created.";
 }
 
+NetworkManager::NetworkManager(Taifex::TaifexSdk* futures_sdk, Taifex::TaifexSdk* options_sdk)
+    : sdk_core_logic_(nullptr), running_(false), retrans_primary_active_(true) {
+    if (!futures_sdk || !options_sdk) {
+        LOG_ERROR << "NetworkManager created with a null segment TaifexSdk pointer!";
+        return;
+    }
+    segmented_ = true;
+    segment_sdks_[static_cast<size_t>(CoreUtils::MarketSegment::FUTURES)] = futures_sdk;
+    segment_sdks_[static_cast<size_t>(CoreUtils::MarketSegment::OPTIONS)] = options_sdk;
+    channel_segments_ = std::make_unique<std::atomic<uint8_t>[]>(CoreUtils::ChannelStateTable::CHANNEL_COUNT);
+    LOG_INFO << "NetworkManager created in segment-parallel mode (futures and options engines).";
+}
+
 NetworkManager::~NetworkManager() {
     LOG_INFO << "NetworkManager shutting down...";
     stop();
@@ -77,10 +96,38 @@ bool NetworkManager::configure_and_start(const NetworkManagerConfig& config) {
         }
     }
 
+    auto requester = [this](uint32_t channel_id, uint64_t begin_seq, uint16_t count) {
+        queue_retransmission_request(static_cast<uint16_t>(channel_id), static_cast<uint32_t>(begin_seq), count);
+    };
+    if (sdk_core_logic_) {
+        std::lock_guard<std::mutex> lock(sdk_mutex_);
+        sdk_core_logic_->set_retransmission_requester(requester);
+    }
+    if (segmented_) {
+        // Each engine is only touched by its worker thread from here on; retransmission requests it
+        // raises go to the sender thread like everyone else's.
+        static const char* const WORKER_NAMES[] = {"", "futures", "options"};
+        for (size_t segment = 1; segment < segment_sdks_.size(); ++segment) {
+            Taifex::TaifexSdk* sdk = segment_sdks_[segment];
+            sdk->set_retransmission_requester(requester);
+            segment_workers_[segment] = std::make_unique<SegmentWorker>(
+                WORKER_NAMES[segment], config_.segment_queue_capacity, config_.segment_slot_bytes,
+                [sdk](const unsigned char* data, size_t length) { sdk->process_message(data, length); },
+                [sdk]() { sdk->poll_timers(); });
+            segment_workers_[segment]->start();
+        }
+    }
+
     if (config_.primary_retrans_server) {
         retrans_primary_active_ = true; // Start with primary
         connect_retransmission_client(retrans_primary_active_);
     }
+    {
+        std::lock_guard<std::mutex> pending_lock(pending_requests_mutex_);
+        retrans_sender_stopping_ = false;
+        retrans_disconnected_ = false;
+    }
+    retrans_sender_thread_ = std::thread(&NetworkManager::run_retransmission_sender, this);
 
     running_ = true;
     bool primary_started = false;
@@ -115,10 +162,22 @@ bool NetworkManager::configure_and_start(const NetworkManagerConfig& config) {
          // cleanup partially started components
          if (primary_multicast_receiver_ && primary_started) primary_multicast_receiver_->stop();
          if (secondary_multicast_receiver_ && secondary_started) secondary_multicast_receiver_->stop();
+         stop_retransmission_sender();
          if (retransmission_client_) retransmission_client_->stop();
+         for (auto& worker : segment_workers_) {
+             if (worker) worker->stop();
+         }
          return false;
     }
 
+    if (config_.timer_interval.count() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(timer_mutex_);
+            timer_stopping_ = false;
+        }
+        timer_thread_ = std::thread(&NetworkManager::run_timers, this);
+    }
+
     LOG_INFO << "NetworkManager started.";
     return running_.load();
 }
@@ -129,15 +188,39 @@ void NetworkManager::stop() {
         return;
     }
     LOG_INFO << "NetworkManager stopping...";
+    if (timer_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(timer_mutex_);
+            timer_stopping_ = true;
+        }
+        timer_cv_.notify_one();
+        timer_thread_.join();
+    }
     if (primary_multicast_receiver_) {
         primary_multicast_receiver_->stop();
     }
     if (secondary_multicast_receiver_) {
         secondary_multicast_receiver_->stop();
     }
+    stop_retransmission_sender();
     if (retransmission_client_) {
         retransmission_client_->stop();
     }
+    if (sdk_core_logic_) {
+        std::lock_guard<std::mutex> lock(sdk_mutex_);
+        sdk_core_logic_->set_retransmission_requester(nullptr);
+    }
+    for (size_t segment = 1; segment < segment_workers_.size(); ++segment) {
+        if (segment_workers_[segment]) {
+            segment_workers_[segment]->stop();
+            segment_workers_[segment].reset();
+            segment_sdks_[segment]->set_retransmission_requester(nullptr);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> pending_lock(pending_requests_mutex_);
+        pending_retrans_requests_.clear();
+    }
     LOG_INFO << "NetworkManager stopped.";
 }
 
@@ -153,19 +236,46 @@ void NetworkManager::on_secondary_multicast_data(const unsigned char* data, size
 
 
 void NetworkManager::process_incoming_packet(const unsigned char* data, size_t length, bool is_from_primary_feed, bool is_retransmitted) {
-    if (!running_.load() || !sdk_core_logic_) return;
+    if (!running_.load() || !has_engine()) return;
 
     CoreUtils::CommonHeader header;
     if (!CoreUtils::CommonHeader::parse(data, length, header)) {
         LOG_WARNING << "NM: Dropping packet - failed to parse common header. Source: " << (is_retransmitted ? "Retrans" : (is_from_primary_feed ? "PrimaryMC" : "SecondaryMC"));
+        CoreUtils::incrementMetric(CoreUtils::Metric::HEADER_ERRORS);
+        return;
+    }
+    uint32_t channel_id = 0;
+    uint64_t channel_seq = 0;
+    try {
+        channel_id = header.getChannelId();
+        channel_seq = header.getChannelSeq();
+    } catch (const CoreUtils::ParsingError& e) {
+        LOG_WARNING << "NM: Dropping packet - invalid CHANNEL-ID/CHANNEL-SEQ: " << e.what();
+        CoreUtils::incrementMetric(CoreUtils::Metric::HEADER_ERRORS);
         return;
     }
-    uint32_t channel_id = header.getChannelId();
-    uint64_t channel_seq = header.getChannelSeq();
     uint64_t combined_seq_key = (static_cast<uint64_t>(channel_id) << 32) | channel_seq;
+    auto now = std::chrono::steady_clock::now();
+
+    Taifex::TaifexSdk* sdk = sdk_core_logic_;
+    size_t segment = 0;
+    if (segmented_) {
+        segment = route_segment(header, channel_id);
+        sdk = segment_sdks_[segment];
+        if (!sdk) {
+            LOG_DEBUG << "NM: Dropping TC 0 frame on Channel " << channel_id << " before any market data identified its segment.";
+            CoreUtils::incrementMetric(CoreUtils::Metric::FILTERED_MESSAGES);
+            return;
+        }
+    }
+
+    if (CoreUtils::ChannelState* state = sdk->channel_states().find(channel_id)) {
+        state->last_receive_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count(),
+                                     std::memory_order_relaxed);
+        state->packets_received.fetch_add(1, std::memory_order_relaxed);
+    }
 
     if (config_.dual_feed_enabled && !is_retransmitted) { // Deduplication for multicast feeds only
-        auto now = std::chrono::steady_clock::now();
         // Check if sequence number already seen recently
         auto it = deduplication_log_.find(combined_seq_key);
         if (it != deduplication_log_.end()) {
@@ -173,6 +283,7 @@ void NetworkManager::process_incoming_packet(const unsigned char* data, size_t l
             // if (now - it->second < DEDUPLICATION_TIME_WINDOW_MS) { // Example time window check
                  LOG_DEBUG << "NM: Duplicate packet on Channel " << channel_id <<
                                    " Seq " << channel_seq << " from " << (is_from_primary_feed ? "primary" : "secondary") << ". Discarding.";
+                CoreUtils::incrementMetric(CoreUtils::Metric::DUAL_FEED_DUPLICATES);
                 return;
             // } else {
             //     // Seen before but outside time window, treat as new (or log as stale duplicate)
@@ -188,28 +299,124 @@ void NetworkManager::process_incoming_packet(const unsigned char* data, size_t l
             }
         }
     }
-    forward_to_sdk(data, length);
+    forward_to_sdk(sdk, segment, data, length);
+}
+
+size_t NetworkManager::route_segment(const CoreUtils::CommonHeader& header, uint32_t channel_id) {
+    const CoreUtils::MarketSegment segment = CoreUtils::identifyMarketSegment(header);
+    if (channel_id >= CoreUtils::ChannelStateTable::CHANNEL_COUNT) {
+        return static_cast<size_t>(segment);
+    }
+    std::atomic<uint8_t>& learned = channel_segments_[channel_id];
+    if (segment == CoreUtils::MarketSegment::NONE) {
+        return learned.load(std::memory_order_relaxed);
+    }
+    learned.store(static_cast<uint8_t>(segment), std::memory_order_relaxed);
+    return static_cast<size_t>(segment);
 }
 
 
 void NetworkManager::on_retransmitted_market_data(const unsigned char* data, size_t length) {
-    if (!running_.load() || !sdk_core_logic_) return;
+    if (!running_.load() || !has_engine()) return;
     LOG_DEBUG << "NM: Received retransmitted market data (len: " << length << ")";
     process_incoming_packet(data, length, false /*is_primary, doesn't matter*/, true /*is_retransmitted*/);
 }
 
-void NetworkManager::forward_to_sdk(const unsigned char* data, size_t length) {
-     if (sdk_core_logic_) {
-        sdk_core_logic_->process_message(data, length);
+void NetworkManager::forward_to_sdk(Taifex::TaifexSdk* sdk, size_t segment, const unsigned char* data, size_t length) {
+    if (segmented_) {
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(sdk_mutex_);
+            queued = segment_workers_[segment] && segment_workers_[segment]->submit(data, length);
+        }
+        if (!queued) {
+            LOG_WARNING << "NM: Segment " << segment << " engine queue full. Frame dropped; gap recovery will request it.";
+            CoreUtils::incrementMetric(CoreUtils::Metric::SEGMENT_QUEUE_OVERFLOWS);
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> lock(sdk_mutex_);
+    sdk->process_message(data, length);
+}
+
+void NetworkManager::run_timers() {
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    while (!timer_cv_.wait_for(lock, config_.timer_interval, [this]() { return timer_stopping_; })) {
+        if (!has_engine()) {
+            continue;
+        }
+        if (segmented_) {
+            // Each engine is only touched by its worker thread; the tick runs there between frames.
+            for (const auto& worker : segment_workers_) {
+                if (worker) {
+                    worker->post_tick();
+                }
+            }
+            continue;
+        }
+        lock.unlock(); // stop() must not wait behind the engine.
+        {
+            // Retransmission retries it raises go to the sender thread; this thread never sends.
+            std::lock_guard<std::mutex> sdk_lock(sdk_mutex_);
+            sdk_core_logic_->poll_timers();
+        }
+        lock.lock();
+    }
+}
+
+void NetworkManager::run_retransmission_sender() {
+    std::vector<PendingRetransmissionRequest> requests;
+    std::unique_lock<std::mutex> lock(pending_requests_mutex_);
+    while (true) {
+        pending_requests_cv_.wait(lock, [this]() {
+            return retrans_sender_stopping_ || retrans_disconnected_ || !pending_retrans_requests_.empty();
+        });
+        if (retrans_sender_stopping_) {
+            return;
+        }
+        const bool disconnected = std::exchange(retrans_disconnected_, false);
+        requests.swap(pending_retrans_requests_);
+        lock.unlock(); // Engines keep queueing while this thread sends.
+        if (disconnected) {
+            switch_retransmission_server();
+        }
+        for (const auto& request : requests) {
+            send_retransmission_request(request.channel_id, request.start_seq_num, request.count);
+        }
+        requests.clear();
+        lock.lock();
     }
 }
 
+void NetworkManager::stop_retransmission_sender() {
+    if (!retrans_sender_thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> pending_lock(pending_requests_mutex_);
+        retrans_sender_stopping_ = true;
+    }
+    pending_requests_cv_.notify_one();
+    retrans_sender_thread_.join();
+}
 
 void NetworkManager::trigger_retransmission_request(uint16_t channel_id, uint32_t start_seq_num, uint16_t count) {
     if (!running_.load()) {
         LOG_WARNING << "NM: Cannot trigger retransmission, NetworkManager not running.";
         return;
     }
+    queue_retransmission_request(channel_id, start_seq_num, count);
+}
+
+void NetworkManager::queue_retransmission_request(uint16_t channel_id, uint32_t start_seq_num, uint16_t count) {
+    {
+        std::lock_guard<std::mutex> pending_lock(pending_requests_mutex_);
+        pending_retrans_requests_.push_back({channel_id, start_seq_num, count});
+    }
+    pending_requests_cv_.notify_one();
+}
+
+void NetworkManager::send_retransmission_request(uint16_t channel_id, uint32_t start_seq_num, uint16_t count) {
     if (retransmission_client_) {
         LOG_INFO << "NM: Triggering retransmission for Channel " << channel_id <<
                                " from Seq " << start_seq_num << ", Count " << count;
@@ -237,7 +444,7 @@ void NetworkManager::connect_retransmission_client(bool use_primary_server) {
             [this](const TaifexRetransmission::DataResponse102& resp, const std::vector<unsigned char>& retrans_data) { this->on_retransmission_status(resp, retrans_data); }, // Adjusted for new sig
             [this](const TaifexRetransmission::ErrorNotification010& err_msg) { this->on_retransmission_error(err_msg); }, // Adjusted
             [this]() { this->on_retransmission_disconnected(); },
-            [this]() { LOG_INFO << "NM: Retransmission client logged in to " << (retrans_primary_active_ ? "primary" : "backup") << " server.";}
+            [server_type]() { LOG_INFO << "NM: Retransmission client logged in to " << server_type << " server.";}
         );
         LOG_INFO << "NM: Configured " << server_type << " retransmission server: " << server_config_opt->ip;
         if (!retransmission_client_->start()) {
@@ -268,6 +475,15 @@ void NetworkManager::on_retransmission_error(const TaifexRetransmission::ErrorNo
 
 void NetworkManager::on_retransmission_disconnected() {
     LOG_WARNING << "NM: Retransmission client disconnected.";
+    // Runs on the client's own thread, which cannot stop (join) itself; the sender thread fails over.
+    {
+        std::lock_guard<std::mutex> pending_lock(pending_requests_mutex_);
+        retrans_disconnected_ = true;
+    }
+    pending_requests_cv_.notify_one();
+}
+
+void NetworkManager::switch_retransmission_server() {
     // Simple strategy: if primary was active and backup is configured, try switching to backup.
     // More complex logic would involve retry counts, timers, etc.
     if (retrans_primary_active_ && config_.backup_retrans_server) {
@@ -8,12 +8,20 @@
 #include <chrono>
 #include <optional>
 #include <atomic>
+#include <mutex>
+#include <array>
+#include <condition_variable>
+#include <thread>
 
 // Forward declare TaifexSdk to pass pointer
 namespace Taifex {
     class TaifexSdk;
 }
 
+namespace CoreUtils {
+    struct CommonHeader;
+}
+
 // Forward declare types from retransmission_protocol.h to avoid including the whole file here
 namespace TaifexRetransmission {
     struct DataResponse102;
@@ -25,6 +33,7 @@ namespace Networking {
 
 class MulticastReceiver;
 class RetransmissionClient;
+class SegmentWorker;
 
 /**
  * @brief Configuration for the NetworkManager.
@@ -98,6 +107,29 @@ struct NetworkManagerConfig {
      *        This field is for future enhancement or more sophisticated reordering/deduplication logic.
      */
     std::chrono::milliseconds dual_feed_reorder_window_ms{100};
+
+    /**
+     * @brief Frames each segment engine can have queued in segment-parallel mode (see the two-engine
+     *        constructor). Frames arriving while an engine's queue is full are dropped and recovered
+     *        by that engine's gap recovery.
+     */
+    size_t segment_queue_capacity = 65536;
+
+    /**
+     * @brief Bytes preallocated for each queued frame in segment-parallel mode, so queueing a frame
+     *        never allocates on the receive thread. Each engine's queue takes
+     *        `segment_queue_capacity` times this up front. The largest I081/I083 frame is 1338 bytes;
+     *        a larger frame grows its slot once.
+     */
+    size_t segment_slot_bytes = 1536;
+
+    /**
+     * @brief How often the engines' timers are fired (`TaifexSdk::poll_timers`), so gap timeouts,
+     *        retransmission retries and liveness events happen on a quiet feed too. Runs on a timer
+     *        thread in single-engine mode and on each worker thread in segment-parallel mode.
+     *        0 disables it; the engines then only fire timers when they process a frame.
+     */
+    std::chrono::milliseconds timer_interval{10};
 };
 
 /**
@@ -122,6 +154,19 @@ public:
      */
     explicit NetworkManager(Taifex::TaifexSdk* sdk_core_logic);
 
+    /**
+     * @brief Constructs a NetworkManager in segment-parallel mode: futures frames (TC 1-3) and options
+     *        frames (TC 4-5) are processed by separate engines, each on its own worker thread, so a
+     *        burst in one segment cannot delay the other.
+     *
+     * Each engine sees only its own segment's channels; heartbeats and sequence resets (TC 0) go to the
+     * engine whose market data has been seen on the same channel. Engines must not be accessed from
+     * other threads while the NetworkManager is running.
+     * @param futures_sdk Non-owning; must outlive the NetworkManager.
+     * @param options_sdk Non-owning; must outlive the NetworkManager.
+     */
+    NetworkManager(Taifex::TaifexSdk* futures_sdk, Taifex::TaifexSdk* options_sdk);
+
     /**
      * @brief Destructor. Stops all network activity and cleans up resources.
      */
@@ -149,8 +194,11 @@ public:
     void stop();
 
     /**
-     * @brief Triggers a retransmission request for a specified channel and sequence range.
-     * This method is typically called by `TaifexSdk` when its sequence validation logic detects a gap.
+     * @brief Queues a retransmission request for a specified channel and sequence range.
+     * Callable from any thread. Every request is sent, in queue order, by the NetworkManager's
+     * retransmission sender thread, which is the only thread that uses the retransmission client.
+     * While running, the NetworkManager is also registered as the `TaifexSdk` retransmission
+     * requester, so gaps detected by the SDK's sequence validation are queued the same way.
      * @param channel_id The Channel ID for which data is being requested.
      * @param start_seq_num The starting sequence number for retransmission.
      * @param count The number of messages to recover.
@@ -183,22 +231,61 @@ private:
 
 
     void process_incoming_packet(const unsigned char* data, size_t length, bool is_from_primary_feed, bool is_retransmitted = false);
-    void forward_to_sdk(const unsigned char* data, size_t length);
+    void forward_to_sdk(Taifex::TaifexSdk* sdk, size_t segment, const unsigned char* data, size_t length);
+    size_t route_segment(const CoreUtils::CommonHeader& header, uint32_t channel_id);
+    bool has_engine() const { return sdk_core_logic_ || segmented_; }
+    void run_timers();
+    void queue_retransmission_request(uint16_t channel_id, uint32_t start_seq_num, uint16_t count);
+    void run_retransmission_sender();
+    void stop_retransmission_sender();
+    void send_retransmission_request(uint16_t channel_id, uint32_t start_seq_num, uint16_t count);
+    void switch_retransmission_server();
 
     void connect_retransmission_client(bool use_primary_server);
 
 
-    Taifex::TaifexSdk* sdk_core_logic_;
+    Taifex::TaifexSdk* sdk_core_logic_;   // Single-engine mode.
     NetworkManagerConfig config_;
 
+    // Segment-parallel mode, indexed by CoreUtils::MarketSegment (slot 0, NONE, is unused).
+    bool segmented_ = false;
+    std::array<Taifex::TaifexSdk*, 3> segment_sdks_{};
+    std::array<std::unique_ptr<SegmentWorker>, 3> segment_workers_;
+    std::unique_ptr<std::atomic<uint8_t>[]> channel_segments_; // CHANNEL-ID -> MarketSegment, learned from market data.
+
     std::unique_ptr<MulticastReceiver> primary_multicast_receiver_;
     std::unique_ptr<MulticastReceiver> secondary_multicast_receiver_;
-    std::unique_ptr<RetransmissionClient> retransmission_client_;
+    std::unique_ptr<RetransmissionClient> retransmission_client_; // Owned by the sender thread while running.
 
     std::map<uint64_t, std::chrono::steady_clock::time_point> deduplication_log_;
 
     std::atomic<bool> running_;
     bool retrans_primary_active_ = true;
+
+    // Multicast and retransmission threads both feed the SDK, which is not thread-safe. In segment-parallel
+    // mode it serializes the producers of the segment worker queues instead.
+    std::mutex sdk_mutex_;
+
+    // Requests raised by the engines, sent in order by the retransmission sender thread. That thread
+    // alone sends through retransmission_client_ and replaces it on failover, so an engine never waits
+    // on a send, and the client's own thread (which reports the disconnect) is never asked to join itself.
+    struct PendingRetransmissionRequest {
+        uint16_t channel_id;
+        uint32_t start_seq_num;
+        uint16_t count;
+    };
+    std::mutex pending_requests_mutex_;
+    std::condition_variable pending_requests_cv_;
+    std::vector<PendingRetransmissionRequest> pending_retrans_requests_;
+    bool retrans_disconnected_ = false;  // Set by the client's thread; failover runs on the sender thread.
+    bool retrans_sender_stopping_ = false;
+    std::thread retrans_sender_thread_;
+
+    // Fires the engines' timers every config_.timer_interval.
+    std::thread timer_thread_;
+    std::mutex timer_mutex_;
+    std::condition_variable timer_cv_;
+    bool timer_stopping_ = false;
 };
 
 } // namespace Networking
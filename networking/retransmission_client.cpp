@@ -14,6 +14,7 @@
 #include <chrono>   // For sleep, system_clock
 
 #include "common_header.h"     // For parsing retransmitted market data headers
+#include "metrics.h"
 #include "message_identifier.h"// For identifying market data message types if needed
 
 namespace Networking {
@@ -57,15 +58,10 @@ bool RetransmissionClient::connect_to_server() {
     if (connected_.load() && socket_fd_ >= 0) {
         return true;
     }
-    if (socket_fd_ >= 0) {
-        close(socket_fd_);
-        socket_fd_ = -1;
-    }
-    connected_ = false;
-    logged_in_ = false;
+    close_socket();
 
-    socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (socket_fd_ < 0) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
         LOG_ERROR << "RetransmissionClient: Failed to create TCP socket: " << strerror(errno);
         return false;
     }
@@ -76,31 +72,41 @@ bool RetransmissionClient::connect_to_server() {
     serv_addr.sin_port = htons(server_port_);
     if (inet_pton(AF_INET, server_ip_.c_str(), &serv_addr.sin_addr) <= 0) {
         LOG_ERROR << "RetransmissionClient: Invalid server IP address: " << server_ip_;
-        close(socket_fd_);
-        socket_fd_ = -1;
+        close(fd);
         return false;
     }
 
     LOG_INFO << "RetransmissionClient: Connecting to " << server_ip_ << ":" << server_port_ << "...";
-    if (connect(socket_fd_, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+    if (connect(fd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
         LOG_ERROR << "RetransmissionClient: Connection failed to " << server_ip_ << ":" << server_port_ << ": " << strerror(errno);
-        close(socket_fd_);
-        socket_fd_ = -1;
+        close(fd);
         return false;
     }
 
     struct timeval tv;
     tv.tv_sec = DEFAULT_RECV_TIMEOUT_SEC;
     tv.tv_usec = 0;
-    if (setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof tv) < 0) {
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof tv) < 0) {
         LOG_WARNING << "RetransmissionClient: Failed to set SO_RCVTIMEO. Recv calls may block longer than expected.";
     }
 
     LOG_INFO << "RetransmissionClient: Connected successfully to " << server_ip_ << ":" << server_port_;
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    socket_fd_ = fd;
     connected_ = true;
     return true;
 }
 
+void RetransmissionClient::close_socket() {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    if (socket_fd_ >= 0) {
+        close(socket_fd_);
+        socket_fd_ = -1;
+    }
+    connected_ = false;
+    logged_in_ = false;
+}
+
 bool RetransmissionClient::perform_login() {
     if (!connected_.load()) {
         LOG_WARNING << "RetransmissionClient: Not connected, cannot perform login.";
@@ -111,6 +117,7 @@ bool RetransmissionClient::perform_login() {
         return true;
     }
 
+    std::lock_guard<std::mutex> lock(send_mutex_);
     client_msg_seq_num_ = 0;
 
     TaifexRetransmission::LoginRequest020 login_req;
@@ -138,42 +145,36 @@ bool RetransmissionClient::perform_login() {
 }
 
 
-void RetransmissionClient::send_tcp_message(const std::vector<unsigned char>& message_bytes) {
+bool RetransmissionClient::send_tcp_message(const std::vector<unsigned char>& message_bytes) {
     if (!connected_.load() || socket_fd_ < 0) {
         LOG_ERROR << "RetransmissionClient: Not connected, cannot send message.";
         // error_callback_ might be too strong here, as it's for protocol errors. Disconnected is more appropriate.
         // If not connected, the receive_loop should handle invoking disconnected_callback_.
-        return;
+        return false;
     }
 
-    ssize_t total_sent = 0;
-    ssize_t remaining = message_bytes.size();
+    size_t total_sent = 0;
     const unsigned char* data_ptr = message_bytes.data();
 
     while (total_sent < message_bytes.size()) {
-        ssize_t sent_this_call = send(socket_fd_, data_ptr + total_sent, remaining, 0);
+        // MSG_NOSIGNAL: a peer that has gone away must not raise SIGPIPE in the sending thread.
+        ssize_t sent_this_call = send(socket_fd_, data_ptr + total_sent, message_bytes.size() - total_sent, MSG_NOSIGNAL);
         if (sent_this_call < 0) {
             LOG_ERROR << "RetransmissionClient: send() error: " << strerror(errno);
-            close(socket_fd_); // Close socket on send error
-            socket_fd_ = -1;
-            connected_ = false;
-            logged_in_ = false;
-            if (disconnected_callback_) disconnected_callback_();
-            return;
+        } else if (sent_this_call == 0) { // Should not happen with blocking socket unless error
+            LOG_ERROR << "RetransmissionClient: send() returned 0, treating as disconnect.";
         }
-        if (sent_this_call == 0) { // Should not happen with blocking socket unless error
-             LOG_ERROR << "RetransmissionClient: send() returned 0, treating as disconnect.";
-            close(socket_fd_);
-            socket_fd_ = -1;
-            connected_ = false;
+        if (sent_this_call <= 0) {
+            // The receive loop owns the socket: shutting it down wakes its recv(), which then closes the
+            // socket and reports the disconnect.
+            shutdown(socket_fd_, SHUT_RDWR);
             logged_in_ = false;
-            if (disconnected_callback_) disconnected_callback_();
-            return;
+            return false;
         }
-        total_sent += sent_this_call;
-        remaining -= sent_this_call;
+        total_sent += static_cast<size_t>(sent_this_call);
     }
     LOG_DEBUG << "RetransmissionClient: Sent " << total_sent << " bytes.";
+    return true;
 }
 
 
@@ -208,25 +209,22 @@ void RetransmissionClient::receive_loop() {
                 if (!running_.load()) break;
                 continue;
             }
-            if (!running_.load() && (errno == EINTR || errno == EBADF)) {
-                LOG_INFO << "RetransmissionClient: recv interrupted or socket closed, likely due to stop().";
+            if (!running_.load()) {
+                LOG_INFO << "RetransmissionClient: recv interrupted or socket shut down by stop().";
                 break;
             }
             LOG_ERROR << "RetransmissionClient: recv() error: " << strerror(errno);
-            close(socket_fd_);
-            socket_fd_ = -1;
-            connected_ = false;
-            logged_in_ = false;
+            close_socket();
             if (disconnected_callback_) disconnected_callback_();
             continue;
         }
 
         if (bytes_received == 0) {
+            if (!running_.load()) {
+                break; // stop() shut the socket down; not a disconnect to report.
+            }
             LOG_INFO << "RetransmissionClient: Server closed connection.";
-            close(socket_fd_);
-            socket_fd_ = -1;
-            connected_ = false;
-            logged_in_ = false;
+            close_socket();
             if (disconnected_callback_) disconnected_callback_();
             continue;
         }
@@ -257,19 +255,20 @@ void RetransmissionClient::stop() {
     }
     LOG_INFO << "RetransmissionClient: Stopping...";
 
-    if (socket_fd_ >= 0) {
-        // No need for shutdown() typically before close() for client sockets unless specific linger options are set.
-        // Closing the socket will cause blocking operations like recv() in receive_loop to fail (e.g., with EBADF or return 0).
-        close(socket_fd_);
-        socket_fd_ = -1;
+    {
+        // Shutting the socket down makes a recv() blocked in receive_loop return. It is only closed once
+        // that thread has exited, so its descriptor cannot be reused under it.
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (socket_fd_ >= 0) {
+            shutdown(socket_fd_, SHUT_RDWR);
+        }
     }
 
     if (client_thread_ && client_thread_->joinable()) {
         client_thread_->join();
     }
 
-    connected_ = false;
-    logged_in_ = false;
+    close_socket();
     LOG_INFO << "RetransmissionClient: Stopped.";
 }
 
@@ -284,7 +283,6 @@ bool RetransmissionClient::request_retransmission(uint16_t channel_id, uint32_t
     }
 
     TaifexRetransmission::DataRequest101 req;
-    req.header.msg_seq_num = client_msg_seq_num_++;
     // Set msg_time
     auto now = std::chrono::system_clock::now();
     auto epoch_s_count = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
@@ -296,12 +294,17 @@ bool RetransmissionClient::request_retransmission(uint16_t channel_id, uint32_t
     req.begin_seq_no = begin_seq_no;
     req.recover_num = count;
 
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    req.header.msg_seq_num = client_msg_seq_num_++;
     std::vector<unsigned char> buffer;
     req.serialize(buffer);
 
     LOG_INFO << "RetransmissionClient: Sending DataRequest101 (ClientMsgSeq: " << req.header.msg_seq_num <<
                            ", Channel: " << channel_id << ", Begin: " << begin_seq_no << ", Count: " << count << ")";
-    send_tcp_message(buffer);
+    if (!send_tcp_message(buffer)) {
+        return false;
+    }
+    CoreUtils::incrementMetric(CoreUtils::Metric::RETRANSMISSION_REQUESTS_SENT);
     return true;
 }
 
@@ -312,7 +315,6 @@ bool RetransmissionClient::send_client_heartbeat() { // Renamed for clarity in h
     }
 
     TaifexRetransmission::HeartbeatClient105 hb_resp;
-    hb_resp.header.msg_seq_num = client_msg_seq_num_++;
     // Set msg_time
     auto now = std::chrono::system_clock::now();
     auto epoch_s_count = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
@@ -320,12 +322,13 @@ bool RetransmissionClient::send_client_heartbeat() { // Renamed for clarity in h
     hb_resp.header.msg_time.epoch_s = static_cast<uint32_t>(epoch_s_count);
     hb_resp.header.msg_time.nanosecond = static_cast<uint32_t>(ns_since_epoch_count % 1000000000ULL);
 
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    hb_resp.header.msg_seq_num = client_msg_seq_num_++;
     std::vector<unsigned char> buffer;
     hb_resp.serialize(buffer);
 
     LOG_INFO << "RetransmissionClient: Sending HeartbeatClient105 (ClientMsgSeq: " << hb_resp.header.msg_seq_num << ")";
-    send_tcp_message(buffer);
-    return true;
+    return send_tcp_message(buffer);
 }
 
 void RetransmissionClient::process_incoming_data(const unsigned char* data_chunk, size_t length) {
@@ -350,6 +353,8 @@ void RetransmissionClient::process_incoming_data(const unsigned char* data_chunk
 
                 if (current_size >= full_market_msg_len) {
                     LOG_DEBUG << "RetransmissionClient: Received retransmitted market data message (len: " << full_market_msg_len << ")";
+                    CoreUtils::incrementMetric(CoreUtils::Metric::RETRANSMITTED_MESSAGES_RECEIVED);
+                    CoreUtils::incrementMetric(CoreUtils::Metric::RETRANSMITTED_BYTES_RECEIVED, full_market_msg_len);
                     if (market_data_callback_) {
                         market_data_callback_(current_data, full_market_msg_len);
                     }
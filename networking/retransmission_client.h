@@ -9,6 +9,7 @@
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 
 namespace Networking {
 
@@ -25,7 +26,9 @@ namespace Networking {
  * - Sending client heartbeats (MsgType 105) in response to server heartbeats (MsgType 104).
  * - Managing message sequencing and providing data/status through callbacks.
  *
- * It operates its own network thread for receiving and processing messages.
+ * It operates its own network thread for receiving and processing messages. `request_retransmission`
+ * may be called from any thread: outgoing messages take their MsgSeqNum and are written under one
+ * lock, so they never interleave with the heartbeats sent from the network thread.
  */
 class RetransmissionClient {
 public:
@@ -113,7 +116,10 @@ public:
 private:
     bool connect_to_server();
     bool perform_login();
-    void send_tcp_message(const std::vector<unsigned char>& message_bytes);
+    // Callers hold send_mutex_. On failure the socket is shut down; the receive loop then closes it
+    // and reports the disconnect.
+    bool send_tcp_message(const std::vector<unsigned char>& message_bytes);
+    void close_socket();
     void receive_loop();
     void process_incoming_data(const unsigned char* data_chunk, size_t length);
     // Changed handle_complete_message to take full message data for specific deserializers
@@ -131,6 +137,9 @@ private:
     DisconnectedCallback disconnected_callback_;
     LoggedInCallback logged_in_callback_;
 
+    // socket_fd_ is only replaced or closed by the receive thread (and by stop() once it has joined),
+    // always under send_mutex_, which also orders client_msg_seq_num_ with the bytes sent.
+    std::mutex send_mutex_;
     int socket_fd_;
     std::atomic<bool> running_;
     std::atomic<bool> connected_;
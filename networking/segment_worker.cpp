@@ -0,0 +1,99 @@
+#include "networking/segment_worker.h"
+
+#include "logger.h"
+
+#include <bit>
+
+namespace Networking {
+
+SegmentWorker::SegmentWorker(const char* name, size_t capacity, size_t slot_bytes, FrameHandler handler,
+                             std::function<void()> on_tick)
+    : name_(name),
+      handler_(std::move(handler)),
+      on_tick_(std::move(on_tick)),
+      slots_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)),
+      mask_(slots_.size() - 1) {
+    for (auto& slot : slots_) {
+        slot.reserve(slot_bytes);
+    }
+}
+
+SegmentWorker::~SegmentWorker() {
+    stop();
+}
+
+void SegmentWorker::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread(&SegmentWorker::run, this);
+    LOG_INFO << "SegmentWorker " << name_ << " started with " << slots_.size() << " slots.";
+}
+
+void SegmentWorker::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    wakeups_.fetch_add(1, std::memory_order_release);
+    wakeups_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    const uint64_t discarded = tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_relaxed);
+    head_.store(tail_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    processed_.fetch_add(discarded, std::memory_order_release); // Keeps wait_until_idle from hanging.
+    LOG_INFO << "SegmentWorker " << name_ << " stopped. " << discarded << " queued frames discarded.";
+}
+
+bool SegmentWorker::submit(const unsigned char* data, size_t length) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    slots_[tail & mask_].assign(data, data + length);
+    tail_.store(tail + 1, std::memory_order_release);
+    wakeups_.fetch_add(1, std::memory_order_release);
+    wakeups_.notify_one();
+    return true;
+}
+
+void SegmentWorker::post_tick() {
+    if (tick_pending_.exchange(true, std::memory_order_acq_rel)) {
+        return; // The worker has yet to run the previous one.
+    }
+    wakeups_.fetch_add(1, std::memory_order_release);
+    wakeups_.notify_one();
+}
+
+void SegmentWorker::wait_until_idle() const {
+    const uint64_t target = tail_.load(std::memory_order_acquire);
+    while (processed_.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+void SegmentWorker::run() {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    while (true) {
+        const uint32_t wakeups = wakeups_.load(std::memory_order_acquire);
+        if (!running_.load(std::memory_order_acquire)) {
+            break;
+        }
+        if (tick_pending_.exchange(false, std::memory_order_acq_rel)) {
+            if (on_tick_) {
+                on_tick_();
+            }
+        }
+        if (head == tail_.load(std::memory_order_acquire)) {
+            wakeups_.wait(wakeups, std::memory_order_acquire); // Returns once submit or stop bumps the counter.
+            continue;
+        }
+        const std::vector<unsigned char>& frame = slots_[head & mask_];
+        handler_(frame.data(), frame.size());
+        head_.store(++head, std::memory_order_release);
+        processed_.fetch_add(1, std::memory_order_release);
+    }
+}
+
+} // namespace Networking
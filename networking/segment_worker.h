@@ -0,0 +1,93 @@
+#ifndef SEGMENT_WORKER_H
+#define SEGMENT_WORKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Networking {
+
+/**
+ * @brief Runs one market segment's engine on its own thread, fed through a bounded
+ *        single-producer/single-consumer frame queue.
+ *
+ * `submit` copies the frame into a slot whose buffer is reserved to `slot_bytes` at construction
+ * (a larger frame grows its slot once, and slots keep their capacity), so submitting does not
+ * allocate, not even on the first lap. It never blocks: a full queue rejects the frame, which the
+ * engine's sequence gap recovery then requests again. Producers must be serialized by the caller.
+ */
+class SegmentWorker {
+public:
+    /**
+     * @brief Called on the worker thread for each frame, in submission order.
+     */
+    using FrameHandler = std::function<void(const unsigned char* data, size_t length)>;
+
+    /**
+     * @param name Used in log messages (e.g., "futures").
+     * @param capacity Queue capacity in frames, rounded up to a power of two.
+     * @param slot_bytes Bytes reserved for each slot up front; `capacity` times this is allocated.
+     * @param handler Processes one frame. Runs only on the worker thread.
+     * @param on_tick Optional; runs on the worker thread once for each `post_tick`, between frames.
+     */
+    SegmentWorker(const char* name, size_t capacity, size_t slot_bytes, FrameHandler handler,
+                  std::function<void()> on_tick = nullptr);
+
+    /** @brief Stops the thread, discarding frames still queued. */
+    ~SegmentWorker();
+
+    SegmentWorker(const SegmentWorker&) = delete;
+    SegmentWorker& operator=(const SegmentWorker&) = delete;
+
+    /** @brief Starts the worker thread. */
+    void start();
+
+    /** @brief Stops and joins the worker thread. Frames still queued are discarded. */
+    void stop();
+
+    /**
+     * @brief Queues a copy of the frame for the worker thread.
+     * @return False if the queue is full and the frame was dropped.
+     */
+    bool submit(const unsigned char* data, size_t length);
+
+    /**
+     * @brief Asks the worker thread to run `on_tick` (e.g. to fire its engine's timers) before its
+     *        next frame, waking it if idle. Ticks posted before the worker gets to them coalesce.
+     *        Callable from any thread; never blocks.
+     */
+    void post_tick();
+
+    /** @brief Blocks until every frame submitted so far has been processed. Requires a running worker. */
+    void wait_until_idle() const;
+
+    /** @brief Frames processed by the worker. */
+    uint64_t processed_count() const { return processed_.load(std::memory_order_acquire); }
+
+    /** @brief Frames rejected because the queue was full. */
+    uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    const char* name_;
+    FrameHandler handler_;
+    std::function<void()> on_tick_;
+    std::vector<std::vector<unsigned char>> slots_;
+    size_t mask_;
+
+    alignas(64) std::atomic<uint64_t> head_{0};      // Next slot to consume; written by the worker.
+    alignas(64) std::atomic<uint64_t> tail_{0};      // Next slot to fill; written by the producer.
+    alignas(64) std::atomic<uint32_t> wakeups_{0};   // Bumped on submit, post_tick and stop; the worker waits on it.
+    std::atomic<bool> tick_pending_{false};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace Networking
+#endif // SEGMENT_WORKER_H
@@ -0,0 +1,93 @@
+// normalized_event.h
+#ifndef NORMALIZED_EVENT_H
+#define NORMALIZED_EVENT_H
+
+#include <cstdint>
+#include <type_traits>
+
+namespace CoreUtils {
+
+/** @brief What a `NormalizedEvent` describes. */
+enum class EventType : uint8_t {
+    NONE = 0,
+    LEVEL_NEW,      ///< I081 MD-UPDATE-ACTION 0: a level is inserted at `level`.
+    LEVEL_CHANGE,   ///< I081 action 1: the level at `level` is replaced.
+    LEVEL_DELETE,   ///< I081 action 2: the level at `level` is removed.
+    LEVEL_OVERLAY,  ///< I081 action 5: the level at `level` is overwritten.
+    BOOK_CLEAR,     ///< The book is emptied: before an I083 snapshot's levels, or on I002 (`FLAG_RESET`).
+    SNAPSHOT_LEVEL, ///< One I083 level, following a BOOK_CLEAR.
+    BOOK_STALE      ///< PROD-MSG-SEQ gap: the book is unreliable until its next snapshot.
+};
+
+/** @brief Book side of a level event; NONE for book-wide events. */
+enum class EventSide : uint8_t {
+    NONE = 0,
+    BID,         ///< MD-ENTRY-TYPE 0
+    ASK,         ///< MD-ENTRY-TYPE 1
+    DERIVED_BID, ///< MD-ENTRY-TYPE E
+    DERIVED_ASK  ///< MD-ENTRY-TYPE F
+};
+
+/**
+ * @brief One cache line describing a single book change, independent of the TAIFEX frame it came
+ *        from. Trivially copyable, so it can be moved with memcpy through queues and files.
+ *
+ * Prices are the signed scaled integers of the message; `decimal_locator` places the point.
+ * Events decoded from one frame are contiguous; the last carries `FLAG_END_OF_MESSAGE`.
+ * I081/I083 bodies are decoded straight into these (messages/message_events.h); the order book
+ * applies them and every consumer downstream receives the same buffer.
+ */
+struct alignas(64) NormalizedEvent {
+    /** @brief Flag bit: last event decoded from its frame. */
+    static constexpr uint8_t FLAG_END_OF_MESSAGE = 0x01;
+    /** @brief Flag bit: BOOK_CLEAR caused by an I002 sequence reset. */
+    static constexpr uint8_t FLAG_RESET = 0x02;
+    /** @brief Flag bit: event of an I083 with CALCULATED-FLAG 1 (trial matching, no derived quotes). */
+    static constexpr uint8_t FLAG_CALCULATED = 0x04;
+    /** @brief Flag bit: part of a book image written to an event journal checkpoint, not of the feed. */
+    static constexpr uint8_t FLAG_CHECKPOINT = 0x08;
+
+    uint64_t  channel_seq;
+    uint64_t  exchange_time_us; ///< INFORMATION-TIME, microseconds since midnight.
+    int64_t   price;
+    int64_t   quantity;
+    uint32_t  prod_msg_seq;
+    uint32_t  product;          ///< ProductHandle of the book's I010 product.
+    uint32_t  book;             ///< BookHandle, dense per SDK instance.
+    uint16_t  channel_id;
+    EventType type;
+    EventSide side;
+    uint8_t   level;            ///< MD-PRICE-LEVEL, 1-based; 0 for book-wide events.
+    uint8_t   flags;
+    uint8_t   decimal_locator;
+    uint8_t   reserved[13];
+};
+
+static_assert(sizeof(NormalizedEvent) == 64, "NormalizedEvent is one cache line.");
+static_assert(std::is_trivially_copyable_v<NormalizedEvent>, "NormalizedEvent is copied as raw bytes.");
+
+/** @brief Maps an I081 MD-UPDATE-ACTION to a level event; NONE for unknown actions. */
+inline EventType eventTypeFromUpdateAction(char md_update_action) {
+    switch (md_update_action) {
+        case '0': return EventType::LEVEL_NEW;
+        case '1': return EventType::LEVEL_CHANGE;
+        case '2': return EventType::LEVEL_DELETE;
+        case '5': return EventType::LEVEL_OVERLAY;
+        default:  return EventType::NONE;
+    }
+}
+
+/** @brief Maps an I081/I083 MD-ENTRY-TYPE to a side. */
+inline EventSide eventSideFromEntryType(char md_entry_type) {
+    switch (md_entry_type) {
+        case '0': return EventSide::BID;
+        case '1': return EventSide::ASK;
+        case 'E': return EventSide::DERIVED_BID;
+        case 'F': return EventSide::DERIVED_ASK;
+        default:  return EventSide::NONE;
+    }
+}
+
+} // namespace CoreUtils
+
+#endif // NORMALIZED_EVENT_H
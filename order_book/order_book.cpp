@@ -4,13 +4,18 @@
 // SpecificMessageParsers::MessageI010 is forward declared, not directly used in these initial methods beyond constructor param.
 
 #include <algorithm> // For std::min
+#include <iterator>  // For std::prev
 
 namespace OrderBookManagement {
 
-OrderBook::OrderBook(const std::string& prod_id, uint8_t decimal_loc)
+OrderBook::OrderBook(const std::string& prod_id, uint8_t decimal_loc, std::pmr::memory_resource* memory,
+                     size_t max_depth)
     : product_id_(prod_id),
       decimal_locator_(decimal_loc),
-      last_prod_msg_seq_(0) {
+      last_prod_msg_seq_(0),
+      max_depth_(max_depth),
+      bids_(memory),
+      asks_(memory) {
     // Initialization complete via member initializers
 }
 
@@ -29,9 +34,18 @@ void OrderBook::reset() {
     derived_bid_.reset();
     derived_ask_.reset();
     last_prod_msg_seq_ = 0;
+    stale_ = false;
     // product_id_ and decimal_locator_ remain, as they define the book's identity.
 }
 
+void OrderBook::mark_stale() {
+    stale_ = true;
+}
+
+bool OrderBook::is_stale() const {
+    return stale_;
+}
+
 const std::string& OrderBook::get_product_id() const {
     return product_id_;
 }
@@ -40,6 +54,26 @@ uint32_t OrderBook::get_last_prod_msg_seq() const {
     return last_prod_msg_seq_;
 }
 
+uint8_t OrderBook::get_decimal_locator() const {
+    return decimal_locator_;
+}
+
+size_t OrderBook::get_max_depth() const {
+    return max_depth_;
+}
+
+void OrderBook::trim_to_max_depth() {
+    if (max_depth_ == 0) {
+        return;
+    }
+    while (bids_.size() > max_depth_) {
+        bids_.erase(std::prev(bids_.end()));
+    }
+    while (asks_.size() > max_depth_) {
+        asks_.erase(std::prev(asks_.end()));
+    }
+}
+
 std::vector<PriceQuantityLevel> OrderBook::get_top_bids(size_t n) const {
     std::vector<PriceQuantityLevel> top_levels;
     if (n == 0) return top_levels; // Handle n=0 case explicitly
@@ -74,6 +108,39 @@ std::optional<PriceQuantityLevel> OrderBook::get_derived_ask() const {
     return derived_ask_;
 }
 
+size_t OrderBook::copy_top_bids(std::span<PriceQuantityLevel> out) const {
+    size_t count = 0;
+    for (auto it = bids_.begin(); it != bids_.end() && count < out.size(); ++it) {
+        out[count++] = {it->first, it->second};
+    }
+    return count;
+}
+
+size_t OrderBook::copy_top_asks(std::span<PriceQuantityLevel> out) const {
+    size_t count = 0;
+    for (auto it = asks_.begin(); it != asks_.end() && count < out.size(); ++it) {
+        out[count++] = {it->first, it->second};
+    }
+    return count;
+}
+
+void OrderBook::restore(uint32_t last_prod_msg_seq, bool stale,
+                        std::span<const PriceQuantityLevel> bids, std::span<const PriceQuantityLevel> asks,
+                        std::optional<PriceQuantityLevel> derived_bid, std::optional<PriceQuantityLevel> derived_ask) {
+    reset();
+    last_prod_msg_seq_ = last_prod_msg_seq;
+    stale_ = stale;
+    for (const PriceQuantityLevel& level : bids) {
+        bids_[level.price] = level.quantity;
+    }
+    for (const PriceQuantityLevel& level : asks) {
+        asks_[level.price] = level.quantity;
+    }
+    derived_bid_ = derived_bid;
+    derived_ask_ = derived_ask;
+    trim_to_max_depth();
+}
+
 // --- Placeholder for methods to be implemented in next subtasks ---
 
 // Prices from MessageI08x.md_entry_px are already scaled integers (e.g., 12345 for 123.45 if locator is 2).
@@ -102,183 +169,206 @@ PriceType OrderBook::scale_price(int64_t raw_price) const {
 }
 
 
-void OrderBook::apply_snapshot(const SpecificMessageParsers::MessageI083& i083_msg) {
+bool OrderBook::accept_snapshot_sequence(uint32_t prod_msg_seq) {
+    if (!stale_ && last_prod_msg_seq_ != 0 && prod_msg_seq < last_prod_msg_seq_) {
+        // The book has already moved past this snapshot via I081 updates.
+        return false;
+    }
     reset(); // Clear the book first as per specification for I083
+    last_prod_msg_seq_ = prod_msg_seq;
+    return true;
+}
 
-    last_prod_msg_seq_ = i083_msg.prod_msg_seq;
-
-    for (const auto& entry : i083_msg.md_entries) { // C++11: const SpecificMessageParsers::MdEntryI083& entry : i083_msg.md_entries
-        PriceType current_price = apply_sign_to_price(entry.md_entry_px, entry.sign);
-        QuantityType current_quantity = static_cast<QuantityType>(entry.md_entry_size);
-
-        // Per spec for I083: "若該委託簿委託檔數不滿揭示深度檔數,則僅揭示委託簿內檔數。"
-        // "若此委託簿內有衍生買賣價量,則接續賣邊價量後,繼續揭示最佳一檔衍生買賣價量。"
-        // calculated_flag = '1' (試撮後): Prices 999999999 (market buy) / -999999999 (market sell) are possible.
-        // "試撮階段無衍生委託單。" (No derived orders if calculated_flag == '1')
-
-        switch (entry.md_entry_type) {
-            case '0': // Buy
-                if (current_quantity > 0) { // Only add if there's quantity
-                    bids_[current_price] = current_quantity;
+void OrderBook::apply_snapshot_level(CoreUtils::EventSide side, PriceType price, QuantityType quantity, bool calculated) {
+    // Per spec for I083: "若該委託簿委託檔數不滿揭示深度檔數,則僅揭示委託簿內檔數。"
+    // "若此委託簿內有衍生買賣價量,則接續賣邊價量後,繼續揭示最佳一檔衍生買賣價量。"
+    // calculated_flag = '1' (試撮後): Prices 999999999 (market buy) / -999999999 (market sell) are possible.
+    // "試撮階段無衍生委託單。" (No derived orders if calculated_flag == '1')
+    switch (side) {
+        case CoreUtils::EventSide::BID:
+            // I083 is a full snapshot listing active levels; a level with 0 quantity is not added.
+            if (quantity > 0) {
+                bids_[price] = quantity;
+            }
+            break;
+        case CoreUtils::EventSide::ASK:
+            if (quantity > 0) {
+                asks_[price] = quantity;
+            }
+            break;
+        case CoreUtils::EventSide::DERIVED_BID:
+            if (!calculated) { // Derived only if not call auction
+                if (quantity > 0 || price != 0) { // Store if qty > 0 or price non-zero (as per I081 overlay logic)
+                    derived_bid_ = PriceQuantityLevel{price, quantity};
                 } else {
-                    // Quantity 0 could imply removal, but I083 is a full snapshot.
-                    // If a price level from snapshot has 0 qty, it shouldn't be in the active book.
-                    // However, spec for I083 usually lists active levels.
-                    // If calculated_flag='1', market orders (price 999... or -999...) might have 0 quantity
-                    // if they are fully matched, but the snapshot should show remaining.
-                    // For simplicity, if quantity is 0, we don't add it.
-                }
-                break;
-            case '1': // Sell
-                if (current_quantity > 0) {
-                    asks_[current_price] = current_quantity;
-                }
-                break;
-            case 'E': // Derived Buy
-                if (i083_msg.calculated_flag == '0') { // Derived only if not call auction
-                    if (current_quantity > 0 || current_price != 0) { // Store if qty > 0 or price non-zero (as per I081 overlay logic)
-                        derived_bid_ = PriceQuantityLevel{current_price, current_quantity}; // C++11: derived_bid_ = PriceQuantityLevel{current_price, current_quantity}; or make_optional
-                    } else {
-                        derived_bid_.reset(); // Explicitly clear if qty and price are zero
-                    }
+                    derived_bid_.reset(); // Explicitly clear if qty and price are zero
                 }
-                break;
-            case 'F': // Derived Sell
-                if (i083_msg.calculated_flag == '0') { // Derived only if not call auction
-                     if (current_quantity > 0 || current_price != 0) {
-                        derived_ask_ = PriceQuantityLevel{current_price, current_quantity}; // C++11: derived_ask_ = PriceQuantityLevel{current_price, current_quantity}; or make_optional
-                    } else {
-                        derived_ask_.reset();
-                    }
+            }
+            break;
+        case CoreUtils::EventSide::DERIVED_ASK:
+            if (!calculated) {
+                if (quantity > 0 || price != 0) {
+                    derived_ask_ = PriceQuantityLevel{price, quantity};
+                } else {
+                    derived_ask_.reset();
                 }
-                break;
-            default:
-                // Unknown md_entry_type, log or handle error
-                // For now, ignore.
-                break;
-        }
+            }
+            break;
+        default:
+            // Unknown md_entry_type; ignored.
+            break;
     }
 }
 
-void OrderBook::apply_update(const SpecificMessageParsers::MessageI081& i081_msg) {
-    // It's important to process entries sequentially as per TAIFEX spec.
-    // "若訊息內有兩組價量更新資訊,應先處理完第一組價量之差異更新後,
-    // 再依委託簿更新的結果,繼續更新第二組價量資訊,始可獲得正確之委託簿資訊。"
-
-    // Consider if prod_msg_seq should be checked for out-of-order updates here,
-    // or if that's a higher-level (SDK) responsibility. For now, just update.
-    if (i081_msg.prod_msg_seq > last_prod_msg_seq_ || last_prod_msg_seq_ == 0) { // Basic check
-      last_prod_msg_seq_ = i081_msg.prod_msg_seq;
-    } else if (i081_msg.prod_msg_seq < last_prod_msg_seq_) {
-      // Potentially an old message, log and ignore? Or let SDK handle.
-      // For now, skipping if it's an older sequence.
-      // std::cerr << "Warning: Received out-of-order I081 for " << product_id_
-      //           << ". Current seq: " << last_prod_msg_seq_
-      //           << ", received seq: " << i081_msg.prod_msg_seq << std::endl;
-      // return; // Or some other strategy
+bool OrderBook::apply_snapshot(const SpecificMessageParsers::MessageI083& i083_msg) {
+    if (!accept_snapshot_sequence(i083_msg.prod_msg_seq)) {
+        return false;
     }
+    const bool calculated = i083_msg.calculated_flag != '0';
+    for (const auto& entry : i083_msg.md_entries) {
+        apply_snapshot_level(CoreUtils::eventSideFromEntryType(entry.md_entry_type),
+                             apply_sign_to_price(entry.md_entry_px, entry.sign),
+                             static_cast<QuantityType>(entry.md_entry_size), calculated);
+    }
+    trim_to_max_depth();
+    return true;
+}
 
+bool OrderBook::apply_snapshot(uint32_t prod_msg_seq, std::span<const CoreUtils::NormalizedEvent> events) {
+    if (!accept_snapshot_sequence(prod_msg_seq)) {
+        return false;
+    }
+    for (const CoreUtils::NormalizedEvent& event : events) {
+        if (event.type == CoreUtils::EventType::SNAPSHOT_LEVEL) {
+            apply_snapshot_level(event.side, event.price, static_cast<QuantityType>(event.quantity),
+                                 (event.flags & CoreUtils::NormalizedEvent::FLAG_CALCULATED) != 0);
+        }
+    }
+    trim_to_max_depth();
+    return true;
+}
 
-    for (const auto& entry : i081_msg.md_entries) { // C++11: const SpecificMessageParsers::MdEntryI081& entry : i081_msg.md_entries
-        PriceType current_price = apply_sign_to_price(entry.md_entry_px, entry.sign);
-        QuantityType current_quantity = static_cast<QuantityType>(entry.md_entry_size);
-
-        char update_action = entry.md_update_action;
-        char entry_type = entry.md_entry_type;
-        // uint8_t price_level = entry.md_price_level; // Not directly used by map if price is the key.
-                                                       // It's for context or if book was array-based.
+UpdateResult OrderBook::accept_update_sequence(uint32_t prod_msg_seq) {
+    // PROD-MSG-SEQ is contiguous per product, so a lost update is detected here without any
+    // channel-level recovery. Only this book goes stale; it resyncs from its next I083.
+    if (stale_) {
+        return UpdateResult::IGNORED_STALE;
+    }
+    if (last_prod_msg_seq_ != 0) { // 0: no baseline yet (fresh or reset book)
+        if (prod_msg_seq <= last_prod_msg_seq_) {
+            return UpdateResult::DUPLICATE;
+        }
+        if (prod_msg_seq != last_prod_msg_seq_ + 1) {
+            stale_ = true;
+            return UpdateResult::GAP_DETECTED;
+        }
+    }
+    last_prod_msg_seq_ = prod_msg_seq;
+    return UpdateResult::APPLIED;
+}
 
-        switch (entry_type) {
-            case '0': // Buy Side
-                if (update_action == '0') { // New
-                    if (current_quantity > 0) {
-                        bids_[current_price] = current_quantity;
-                    } else {
-                        // Adding a new level with 0 quantity effectively means no level or remove if exists.
-                        // For "New", it implies it wasn't there. So, adding with 0 has no effect or could be an error.
-                        // Safest is to ignore if quantity is 0 for a "New" action.
-                    }
-                } else if (update_action == '1') { // Change
-                    auto it = bids_.find(current_price);
-                    if (it != bids_.end()) {
-                        if (current_quantity > 0) {
-                            it->second = current_quantity;
-                        } else {
-                            bids_.erase(it); // Quantity 0 means delete the level
-                        }
+void OrderBook::apply_level(CoreUtils::EventType type, CoreUtils::EventSide side, PriceType price, QuantityType quantity) {
+    switch (side) {
+        case CoreUtils::EventSide::BID:
+            if (type == CoreUtils::EventType::LEVEL_NEW) {
+                // A New level with 0 quantity has no effect.
+                if (quantity > 0) {
+                    bids_[price] = quantity;
+                }
+            } else if (type == CoreUtils::EventType::LEVEL_CHANGE) {
+                auto it = bids_.find(price);
+                if (it != bids_.end()) {
+                    if (quantity > 0) {
+                        it->second = quantity;
                     } else {
-                        // Change for a non-existent level? Could be an error or an implicit "New".
-                        // Spec usually implies Change is for existing levels.
-                        // If quantity > 0, could treat as New. For now, assume Change targets existing.
-                         if (current_quantity > 0) { // Treat as new if it doesn't exist
-                            bids_[current_price] = current_quantity;
-                         }
+                        bids_.erase(it); // Quantity 0 means delete the level
                     }
-                } else if (update_action == '2') { // Delete
-                    bids_.erase(current_price);
+                } else if (quantity > 0) { // Change for a non-existent level: treat as New
+                    bids_[price] = quantity;
                 }
-                // Overlay ('5') is not for regular bids/asks per spec section "七" & "八"
-                break;
+            } else if (type == CoreUtils::EventType::LEVEL_DELETE) {
+                bids_.erase(price);
+            }
+            // Overlay ('5') is not for regular bids/asks per spec section "七" & "八"
+            break;
 
-            case '1': // Sell Side
-                if (update_action == '0') { // New
-                    if (current_quantity > 0) {
-                        asks_[current_price] = current_quantity;
-                    }
-                } else if (update_action == '1') { // Change
-                    auto it = asks_.find(current_price);
-                    if (it != asks_.end()) {
-                        if (current_quantity > 0) {
-                            it->second = current_quantity;
-                        } else {
-                            asks_.erase(it);
-                        }
+        case CoreUtils::EventSide::ASK:
+            if (type == CoreUtils::EventType::LEVEL_NEW) {
+                if (quantity > 0) {
+                    asks_[price] = quantity;
+                }
+            } else if (type == CoreUtils::EventType::LEVEL_CHANGE) {
+                auto it = asks_.find(price);
+                if (it != asks_.end()) {
+                    if (quantity > 0) {
+                        it->second = quantity;
                     } else {
-                         if (current_quantity > 0) { // Treat as new
-                            asks_[current_price] = current_quantity;
-                         }
+                        asks_.erase(it);
                     }
-                } else if (update_action == '2') { // Delete
-                    asks_.erase(current_price);
+                } else if (quantity > 0) { // Treat as new
+                    asks_[price] = quantity;
                 }
-                // Overlay ('5') is not for regular bids/asks
-                break;
+            } else if (type == CoreUtils::EventType::LEVEL_DELETE) {
+                asks_.erase(price);
+            }
+            break;
 
-            case 'E': // Derived Buy
-                if (update_action == '5') { // Overlay
-                    if (current_quantity > 0 || current_price != 0) { // Price can be 0 if qty is also 0 for deletion
-                        derived_bid_ = PriceQuantityLevel{current_price, current_quantity}; // C++11: derived_bid_ = PriceQuantityLevel{current_price, current_quantity}; or make_optional
-                    } else {
-                        derived_bid_.reset(); // Both 0 means delete/clear
-                    }
+        case CoreUtils::EventSide::DERIVED_BID:
+            // The spec only uses Overlay for derived quotes.
+            if (type == CoreUtils::EventType::LEVEL_OVERLAY) {
+                if (quantity > 0 || price != 0) { // Price can be 0 if qty is also 0 for deletion
+                    derived_bid_ = PriceQuantityLevel{price, quantity};
+                } else {
+                    derived_bid_.reset(); // Both 0 means delete/clear
                 }
-                // Other actions (New, Change, Delete) are not typical for derived via I081 based on common usage.
-                // The spec focuses on Overlay for derived.
-                break;
-
-            case 'F': // Derived Sell
-                if (update_action == '5') { // Overlay
-                    if (current_quantity > 0 || current_price != 0) {
-                        derived_ask_ = PriceQuantityLevel{current_price, current_quantity}; // C++11: derived_ask_ = PriceQuantityLevel{current_price, current_quantity}; or make_optional
-                    } else {
-                        derived_ask_.reset();
-                    }
+            }
+            break;
+
+        case CoreUtils::EventSide::DERIVED_ASK:
+            if (type == CoreUtils::EventType::LEVEL_OVERLAY) {
+                if (quantity > 0 || price != 0) {
+                    derived_ask_ = PriceQuantityLevel{price, quantity};
+                } else {
+                    derived_ask_.reset();
                 }
-                break;
-            default:
-                // Unknown md_entry_type
-                break;
-        }
+            }
+            break;
+        default:
+            // Unknown md_entry_type
+            break;
+    }
+}
+
+UpdateResult OrderBook::apply_update(const SpecificMessageParsers::MessageI081& i081_msg) {
+    // It's important to process entries sequentially as per TAIFEX spec.
+    // "若訊息內有兩組價量更新資訊,應先處理完第一組價量之差異更新後,
+    // 再依委託簿更新的結果,繼續更新第二組價量資訊,始可獲得正確之委託簿資訊。"
+    const UpdateResult result = accept_update_sequence(i081_msg.prod_msg_seq);
+    if (result != UpdateResult::APPLIED) {
+        return result;
+    }
+    for (const auto& entry : i081_msg.md_entries) {
+        apply_level(CoreUtils::eventTypeFromUpdateAction(entry.md_update_action),
+                    CoreUtils::eventSideFromEntryType(entry.md_entry_type),
+                    apply_sign_to_price(entry.md_entry_px, entry.sign),
+                    static_cast<QuantityType>(entry.md_entry_size));
+    }
+    // A level pushed out of the disclosed depth gets no delete ("期交所不另送出刪除訊息"); the
+    // exchange sends a New when one comes back into view, so levels past max_depth_ are dropped.
+    trim_to_max_depth();
+    return UpdateResult::APPLIED;
+}
+
+UpdateResult OrderBook::apply_update(uint32_t prod_msg_seq, std::span<const CoreUtils::NormalizedEvent> events) {
+    const UpdateResult result = accept_update_sequence(prod_msg_seq);
+    if (result != UpdateResult::APPLIED) {
+        return result;
+    }
+    for (const CoreUtils::NormalizedEvent& event : events) {
+        apply_level(event.type, event.side, event.price, static_cast<QuantityType>(event.quantity));
     }
-    // Pruning to fixed depth (e.g. 5 levels) after updates if required by strict interpretation
-    // of "向下調整其它價格檔位，並刪除超出委託簿揭示深度之檔位"
-    // For now, map stores all levels, get_top_X provides the view.
-    // If strict depth:
-    // while (bids_.size() > MAX_DEPTH) { bids_.erase(std::prev(bids_.end())); } // std::map greater sorts high to low, last is lowest
-    // while (asks_.size() > MAX_DEPTH) { asks_.erase(std::prev(asks_.end())); } // std::map less sorts low to high, last is highest
-    // This pruning is complex because "delete" on level 2 doesn't mean level 6 becomes visible if MAX_DEPTH is 5.
-    // The spec implies the view is managed by the exchange sending updates to fill the view.
-    // The current std::map approach of storing all known levels is simpler and likely correct for data retention.
+    trim_to_max_depth();
+    return UpdateResult::APPLIED;
 }
 
 } // namespace OrderBookManagement
@@ -7,6 +7,10 @@
 #include <cstdint>
 #include <functional> // For std::greater, std::less
 #include <optional>   // For potentially absent derived quotes if a more complex struct is used
+#include <span>
+#include <memory_resource>
+
+#include "normalized_event.h"
 
 // Forward declare message structs from Department C that will be used by OrderBook methods.
 // This avoids including the full message headers in order_book.h if only references/pointers are used in method signatures.
@@ -36,6 +40,16 @@ struct PriceQuantityLevel {
 };
 
 
+/**
+ * @brief Outcome of applying a differential update (I081) to an OrderBook.
+ */
+enum class UpdateResult {
+    APPLIED,        // PROD-MSG-SEQ was the next expected one; the book changed.
+    DUPLICATE,      // PROD-MSG-SEQ already applied (replay/old message); ignored.
+    GAP_DETECTED,   // PROD-MSG-SEQ skipped ahead; the book was marked stale and the update ignored.
+    IGNORED_STALE   // The book is stale and waiting for a snapshot; ignored.
+};
+
 class OrderBook {
 public:
     /**
@@ -43,25 +57,54 @@ public:
      * @param prod_id The product identifier for this order book.
      * @param decimal_loc The decimal locator for this product's prices, taken from I010.
      *                    This is crucial for interpreting incoming prices correctly.
+     * @param memory Where price levels are allocated (e.g. the SDK's preallocated book pool).
+     *               Must outlive the book. Copies of the book use the default resource.
+     * @param max_depth Levels kept per side; 0 keeps every level. Levels pushed below it are
+     *                  dropped, as the exchange sends no delete for them. Must be at least the
+     *                  depth the feed discloses.
      */
-    OrderBook(const std::string& prod_id, uint8_t decimal_loc);
+    OrderBook(const std::string& prod_id, uint8_t decimal_loc,
+              std::pmr::memory_resource* memory = std::pmr::get_default_resource(), size_t max_depth = 0);
     OrderBook(); // Default constructor, perhaps for use in maps, then initialize separately. Consider if needed.
 
     /**
      * @brief Rebuilds the order book from a snapshot message (I083).
-     * Clears existing book data before applying the snapshot.
+     * Clears existing book data before applying the snapshot. This is also how a stale book
+     * resynchronizes: the snapshot's PROD-MSG-SEQ becomes the new baseline.
+     * A snapshot older than the last applied PROD-MSG-SEQ of an in-sync book is ignored.
      * @param i083_msg The parsed I083 message content.
      *                 Prices in i083_msg are raw; they will be scaled using the stored decimal_locator.
+     * @return True if the snapshot was applied, false if it was outdated and ignored.
      */
-    void apply_snapshot(const SpecificMessageParsers::MessageI083& i083_msg);
+    bool apply_snapshot(const SpecificMessageParsers::MessageI083& i083_msg);
 
     /**
      * @brief Updates the order book from a differential update message (I081).
      * Applies changes sequentially based on MD-UPDATE-ACTION.
+     *
+     * PROD-MSG-SEQ must follow the last applied one. An older sequence is ignored; a skipped
+     * sequence means an update for this product was lost, so the book is marked stale and
+     * ignores updates until the next snapshot. A book with no baseline yet (fresh or reset)
+     * accepts any sequence.
      * @param i081_msg The parsed I081 message content.
      *                 Prices in i081_msg are raw; they will be scaled using the stored decimal_locator.
+     * @return How the update was handled; only `UpdateResult::APPLIED` changes the book.
+     */
+    UpdateResult apply_update(const SpecificMessageParsers::MessageI081& i081_msg);
+
+    /**
+     * @brief Same as the I083 overload, from the events `decode_i083_events` produced: the
+     *        SNAPSHOT_LEVEL events are applied, anything else is skipped.
+     * @param prod_msg_seq The snapshot's PROD-MSG-SEQ.
      */
-    void apply_update(const SpecificMessageParsers::MessageI081& i081_msg);
+    bool apply_snapshot(uint32_t prod_msg_seq, std::span<const CoreUtils::NormalizedEvent> events);
+
+    /**
+     * @brief Same as the I081 overload, from the events `decode_i081_events` produced: the
+     *        LEVEL_* events are applied in order, anything else is skipped.
+     * @param prod_msg_seq The update's PROD-MSG-SEQ; sequenced even when `events` is empty.
+     */
+    UpdateResult apply_update(uint32_t prod_msg_seq, std::span<const CoreUtils::NormalizedEvent> events);
 
     /**
      * @brief Resets the order book upon receiving a Sequence Reset message (I002).
@@ -69,6 +112,18 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Marks the book as stale: its contents can no longer be trusted (e.g. after a
+     * PROD-MSG-SEQ gap). A stale book stays stale until the next snapshot (I083)
+     * or reset (I002) rebuilds it.
+     */
+    void mark_stale();
+
+    /**
+     * @brief Returns true if the book is awaiting a snapshot to resynchronize.
+     */
+    bool is_stale() const;
+
     /**
      * @brief Gets the product ID associated with this order book.
      */
@@ -79,6 +134,16 @@ public:
      */
     uint32_t get_last_prod_msg_seq() const;
 
+    /**
+     * @brief Gets the decimal locator the book was created with (from I010).
+     */
+    uint8_t get_decimal_locator() const;
+
+    /**
+     * @brief Gets the number of levels kept per side (0: unbounded).
+     */
+    size_t get_max_depth() const;
+
     /**
      * @brief Retrieves the top N bid levels.
      * @param n The number of levels to retrieve.
@@ -105,21 +170,53 @@ public:
      */
     std::optional<PriceQuantityLevel> get_derived_ask() const;
 
+    /**
+     * @brief Copies up to `out.size()` best bid levels into `out` without allocating.
+     * @return The number of levels copied.
+     */
+    size_t copy_top_bids(std::span<PriceQuantityLevel> out) const;
+
+    /**
+     * @brief Copies up to `out.size()` best ask levels into `out` without allocating.
+     * @return The number of levels copied.
+     */
+    size_t copy_top_asks(std::span<PriceQuantityLevel> out) const;
+
+    /**
+     * @brief Replaces the book's contents with previously saved state (e.g. from a
+     * `Taifex::StateStore` after a restart). Identity (product ID, decimal locator) is unchanged.
+     */
+    void restore(uint32_t last_prod_msg_seq, bool stale,
+                 std::span<const PriceQuantityLevel> bids, std::span<const PriceQuantityLevel> asks,
+                 std::optional<PriceQuantityLevel> derived_bid, std::optional<PriceQuantityLevel> derived_ask);
+
 
 private:
     // Helper function to scale raw prices from messages using the product's decimal_locator.
     PriceType scale_price(int64_t raw_price) const;
+    // Checks an I081's PROD-MSG-SEQ against the book and advances it when APPLIED is returned.
+    UpdateResult accept_update_sequence(uint32_t prod_msg_seq);
+    // Checks an I083's PROD-MSG-SEQ; on true the book is cleared and takes it as its baseline.
+    bool accept_snapshot_sequence(uint32_t prod_msg_seq);
+    // One I081 entry, `price` already signed.
+    void apply_level(CoreUtils::EventType type, CoreUtils::EventSide side, PriceType price, QuantityType quantity);
+    // Drops the levels below max_depth_ on each side.
+    void trim_to_max_depth();
+    // One I083 entry; derived quotes only outside trial matching.
+    void apply_snapshot_level(CoreUtils::EventSide side, PriceType price, QuantityType quantity, bool calculated);
     // Helper function to unscale prices if needed for external representation (not typically stored unscaled).
     // int64_t unscale_price(PriceType scaled_price) const; // Example, might not be needed internally.
 
     std::string product_id_;
     uint8_t decimal_locator_; // Stores the decimal locator for this product.
     uint32_t last_prod_msg_seq_;
+    bool stale_ = false;
+    size_t max_depth_ = 0; // 0: unbounded
 
     // Bids: Highest price first
-    std::map<PriceType, QuantityType, std::greater<PriceType>> bids_;
+    std::pmr::map<PriceType, QuantityType, std::greater<PriceType>> bids_;
     // Asks: Lowest price first
-    std::map<PriceType, QuantityType, std::less<PriceType>> asks_;
+    std::pmr::map<PriceType, QuantityType, std::less<PriceType>> asks_;
 
     // Storage for derived quotes. Using std::optional for clarity if a quote might not be present.
     std::optional<PriceQuantityLevel> derived_bid_;
@@ -33,36 +33,34 @@ std::vector<unsigned char> asciiToPackBcd(const std::string& ascii_numeric_str)
     return bcd_result;
 }
 
-std::string packBcdToAscii(const std::vector<unsigned char>& bcd_data, size_t num_digits) {
-    std::string full_decoded_str;
-    full_decoded_str.reserve(bcd_data.size() * 2);
-
-    for (unsigned char byte : bcd_data) {
-        unsigned char nibble1 = (byte >> 4) & 0x0F;
-        unsigned char nibble2 = byte & 0x0F;
+std::string packBcdToAscii(const unsigned char* bcd_data, size_t length, size_t num_digits) {
+    const size_t decoded_digits = length * 2;
+    const size_t out_digits = num_digits == 0 ? decoded_digits : num_digits;
+    // Left-pad with zeros when fewer digits are encoded than requested; drop the leading ones
+    // when more are encoded.
+    std::string result(out_digits > decoded_digits ? out_digits - decoded_digits : 0, '0');
+    result.reserve(out_digits);
+    const size_t skip = decoded_digits > out_digits ? decoded_digits - out_digits : 0;
+
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char nibble1 = (bcd_data[i] >> 4) & 0x0F;
+        unsigned char nibble2 = bcd_data[i] & 0x0F;
 
         if (nibble1 > 9 || nibble2 > 9) {
             throw std::runtime_error("Invalid BCD data: nibble > 9 detected during packBcdToAscii.");
         }
-        full_decoded_str.push_back(nibble1 + '0');
-        full_decoded_str.push_back(nibble2 + '0');
-    }
-
-    if (num_digits == 0 && !bcd_data.empty()) {
-        return full_decoded_str;
-    }
-    if (num_digits == 0 && bcd_data.empty()){
-        return "";
-    }
-
-    if (full_decoded_str.length() < num_digits) {
-        std::string padding(num_digits - full_decoded_str.length(), '0');
-        return padding + full_decoded_str;
-    } else if (full_decoded_str.length() > num_digits) {
-        return full_decoded_str.substr(full_decoded_str.length() - num_digits);
+        if (2 * i >= skip) {
+            result.push_back(nibble1 + '0');
+        }
+        if (2 * i + 1 >= skip) {
+            result.push_back(nibble2 + '0');
+        }
     }
+    return result;
+}
 
-    return full_decoded_str;
+std::string packBcdToAscii(const std::vector<unsigned char>& bcd_data, size_t num_digits) {
+    return packBcdToAscii(bcd_data.data(), bcd_data.size(), num_digits);
 }
 
 std::string packBcdToAscii(const std::vector<unsigned char>& bcd_data) {
@@ -10,6 +10,9 @@ namespace CoreUtils {
 
 std::vector<unsigned char> asciiToPackBcd(const std::string& ascii_numeric_str);
 std::string packBcdToAscii(const std::vector<unsigned char>& bcd_data, size_t num_digits);
+// Same as above on a raw byte range. Results of up to 15 digits fit the string's inline buffer, so
+// decoding header and body fields does not allocate.
+std::string packBcdToAscii(const unsigned char* bcd_data, size_t length, size_t num_digits);
 std::string packBcdToAscii(const std::vector<unsigned char>& bcd_data);
 
 } // namespace CoreUtils
@@ -0,0 +1,162 @@
+#include "sdk/bar_aggregator.h"
+
+#include <algorithm> // For std::min, std::max
+
+namespace Taifex {
+
+namespace {
+
+constexpr uint64_t SECOND_US = 1000ull * 1000;
+constexpr uint64_t NEW_DAY_THRESHOLD_US = 12ull * 3600 * SECOND_US;
+
+} // namespace
+
+void BarAggregator::configure(const BarConfig& config) {
+    const size_t capacities[BAR_INTERVAL_COUNT] = {config.second_bars, config.minute_bars};
+    const uint64_t lengths[BAR_INTERVAL_COUNT] = {SECOND_US, 60 * SECOND_US};
+    enabled_ = false;
+    for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+        Series& series = series_[i];
+        series = Series{};
+        series.length_us = lengths[i];
+        series.capacity = capacities[i];
+        if (series.capacity == 0) {
+            continue;
+        }
+        series.rings.resize(config.expected_books * series.capacity);
+        series.books.resize(config.expected_books);
+        series.open.reserve(config.expected_books);
+        enabled_ = true;
+    }
+}
+
+void BarAggregator::add_book(BookHandle book) {
+    for (Series& series : series_) {
+        if (series.capacity == 0 || book < series.books.size()) {
+            continue;
+        }
+        const size_t books = std::max<size_t>(book + 1, series.books.size() * 2);
+        series.rings.resize(books * series.capacity);
+        series.books.resize(books);
+        series.open.reserve(books);
+    }
+}
+
+Bar* BarAggregator::open_bar_for(Series& series, BookHandle book) {
+    if (series.capacity == 0 || book >= series.books.size()) {
+        return nullptr;
+    }
+    BookBars& bars = series.books[book];
+    if (!bars.has_open) {
+        bars.open = Bar{};
+        bars.open.start_time_us = series.start_us;
+        bars.has_open = true;
+        series.open.push_back(book);
+    }
+    return &bars.open;
+}
+
+void BarAggregator::roll(Series& series, BarInterval interval, uint64_t time_us) {
+    if (series.capacity == 0) {
+        return;
+    }
+    const uint64_t start_us = time_us - time_us % series.length_us;
+    if (!series.started) {
+        series.start_us = start_us;
+        series.started = true;
+    } else if (start_us > series.start_us || series.start_us - start_us > NEW_DAY_THRESHOLD_US) {
+        close_all(series, interval);
+        series.start_us = start_us;
+    }
+}
+
+void BarAggregator::close_all(Series& series, BarInterval interval) {
+    for (BookHandle book : series.open) {
+        BookBars& bars = series.books[book];
+        series.rings[book * series.capacity + bars.head] = bars.open;
+        bars.head = static_cast<uint32_t>((bars.head + 1) % series.capacity);
+        bars.count = static_cast<uint32_t>(std::min<size_t>(bars.count + 1, series.capacity));
+        bars.has_open = false;
+        if (callback_) {
+            callback_(book, interval, bars.open);
+        }
+    }
+    series.open.clear();
+}
+
+void BarAggregator::advance(uint64_t time_us) {
+    if (!enabled_) {
+        return;
+    }
+    for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+        roll(series_[i], static_cast<BarInterval>(i), time_us);
+    }
+}
+
+void BarAggregator::on_quote(BookHandle book, uint64_t time_us, int64_t best_bid, int64_t best_ask) {
+    if (!enabled_) {
+        return;
+    }
+    const int64_t mid2 = best_bid + best_ask;
+    for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+        roll(series_[i], static_cast<BarInterval>(i), time_us);
+        Bar* bar = open_bar_for(series_[i], book);
+        if (!bar) {
+            continue;
+        }
+        if (bar->quote_count++ == 0) {
+            bar->mid2_open = bar->mid2_high = bar->mid2_low = mid2;
+        } else {
+            bar->mid2_high = std::max(bar->mid2_high, mid2);
+            bar->mid2_low = std::min(bar->mid2_low, mid2);
+        }
+        bar->mid2_close = mid2;
+    }
+}
+
+void BarAggregator::on_trade(BookHandle book, uint64_t time_us, int64_t price, uint64_t quantity) {
+    if (!enabled_) {
+        return;
+    }
+    for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+        roll(series_[i], static_cast<BarInterval>(i), time_us);
+        Bar* bar = open_bar_for(series_[i], book);
+        if (!bar) {
+            continue;
+        }
+        if (bar->trade_count++ == 0) {
+            bar->open = bar->high = bar->low = price;
+        } else {
+            bar->high = std::max(bar->high, price);
+            bar->low = std::min(bar->low, price);
+        }
+        bar->close = price;
+        bar->volume += quantity;
+    }
+}
+
+size_t BarAggregator::copy_bars(BookHandle book, BarInterval interval, std::span<Bar> out) const {
+    const Series& series = series_[static_cast<size_t>(interval)];
+    if (series.capacity == 0 || book >= series.books.size()) {
+        return 0;
+    }
+    const BookBars& bars = series.books[book];
+    const size_t count = std::min<size_t>(bars.count, out.size());
+    const Bar* ring = &series.rings[book * series.capacity];
+    size_t slot = (bars.head + series.capacity - count) % series.capacity;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = ring[slot];
+        slot = (slot + 1) % series.capacity;
+    }
+    return count;
+}
+
+const Bar* BarAggregator::open_bar(BookHandle book, BarInterval interval) const {
+    const Series& series = series_[static_cast<size_t>(interval)];
+    if (series.capacity == 0 || book >= series.books.size() || !series.books[book].has_open) {
+        return nullptr;
+    }
+    return &series.books[book].open;
+}
+
+} // namespace Taifex
@@ -0,0 +1,128 @@
+#ifndef BAR_AGGREGATOR_H
+#define BAR_AGGREGATOR_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "sdk/product_registry.h"
+
+namespace Taifex {
+
+/** @brief Bar lengths kept by `BarAggregator`. */
+enum class BarInterval : uint8_t {
+    SECOND = 0, ///< 1 s bars
+    MINUTE = 1  ///< 1 min bars
+};
+
+constexpr size_t BAR_INTERVAL_COUNT = 2;
+
+/**
+ * @brief Closed bars kept per book and interval. Each series is a ring over one preallocated
+ *        block; the oldest bar is overwritten. 0 turns the interval off.
+ */
+struct BarConfig {
+    size_t second_bars = 300; ///< Five minutes of 1 s bars.
+    size_t minute_bars = 300; ///< Five hours of 1 min bars.
+    /** @brief Books the rings are allocated for up front; later books grow them (cold path). */
+    size_t expected_books = 0;
+};
+
+/**
+ * @brief One bar of one book. Prices are the book's scaled integers.
+ *
+ * Trade fields are valid when `trade_count` > 0, mid fields when `quote_count` > 0. The mid is
+ * kept as best bid + best ask (twice the mid), so it stays exact.
+ */
+struct Bar {
+    uint64_t start_time_us = 0; ///< INFORMATION-TIME (microseconds since midnight) the bar starts at.
+    int64_t  open = 0;
+    int64_t  high = 0;
+    int64_t  low = 0;
+    int64_t  close = 0;
+    uint64_t volume = 0;
+    uint32_t trade_count = 0;
+    uint32_t quote_count = 0;   ///< Book updates with both sides present.
+    int64_t  mid2_open = 0;
+    int64_t  mid2_high = 0;
+    int64_t  mid2_low = 0;
+    int64_t  mid2_close = 0;
+};
+
+/**
+ * @brief Incremental OHLCV bars per book, 1 s and 1 min, from trades and the book mid.
+ *
+ * Every input updates the book's open bar in place: O(1), no allocation. Time is the exchange's
+ * INFORMATION-TIME, never the wall clock, so a replay produces the same bars as the live session.
+ * The aggregator keeps one clock across all books: once an input (or `advance`) reaches the next
+ * interval, every bar still open is closed, appended to its book's ring and passed to the
+ * callback. A book without inputs during an interval has no bar for it. Inputs stamped before the
+ * open interval (a channel running slightly behind another) count toward the open bar; a clock
+ * going back by more than 12 hours is a new day and closes everything.
+ *
+ * Books are addressed by `BookHandle` rather than `ProductHandle`, because complex books share
+ * the handle of their first leg. Single-threaded: the thread calling `TaifexSdk::process_message`.
+ */
+class BarAggregator {
+public:
+    using BarCallback = std::function<void(BookHandle book, BarInterval interval, const Bar& bar)>;
+
+    /** @brief Allocates the rings and clears all bars. */
+    void configure(const BarConfig& config);
+    bool enabled() const { return enabled_; }
+
+    /** @brief Makes room for the book's rings; allocates only past `expected_books`. */
+    void add_book(BookHandle book);
+
+    /** @brief A book update with the best bid and ask (scaled), at INFORMATION-TIME `time_us`. */
+    void on_quote(BookHandle book, uint64_t time_us, int64_t best_bid, int64_t best_ask);
+    /** @brief A trade of `quantity` at `price` (scaled), at INFORMATION-TIME `time_us`. */
+    void on_trade(BookHandle book, uint64_t time_us, int64_t price, uint64_t quantity);
+    /** @brief Moves the clock without an input (e.g. on a heartbeat), closing finished bars. */
+    void advance(uint64_t time_us);
+
+    /** @brief Called for every closed bar, on the thread that closed it. */
+    void set_callback(BarCallback callback) { callback_ = std::move(callback); }
+
+    /**
+     * @brief Copies the book's most recent closed bars, oldest first.
+     * @return Bars copied: at most `out.size()` and the ring's capacity.
+     */
+    size_t copy_bars(BookHandle book, BarInterval interval, std::span<Bar> out) const;
+    /** @return The bar still being built for the book, or nullptr. */
+    const Bar* open_bar(BookHandle book, BarInterval interval) const;
+
+private:
+    struct BookBars {
+        Bar open;
+        uint32_t head = 0;      // Next slot to write.
+        uint32_t count = 0;     // Closed bars in the ring.
+        bool has_open = false;
+    };
+
+    struct Series {
+        uint64_t length_us = 0;
+        size_t capacity = 0;             // Closed bars per book; 0 when the interval is off.
+        std::vector<Bar> rings;          // Book b owns [b * capacity, (b + 1) * capacity).
+        std::vector<BookBars> books;
+        std::vector<BookHandle> open;    // Books with an open bar, closed together.
+        uint64_t start_us = 0;           // Start of the open interval.
+        bool started = false;
+    };
+
+    // The book's bar in the open interval, started on first use; nullptr if the series is off.
+    Bar* open_bar_for(Series& series, BookHandle book);
+    // Closes the open interval once `time_us` is past it (or a new day has started).
+    void roll(Series& series, BarInterval interval, uint64_t time_us);
+    void close_all(Series& series, BarInterval interval);
+
+    std::array<Series, BAR_INTERVAL_COUNT> series_;
+    BarCallback callback_;
+    bool enabled_ = false;
+};
+
+} // namespace Taifex
+#endif // BAR_AGGREGATOR_H
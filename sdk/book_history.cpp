@@ -0,0 +1,114 @@
+#include "sdk/book_history.h"
+
+#include "logger.h"
+#include "messages/message_events.h"
+
+#include <algorithm> // For std::upper_bound
+
+namespace Taifex {
+
+namespace {
+
+std::string padded_prod_id(std::string_view prod_id) {
+    std::string key(prod_id.substr(0, sizeof(JournalBookRecord::prod_id)));
+    key.resize(sizeof(JournalBookRecord::prod_id), ' ');
+    return key;
+}
+
+bool is_image(const CoreUtils::NormalizedEvent& event) {
+    return (event.flags & CoreUtils::NormalizedEvent::FLAG_CHECKPOINT) != 0;
+}
+
+} // namespace
+
+bool BookHistory::open(const std::string& journal_path) {
+    close();
+    if (!reader_.open(journal_path)) {
+        return false;
+    }
+    const size_t record_count = reader_.record_count();
+    size_t index = 0;
+    while (index < record_count) {
+        switch (reader_.record_type(index)) {
+            case JournalRecordType::BOOK: {
+                const JournalBookRecord& record = reader_.book(index);
+                if (record.book >= books_.size()) {
+                    books_.resize(record.book + 1);
+                }
+                Book& book = books_[record.book];
+                book.prod_id.assign(record.prod_id, sizeof(record.prod_id));
+                book.decimal_locator = record.decimal_locator;
+                by_prod_id_[book.prod_id] = record.book;
+                ++index;
+                continue;
+            }
+            case JournalRecordType::PRODUCT:
+            case JournalRecordType::CHECKPOINT:
+                ++index;
+                continue;
+            case JournalRecordType::EVENT:
+                break;
+        }
+        // Runs are cut exactly as `TaifexSdk::replay_journal` cuts them.
+        const CoreUtils::NormalizedEvent& first = reader_.event(index);
+        const size_t end = reader_.run_end(index, SpecificMessageParsers::MAX_BOOK_MESSAGE_EVENTS);
+        if (first.book < books_.size()) {
+            Book& book = books_[first.book];
+            if (is_image(first)) {
+                book.images.push_back(static_cast<uint32_t>(book.runs.size()));
+            }
+            book.runs.push_back({index, first.exchange_time_us, static_cast<uint32_t>(end - index)});
+        }
+        index = end;
+    }
+    LOG_INFO << "BookHistory: indexed " << books_.size() << " books from " << journal_path << " (" << record_count
+             << " records).";
+    return true;
+}
+
+void BookHistory::close() {
+    reader_.close();
+    books_.clear();
+    by_prod_id_.clear();
+}
+
+std::optional<OrderBookManagement::OrderBook> BookHistory::book_as_of(std::string_view prod_id,
+                                                                      uint64_t exchange_time_us,
+                                                                      size_t* events_applied) const {
+    if (events_applied) {
+        *events_applied = 0;
+    }
+    const auto found = by_prod_id_.find(padded_prod_id(prod_id));
+    if (found == by_prod_id_.end()) {
+        return std::nullopt;
+    }
+    const Book& book = books_[found->second];
+    if (book.runs.empty() || book.runs.front().exchange_time_us > exchange_time_us) {
+        return std::nullopt;
+    }
+
+    // The last image at or before the time; without one, the book's first message.
+    const auto image = std::upper_bound(book.images.begin(), book.images.end(), exchange_time_us,
+                                        [&book](uint64_t time_us, uint32_t run) {
+                                            return time_us < book.runs[run].exchange_time_us;
+                                        });
+    const size_t start = image == book.images.begin() ? 0 : *(image - 1);
+
+    OrderBookManagement::OrderBook order_book(book.prod_id, book.decimal_locator);
+    size_t applied = 0;
+    for (size_t r = start; r < book.runs.size() && book.runs[r].exchange_time_us <= exchange_time_us; ++r) {
+        const Run& run = book.runs[r];
+        const CoreUtils::NormalizedEvent& first = reader_.event(run.record);
+        if (r != start && is_image(first)) {
+            continue; // Repeats what the events since `start` built.
+        }
+        apply_journal_run(order_book, std::span(&first, run.events));
+        applied += run.events;
+    }
+    if (events_applied) {
+        *events_applied = applied;
+    }
+    return order_book;
+}
+
+} // namespace Taifex
@@ -0,0 +1,74 @@
+#ifndef BOOK_HISTORY_H
+#define BOOK_HISTORY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "order_book/order_book.h"
+#include "sdk/event_journal.h"
+#include "sdk/product_registry.h"
+
+namespace Taifex {
+
+/**
+ * @brief Point-in-time book queries over an event journal (`TaifexSdk::journal_events`).
+ *
+ * `open` maps the journal and indexes it once per book: where each of the book's journaled
+ * messages starts and which of them are checkpoint images (the periodic full checkpoints and the
+ * book's own checkpoints, see `EventJournalConfig::book_checkpoint_events`). `book_as_of` then
+ * seeks to the book's last image at or before the requested time and applies only that book's
+ * messages from there, so a query touches a bounded number of events regardless of the journal's
+ * length or how many other books it holds. The journal is assumed to be in INFORMATION-TIME
+ * order, as recorded from one feed.
+ */
+class BookHistory {
+public:
+    BookHistory() = default;
+
+    BookHistory(const BookHistory&) = delete;
+    BookHistory& operator=(const BookHistory&) = delete;
+
+    /** @return False if the file is missing or not a journal. */
+    bool open(const std::string& journal_path);
+    void close();
+    bool is_open() const { return reader_.is_open(); }
+
+    /** @brief Books found in the journal. */
+    size_t book_count() const { return books_.size(); }
+
+    /**
+     * @brief The book of `prod_id` (trimmed or space-padded) as it stood after every journaled
+     *        message stamped at or before `exchange_time_us` (INFORMATION-TIME, microseconds
+     *        since midnight).
+     * @param events_applied If given, receives the number of journaled events replayed.
+     * @return `std::nullopt` for a product not in the journal or a time before its first message.
+     */
+    std::optional<OrderBookManagement::OrderBook> book_as_of(std::string_view prod_id, uint64_t exchange_time_us,
+                                                             size_t* events_applied = nullptr) const;
+
+private:
+    struct Run {
+        size_t   record;           // First event's index in the journal.
+        uint64_t exchange_time_us;
+        uint32_t events;
+    };
+
+    struct Book {
+        std::string prod_id;       // Space padded, as journaled.
+        uint8_t decimal_locator = 0;
+        std::vector<Run> runs;         // Every message of the book, in journal order.
+        std::vector<uint32_t> images;  // Indexes into `runs` of its checkpoint images.
+    };
+
+    EventJournalReader reader_;
+    std::vector<Book> books_;                                // By the journal's BookHandle.
+    std::unordered_map<std::string, BookHandle> by_prod_id_; // Space-padded PROD-ID.
+};
+
+} // namespace Taifex
+#endif // BOOK_HISTORY_H
@@ -0,0 +1,265 @@
+#include "sdk/channel_gap_manager.h"
+
+#include "logger.h"
+#include "channel_state.h"
+#include "memory_utils.h"
+
+#include <algorithm> // For std::min
+#include <limits>
+
+namespace Taifex {
+
+ChannelGapManager::ChannelGapManager(const GapRecoveryConfig& config)
+    : config_(config), channels_(CoreUtils::ChannelStateTable::CHANNEL_COUNT) {
+    if (config_.reorder_capacity == 0) {
+        config_.reorder_capacity = 1;
+    }
+}
+
+void ChannelGapManager::configure(const GapRecoveryConfig& config) {
+    config_ = config;
+    if (config_.reorder_capacity == 0) {
+        config_.reorder_capacity = 1;
+    }
+}
+
+void ChannelGapManager::set_retransmission_requester(RetransmissionRequester requester) {
+    requester_ = std::move(requester);
+}
+
+ChannelGapManager::ChannelRecovery* ChannelGapManager::find(uint32_t channel_id) const {
+    return channel_id < channels_.size() ? channels_[channel_id].get() : nullptr;
+}
+
+ChannelGapManager::ChannelRecovery& ChannelGapManager::recovery_for(uint32_t channel_id) {
+    // Callers pass CHANNEL-IDs already range-checked against the SDK's channel state table.
+    std::unique_ptr<ChannelRecovery>& entry = channels_[channel_id];
+    if (entry) {
+        return *entry;
+    }
+    entry = std::make_unique<ChannelRecovery>();
+    registered_channels_.push_back(channel_id);
+    ChannelRecovery& rec = *entry;
+    rec.ring.resize(config_.reorder_capacity);
+    for (auto& slot : rec.ring) {
+        slot.bytes.reserve(config_.max_frame_length);
+    }
+    return rec;
+}
+
+void ChannelGapManager::register_channel(uint32_t channel_id) {
+    if (channel_id < channels_.size()) {
+        recovery_for(channel_id);
+    }
+}
+
+void ChannelGapManager::request_range(uint32_t channel_id, ChannelRecovery& rec,
+                                      uint64_t begin_seq, uint64_t end_seq) {
+    if (end_seq < begin_seq) {
+        return;
+    }
+    if (!requester_) {
+        LOG_DEBUG << "No retransmission requester set; Channel " << channel_id
+                  << " range " << begin_seq << "-" << end_seq << " will wait for timeout.";
+        rec.requested_up_to = std::max(rec.requested_up_to, end_seq);
+        return;
+    }
+    // DataRequest101 carries RecoverNum as uint16_t, so large ranges are split.
+    const uint64_t max_count = std::numeric_limits<uint16_t>::max();
+    uint64_t seq = begin_seq;
+    while (seq <= end_seq) {
+        uint64_t count = std::min(max_count, end_seq - seq + 1);
+        LOG_INFO << "Requesting retransmission for Channel " << channel_id
+                 << " Seq " << seq << " Count " << count;
+        requester_(channel_id, seq, static_cast<uint16_t>(count));
+        seq += count;
+    }
+    rec.requested_up_to = std::max(rec.requested_up_to, end_seq);
+}
+
+bool ChannelGapManager::hold(uint32_t channel_id, uint64_t expected_seq, uint64_t seq,
+                             const unsigned char* frame, size_t length, Clock::time_point now) {
+    if (channel_id >= channels_.size()) {
+        return false;
+    }
+    ChannelRecovery& rec = recovery_for(channel_id);
+    const size_t capacity = rec.ring.size();
+
+    // A frame is only reachable if every sequence between expected and it fits in the ring.
+    if (seq - expected_seq >= capacity) {
+        LOG_WARNING << "Channel " << channel_id << " Seq " << seq << " is beyond the reorder window (expected "
+                    << expected_seq << ", capacity " << capacity << ").";
+        return false;
+    }
+
+    Slot& slot = rec.ring[seq % capacity];
+    if (slot.seq == seq) {
+        LOG_DEBUG << "Channel " << channel_id << " Seq " << seq << " already held. Ignoring duplicate.";
+        return true;
+    }
+    if (slot.seq != 0) {
+        // A stale frame from an older window still occupies the slot; it can never be drained.
+        --rec.held_count;
+    }
+    slot.seq = seq;
+    slot.bytes.assign(frame, frame + length);
+    ++rec.held_count;
+
+    if (!rec.gap_open) {
+        rec.gap_open = true;
+        rec.gap_started = now;
+        rec.requested_up_to = expected_seq - 1;
+        LOG_WARNING << "Gap detected in Channel " << channel_id << ". Expected: " << expected_seq
+                    << ", Got: " << seq << ". Holding frames for recovery.";
+    }
+    if (seq > rec.requested_up_to + 1) {
+        request_range(channel_id, rec, std::max(expected_seq, rec.requested_up_to + 1), seq - 1);
+    }
+    if (seq > rec.requested_up_to) {
+        rec.requested_up_to = seq;
+    }
+    return true;
+}
+
+const std::vector<unsigned char>* ChannelGapManager::held_frame(uint32_t channel_id, uint64_t seq) const {
+    const ChannelRecovery* rec = find(channel_id);
+    if (!rec || rec->held_count == 0) {
+        return nullptr;
+    }
+    const Slot& slot = rec->ring[seq % rec->ring.size()];
+    return (slot.seq == seq) ? &slot.bytes : nullptr;
+}
+
+void ChannelGapManager::release(uint32_t channel_id, uint64_t seq) {
+    ChannelRecovery* rec = find(channel_id);
+    if (!rec) {
+        return;
+    }
+    Slot& slot = rec->ring[seq % rec->ring.size()];
+    if (slot.seq == seq) {
+        slot.seq = 0;
+        slot.bytes.clear(); // Keeps capacity.
+        --rec->held_count;
+    }
+}
+
+void ChannelGapManager::on_drained(uint32_t channel_id, uint64_t next_expected_seq, Clock::time_point now) {
+    ChannelRecovery* found = find(channel_id);
+    if (!found || !found->gap_open) {
+        return;
+    }
+    ChannelRecovery& rec = *found;
+    if (rec.held_count == 0) {
+        rec.gap_open = false;
+        LOG_INFO << "Channel " << channel_id << " gap recovered. Resuming at Seq " << next_expected_seq << ".";
+        return;
+    }
+    // Every hole below the highest held frame was requested when that frame was held, so
+    // progress only needs to restart the timeout window for the remaining holes.
+    rec.gap_started = now;
+    LOG_DEBUG << "Channel " << channel_id << " drained to Seq " << (next_expected_seq - 1) << ", "
+              << rec.held_count << " frames still held.";
+}
+
+bool ChannelGapManager::is_recovering(uint32_t channel_id) const {
+    const ChannelRecovery* rec = find(channel_id);
+    return rec && rec->gap_open;
+}
+
+bool ChannelGapManager::has_timed_out(uint32_t channel_id, Clock::time_point now) const {
+    const ChannelRecovery* rec = find(channel_id);
+    if (!rec || !rec->gap_open) {
+        return false;
+    }
+    return now - rec->gap_started >= config_.gap_timeout;
+}
+
+ChannelGapManager::Clock::time_point ChannelGapManager::gap_deadline(uint32_t channel_id) const {
+    const ChannelRecovery* rec = find(channel_id);
+    return rec ? rec->gap_started + config_.gap_timeout : Clock::time_point{};
+}
+
+size_t ChannelGapManager::request_missing(uint32_t channel_id, uint64_t expected_seq) {
+    ChannelRecovery* found = find(channel_id);
+    if (!found || !found->gap_open || !requester_) {
+        return 0;
+    }
+    ChannelRecovery& rec = *found;
+    const size_t capacity = rec.ring.size();
+    const uint64_t highest = rec.requested_up_to;
+    size_t requested = 0;
+    uint64_t seq = expected_seq;
+    while (seq < highest) {
+        if (rec.ring[seq % capacity].seq == seq) {
+            ++seq;
+            continue;
+        }
+        const uint64_t begin = seq;
+        while (seq < highest && rec.ring[seq % capacity].seq != seq) {
+            ++seq;
+        }
+        request_range(channel_id, rec, begin, seq - 1);
+        ++requested;
+    }
+    return requested;
+}
+
+uint64_t ChannelGapManager::lowest_held_seq(uint32_t channel_id) const {
+    const ChannelRecovery* rec = find(channel_id);
+    if (!rec || rec->held_count == 0) {
+        return 0;
+    }
+    uint64_t lowest = 0;
+    for (const auto& slot : rec->ring) {
+        if (slot.seq != 0 && (lowest == 0 || slot.seq < lowest)) {
+            lowest = slot.seq;
+        }
+    }
+    return lowest;
+}
+
+std::vector<uint32_t> ChannelGapManager::recovering_channels() const {
+    std::vector<uint32_t> result;
+    for (uint32_t channel_id : registered_channels_) {
+        if (channels_[channel_id]->gap_open) {
+            result.push_back(channel_id);
+        }
+    }
+    return result;
+}
+
+void ChannelGapManager::reset_channel(uint32_t channel_id) {
+    ChannelRecovery* found = find(channel_id);
+    if (!found) {
+        return;
+    }
+    ChannelRecovery& rec = *found;
+    for (auto& slot : rec.ring) {
+        slot.seq = 0;
+        slot.bytes.clear();
+    }
+    rec.held_count = 0;
+    rec.gap_open = false;
+    rec.requested_up_to = 0;
+}
+
+size_t ChannelGapManager::prefault(bool lock, size_t& out_bytes_locked) {
+    size_t bytes = 0;
+    for (uint32_t channel_id : registered_channels_) {
+        for (Slot& slot : channels_[channel_id]->ring) {
+            if (slot.seq == 0) {
+                slot.bytes.resize(slot.bytes.capacity()); // Within the reserved buffer: no allocation.
+                slot.bytes.clear();
+            }
+            bytes += slot.bytes.capacity();
+            if (lock) {
+                const size_t locked = CoreUtils::lockMemory(slot.bytes.data(), slot.bytes.capacity());
+                lock = locked != 0; // Over the limit: the rest would fail too (and warn each time).
+                out_bytes_locked += locked;
+            }
+        }
+    }
+    return bytes;
+}
+
+} // namespace Taifex
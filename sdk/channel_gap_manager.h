@@ -0,0 +1,163 @@
+#ifndef CHANNEL_GAP_MANAGER_H
+#define CHANNEL_GAP_MANAGER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Taifex {
+
+/**
+ * @brief Tuning parameters for per-channel gap recovery.
+ */
+struct GapRecoveryConfig {
+    /** @brief Number of out-of-sequence frames that can be held per channel while a gap is open. */
+    size_t reorder_capacity = 256;
+    /**
+     * @brief Bytes reserved up front for each held frame. Frames up to this size are stored without
+     *        allocating. The largest I081/I083 frame (99 entries) is 1338 bytes.
+     */
+    size_t max_frame_length = 1536;
+    /**
+     * @brief How long a gap may stay open waiting for retransmitted frames before the SDK gives up
+     *        and falls back to snapshot recovery.
+     */
+    std::chrono::milliseconds gap_timeout{500};
+    /**
+     * @brief While a gap stays open, the holes still missing are requested again this often (a
+     *        lost DataRequest101 or response otherwise waits for `gap_timeout`). 0 requests once.
+     *        Enforced by `TaifexSdk::poll_timers`.
+     */
+    std::chrono::milliseconds retransmission_timeout{0};
+};
+
+/**
+ * @brief Holds out-of-sequence frames per channel while missing CHANNEL-SEQ ranges are recovered.
+ *
+ * When a frame arrives ahead of the expected CHANNEL-SEQ, the SDK parks a copy of it in a
+ * preallocated ring keyed by CHANNEL-SEQ (slot = seq % reorder_capacity) and the manager requests
+ * the missing range through the registered retransmission requester (normally
+ * `NetworkManager::trigger_retransmission_request`, which issues a DataRequest101).
+ * Retransmitted frames fill the holes; the SDK then drains the ring in order.
+ *
+ * The manager does not track the expected sequence itself; it only owns the held frames and
+ * the recovery bookkeeping (requested range, gap start time) for channels with an open gap.
+ * Channels are looked up by CHANNEL-ID in a flat table (0-9999); ids outside that range are
+ * never held. It is not thread-safe; it is driven from `TaifexSdk::process_message`.
+ */
+class ChannelGapManager {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Callback used to request retransmission of `count` frames starting at `begin_seq` on `channel_id`.
+     */
+    using RetransmissionRequester = std::function<void(uint32_t channel_id, uint64_t begin_seq, uint16_t count)>;
+
+    explicit ChannelGapManager(const GapRecoveryConfig& config = GapRecoveryConfig{});
+
+    /** @brief Replaces the configuration. Existing rings keep their size until the channel is reset. */
+    void configure(const GapRecoveryConfig& config);
+    const GapRecoveryConfig& config() const { return config_; }
+
+    /** @brief Sets (or clears, with nullptr) the callback used to request missing ranges. */
+    void set_retransmission_requester(RetransmissionRequester requester);
+
+    /**
+     * @brief Preallocates the reorder ring for a channel. Called when the channel is first seen so
+     *        that no allocation happens when its first gap opens.
+     */
+    void register_channel(uint32_t channel_id);
+
+    /**
+     * @brief Parks an out-of-sequence frame and requests any missing range not yet requested.
+     * @param channel_id Channel the frame belongs to.
+     * @param expected_seq The next CHANNEL-SEQ the SDK is waiting for.
+     * @param seq CHANNEL-SEQ of the frame being held (must be > expected_seq).
+     * @param frame Full raw frame (ESC .. terminal code).
+     * @param length Frame length in bytes.
+     * @param now Current time, used to start the gap timer.
+     * @return True if the frame was stored (or was already held). False if it lies beyond the ring's
+     *         reach, in which case the caller should fall back to snapshot recovery.
+     */
+    bool hold(uint32_t channel_id, uint64_t expected_seq, uint64_t seq,
+              const unsigned char* frame, size_t length, Clock::time_point now);
+
+    /**
+     * @brief Returns the held frame with CHANNEL-SEQ `seq` on `channel_id`, or nullptr if none is held.
+     *        The pointer stays valid until `release` or `reset_channel` is called for that slot.
+     */
+    const std::vector<unsigned char>* held_frame(uint32_t channel_id, uint64_t seq) const;
+
+    /** @brief Frees the slot holding `seq` after the SDK has applied it. */
+    void release(uint32_t channel_id, uint64_t seq);
+
+    /**
+     * @brief Updates recovery bookkeeping after the SDK has drained up to `next_expected_seq - 1`.
+     *        Closes the gap if nothing is held any more; otherwise restarts the timeout window,
+     *        since the remaining holes have already been requested.
+     */
+    void on_drained(uint32_t channel_id, uint64_t next_expected_seq, Clock::time_point now);
+
+    /** @brief True if the channel has an open gap. */
+    bool is_recovering(uint32_t channel_id) const;
+
+    /** @brief True if the channel's open gap has been waiting longer than the configured timeout. */
+    bool has_timed_out(uint32_t channel_id, Clock::time_point now) const;
+
+    /** @brief When the channel's open gap times out; meaningless if it has none. */
+    Clock::time_point gap_deadline(uint32_t channel_id) const;
+
+    /**
+     * @brief Requests again every CHANNEL-SEQ from `expected_seq` up to the highest held frame
+     *        that is still not held, as contiguous ranges.
+     * @return Ranges requested; 0 if the channel has no open gap.
+     */
+    size_t request_missing(uint32_t channel_id, uint64_t expected_seq);
+
+    /** @brief Lowest CHANNEL-SEQ currently held for the channel, or 0 if nothing is held. */
+    uint64_t lowest_held_seq(uint32_t channel_id) const;
+
+    /** @brief Channels with an open gap (used to poll for timeouts). */
+    std::vector<uint32_t> recovering_channels() const;
+
+    /** @brief Drops every held frame and any open gap for the channel (e.g. on I002). */
+    void reset_channel(uint32_t channel_id);
+
+    /**
+     * @brief Writes every empty slot of every registered ring once, so their pages are faulted
+     *        in before the first gap, and `mlock`s the slots when `lock` is set.
+     * @param out_bytes_locked Incremented by the bytes locked.
+     * @return Bytes of ring buffers covered.
+     */
+    size_t prefault(bool lock, size_t& out_bytes_locked);
+
+private:
+    struct Slot {
+        uint64_t seq = 0; // 0 marks an empty slot; CHANNEL-SEQ starts at 1.
+        std::vector<unsigned char> bytes;
+    };
+
+    struct ChannelRecovery {
+        std::vector<Slot> ring;
+        size_t held_count = 0;
+        bool gap_open = false;
+        uint64_t requested_up_to = 0;  // Highest CHANNEL-SEQ already covered by a request.
+        Clock::time_point gap_started{};
+    };
+
+    ChannelRecovery& recovery_for(uint32_t channel_id);
+    ChannelRecovery* find(uint32_t channel_id) const;
+    void request_range(uint32_t channel_id, ChannelRecovery& rec, uint64_t begin_seq, uint64_t end_seq);
+
+    GapRecoveryConfig config_;
+    RetransmissionRequester requester_;
+    std::vector<std::unique_ptr<ChannelRecovery>> channels_; // Indexed by CHANNEL-ID; null until registered.
+    std::vector<uint32_t> registered_channels_;
+};
+
+} // namespace Taifex
+#endif // CHANNEL_GAP_MANAGER_H
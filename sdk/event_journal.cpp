@@ -0,0 +1,306 @@
+#include "sdk/event_journal.h"
+
+#include "logger.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cerrno>
+#include <cstddef>   // For offsetof
+#include <cstring>   // For std::memcpy, std::strerror
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Taifex {
+
+namespace {
+
+constexpr char JOURNAL_MAGIC[8] = {'T', 'X', 'E', 'V', 'J', 'N', 'L', '1'};
+constexpr uint32_t JOURNAL_VERSION = 1;
+constexpr size_t RECORD_SIZE = sizeof(CoreUtils::NormalizedEvent);
+constexpr size_t RECORD_TYPE_OFFSET = offsetof(CoreUtils::NormalizedEvent, type);
+
+struct alignas(64) JournalFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint8_t  reserved[48];
+};
+
+static_assert(sizeof(JournalFileHeader) == RECORD_SIZE, "The header is one record long.");
+static_assert(sizeof(JournalProductRecord) == RECORD_SIZE && sizeof(JournalBookRecord) == RECORD_SIZE &&
+                  sizeof(JournalCheckpointRecord) == RECORD_SIZE, "Journal records are 64 bytes.");
+static_assert(offsetof(JournalProductRecord, record_type) == RECORD_TYPE_OFFSET &&
+                  offsetof(JournalBookRecord, record_type) == RECORD_TYPE_OFFSET &&
+                  offsetof(JournalCheckpointRecord, record_type) == RECORD_TYPE_OFFSET,
+              "Record kinds share the byte of NormalizedEvent::type.");
+
+bool write_all(int fd, const void* data, size_t length) {
+    const char* pos = static_cast<const char*>(data);
+    while (length > 0) {
+        const ssize_t written = ::write(fd, pos, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        pos += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+// --- EventJournalWriter ---
+
+EventJournalWriter::~EventJournalWriter() {
+    close();
+}
+
+bool EventJournalWriter::open(const std::string& path, size_t buffer_bytes) {
+    close();
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        LOG_ERROR << "EventJournalWriter: cannot open " << path << ": " << std::strerror(errno);
+        return false;
+    }
+    JournalFileHeader header = {};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.record_size = RECORD_SIZE;
+    if (!write_all(fd_, &header, sizeof(header))) {
+        LOG_ERROR << "EventJournalWriter: cannot write " << path << ": " << std::strerror(errno);
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    buffer_capacity_ = std::max<size_t>(1, buffer_bytes / RECORD_SIZE);
+    buffer_ = std::make_unique<CoreUtils::NormalizedEvent[]>(buffer_capacity_);
+    buffered_ = 0;
+    event_count_ = 0;
+    failed_ = false;
+    return true;
+}
+
+void EventJournalWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+    buffer_.reset();
+    buffer_capacity_ = 0;
+}
+
+bool EventJournalWriter::flush() {
+    if (fd_ < 0 || buffered_ == 0) {
+        return !failed_;
+    }
+    if (!failed_ && !write_all(fd_, buffer_.get(), buffered_ * RECORD_SIZE)) {
+        LOG_ERROR << "EventJournalWriter: write failed: " << std::strerror(errno) << "; journal truncated.";
+        failed_ = true;
+    }
+    buffered_ = 0;
+    return !failed_;
+}
+
+void EventJournalWriter::append_record(const void* record) {
+    if (buffered_ == buffer_capacity_) {
+        flush();
+    }
+    std::memcpy(&buffer_[buffered_++], record, RECORD_SIZE);
+}
+
+void EventJournalWriter::add_product(ProductHandle product, const ProductInfo& info) {
+    if (fd_ < 0) {
+        return;
+    }
+    JournalProductRecord record = {};
+    record.info = info;
+    record.product = product;
+    record.record_type = static_cast<uint8_t>(JournalRecordType::PRODUCT);
+    append_record(&record);
+}
+
+void EventJournalWriter::add_book(BookHandle book, std::string_view prod_id, ProductHandle product, uint8_t decimal_locator) {
+    if (fd_ < 0) {
+        return;
+    }
+    JournalBookRecord record = {};
+    std::memset(record.prod_id, ' ', sizeof(record.prod_id));
+    std::memcpy(record.prod_id, prod_id.data(), std::min(prod_id.size(), sizeof(record.prod_id)));
+    record.book = book;
+    record.product = product;
+    record.decimal_locator = decimal_locator;
+    record.record_type = static_cast<uint8_t>(JournalRecordType::BOOK);
+    append_record(&record);
+}
+
+void EventJournalWriter::begin_checkpoint(uint64_t exchange_time_us, uint32_t book_count) {
+    if (fd_ < 0) {
+        return;
+    }
+    JournalCheckpointRecord record = {};
+    record.exchange_time_us = exchange_time_us;
+    record.event_index = event_count_;
+    record.book_count = book_count;
+    record.record_type = static_cast<uint8_t>(JournalRecordType::CHECKPOINT);
+    append_record(&record);
+}
+
+void EventJournalWriter::begin_book_checkpoint(uint64_t exchange_time_us, BookHandle book) {
+    if (fd_ < 0) {
+        return;
+    }
+    JournalCheckpointRecord record = {};
+    record.exchange_time_us = exchange_time_us;
+    record.event_index = event_count_;
+    record.book_count = 1;
+    record.book = book;
+    record.single_book = 1;
+    record.record_type = static_cast<uint8_t>(JournalRecordType::CHECKPOINT);
+    append_record(&record);
+}
+
+void EventJournalWriter::append(std::span<const CoreUtils::NormalizedEvent> events) {
+    if (fd_ < 0) {
+        return;
+    }
+    // Copy straight into the buffer in as few pieces as it takes.
+    while (!events.empty()) {
+        if (buffered_ == buffer_capacity_) {
+            flush();
+        }
+        const size_t count = std::min(events.size(), buffer_capacity_ - buffered_);
+        std::memcpy(&buffer_[buffered_], events.data(), count * RECORD_SIZE);
+        buffered_ += count;
+        for (size_t i = 0; i < count; ++i) {
+            if (!(events[i].flags & CoreUtils::NormalizedEvent::FLAG_CHECKPOINT)) {
+                ++event_count_;
+            }
+        }
+        events = events.subspan(count);
+    }
+}
+
+// --- EventJournalReader ---
+
+EventJournalReader::~EventJournalReader() {
+    close();
+}
+
+bool EventJournalReader::open(const std::string& path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_ERROR << "EventJournalReader: cannot open " << path << ": " << std::strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(JournalFileHeader)) {
+        LOG_ERROR << "EventJournalReader: " << path << " is not a journal.";
+        ::close(fd);
+        return false;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR << "EventJournalReader: mmap failed: " << std::strerror(errno);
+        return false;
+    }
+    const auto* header = static_cast<const JournalFileHeader*>(mapping);
+    if (std::memcmp(header->magic, JOURNAL_MAGIC, sizeof(header->magic)) != 0 || header->version != JOURNAL_VERSION ||
+        header->record_size != RECORD_SIZE) {
+        LOG_ERROR << "EventJournalReader: " << path << " is not a version " << JOURNAL_VERSION << " journal.";
+        munmap(mapping, size);
+        return false;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    mapping_ = mapping;
+    mapping_size_ = size;
+    records_ = reinterpret_cast<const CoreUtils::NormalizedEvent*>(static_cast<const char*>(mapping) + RECORD_SIZE);
+    record_count_ = (size - RECORD_SIZE) / RECORD_SIZE; // A torn last record is ignored.
+    return true;
+}
+
+void EventJournalReader::close() {
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    records_ = nullptr;
+    record_count_ = 0;
+}
+
+JournalRecordType EventJournalReader::record_type(size_t index) const {
+    const uint8_t type = reinterpret_cast<const uint8_t*>(&records_[index])[RECORD_TYPE_OFFSET];
+    return type < 0x80 ? JournalRecordType::EVENT : static_cast<JournalRecordType>(type);
+}
+
+const JournalProductRecord& EventJournalReader::product(size_t index) const {
+    return *reinterpret_cast<const JournalProductRecord*>(&records_[index]);
+}
+
+const JournalBookRecord& EventJournalReader::book(size_t index) const {
+    return *reinterpret_cast<const JournalBookRecord*>(&records_[index]);
+}
+
+const JournalCheckpointRecord& EventJournalReader::checkpoint(size_t index) const {
+    return *reinterpret_cast<const JournalCheckpointRecord*>(&records_[index]);
+}
+
+size_t EventJournalReader::find_checkpoint(uint64_t exchange_time_us) const {
+    size_t found = NPOS;
+    for (size_t i = 0; i < record_count_; ++i) {
+        if (record_type(i) == JournalRecordType::CHECKPOINT && !checkpoint(i).single_book &&
+            checkpoint(i).exchange_time_us <= exchange_time_us) {
+            found = i;
+        }
+    }
+    return found;
+}
+
+size_t EventJournalReader::run_end(size_t index, size_t max_events) const {
+    const BookHandle book = records_[index].book;
+    size_t end = index + 1;
+    while (end < record_count_ && end - index < max_events &&
+           !(records_[end - 1].flags & CoreUtils::NormalizedEvent::FLAG_END_OF_MESSAGE) &&
+           record_type(end) == JournalRecordType::EVENT && records_[end].book == book) {
+        ++end;
+    }
+    return end;
+}
+
+JournalRunResult apply_journal_run(OrderBookManagement::OrderBook& order_book,
+                                   std::span<const CoreUtils::NormalizedEvent> events) {
+    const CoreUtils::NormalizedEvent& first = events.front();
+    switch (first.type) {
+        case CoreUtils::EventType::BOOK_CLEAR:
+            if (first.flags & CoreUtils::NormalizedEvent::FLAG_RESET) {
+                order_book.reset();
+                return JournalRunResult::RESET;
+            }
+            if (!order_book.apply_snapshot(first.prod_msg_seq, events)) {
+                return JournalRunResult::IGNORED;
+            }
+            if (events.back().type == CoreUtils::EventType::BOOK_STALE) {
+                order_book.mark_stale(); // A checkpointed stale book.
+            }
+            return JournalRunResult::SNAPSHOT;
+        case CoreUtils::EventType::BOOK_STALE:
+            order_book.mark_stale();
+            return JournalRunResult::STALE;
+        default:
+            return order_book.apply_update(first.prod_msg_seq, events) == OrderBookManagement::UpdateResult::APPLIED
+                       ? JournalRunResult::UPDATE
+                       : JournalRunResult::IGNORED;
+    }
+}
+
+} // namespace Taifex
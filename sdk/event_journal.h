@@ -0,0 +1,195 @@
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "normalized_event.h"
+#include "order_book/order_book.h"
+#include "sdk/product_registry.h"
+
+namespace Taifex {
+
+/** @brief Settings for `TaifexSdk::journal_events`. */
+struct EventJournalConfig {
+    /** @brief Journal file; truncated if it exists. */
+    std::string path;
+    /**
+     * @brief INFORMATION-TIME between book checkpoints, in microseconds. A replay can start at any
+     *        checkpoint instead of the beginning of the file. 0 writes only the opening checkpoint.
+     */
+    uint64_t checkpoint_interval_us = 60ull * 1000 * 1000;
+    /**
+     * @brief After this many events of one book since its last image, that book's image is also
+     *        journaled on its own, so an as-of query (`BookHistory`) on an active book replays a
+     *        bounded number of events. 0 writes only the periodic checkpoints.
+     */
+    uint32_t book_checkpoint_events = 4096;
+    /** @brief Records are written in blocks of this size; each block is one write(2). */
+    size_t buffer_bytes = 1 << 20;
+};
+
+/**
+ * @brief Kind of a 64-byte journal record. Records that are not events carry their kind in the
+ *        byte where a `NormalizedEvent` has its `type`; event types stay below 0x80.
+ */
+enum class JournalRecordType : uint8_t {
+    EVENT = 0,
+    CHECKPOINT = 0xFC, ///< `JournalCheckpointRecord`, followed by each book's image as events.
+    PRODUCT = 0xFD,    ///< `JournalProductRecord`
+    BOOK = 0xFE        ///< `JournalBookRecord`
+};
+
+/** @brief Journal record: reference data of a product, written before any book uses it. */
+struct alignas(64) JournalProductRecord {
+    ProductInfo   info;
+    ProductHandle product;
+    uint8_t       reserved0[46 - sizeof(ProductInfo) - sizeof(ProductHandle)];
+    uint8_t       record_type;
+    uint8_t       reserved1[17];
+};
+
+/** @brief Journal record: identity of a book, written before its first event. */
+struct alignas(64) JournalBookRecord {
+    char          prod_id[20];
+    BookHandle    book;
+    ProductHandle product;
+    uint8_t       decimal_locator;
+    uint8_t       reserved0[17];
+    uint8_t       record_type;
+    uint8_t       reserved1[17];
+};
+
+/**
+ * @brief Journal record: start of a checkpoint. The image of every book follows as events
+ *        flagged `NormalizedEvent::FLAG_CHECKPOINT`: a BOOK_CLEAR carrying the book's PROD-MSG-SEQ,
+ *        its levels as SNAPSHOT_LEVELs, and BOOK_STALE if it was stale. A single-book checkpoint
+ *        is followed by the image of `book` only; a replay can not start from one.
+ */
+struct alignas(64) JournalCheckpointRecord {
+    uint64_t   exchange_time_us; ///< INFORMATION-TIME of the event that triggered it.
+    uint64_t   event_index;      ///< Feed events journaled before it.
+    uint32_t   book_count;
+    BookHandle book;             ///< The book of a single-book checkpoint.
+    uint8_t    single_book;      ///< 1: only `book`'s image follows.
+    uint8_t    reserved0[21];
+    uint8_t    record_type;
+    uint8_t    reserved1[17];
+};
+
+/**
+ * @brief Appends normalized events to a journal file, with the reference data needed to replay
+ *        them and periodic book checkpoints. Single writer: the thread calling
+ *        `TaifexSdk::process_message`.
+ *
+ * The file is a 64-byte header followed by 64-byte records, so it can be mapped and walked with
+ * a fixed stride. Records are buffered and written a block at a time; `flush` forces a write.
+ */
+class EventJournalWriter {
+public:
+    /** @brief Levels per side a checkpoint keeps, so that one book's image fits an event batch. */
+    static constexpr size_t CHECKPOINT_DEPTH = 48;
+
+    EventJournalWriter() = default;
+    ~EventJournalWriter();
+
+    EventJournalWriter(const EventJournalWriter&) = delete;
+    EventJournalWriter& operator=(const EventJournalWriter&) = delete;
+
+    /** @return False if the file could not be created. */
+    bool open(const std::string& path, size_t buffer_bytes);
+    /** @brief Writes what is buffered and closes the file. */
+    void close();
+    bool is_open() const { return fd_ >= 0; }
+
+    void add_product(ProductHandle product, const ProductInfo& info);
+    void add_book(BookHandle book, std::string_view prod_id, ProductHandle product, uint8_t decimal_locator);
+    void begin_checkpoint(uint64_t exchange_time_us, uint32_t book_count);
+    void begin_book_checkpoint(uint64_t exchange_time_us, BookHandle book);
+    void append(std::span<const CoreUtils::NormalizedEvent> events);
+    /** @brief Writes buffered records to the file. */
+    bool flush();
+
+    /** @brief Feed events appended since `open` (checkpoint images excluded). */
+    uint64_t event_count() const { return event_count_; }
+    /** @brief True once a write failed; later records are dropped. */
+    bool failed() const { return failed_; }
+
+private:
+    void append_record(const void* record);
+
+    int fd_ = -1;
+    std::unique_ptr<CoreUtils::NormalizedEvent[]> buffer_; // 64-byte records.
+    size_t buffer_capacity_ = 0;                           // Records.
+    size_t buffered_ = 0;
+    uint64_t event_count_ = 0;
+    bool failed_ = false;
+};
+
+/**
+ * @brief Read-only view of a journal file, mapped into memory. Records are addressed by index.
+ */
+class EventJournalReader {
+public:
+    static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+
+    EventJournalReader() = default;
+    ~EventJournalReader();
+
+    EventJournalReader(const EventJournalReader&) = delete;
+    EventJournalReader& operator=(const EventJournalReader&) = delete;
+
+    /** @return False if the file is missing or not a journal. */
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return records_ != nullptr; }
+
+    /** @brief Complete records in the file. */
+    size_t record_count() const { return record_count_; }
+    JournalRecordType record_type(size_t index) const;
+
+    const CoreUtils::NormalizedEvent& event(size_t index) const { return records_[index]; }
+    const JournalProductRecord& product(size_t index) const;
+    const JournalBookRecord& book(size_t index) const;
+    const JournalCheckpointRecord& checkpoint(size_t index) const;
+
+    /** @return Index of the last full checkpoint at or before `exchange_time_us`, or `NPOS`. */
+    size_t find_checkpoint(uint64_t exchange_time_us) const;
+
+    /**
+     * @brief End of the run of events starting at `index`: one journaled message for one book, up
+     *        to its FLAG_END_OF_MESSAGE or where an I002's clears move on to the next book, and at
+     *        most `max_events` long.
+     */
+    size_t run_end(size_t index, size_t max_events) const;
+
+private:
+    const CoreUtils::NormalizedEvent* records_ = nullptr; // Past the header; null while closed.
+    size_t record_count_ = 0;
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+};
+
+/** @brief What `apply_journal_run` did to the book. */
+enum class JournalRunResult {
+    IGNORED,  ///< Outdated snapshot, or an update the book did not apply.
+    SNAPSHOT, ///< Rebuilt from an I083 or a checkpoint image.
+    UPDATE,   ///< I081 applied.
+    STALE,    ///< Marked stale.
+    RESET     ///< Cleared by an I002.
+};
+
+/**
+ * @brief Applies one run of journaled events (see `EventJournalReader::run_end`) to a book, as
+ *        the live feed applied them.
+ */
+JournalRunResult apply_journal_run(OrderBookManagement::OrderBook& order_book,
+                                   std::span<const CoreUtils::NormalizedEvent> events);
+
+} // namespace Taifex
+#endif // EVENT_JOURNAL_H
@@ -0,0 +1,242 @@
+#include "sdk/fanout_protocol.h"
+
+#include <algorithm> // For std::min
+#include <utility>   // For std::move
+
+namespace Taifex {
+
+namespace {
+
+void append_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void append_signed(std::vector<uint8_t>& out, int64_t value) {
+    append_varint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); // Zigzag.
+}
+
+bool read_varint(const uint8_t*& pos, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && pos < end; shift += 7) {
+        const uint8_t byte = *pos++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool read_signed(const uint8_t*& pos, const uint8_t* end, int64_t& value) {
+    uint64_t zigzag;
+    if (!read_varint(pos, end, zigzag)) {
+        return false;
+    }
+    value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    return true;
+}
+
+// Reserves the length prefix of a frame; `finish_frame` fills it in.
+size_t begin_frame(std::vector<uint8_t>& out, FanoutFrameType type) {
+    const size_t start = out.size();
+    out.push_back(0);
+    out.push_back(0);
+    out.push_back(static_cast<uint8_t>(type));
+    return start;
+}
+
+void finish_frame(std::vector<uint8_t>& out, size_t start) {
+    const size_t length = out.size() - start - 2;
+    out[start] = static_cast<uint8_t>(length);
+    out[start + 1] = static_cast<uint8_t>(length >> 8);
+}
+
+void append_levels(std::vector<uint8_t>& out, const FanoutLevel* levels, size_t count, int64_t reference) {
+    for (size_t i = 0; i < count; ++i) {
+        append_signed(out, levels[i].price - reference);
+        append_varint(out, levels[i].quantity);
+        reference = levels[i].price;
+    }
+}
+
+bool read_levels(const uint8_t*& pos, const uint8_t* end, FanoutLevel* levels, size_t count, int64_t reference) {
+    for (size_t i = 0; i < count; ++i) {
+        int64_t delta;
+        if (!read_signed(pos, end, delta) || !read_varint(pos, end, levels[i].quantity)) {
+            return false;
+        }
+        levels[i].price = reference + delta;
+        reference = levels[i].price;
+    }
+    return true;
+}
+
+} // namespace
+
+void append_fanout_hello(std::vector<uint8_t>& out, uint8_t depth) {
+    const size_t start = begin_frame(out, FanoutFrameType::HELLO);
+    out.push_back(FANOUT_PROTOCOL_VERSION);
+    out.push_back(depth);
+    finish_frame(out, start);
+}
+
+void append_fanout_definition(std::vector<uint8_t>& out, uint32_t book, uint8_t decimal_locator, std::string_view prod_id) {
+    const size_t end = prod_id.find_last_not_of(' ');
+    prod_id = end == std::string_view::npos ? std::string_view() : prod_id.substr(0, std::min<size_t>(end + 1, 255));
+    const size_t start = begin_frame(out, FanoutFrameType::DEFINITION);
+    append_varint(out, book);
+    out.push_back(decimal_locator);
+    out.push_back(static_cast<uint8_t>(prod_id.size()));
+    out.insert(out.end(), prod_id.begin(), prod_id.end());
+    finish_frame(out, start);
+}
+
+void append_fanout_book(std::vector<uint8_t>& out, const FanoutBookUpdate& update) {
+    const uint8_t bid_count = std::min<uint8_t>(update.bid_count, FanoutBookUpdate::MAX_LEVELS);
+    const uint8_t ask_count = std::min<uint8_t>(update.ask_count, FanoutBookUpdate::MAX_LEVELS);
+    const size_t start = begin_frame(out, FanoutFrameType::BOOK);
+    append_varint(out, update.book);
+    append_varint(out, update.prod_msg_seq);
+    out.push_back(update.flags);
+    out.push_back(bid_count);
+    out.push_back(ask_count);
+    append_levels(out, update.bids, bid_count, 0);
+    append_levels(out, update.asks, ask_count, bid_count ? update.bids[0].price : 0);
+    if (update.flags & FanoutBookUpdate::FLAG_DERIVED_BID) {
+        append_levels(out, &update.derived_bid, 1, 0);
+    }
+    if (update.flags & FanoutBookUpdate::FLAG_DERIVED_ASK) {
+        append_levels(out, &update.derived_ask, 1, 0);
+    }
+    finish_frame(out, start);
+}
+
+FanoutDecoder::FanoutDecoder(HelloHandler hello_handler, DefinitionHandler definition_handler, BookHandler book_handler)
+    : hello_handler_(std::move(hello_handler)),
+      definition_handler_(std::move(definition_handler)),
+      book_handler_(std::move(book_handler)) {
+    pending_.reserve(FANOUT_MAX_FRAME_SIZE);
+}
+
+void FanoutDecoder::reset() {
+    pending_.clear();
+    frames_ = 0;
+}
+
+bool FanoutDecoder::feed(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return true;
+    }
+    // Complete the frame left over from the previous call first.
+    if (!pending_.empty()) {
+        if (pending_.size() < 2) {
+            pending_.push_back(*data++); // Second byte of the length.
+            --length;
+            if (length == 0) {
+                return true;
+            }
+        }
+        const size_t wanted = 2 + (pending_[0] | (pending_[1] << 8));
+        const size_t take = std::min(wanted - pending_.size(), length);
+        pending_.insert(pending_.end(), data, data + take);
+        data += take;
+        length -= take;
+        if (pending_.size() < wanted) {
+            return true; // Still incomplete; all input consumed.
+        }
+        if (!decode_frame(pending_.data() + 2, wanted - 2)) {
+            return false;
+        }
+        pending_.clear();
+    }
+
+    // Then decode straight from the caller's buffer.
+    while (length >= 2) {
+        const size_t frame_length = data[0] | (data[1] << 8);
+        if (length < 2 + frame_length) {
+            break;
+        }
+        if (!decode_frame(data + 2, frame_length)) {
+            return false;
+        }
+        data += 2 + frame_length;
+        length -= 2 + frame_length;
+    }
+    pending_.insert(pending_.end(), data, data + length);
+    return true;
+}
+
+bool FanoutDecoder::decode_frame(const uint8_t* payload, size_t length) {
+    if (length == 0) {
+        return false;
+    }
+    const uint8_t* pos = payload + 1;
+    const uint8_t* end = payload + length;
+    switch (static_cast<FanoutFrameType>(payload[0])) {
+        case FanoutFrameType::HELLO: {
+            if (length != 3) {
+                return false;
+            }
+            if (hello_handler_) {
+                hello_handler_(pos[0], pos[1]);
+            }
+            break;
+        }
+        case FanoutFrameType::DEFINITION: {
+            uint64_t book;
+            if (!read_varint(pos, end, book) || end - pos < 2 || end - pos != 2 + pos[1]) {
+                return false;
+            }
+            FanoutBookDefinition definition;
+            definition.book = static_cast<uint32_t>(book);
+            definition.decimal_locator = pos[0];
+            definition.prod_id = std::string_view(reinterpret_cast<const char*>(pos + 2), pos[1]);
+            if (definition_handler_) {
+                definition_handler_(definition);
+            }
+            break;
+        }
+        case FanoutFrameType::BOOK: {
+            FanoutBookUpdate update;
+            uint64_t book;
+            uint64_t prod_msg_seq;
+            if (!read_varint(pos, end, book) || !read_varint(pos, end, prod_msg_seq) || end - pos < 3) {
+                return false;
+            }
+            update.book = static_cast<uint32_t>(book);
+            update.prod_msg_seq = static_cast<uint32_t>(prod_msg_seq);
+            update.flags = pos[0];
+            update.bid_count = pos[1];
+            update.ask_count = pos[2];
+            pos += 3;
+            if (update.bid_count > FanoutBookUpdate::MAX_LEVELS || update.ask_count > FanoutBookUpdate::MAX_LEVELS ||
+                !read_levels(pos, end, update.bids, update.bid_count, 0) ||
+                !read_levels(pos, end, update.asks, update.ask_count, update.bid_count ? update.bids[0].price : 0)) {
+                return false;
+            }
+            if ((update.flags & FanoutBookUpdate::FLAG_DERIVED_BID) && !read_levels(pos, end, &update.derived_bid, 1, 0)) {
+                return false;
+            }
+            if ((update.flags & FanoutBookUpdate::FLAG_DERIVED_ASK) && !read_levels(pos, end, &update.derived_ask, 1, 0)) {
+                return false;
+            }
+            if (pos != end) {
+                return false;
+            }
+            if (book_handler_) {
+                book_handler_(update);
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    ++frames_;
+    return true;
+}
+
+} // namespace Taifex
@@ -0,0 +1,119 @@
+#ifndef FANOUT_PROTOCOL_H
+#define FANOUT_PROTOCOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace Taifex {
+
+/**
+ * Wire format of `UdsFanoutServer`, a byte stream of frames:
+ *
+ *   uint16 length (little endian, bytes that follow) | uint8 type | payload
+ *
+ *   HELLO       version u8, depth u8                         First frame on every connection.
+ *   DEFINITION  book varint, decimal_locator u8,             Sent before the first update of a
+ *               prod_id length u8, prod_id bytes               book, and for every book on connect.
+ *   BOOK        book varint, prod_msg_seq varint, flags u8,  Top N levels of a book after a change.
+ *               bid_count u8, ask_count u8, levels...
+ *
+ * Each BOOK frame is a complete image, so any number of them can be dropped in favour of a later
+ * one (conflation) without breaking the stream. Level prices are zigzag varints relative to the
+ * previous level on the same side; the first bid is relative to 0 and the first ask relative to
+ * the first bid (or 0 without bids). Quantities are varints. Derived levels follow when flagged,
+ * each relative to 0.
+ */
+enum class FanoutFrameType : uint8_t {
+    HELLO = 1,
+    DEFINITION = 2,
+    BOOK = 3
+};
+
+inline constexpr uint8_t FANOUT_PROTOCOL_VERSION = 1;
+
+/** @brief Largest BOOK frame: header fields plus 10 levels per side and both derived levels at 20 bytes each. */
+inline constexpr size_t FANOUT_MAX_FRAME_SIZE = 2 + 1 + 5 + 5 + 3 + 22 * 20;
+
+struct FanoutLevel {
+    int64_t  price;
+    uint64_t quantity;
+};
+
+/** @brief Decoded BOOK frame. */
+struct FanoutBookUpdate {
+    static constexpr size_t MAX_LEVELS = 10;
+
+    static constexpr uint8_t FLAG_STALE = 0x01;       ///< PROD-MSG-SEQ gap: unreliable until the next snapshot.
+    static constexpr uint8_t FLAG_CONFLATED = 0x02;   ///< Earlier updates of this book were skipped for this client.
+    static constexpr uint8_t FLAG_DERIVED_BID = 0x04;
+    static constexpr uint8_t FLAG_DERIVED_ASK = 0x08;
+
+    uint32_t book = 0;
+    uint32_t prod_msg_seq = 0;
+    uint8_t  flags = 0;
+    uint8_t  bid_count = 0;
+    uint8_t  ask_count = 0;
+    FanoutLevel bids[MAX_LEVELS] = {};
+    FanoutLevel asks[MAX_LEVELS] = {};
+    FanoutLevel derived_bid = {};
+    FanoutLevel derived_ask = {};
+
+    bool stale() const { return flags & FLAG_STALE; }
+    bool conflated() const { return flags & FLAG_CONFLATED; }
+};
+
+/** @brief Decoded DEFINITION frame. `prod_id` points into the decoder's buffer. */
+struct FanoutBookDefinition {
+    uint32_t book = 0;
+    uint8_t  decimal_locator = 0;
+    std::string_view prod_id; // Without trailing spaces.
+};
+
+/** @brief Appends a HELLO frame. */
+void append_fanout_hello(std::vector<uint8_t>& out, uint8_t depth);
+
+/** @brief Appends a DEFINITION frame; `prod_id` is sent without trailing spaces. */
+void append_fanout_definition(std::vector<uint8_t>& out, uint32_t book, uint8_t decimal_locator, std::string_view prod_id);
+
+/** @brief Appends a BOOK frame; at most `MAX_LEVELS` levels per side are encoded. */
+void append_fanout_book(std::vector<uint8_t>& out, const FanoutBookUpdate& update);
+
+/**
+ * @brief Incremental decoder of the fan-out stream. Bytes may be fed in any split; complete frames
+ *        are delivered to the handlers in order.
+ */
+class FanoutDecoder {
+public:
+    using HelloHandler = std::function<void(uint8_t version, uint8_t depth)>;
+    using DefinitionHandler = std::function<void(const FanoutBookDefinition& definition)>;
+    using BookHandler = std::function<void(const FanoutBookUpdate& update)>;
+
+    FanoutDecoder(HelloHandler hello_handler, DefinitionHandler definition_handler, BookHandler book_handler);
+
+    /**
+     * @brief Decodes every complete frame in the buffered bytes plus `data`.
+     * @return False if a malformed frame was found; the decoder must then be `reset()`.
+     */
+    bool feed(const uint8_t* data, size_t length);
+
+    /** @brief Drops buffered bytes, e.g. after reconnecting. */
+    void reset();
+
+    /** @brief Frames decoded since construction or the last reset. */
+    uint64_t frame_count() const { return frames_; }
+
+private:
+    bool decode_frame(const uint8_t* payload, size_t length);
+
+    HelloHandler hello_handler_;
+    DefinitionHandler definition_handler_;
+    BookHandler book_handler_;
+    std::vector<uint8_t> pending_; // Start of an incomplete frame.
+    uint64_t frames_ = 0;
+};
+
+} // namespace Taifex
+#endif // FANOUT_PROTOCOL_H
@@ -0,0 +1,177 @@
+#include "sdk/liveness_monitor.h"
+
+#include "logger.h"
+#include "channel_state.h"
+#include "metrics.h"
+
+namespace Taifex {
+
+uint64_t LivenessMonitor::floor_tick(Clock::time_point t) {
+    const auto ticks = std::chrono::floor<std::chrono::milliseconds>(t.time_since_epoch()).count();
+    return ticks < 0 ? 0 : static_cast<uint64_t>(ticks);
+}
+
+uint64_t LivenessMonitor::ceil_tick(Clock::time_point t) {
+    const auto ticks = std::chrono::ceil<std::chrono::milliseconds>(t.time_since_epoch()).count();
+    return ticks < 0 ? 0 : static_cast<uint64_t>(ticks);
+}
+
+void LivenessMonitor::configure(const LivenessConfig& config) {
+    config_ = config;
+    if (config_.channel_timeout.count() <= 0) {
+        for (const auto& timers : channels_) {
+            if (timers) {
+                wheel_.cancel(timers->stale);
+                timers->stale_reported = false;
+            }
+        }
+    }
+    if (!products_enabled()) {
+        for (BookTimer& timer : books_) {
+            wheel_.cancel(timer.stale);
+        }
+        books_.clear();
+    }
+}
+
+void LivenessMonitor::reset(Clock::time_point now) {
+    wheel_.reset(floor_tick(now));
+    for (const auto& timers : channels_) {
+        if (timers) {
+            timers->stale_reported = false;
+            timers->last_message = now;
+        }
+    }
+    for (BookTimer& timer : books_) {
+        timer.stale_reported = false;
+        timer.last_message = now;
+    }
+}
+
+void LivenessMonitor::register_channel(uint32_t channel_id) {
+    if (channel_id >= CoreUtils::ChannelStateTable::CHANNEL_COUNT) {
+        return;
+    }
+    if (channels_.empty()) {
+        channels_.resize(CoreUtils::ChannelStateTable::CHANNEL_COUNT);
+    }
+    if (channels_[channel_id]) {
+        return;
+    }
+    auto timers = std::make_unique<ChannelTimers>();
+    timers->stale.kind = CHANNEL_STALE;
+    timers->gap.kind = GAP;
+    timers->retransmission.kind = RETRANSMISSION;
+    for (WheelTimer* timer : {&timers->stale, &timers->gap, &timers->retransmission}) {
+        timer->key = channel_id;
+    }
+    channels_[channel_id] = std::move(timers);
+}
+
+void LivenessMonitor::add_book(BookHandle book, uint32_t channel_id, Clock::time_point now) {
+    while (books_.size() <= book) {
+        BookTimer& timer = books_.emplace_back();
+        timer.stale.kind = PRODUCT_STALE;
+        timer.stale.key = static_cast<uint32_t>(books_.size() - 1);
+    }
+    BookTimer& timer = books_[book];
+    if (!timer.stale.armed() && !timer.stale_reported) {
+        timer.last_message = now;
+        timer.channel_id = channel_id;
+        book_active(book, timer);
+    }
+}
+
+void LivenessMonitor::arm(ChannelTimer timer, uint32_t channel_id, Clock::time_point deadline) {
+    if (channel_id >= channels_.size() || !channels_[channel_id]) {
+        return;
+    }
+    WheelTimer& wheel_timer = timer == ChannelTimer::GAP ? channels_[channel_id]->gap : channels_[channel_id]->retransmission;
+    if (!wheel_timer.armed()) {
+        wheel_.schedule(wheel_timer, ceil_tick(deadline));
+    }
+}
+
+void LivenessMonitor::channel_active(uint32_t channel_id, ChannelTimers& timers) {
+    if (timers.stale_reported) {
+        timers.stale_reported = false;
+        LOG_INFO << "Channel " << channel_id << " resumed.";
+        emit(LivenessEventType::CHANNEL_RESUMED, channel_id, INVALID_BOOK_HANDLE, timers.last_message);
+    }
+    if (config_.channel_timeout.count() > 0 && !timers.stale.armed()) {
+        wheel_.schedule(timers.stale, ceil_tick(timers.last_message + config_.channel_timeout));
+    }
+}
+
+void LivenessMonitor::book_active(BookHandle book, BookTimer& timer) {
+    if (timer.stale_reported) {
+        timer.stale_reported = false;
+        emit(LivenessEventType::PRODUCT_RESUMED, timer.channel_id, book, timer.last_message);
+    }
+    if (products_enabled() && !timer.stale.armed()) {
+        wheel_.schedule(timer.stale, ceil_tick(timer.last_message + config_.product_timeout));
+    }
+}
+
+size_t LivenessMonitor::fire_due(uint64_t tick, Clock::time_point now) {
+    return wheel_.advance(tick, [this, now](WheelTimer& timer) { fire(timer, now); });
+}
+
+void LivenessMonitor::fire(WheelTimer& timer, Clock::time_point now) {
+    switch (timer.kind) {
+        case CHANNEL_STALE: {
+            ChannelTimers& timers = *channels_[timer.key];
+            const Clock::time_point deadline = timers.last_message + config_.channel_timeout;
+            if (now < deadline) {
+                wheel_.schedule(timer, ceil_tick(deadline)); // Frames arrived since it was armed.
+                return;
+            }
+            timers.stale_reported = true;
+            CoreUtils::incrementMetric(CoreUtils::Metric::STALE_CHANNELS);
+            LOG_WARNING << "Channel " << timer.key << " stale: no frame for "
+                        << std::chrono::duration_cast<std::chrono::milliseconds>(now - timers.last_message).count()
+                        << " ms.";
+            emit(LivenessEventType::CHANNEL_STALE, timer.key, INVALID_BOOK_HANDLE, timers.last_message);
+            return;
+        }
+        case PRODUCT_STALE: {
+            BookTimer& book = books_[timer.key];
+            const Clock::time_point deadline = book.last_message + config_.product_timeout;
+            if (now < deadline) {
+                wheel_.schedule(timer, ceil_tick(deadline));
+                return;
+            }
+            book.stale_reported = true;
+            CoreUtils::incrementMetric(CoreUtils::Metric::STALE_PRODUCTS);
+            emit(LivenessEventType::PRODUCT_STALE, book.channel_id, timer.key, book.last_message);
+            return;
+        }
+        case GAP:
+        case RETRANSMISSION:
+            if (timer_handler_) {
+                timer_handler_(timer.kind == GAP ? ChannelTimer::GAP : ChannelTimer::RETRANSMISSION, timer.key, now);
+            }
+            return;
+    }
+}
+
+void LivenessMonitor::emit(LivenessEventType type, uint32_t channel_id, BookHandle book, Clock::time_point last_message) {
+    if (event_callback_) {
+        event_callback_(LivenessEvent{type, channel_id, book, last_message});
+    }
+}
+
+LivenessMonitor::Clock::time_point LivenessMonitor::last_message_time(uint32_t channel_id) const {
+    return channel_id < channels_.size() && channels_[channel_id] ? channels_[channel_id]->last_message
+                                                                  : Clock::time_point{};
+}
+
+bool LivenessMonitor::is_channel_stale(uint32_t channel_id) const {
+    return channel_id < channels_.size() && channels_[channel_id] && channels_[channel_id]->stale_reported;
+}
+
+bool LivenessMonitor::is_book_stale(BookHandle book) const {
+    return book < books_.size() && books_[book].stale_reported;
+}
+
+} // namespace Taifex
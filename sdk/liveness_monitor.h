@@ -0,0 +1,168 @@
+#ifndef LIVENESS_MONITOR_H
+#define LIVENESS_MONITOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "sdk/channel_gap_manager.h"
+#include "sdk/product_registry.h"
+#include "sdk/timer_wheel.h"
+
+namespace Taifex {
+
+/** @brief Settings for `TaifexSdk::monitor_liveness`. */
+struct LivenessConfig {
+    /**
+     * @brief A channel with no frame (I001 heartbeats included) for this long is stale; timed from
+     *        the channel's first frame. 0 disables.
+     */
+    std::chrono::milliseconds channel_timeout{0};
+    /** @brief A book with no I081/I083 for this long is stale. 0 disables. */
+    std::chrono::milliseconds product_timeout{0};
+};
+
+enum class LivenessEventType : uint8_t {
+    CHANNEL_STALE,   ///< No frame on `channel_id` for `LivenessConfig::channel_timeout`.
+    CHANNEL_RESUMED, ///< A frame arrived on a stale channel.
+    PRODUCT_STALE,   ///< No I081/I083 for `book` for `LivenessConfig::product_timeout`.
+    PRODUCT_RESUMED  ///< An I081/I083 arrived for a stale book.
+};
+
+struct LivenessEvent {
+    LivenessEventType type;
+    uint32_t channel_id;                     ///< For products, the channel of the book's last message.
+    BookHandle book = INVALID_BOOK_HANDLE;   ///< Products only.
+    ChannelGapManager::Clock::time_point last_message;
+};
+
+/**
+ * @brief Every deadline the SDK keeps, on one `TimerWheel` in 1 ms ticks: per-channel staleness,
+ *        gap timeouts and retransmission retries, and per-book staleness.
+ *
+ * Timers live in preallocated per-channel and per-book records, so arming one never allocates.
+ * Message arrival only stores its time and arms the stale timer when it is idle; a timer that
+ * fires early (because messages kept coming) re-arms itself for the last message plus the
+ * timeout, so a busy channel costs one wheel operation per timeout period rather than per frame.
+ *
+ * Time is whatever `TaifexSdk`'s time source returns, so a replay can drive it virtually.
+ * Not thread-safe; owned and driven by `TaifexSdk`.
+ */
+class LivenessMonitor {
+public:
+    using Clock = ChannelGapManager::Clock;
+    using EventCallback = std::function<void(const LivenessEvent& event)>;
+
+    /** @brief Channel timers whose expiry the owner handles. */
+    enum class ChannelTimer : uint8_t { GAP, RETRANSMISSION };
+    using TimerHandler = std::function<void(ChannelTimer timer, uint32_t channel_id, Clock::time_point now)>;
+
+    static constexpr Clock::duration TICK = std::chrono::milliseconds(1);
+
+    LivenessMonitor() = default;
+
+    LivenessMonitor(const LivenessMonitor&) = delete;
+    LivenessMonitor& operator=(const LivenessMonitor&) = delete;
+
+    void configure(const LivenessConfig& config);
+    const LivenessConfig& config() const { return config_; }
+    bool products_enabled() const { return config_.product_timeout.count() > 0; }
+
+    void set_event_callback(EventCallback callback) { event_callback_ = std::move(callback); }
+    void set_timer_handler(TimerHandler handler) { timer_handler_ = std::move(handler); }
+
+    /** @brief Disarms every timer and restarts time at `now` (e.g. for a new time source). */
+    void reset(Clock::time_point now);
+
+    /** @brief Preallocates the channel's timers. Channels outside 0-9999 are ignored. */
+    void register_channel(uint32_t channel_id);
+    /**
+     * @brief Preallocates timers up to `book` and starts its stale timer as if it was heard on
+     *        `channel_id` at `now`.
+     */
+    void add_book(BookHandle book, uint32_t channel_id, Clock::time_point now);
+
+    /** @brief A frame arrived on a registered channel. */
+    void on_channel_message(uint32_t channel_id, Clock::time_point now) {
+        if (channel_id < channels_.size() && channels_[channel_id]) [[likely]] {
+            ChannelTimers& timers = *channels_[channel_id];
+            timers.last_message = now;
+            if (timers.stale_reported || (!timers.stale.armed() && config_.channel_timeout.count() > 0)) [[unlikely]] {
+                channel_active(channel_id, timers);
+            }
+        }
+    }
+
+    /** @brief An I081/I083 arrived for `book` on `channel_id`. */
+    void on_book_message(BookHandle book, uint32_t channel_id, Clock::time_point now) {
+        if (book < books_.size()) [[likely]] {
+            BookTimer& timer = books_[book];
+            timer.last_message = now;
+            timer.channel_id = channel_id;
+            if (timer.stale_reported || !timer.stale.armed()) [[unlikely]] {
+                book_active(book, timer);
+            }
+        }
+    }
+
+    /** @brief Arms a channel timer for `deadline` unless it is armed already. */
+    void arm(ChannelTimer timer, uint32_t channel_id, Clock::time_point deadline);
+
+    /** @brief Fires every timer due by `now`. */
+    size_t advance(Clock::time_point now) {
+        const uint64_t tick = floor_tick(now);
+        if (tick <= wheel_.now()) [[likely]] {
+            return 0;
+        }
+        return fire_due(tick, now);
+    }
+
+    /** @brief When the channel's last frame arrived; the epoch if none has. */
+    Clock::time_point last_message_time(uint32_t channel_id) const;
+    bool is_channel_stale(uint32_t channel_id) const;
+    bool is_book_stale(BookHandle book) const;
+
+    /** @brief Timers armed. */
+    size_t armed_count() const { return wheel_.armed_count(); }
+
+private:
+    enum TimerKind : uint32_t { CHANNEL_STALE, GAP, RETRANSMISSION, PRODUCT_STALE };
+
+    struct ChannelTimers {
+        WheelTimer stale;
+        WheelTimer gap;
+        WheelTimer retransmission;
+        Clock::time_point last_message{};
+        bool stale_reported = false;
+    };
+
+    struct BookTimer {
+        WheelTimer stale;
+        Clock::time_point last_message{};
+        uint32_t channel_id = 0;
+        bool stale_reported = false;
+    };
+
+    static uint64_t floor_tick(Clock::time_point t);
+    static uint64_t ceil_tick(Clock::time_point t);
+
+    size_t fire_due(uint64_t tick, Clock::time_point now);
+    void fire(WheelTimer& timer, Clock::time_point now);
+    void channel_active(uint32_t channel_id, ChannelTimers& timers);
+    void book_active(BookHandle book, BookTimer& timer);
+    void emit(LivenessEventType type, uint32_t channel_id, BookHandle book, Clock::time_point last_message);
+
+    LivenessConfig config_;
+    std::vector<std::unique_ptr<ChannelTimers>> channels_; // Indexed by CHANNEL-ID; null until registered.
+    std::deque<BookTimer> books_;                         // By BookHandle; a deque so timers never move.
+    TimerWheel wheel_; // After the timers it links, so it is destroyed (and unlinks them) first.
+    EventCallback event_callback_;
+    TimerHandler timer_handler_;
+};
+
+} // namespace Taifex
+#endif // LIVENESS_MONITOR_H
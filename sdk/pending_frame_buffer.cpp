@@ -0,0 +1,77 @@
+#include "sdk/pending_frame_buffer.h"
+
+#include "logger.h"
+
+#include <iterator>
+
+namespace Taifex {
+
+PendingFrameBuffer::PendingFrameBuffer(const PendingFrameConfig& config)
+    : config_(config) {
+}
+
+void PendingFrameBuffer::configure(const PendingFrameConfig& config) {
+    config_ = config;
+}
+
+bool PendingFrameBuffer::push(std::string_view product_key, uint32_t channel_id, bool is_snapshot,
+                              const unsigned char* frame, size_t length) {
+    auto it = pending_.find(std::string(product_key));
+    if (it == pending_.end()) {
+        if (pending_.size() >= config_.max_products || config_.max_frames_per_product == 0) {
+            ++dropped_;
+            return false;
+        }
+        it = pending_.emplace(std::string(product_key), std::deque<PendingFrame>()).first;
+    }
+
+    std::deque<PendingFrame>& queue = it->second;
+    if (is_snapshot) {
+        frame_count_ -= queue.size(); // Superseded by the snapshot.
+        queue.clear();
+    } else if (queue.size() >= config_.max_frames_per_product) {
+        queue.pop_front();
+        --frame_count_;
+        ++dropped_;
+        LOG_DEBUG << "Pending frame queue full for PROD-ID-S: " << product_key << ". Oldest frame dropped.";
+    }
+    queue.push_back(PendingFrame{channel_id, Frame(frame, frame + length)});
+    ++frame_count_;
+    return true;
+}
+
+bool PendingFrameBuffer::has_pending(std::string_view product_key) const {
+    return pending_.find(std::string(product_key)) != pending_.end();
+}
+
+std::vector<PendingFrameBuffer::Frame> PendingFrameBuffer::take(std::string_view product_key) {
+    std::vector<Frame> frames;
+    auto it = pending_.find(std::string(product_key));
+    if (it == pending_.end()) {
+        return frames;
+    }
+    frames.reserve(it->second.size());
+    for (PendingFrame& pending : it->second) {
+        frames.push_back(std::move(pending.frame));
+    }
+    frame_count_ -= frames.size();
+    pending_.erase(it);
+    return frames;
+}
+
+void PendingFrameBuffer::clear() {
+    pending_.clear();
+    frame_count_ = 0;
+}
+
+void PendingFrameBuffer::clear_channel(uint32_t channel_id) {
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        std::deque<PendingFrame>& queue = it->second;
+        const size_t before = queue.size();
+        std::erase_if(queue, [channel_id](const PendingFrame& pending) { return pending.channel_id == channel_id; });
+        frame_count_ -= before - queue.size();
+        it = queue.empty() ? pending_.erase(it) : std::next(it);
+    }
+}
+
+} // namespace Taifex
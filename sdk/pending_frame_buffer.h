@@ -0,0 +1,79 @@
+#ifndef PENDING_FRAME_BUFFER_H
+#define PENDING_FRAME_BUFFER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Taifex {
+
+/**
+ * @brief Bounds for order book frames held until their product's I010 arrives.
+ */
+struct PendingFrameConfig {
+    /** @brief Frames kept per product. When full, the oldest frame is dropped. */
+    size_t max_frames_per_product = 64;
+    /** @brief Products with pending frames. Frames for further products are dropped. */
+    size_t max_products = 4096;
+};
+
+/**
+ * @brief Raw I081/I083 frames for products whose I010 has not been seen yet, queued per product
+ *        (keyed by trimmed PROD-ID-S) in arrival order and tagged with the CHANNEL-ID they came on.
+ *
+ * A queued snapshot supersedes everything queued before it for the same product, so those frames
+ * are discarded. Memory is only used while frames are pending, which is normally just at startup.
+ */
+class PendingFrameBuffer {
+public:
+    using Frame = std::vector<unsigned char>;
+
+    explicit PendingFrameBuffer(const PendingFrameConfig& config = PendingFrameConfig{});
+
+    void configure(const PendingFrameConfig& config);
+
+    /**
+     * @brief Queues a complete raw frame for the product.
+     * @param channel_id CHANNEL-ID the frame arrived on, for `clear_channel`.
+     * @param is_snapshot True for an I083; earlier frames for the product are discarded.
+     * @return False if the frame was dropped because `max_products` products are already pending.
+     */
+    bool push(std::string_view product_key, uint32_t channel_id, bool is_snapshot, const unsigned char* frame,
+              size_t length);
+
+    /** @return True if any frame is pending for the product. */
+    bool has_pending(std::string_view product_key) const;
+
+    /** @brief Removes and returns the product's frames, oldest first. */
+    std::vector<Frame> take(std::string_view product_key);
+
+    /** @brief Discards all pending frames. */
+    void clear();
+
+    /** @brief Discards the frames that arrived on the channel (e.g. on its Sequence Reset). */
+    void clear_channel(uint32_t channel_id);
+
+    bool empty() const { return pending_.empty(); }
+    size_t product_count() const { return pending_.size(); }
+    size_t frame_count() const { return frame_count_; }
+    /** @brief Frames dropped for overflow (not those superseded by a snapshot). */
+    uint64_t dropped_count() const { return dropped_; }
+
+private:
+    struct PendingFrame {
+        uint32_t channel_id;
+        Frame frame;
+    };
+
+    PendingFrameConfig config_;
+    std::unordered_map<std::string, std::deque<PendingFrame>> pending_;
+    size_t frame_count_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+} // namespace Taifex
+#endif // PENDING_FRAME_BUFFER_H
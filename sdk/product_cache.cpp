@@ -0,0 +1,131 @@
+#include "sdk/product_cache.h"
+
+#include "checksum.h" // For CoreUtils::calculateFnv1a64
+#include "logger.h"
+
+#include <chrono>
+#include <cstdio>  // For std::fopen, std::rename
+#include <cstring> // For std::memcmp, std::memcpy
+#include <span>
+
+namespace Taifex {
+
+namespace {
+constexpr char PRODUCT_CACHE_MAGIC[8] = {'T', 'X', 'P', 'C', 'A', 'C', 'H', 'E'};
+constexpr uint32_t PRODUCT_CACHE_VERSION = 1;
+
+struct CacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;  // sizeof(ProductInfo) of the writer; guards against layout changes.
+    uint32_t trading_date; // YYYYMMDD the cache was saved for.
+    uint32_t count;
+    uint64_t checksum;     // FNV-1a 64 of the records.
+};
+
+// YYYYMMDD -> days since epoch; false if not a valid calendar date.
+bool to_days(uint32_t yyyymmdd, std::chrono::sys_days& out_days) {
+    const std::chrono::year_month_day date{std::chrono::year(static_cast<int>(yyyymmdd / 10000)),
+                                           std::chrono::month(yyyymmdd / 100 % 100),
+                                           std::chrono::day(yyyymmdd % 100)};
+    if (!date.ok()) {
+        return false;
+    }
+    out_days = std::chrono::sys_days(date);
+    return true;
+}
+
+uint64_t records_checksum(const std::vector<ProductInfo>& records) {
+    return CoreUtils::calculateFnv1a64(std::as_bytes(std::span<const ProductInfo>(records)));
+}
+} // namespace
+
+bool save_product_cache(const std::string& path, uint32_t trading_date, const ProductRegistry& registry) {
+    std::chrono::sys_days unused;
+    if (path.empty() || !to_days(trading_date, unused)) {
+        LOG_ERROR << "Product cache: a path and a valid trading date are required to save.";
+        return false;
+    }
+
+    std::vector<ProductInfo> records;
+    records.reserve(registry.size());
+    for (ProductHandle handle = 0; handle < registry.size(); ++handle) {
+        records.push_back(*registry.get(handle));
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, PRODUCT_CACHE_MAGIC, sizeof(PRODUCT_CACHE_MAGIC));
+    header.version = PRODUCT_CACHE_VERSION;
+    header.record_size = sizeof(ProductInfo);
+    header.trading_date = trading_date;
+    header.count = static_cast<uint32_t>(records.size());
+    header.checksum = records_checksum(records);
+
+    const std::string temp_path = path + ".tmp";
+    std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR << "Product cache: cannot write " << temp_path;
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (records.empty() || std::fwrite(records.data(), sizeof(ProductInfo), records.size(), file) == records.size());
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        LOG_ERROR << "Product cache: failed to write " << path;
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    LOG_INFO << "Product cache: saved " << records.size() << " products for " << trading_date << " to " << path;
+    return true;
+}
+
+bool load_product_cache(const std::string& path, uint32_t trading_date, uint32_t max_age_days,
+                        std::vector<ProductInfo>& out_products) {
+    out_products.clear();
+    std::chrono::sys_days today;
+    if (!to_days(trading_date, today)) {
+        LOG_ERROR << "Product cache: invalid trading date " << trading_date;
+        return false;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        LOG_INFO << "Product cache: " << path << " not found. Waiting for I010.";
+        return false;
+    }
+    CacheHeader header{};
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, PRODUCT_CACHE_MAGIC, sizeof(PRODUCT_CACHE_MAGIC)) == 0 &&
+              header.version == PRODUCT_CACHE_VERSION &&
+              header.record_size == sizeof(ProductInfo);
+    std::vector<ProductInfo> records;
+    if (ok) {
+        records.resize(header.count);
+        ok = records.empty() || std::fread(records.data(), sizeof(ProductInfo), records.size(), file) == records.size();
+    }
+    std::fclose(file);
+    if (!ok || records_checksum(records) != header.checksum) {
+        LOG_WARNING << "Product cache: " << path << " is corrupt or from an incompatible version. Ignored.";
+        return false;
+    }
+
+    std::chrono::sys_days saved_day;
+    if (!to_days(header.trading_date, saved_day) || saved_day > today ||
+        today - saved_day > std::chrono::days(max_age_days)) {
+        LOG_WARNING << "Product cache: " << path << " was saved for " << header.trading_date
+                    << ", not usable on " << trading_date << ". Ignored.";
+        return false;
+    }
+
+    out_products.reserve(records.size());
+    for (const ProductInfo& info : records) {
+        if (info.end_date >= trading_date) { // END-DATE is the last trading day.
+            out_products.push_back(info);
+        }
+    }
+    LOG_INFO << "Product cache: loaded " << out_products.size() << " of " << records.size() << " products saved for "
+             << header.trading_date << ".";
+    return true;
+}
+
+} // namespace Taifex
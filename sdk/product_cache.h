@@ -0,0 +1,54 @@
+#ifndef PRODUCT_CACHE_H
+#define PRODUCT_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sdk/product_registry.h"
+
+namespace Taifex {
+
+/**
+ * @brief Settings for the on-disk I010 reference cache.
+ *
+ * The cache lets order books be created from the first I083 after a cold start instead of waiting
+ * for the I010 cycle. Cached records are replaced as live I010s arrive.
+ */
+struct ProductCacheConfig {
+    /** @brief Cache file. Empty disables the cache. */
+    std::string path;
+    /** @brief Trading date of this session, YYYYMMDD. Required to load or save the cache. */
+    uint32_t trading_date = 0;
+    /**
+     * @brief Oldest cache accepted, in calendar days before `trading_date` (covers weekends and
+     *        holidays). A cache saved for a later date than `trading_date` is always rejected.
+     */
+    uint32_t max_age_days = 7;
+    /** @brief Save the cache when the SDK is destroyed. Otherwise call `TaifexSdk::save_product_cache`. */
+    bool save_on_shutdown = true;
+};
+
+/**
+ * @brief Writes every product in the registry to `path`, tagged with `trading_date`.
+ *
+ * The file is a small header followed by raw `ProductInfo` records. It is written to a temporary
+ * file and renamed into place, so a crash never leaves a partial cache.
+ * @return False on any I/O error (logged).
+ */
+bool save_product_cache(const std::string& path, uint32_t trading_date, const ProductRegistry& registry);
+
+/**
+ * @brief Reads a cache written by `save_product_cache` for use on `trading_date`.
+ *
+ * The file is rejected if it is missing, corrupt, written by an incompatible build, saved for a
+ * later date than `trading_date` or older than `max_age_days`. Products whose END-DATE (last
+ * trading day) is before `trading_date` are dropped.
+ * @param out_products Filled with the usable records.
+ * @return False if the file was rejected (the reason is logged).
+ */
+bool load_product_cache(const std::string& path, uint32_t trading_date, uint32_t max_age_days,
+                        std::vector<ProductInfo>& out_products);
+
+} // namespace Taifex
+#endif // PRODUCT_CACHE_H
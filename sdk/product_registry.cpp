@@ -0,0 +1,95 @@
+#include "sdk/product_registry.h"
+
+#include "messages/message_i010.h"
+
+#include <algorithm> // For std::min
+#include <cstring> // For std::memcpy, std::memset, std::memcmp
+#include <type_traits>
+
+namespace Taifex {
+
+static_assert(std::is_trivially_copyable<ProductInfo>::value, "ProductInfo must stay a POD record.");
+
+// Parses an 8-digit YYYYMMDD string. Returns false on any non-digit.
+static bool parse_yyyymmdd(const std::string& text, uint32_t& out_value) {
+    if (text.size() != 8) {
+        return false;
+    }
+    uint32_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<uint32_t>(c - '0');
+    }
+    out_value = value;
+    return true;
+}
+
+bool ProductInfo::from_message(const SpecificMessageParsers::MessageI010& msg, ProductInfo& out_info) {
+    ProductInfo info;
+    std::memset(&info, 0, sizeof(info)); // Padding included, so records compare with memcmp.
+
+    std::memset(info.prod_id_s, ' ', PROD_ID_S_LENGTH);
+    std::memcpy(info.prod_id_s, msg.prod_id_s.data(), std::min(msg.prod_id_s.size(), PROD_ID_S_LENGTH));
+    info.prod_kind = msg.prod_kind;
+    info.decimal_locator = msg.decimal_locator;
+    info.strike_price_decimal_locator = msg.strike_price_decimal_locator;
+    info.flow_group = msg.flow_group;
+    info.flags = (msg.dynamic_banding == 'Y') ? FLAG_DYNAMIC_BANDING : 0;
+    info.reference_price = msg.reference_price;
+    if (!parse_yyyymmdd(msg.begin_date, info.begin_date) ||
+        !parse_yyyymmdd(msg.end_date, info.end_date) ||
+        !parse_yyyymmdd(msg.delivery_date, info.delivery_date)) {
+        return false;
+    }
+    out_info = info;
+    return true;
+}
+
+bool operator==(const ProductInfo& lhs, const ProductInfo& rhs) {
+    // Records are zero-initialized by from_message, so padding bytes compare equal.
+    return std::memcmp(&lhs, &rhs, sizeof(ProductInfo)) == 0;
+}
+
+std::string ProductRegistry::make_key(std::string_view prod_id_s) {
+    size_t length = std::min(prod_id_s.size(), ProductInfo::PROD_ID_S_LENGTH);
+    while (length > 0 && prod_id_s[length - 1] == ' ') {
+        --length;
+    }
+    return std::string(prod_id_s.substr(0, length));
+}
+
+ProductHandle ProductRegistry::upsert(const ProductInfo& info, bool& out_changed) {
+    std::string key = make_key(std::string_view(info.prod_id_s, ProductInfo::PROD_ID_S_LENGTH));
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        ProductInfo& existing = products_[it->second];
+        out_changed = (existing != info);
+        if (out_changed) {
+            existing = info;
+        }
+        return it->second;
+    }
+    ProductHandle handle = static_cast<ProductHandle>(products_.size());
+    products_.push_back(info);
+    index_.emplace(std::move(key), handle);
+    out_changed = true;
+    return handle;
+}
+
+ProductHandle ProductRegistry::find(std::string_view prod_id_s) const {
+    auto it = index_.find(make_key(prod_id_s));
+    return (it != index_.end()) ? it->second : INVALID_PRODUCT_HANDLE;
+}
+
+const ProductInfo* ProductRegistry::get(ProductHandle handle) const {
+    return (handle < products_.size()) ? &products_[handle] : nullptr;
+}
+
+void ProductRegistry::reserve(size_t product_count) {
+    products_.reserve(product_count);
+    index_.reserve(product_count);
+}
+
+} // namespace Taifex
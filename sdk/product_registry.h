@@ -0,0 +1,109 @@
+#ifndef PRODUCT_REGISTRY_H
+#define PRODUCT_REGISTRY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SpecificMessageParsers {
+    struct MessageI010;
+}
+
+namespace Taifex {
+
+/** @brief Dense index of a product in the `ProductRegistry`, assigned on first I010. */
+using ProductHandle = uint32_t;
+constexpr ProductHandle INVALID_PRODUCT_HANDLE = std::numeric_limits<ProductHandle>::max();
+
+/** @brief Dense index of an order book, assigned by `TaifexSdk` in order of creation. */
+using BookHandle = uint32_t;
+constexpr BookHandle INVALID_BOOK_HANDLE = std::numeric_limits<BookHandle>::max();
+
+/**
+ * @brief Compact, trivially copyable product reference data built from an I010 message.
+ *
+ * Dates are YYYYMMDD as integers (e.g. 20240117). Prices are scaled integers; use
+ * `decimal_locator` / `strike_price_decimal_locator` to place the decimal point.
+ */
+struct ProductInfo {
+    static constexpr size_t PROD_ID_S_LENGTH = 10;
+
+    /** @brief Flag bit: DYNAMIC-BANDING is 'Y'. */
+    static constexpr uint8_t FLAG_DYNAMIC_BANDING = 0x01;
+
+    /** @brief X(10) PROD-ID-S, space padded as on the wire. Use `id()` for the trimmed form. */
+    char     prod_id_s[PROD_ID_S_LENGTH];
+    /** @brief X(1) PROD-KIND (e.g. I, S, F, O). */
+    char     prod_kind;
+    uint8_t  decimal_locator;
+    uint8_t  strike_price_decimal_locator;
+    uint8_t  flow_group;
+    /** @brief Combination of `FLAG_*` bits. */
+    uint8_t  flags;
+    int64_t  reference_price;
+    uint32_t begin_date;
+    uint32_t end_date;
+    uint32_t delivery_date;
+
+    /** @return PROD-ID-S with trailing spaces removed. */
+    std::string_view id() const {
+        size_t length = PROD_ID_S_LENGTH;
+        while (length > 0 && (prod_id_s[length - 1] == ' ' || prod_id_s[length - 1] == '\0')) {
+            --length;
+        }
+        return std::string_view(prod_id_s, length);
+    }
+
+    bool has_dynamic_banding() const { return (flags & FLAG_DYNAMIC_BANDING) != 0; }
+
+    /**
+     * @brief Converts a parsed I010 into a `ProductInfo`.
+     * @return False if a date field is not an 8-digit number.
+     */
+    static bool from_message(const SpecificMessageParsers::MessageI010& msg, ProductInfo& out_info);
+};
+
+bool operator==(const ProductInfo& lhs, const ProductInfo& rhs);
+inline bool operator!=(const ProductInfo& lhs, const ProductInfo& rhs) { return !(lhs == rhs); }
+
+/**
+ * @brief Product reference data stored densely by `ProductHandle`.
+ *
+ * Handles are assigned in order of first appearance and never reused. The id index is only
+ * consulted when resolving a PROD-ID-S; everything else addresses products by handle.
+ */
+class ProductRegistry {
+public:
+    /**
+     * @brief Inserts or updates a product.
+     * @param info The new reference data.
+     * @param out_changed Set to true if the product is new or any field differs from the stored record.
+     * @return The product's handle.
+     */
+    ProductHandle upsert(const ProductInfo& info, bool& out_changed);
+
+    /**
+     * @brief Resolves a PROD-ID-S to a handle. Accepts the trimmed or space-padded form.
+     * @return The handle, or `INVALID_PRODUCT_HANDLE` if no I010 has been seen for it.
+     */
+    ProductHandle find(std::string_view prod_id_s) const;
+
+    /** @return The product's record, or nullptr for an unknown handle. Valid until the next `upsert`. */
+    const ProductInfo* get(ProductHandle handle) const;
+
+    size_t size() const { return products_.size(); }
+    void reserve(size_t product_count);
+
+private:
+    static std::string make_key(std::string_view prod_id_s);
+
+    std::vector<ProductInfo> products_;
+    std::unordered_map<std::string, ProductHandle> index_; // Trimmed PROD-ID-S -> handle
+};
+
+} // namespace Taifex
+#endif // PRODUCT_REGISTRY_H
@@ -0,0 +1,77 @@
+#ifndef SDK_CONFIG_H
+#define SDK_CONFIG_H
+
+#include "sdk/channel_gap_manager.h"
+#include "sdk/pending_frame_buffer.h"
+#include "sdk/product_cache.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Taifex {
+
+/**
+ * @brief Expected session size. `TaifexSdk::initialize` preallocates its tables, the per-channel
+ *        reorder rings and the order book pool from it, so that the trading session runs without
+ *        heap allocations or rehashes once every product and book exists.
+ */
+struct CapacityConfig {
+    /** @brief Products (I010 PROD-ID-S) expected in the session. */
+    size_t expected_products = 0;
+    /** @brief Order books expected in the session (outrights plus complex products). */
+    size_t expected_books = 0;
+    /**
+     * @brief Price levels per side a book keeps (at least 5, the depth I081/I083 disclose); levels
+     *        pushed deeper are dropped. Sizes the book pool.
+     */
+    size_t max_depth = 10;
+    /** @brief CHANNEL-IDs that will carry data; their reorder rings are allocated at initialization. */
+    std::vector<uint32_t> channels;
+    /**
+     * @brief PROD-ID-S to process (trimmed or space padded). I010/I081/I083 of other products are
+     *        dropped and counted as filtered; complex products follow their first leg. Empty: all.
+     */
+    std::vector<std::string> subscriptions;
+    /**
+     * @brief Upper bound in bytes for what initialization preallocates (book pool and reorder
+     *        rings). The book pool is shrunk to fit; 0 means no bound.
+     */
+    size_t memory_budget_bytes = 0;
+};
+
+/** @brief What `TaifexSdk::process_message` does when a frame allocates on the heap. */
+enum class AllocationCheck {
+    OFF,    ///< No checking.
+    REPORT, ///< Count in `Metric::HOT_PATH_ALLOCATIONS` and log a warning.
+    ABORT   ///< Log an error and abort; for tests and soak runs.
+};
+
+/**
+ * @brief Configuration passed to `TaifexSdk::initialize`.
+ */
+struct SdkConfig {
+    /** @brief Reorder buffer sizing and gap timeout. */
+    GapRecoveryConfig gap_recovery;
+    /** @brief Persisted I010 reference data, preloaded at initialization. Disabled by default. */
+    ProductCacheConfig product_cache;
+    /** @brief Bounds for I081/I083 held until their product's I010 arrives. */
+    PendingFrameConfig pending_frames;
+    /**
+     * @brief Minimum time between publications of the `SdkReader` index (new or changed products
+     *        and new books). Book contents are published on every change regardless.
+     */
+    std::chrono::milliseconds reader_publish_interval{10};
+    /** @brief Preallocation and product subscriptions. */
+    CapacityConfig capacity;
+    /**
+     * @brief Checks every frame for heap allocations made while applying it. Setup work (new
+     *        products, new books, channel resynchronization, held-frame recovery) is exempt. Needs
+     *        the `taifex_allocation_hooks` library linked into the program; otherwise nothing is seen.
+     */
+    AllocationCheck allocation_check = AllocationCheck::OFF;
+};
+
+} // namespace Taifex
+#endif // SDK_CONFIG_H
@@ -0,0 +1,278 @@
+#include "sdk/sdk_reader.h"
+
+#include <algorithm> // For std::min
+#include <cstring> // For std::memcpy
+#include <functional> // For std::hash
+#include <span>
+#include <type_traits>
+
+namespace Taifex {
+
+static_assert(std::is_trivially_copyable_v<BookSnapshot>, "BookSnapshot is copied word by word.");
+
+namespace {
+std::string_view trim_trailing_spaces(std::string_view value) {
+    const size_t end = value.find_last_not_of(' ');
+    return end == std::string_view::npos ? std::string_view() : value.substr(0, end + 1);
+}
+
+// The key `ProductRegistry` indexes a PROD-ID-S under.
+std::string product_key(std::string_view prod_id_s) {
+    return std::string(trim_trailing_spaces(prod_id_s.substr(0, ProductInfo::PROD_ID_S_LENGTH)));
+}
+
+size_t id_shard(const std::string& key) {
+    return std::hash<std::string>{}(key) % ReaderProductTable::ID_SHARD_COUNT;
+}
+
+size_t book_shard(std::string_view key) {
+    return std::hash<std::string_view>{}(key) % ReaderBookTable::SHARD_COUNT;
+}
+} // namespace
+
+void BookSnapshot::capture(const OrderBookManagement::OrderBook& book, size_t depth) {
+    depth = std::min(depth, MAX_LEVELS);
+    last_prod_msg_seq = book.get_last_prod_msg_seq();
+    decimal_locator = book.get_decimal_locator();
+    stale = book.is_stale();
+    bid_count = static_cast<uint8_t>(book.copy_top_bids(std::span(bids, depth)));
+    ask_count = static_cast<uint8_t>(book.copy_top_asks(std::span(asks, depth)));
+    has_derived_bid = false;
+    has_derived_ask = false;
+    if (auto derived = book.get_derived_bid()) {
+        has_derived_bid = true;
+        derived_bid = *derived;
+    }
+    if (auto derived = book.get_derived_ask()) {
+        has_derived_ask = true;
+        derived_ask = *derived;
+    }
+}
+
+void BookSnapshotSlot::publish(const OrderBookManagement::OrderBook& book) {
+    BookSnapshot snapshot;
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    snapshot.version = sequence / 2 + 1;
+    snapshot.capture(book);
+
+    uint64_t words[WORD_COUNT] = {};
+    std::memcpy(words, &snapshot, sizeof(snapshot));
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+        words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+void BookSnapshotSlot::read(BookSnapshot& out) const {
+    uint64_t words[WORD_COUNT];
+    while (true) {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue; // Write in progress.
+        }
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+    std::memcpy(&out, words, sizeof(out));
+}
+
+ReaderPublication::ReadGuard::ReadGuard(const ReaderPublication& publication) {
+    while (true) {
+        const uint64_t epoch = publication.epoch_.load(std::memory_order_seq_cst);
+        std::atomic<uint64_t>& readers = publication.readers_[epoch & 1].value;
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        // Re-checked so the publisher either sees this reader counted under `epoch` or the reader
+        // sees the publisher's epoch change; a stale count would not hold anything back.
+        if (publication.epoch_.load(std::memory_order_seq_cst) == epoch) {
+            readers_ = &readers;
+            break;
+        }
+        readers.fetch_sub(1, std::memory_order_release);
+    }
+    index_ = publication.index_.load(std::memory_order_acquire);
+}
+
+ReaderPublication::~ReaderPublication() {
+    // The last owner is going away, so no reader is left.
+    delete index_.load(std::memory_order_acquire);
+    for (const ReaderIndex* index : retired_) {
+        delete index;
+    }
+    for (const ReaderIndex* index : draining_) {
+        delete index;
+    }
+}
+
+void ReaderPublication::publish(std::unique_ptr<const ReaderIndex> index) {
+    const ReaderIndex* previous = index_.exchange(index.release(), std::memory_order_acq_rel);
+    if (previous) {
+        retired_.push_back(previous);
+    }
+    reclaim();
+}
+
+void ReaderPublication::reclaim() {
+    free_drained();
+    if (draining_.empty() && !retired_.empty()) {
+        // Readers that can still hold a retired index started in the current epoch or earlier;
+        // earlier ones are gone, since the epoch only advances once the previous batch is freed.
+        draining_.swap(retired_);
+        draining_epoch_ = epoch_.load(std::memory_order_relaxed);
+        epoch_.store(draining_epoch_ + 1, std::memory_order_seq_cst);
+        free_drained();
+    }
+}
+
+void ReaderPublication::free_drained() {
+    if (draining_.empty() || readers_[draining_epoch_ & 1].value.load(std::memory_order_seq_cst) != 0) {
+        return;
+    }
+    for (const ReaderIndex* index : draining_) {
+        delete index;
+    }
+    draining_.clear();
+}
+
+ReaderProductTable ReaderProductTable::update(const ReaderProductTable& previous, const ProductRegistry& registry,
+                                              std::span<const ProductHandle> changed) {
+    ReaderProductTable table = previous;
+    table.size_ = registry.size();
+    table.chunks_.resize((table.size_ + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    // Chunks and shards copied for this table; the rest stay shared with `previous`.
+    std::vector<std::shared_ptr<Chunk>> own_chunks(table.chunks_.size());
+    std::array<std::shared_ptr<IdShard>, ID_SHARD_COUNT> own_shards{};
+    auto write = [&](ProductHandle handle) {
+        std::shared_ptr<Chunk>& chunk = own_chunks[handle / CHUNK_SIZE];
+        if (!chunk) {
+            const auto& shared = table.chunks_[handle / CHUNK_SIZE];
+            chunk = shared ? std::make_shared<Chunk>(*shared) : std::make_shared<Chunk>();
+            table.chunks_[handle / CHUNK_SIZE] = chunk;
+        }
+        (*chunk)[handle % CHUNK_SIZE] = *registry.get(handle);
+    };
+
+    for (ProductHandle handle : changed) {
+        if (handle < previous.size_) {
+            write(handle);
+        }
+    }
+    for (ProductHandle handle = static_cast<ProductHandle>(previous.size_); handle < table.size_; ++handle) {
+        write(handle);
+        std::string key = product_key(std::string_view(registry.get(handle)->prod_id_s, ProductInfo::PROD_ID_S_LENGTH));
+        const size_t shard_index = id_shard(key);
+        std::shared_ptr<IdShard>& shard = own_shards[shard_index];
+        if (!shard) {
+            const auto& shared = table.id_shards_[shard_index];
+            shard = shared ? std::make_shared<IdShard>(*shared) : std::make_shared<IdShard>();
+            table.id_shards_[shard_index] = shard;
+        }
+        shard->emplace(std::move(key), handle);
+    }
+    return table;
+}
+
+ProductHandle ReaderProductTable::find(std::string_view prod_id_s) const {
+    const std::string key = product_key(prod_id_s);
+    const auto& shard = id_shards_[id_shard(key)];
+    if (!shard) {
+        return INVALID_PRODUCT_HANDLE;
+    }
+    auto it = shard->find(key);
+    return it != shard->end() ? it->second : INVALID_PRODUCT_HANDLE;
+}
+
+const ProductInfo* ReaderProductTable::get(ProductHandle handle) const {
+    return handle < size_ ? &(*chunks_[handle / CHUNK_SIZE])[handle % CHUNK_SIZE] : nullptr;
+}
+
+ReaderBookTable ReaderBookTable::update(const ReaderBookTable& previous, std::span<const Entry> added) {
+    ReaderBookTable table = previous;
+    // Shards copied for this table; the rest stay shared with `previous`.
+    std::array<std::shared_ptr<Shard>, SHARD_COUNT> own_shards{};
+    for (const auto& [prod_id, slot] : added) {
+        std::string key(trim_trailing_spaces(prod_id));
+        const size_t shard_index = book_shard(key);
+        std::shared_ptr<Shard>& shard = own_shards[shard_index];
+        if (!shard) {
+            const auto& shared = table.shards_[shard_index];
+            shard = shared ? std::make_shared<Shard>(*shared) : std::make_shared<Shard>();
+            table.shards_[shard_index] = shard;
+        }
+        if (shard->insert_or_assign(std::move(key), slot).second) {
+            ++table.size_;
+        }
+    }
+    return table;
+}
+
+const BookSnapshotSlot* ReaderBookTable::find(std::string_view prod_id) const {
+    const std::string_view key = trim_trailing_spaces(prod_id);
+    const auto& shard = shards_[book_shard(key)];
+    if (!shard) {
+        return nullptr;
+    }
+    auto it = shard->find(std::string(key));
+    return it != shard->end() ? it->second.get() : nullptr;
+}
+
+SdkReader::SdkReader(std::shared_ptr<const ReaderPublication> publication)
+    : publication_(std::move(publication)) {
+}
+
+std::optional<ProductInfo> SdkReader::get_product_info(std::string_view prod_id_s) const {
+    if (!publication_) {
+        return std::nullopt;
+    }
+    ReaderPublication::ReadGuard guard = publication_->read();
+    const ReaderIndex* current = guard.index();
+    const ProductInfo* info = current ? current->products.get(current->products.find(prod_id_s)) : nullptr;
+    if (!info) {
+        return std::nullopt;
+    }
+    return *info;
+}
+
+std::optional<ProductInfo> SdkReader::get_product_info(ProductHandle handle) const {
+    if (!publication_) {
+        return std::nullopt;
+    }
+    ReaderPublication::ReadGuard guard = publication_->read();
+    const ReaderIndex* current = guard.index();
+    const ProductInfo* info = current ? current->products.get(handle) : nullptr;
+    if (!info) {
+        return std::nullopt;
+    }
+    return *info;
+}
+
+size_t SdkReader::product_count() const {
+    if (!publication_) {
+        return 0;
+    }
+    ReaderPublication::ReadGuard guard = publication_->read();
+    return guard.index() ? guard.index()->products.size() : 0;
+}
+
+bool SdkReader::get_order_book(std::string_view prod_id, BookSnapshot& out) const {
+    if (!publication_) {
+        return false;
+    }
+    ReaderPublication::ReadGuard guard = publication_->read();
+    const ReaderIndex* current = guard.index();
+    const BookSnapshotSlot* slot = current ? current->books.find(prod_id) : nullptr;
+    if (!slot) {
+        return false;
+    }
+    slot->read(out);
+    return true;
+}
+
+} // namespace Taifex
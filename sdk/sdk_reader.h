@@ -0,0 +1,239 @@
+#ifndef SDK_READER_H
+#define SDK_READER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "order_book/order_book.h"
+#include "sdk/product_registry.h"
+
+namespace Taifex {
+
+/**
+ * @brief Copy of an order book's top levels, as published for `SdkReader`.
+ */
+struct BookSnapshot {
+    static constexpr size_t MAX_LEVELS = 10;
+
+    /** @brief Number of times the book has been published; 0 if never. */
+    uint64_t version = 0;
+    uint32_t last_prod_msg_seq = 0;
+    uint8_t  decimal_locator = 0;
+    bool     stale = false;
+    bool     has_derived_bid = false;
+    bool     has_derived_ask = false;
+    uint8_t  bid_count = 0;
+    uint8_t  ask_count = 0;
+    OrderBookManagement::PriceQuantityLevel bids[MAX_LEVELS] = {};
+    OrderBookManagement::PriceQuantityLevel asks[MAX_LEVELS] = {};
+    OrderBookManagement::PriceQuantityLevel derived_bid = {};
+    OrderBookManagement::PriceQuantityLevel derived_ask = {};
+
+    /** @brief Copies up to `depth` levels per side and the book's state. `version` is left as is. */
+    void capture(const OrderBookManagement::OrderBook& book, size_t depth = MAX_LEVELS);
+};
+
+/**
+ * @brief Seqlock-protected `BookSnapshot` of one book. Written by the processing thread only;
+ *        readers never block it and retry if they overlap a write.
+ */
+class BookSnapshotSlot {
+public:
+    /** @brief Copies the book's top levels. Single writer. */
+    void publish(const OrderBookManagement::OrderBook& book);
+
+    /** @brief Consistent copy of the last published snapshot. Any thread. */
+    void read(BookSnapshot& out) const;
+
+    /** @brief `version` of the last completed publication; 0 if never published. Any thread. */
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(BookSnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> sequence_{0}; // Odd while a write is in progress.
+    std::atomic<uint64_t> words_[WORD_COUNT] = {};
+};
+
+/**
+ * @brief Immutable product table of a `ReaderIndex`.
+ *
+ * Records sit in fixed-size chunks and the PROD-ID-S index is split into shards. `update` shares
+ * every chunk and shard of the previous table except those holding a new or changed product, so
+ * republishing copies only those instead of the whole registry.
+ */
+class ReaderProductTable {
+public:
+    static constexpr size_t CHUNK_SIZE = 256;
+    static constexpr size_t ID_SHARD_COUNT = 64;
+
+    /**
+     * @brief `previous` brought up to date with `registry`.
+     * @param changed Handles below `previous.size()` whose records changed since; handles past its
+     *        end are taken as new. Duplicates are fine.
+     */
+    static ReaderProductTable update(const ReaderProductTable& previous, const ProductRegistry& registry,
+                                     std::span<const ProductHandle> changed);
+
+    /** @brief Same as `ProductRegistry::find`. */
+    ProductHandle find(std::string_view prod_id_s) const;
+
+    /** @return The product's record, or nullptr for an unknown handle. */
+    const ProductInfo* get(ProductHandle handle) const;
+
+    size_t size() const { return size_; }
+
+private:
+    using Chunk = std::array<ProductInfo, CHUNK_SIZE>;
+    using IdShard = std::unordered_map<std::string, ProductHandle>; // Trimmed PROD-ID-S -> handle
+
+    std::vector<std::shared_ptr<const Chunk>> chunks_;
+    std::array<std::shared_ptr<const IdShard>, ID_SHARD_COUNT> id_shards_{};
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Immutable book table of a `ReaderIndex`: the snapshot slot of every book, keyed by
+ *        PROD-ID with trailing spaces removed.
+ *
+ * The index is split into shards like `ReaderProductTable`'s; `update` copies only the shards
+ * that receive a new book and shares the rest with the previous table.
+ */
+class ReaderBookTable {
+public:
+    static constexpr size_t SHARD_COUNT = 64;
+
+    /** @brief A book added since the previous table: its PROD-ID (trimmed or space padded) and slot. */
+    using Entry = std::pair<std::string, std::shared_ptr<const BookSnapshotSlot>>;
+
+    /** @brief `previous` plus `added`; an entry for a PROD-ID already present replaces its slot. */
+    static ReaderBookTable update(const ReaderBookTable& previous, std::span<const Entry> added);
+
+    /** @return The book's slot, or nullptr if the table has no book for `prod_id`. */
+    const BookSnapshotSlot* find(std::string_view prod_id) const;
+
+    size_t size() const { return size_; }
+
+private:
+    using Shard = std::unordered_map<std::string, std::shared_ptr<const BookSnapshotSlot>>;
+
+    std::array<std::shared_ptr<const Shard>, SHARD_COUNT> shards_{};
+    size_t size_ = 0;
+};
+
+/** @brief Immutable index published by `TaifexSdk` for readers. */
+struct ReaderIndex {
+    ReaderProductTable products;
+    ReaderBookTable books;
+};
+
+/**
+ * @brief Where `TaifexSdk` publishes the current `ReaderIndex`; shared with its readers.
+ *
+ * The index is an atomic raw pointer. While a reader uses it, the reader is counted in one of two
+ * counters, picked by the parity of an epoch. A replaced index is freed once the epoch has moved
+ * past the one it was replaced in and that epoch's counter has drained. Neither side waits for
+ * the other: a reader only retries if the epoch moves between counting itself and checking it,
+ * and the publisher frees what it can on each publication and leaves the rest for the next.
+ */
+class ReaderPublication {
+public:
+    /** @brief Keeps the index current at its creation alive until it is destroyed. */
+    class ReadGuard {
+    public:
+        ~ReadGuard() { readers_->fetch_sub(1, std::memory_order_release); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        /** @brief The pinned index; null if nothing has been published yet. */
+        const ReaderIndex* index() const { return index_; }
+
+    private:
+        friend class ReaderPublication;
+        explicit ReadGuard(const ReaderPublication& publication);
+
+        std::atomic<uint64_t>* readers_;
+        const ReaderIndex* index_;
+    };
+
+    ReaderPublication() = default;
+    ~ReaderPublication();
+    ReaderPublication(const ReaderPublication&) = delete;
+    ReaderPublication& operator=(const ReaderPublication&) = delete;
+
+    /** @brief Pins the current index. Any thread; never blocks. */
+    ReadGuard read() const { return ReadGuard(*this); }
+
+    /**
+     * @brief Replaces the index. The previous one is freed by this or a later call once no reader
+     *        can still hold it. Publisher thread only; never waits for readers.
+     */
+    void publish(std::unique_ptr<const ReaderIndex> index);
+
+private:
+    struct alignas(64) ReaderCount {
+        std::atomic<uint64_t> value{0};
+    };
+
+    void reclaim();
+    void free_drained();
+
+    std::atomic<const ReaderIndex*> index_{nullptr};
+    alignas(64) std::atomic<uint64_t> epoch_{0};
+    mutable ReaderCount readers_[2]; // Readers that started in an even / odd epoch.
+
+    // Publisher only.
+    std::vector<const ReaderIndex*> retired_;  // Replaced in the current epoch.
+    std::vector<const ReaderIndex*> draining_; // Replaced in `draining_epoch_`; freed when its readers are gone.
+    uint64_t draining_epoch_ = 0;
+};
+
+/**
+ * @brief Read-only view of a live `TaifexSdk` for use from any thread, concurrently with
+ *        `process_message`. Obtained from `TaifexSdk::create_reader()`; cheap to copy.
+ *
+ * Lookups go through the last published `ReaderIndex`, which lags processing by at most
+ * `SdkConfig::reader_publish_interval` for new or changed products and new books. Book contents
+ * are published after every change. A reader stays usable after the SDK is destroyed; it then
+ * keeps returning the last published state.
+ */
+class SdkReader {
+public:
+    /** @brief A reader attached to nothing; every lookup fails. */
+    SdkReader() = default;
+
+    /** @brief Product reference data by PROD-ID-S (trimmed or space padded). */
+    std::optional<ProductInfo> get_product_info(std::string_view prod_id_s) const;
+
+    /** @brief Product reference data by handle. */
+    std::optional<ProductInfo> get_product_info(ProductHandle handle) const;
+
+    /** @brief Number of products in the published index. */
+    size_t product_count() const;
+
+    /**
+     * @brief Copies the book's top levels.
+     * @param prod_id The book's PROD-ID (trimmed or space padded).
+     * @return False if no such book has been published yet.
+     */
+    bool get_order_book(std::string_view prod_id, BookSnapshot& out) const;
+
+private:
+    friend class TaifexSdk;
+    explicit SdkReader(std::shared_ptr<const ReaderPublication> publication);
+
+    std::shared_ptr<const ReaderPublication> publication_;
+};
+
+} // namespace Taifex
+#endif // SDK_READER_H
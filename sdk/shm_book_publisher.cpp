@@ -0,0 +1,144 @@
+#include "sdk/shm_book_publisher.h"
+
+#include "logger.h"
+
+#include <algorithm> // For std::min
+#include <cerrno>
+#include <cstring>   // For std::memcpy, std::memset, std::strerror
+#include <span>
+
+namespace Taifex {
+
+namespace {
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+struct Layout {
+    size_t products_offset;
+    size_t books_offset;
+    size_t bbo_offset;
+    size_t total_size;
+};
+
+Layout compute_layout(uint32_t product_capacity, uint32_t book_capacity) {
+    Layout layout;
+    layout.products_offset = align_up(sizeof(ShmSegmentHeader), 64);
+    layout.books_offset = align_up(layout.products_offset + sizeof(ShmProductRecord) * product_capacity, 64);
+    layout.bbo_offset = align_up(layout.books_offset + sizeof(ShmBookRecord) * book_capacity, 64);
+    layout.total_size = layout.bbo_offset + sizeof(ShmBboRecord) * book_capacity;
+    return layout;
+}
+} // namespace
+
+ShmBookPublisher::~ShmBookPublisher() {
+    close();
+}
+
+size_t ShmBookPublisher::segment_size_for(uint32_t product_capacity, uint32_t book_capacity) {
+    return compute_layout(product_capacity, book_capacity).total_size;
+}
+
+ShmProductRecord* ShmBookPublisher::products() const {
+    return reinterpret_cast<ShmProductRecord*>(reinterpret_cast<unsigned char*>(header_) + header_->products_offset);
+}
+
+ShmBookRecord* ShmBookPublisher::books() const {
+    return reinterpret_cast<ShmBookRecord*>(reinterpret_cast<unsigned char*>(header_) + header_->books_offset);
+}
+
+ShmBboRecord* ShmBookPublisher::bbos() const {
+    return reinterpret_cast<ShmBboRecord*>(reinterpret_cast<unsigned char*>(header_) + header_->bbo_offset);
+}
+
+bool ShmBookPublisher::open(const ShmPublicationConfig& config) {
+    close();
+    if (config.name.empty()) {
+        LOG_ERROR << "ShmBookPublisher: no segment name configured.";
+        return false;
+    }
+    const Layout layout = compute_layout(config.product_capacity, config.book_capacity);
+    if (!segment_.create(config.name, layout.total_size, SHM_SEGMENT_MAGIC, SHM_LAYOUT_VERSION, config.unlink_on_close)) {
+        LOG_ERROR << "ShmBookPublisher: cannot create " << config.name << ": "
+                  << (errno == EEXIST ? "in use by another running publisher" : std::strerror(errno));
+        return false;
+    }
+
+    // A new segment is zero filled: every record reads as never written.
+    header_ = reinterpret_cast<ShmSegmentHeader*>(segment_.data());
+    header_->depth = std::min<uint32_t>(config.depth, BookSnapshot::MAX_LEVELS);
+    header_->product_capacity = config.product_capacity;
+    header_->book_capacity = config.book_capacity;
+    header_->products_offset = layout.products_offset;
+    header_->books_offset = layout.books_offset;
+    header_->bbo_offset = layout.bbo_offset;
+    header_->total_size = layout.total_size;
+    segment_.set_state(ShmSegmentState::LIVE);
+    LOG_INFO << "ShmBookPublisher: created " << config.name << " (" << layout.total_size << " bytes, depth "
+             << header_->depth << ").";
+    return true;
+}
+
+void ShmBookPublisher::close() {
+    if (!segment_.is_open()) {
+        return;
+    }
+    LOG_INFO << "ShmBookPublisher: closed " << segment_.name() << ".";
+    segment_.close();
+    header_ = nullptr;
+}
+
+void ShmBookPublisher::publish_product(ProductHandle handle, const ProductInfo& info) {
+    if (!header_ || handle >= header_->product_capacity) {
+        return;
+    }
+    products()[handle].info.store(info);
+    if (handle >= header_->product_count.load(std::memory_order_relaxed)) {
+        header_->product_count.store(handle + 1, std::memory_order_release);
+    }
+}
+
+ShmBookIndex ShmBookPublisher::add_book(const OrderBookManagement::OrderBook& book, ProductHandle product) {
+    if (!header_) {
+        return INVALID_SHM_BOOK_INDEX;
+    }
+    const uint32_t index = header_->book_count.load(std::memory_order_relaxed);
+    if (index >= header_->book_capacity) {
+        LOG_WARNING << "ShmBookPublisher: book capacity " << header_->book_capacity << " reached; "
+                    << book.get_product_id() << " is not published.";
+        return INVALID_SHM_BOOK_INDEX;
+    }
+    ShmBookRecord& record = books()[index];
+    const std::string& prod_id = book.get_product_id();
+    std::memset(record.prod_id, ' ', ShmBookRecord::PROD_ID_LENGTH);
+    std::memcpy(record.prod_id, prod_id.data(), std::min(prod_id.size(), ShmBookRecord::PROD_ID_LENGTH));
+    record.product = product;
+    publish_book(index, book);
+    header_->book_count.store(index + 1, std::memory_order_release);
+    return index;
+}
+
+void ShmBookPublisher::publish_book(ShmBookIndex index, const OrderBookManagement::OrderBook& book) {
+    if (!header_ || index >= header_->book_capacity) {
+        return;
+    }
+    ShmBookRecord& record = books()[index];
+    BookSnapshot snapshot;
+    snapshot.version = record.snapshot.sequence() / 2 + 1;
+    snapshot.capture(book, header_->depth);
+    record.snapshot.store(snapshot);
+
+    ShmBbo bbo = {};
+    bbo.last_prod_msg_seq = snapshot.last_prod_msg_seq;
+    bbo.decimal_locator = snapshot.decimal_locator;
+    bbo.stale = snapshot.stale;
+    bbo.has_bid = book.copy_top_bids(std::span(&bbo.bid, 1)) != 0;
+    bbo.has_ask = book.copy_top_asks(std::span(&bbo.ask, 1)) != 0;
+    bbos()[index].bbo.store(bbo);
+}
+
+uint32_t ShmBookPublisher::book_count() const {
+    return header_ ? header_->book_count.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace Taifex
@@ -0,0 +1,86 @@
+#ifndef SHM_BOOK_PUBLISHER_H
+#define SHM_BOOK_PUBLISHER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include "sdk/shm_layout.h"
+#include "sdk/shm_segment.h"
+
+namespace Taifex {
+
+/**
+ * @brief Settings for publishing books to other processes through POSIX shared memory.
+ *
+ * The capacities fix the segment layout. Products with a handle beyond `product_capacity` and
+ * books beyond `book_capacity` are not published.
+ */
+struct ShmPublicationConfig {
+    /** @brief shm_open name, e.g. "/taifex_books". */
+    std::string name;
+    uint32_t product_capacity = 65536;
+    uint32_t book_capacity = 65536;
+    /** @brief Levels per side published for each book; at most `BookSnapshot::MAX_LEVELS`. */
+    uint32_t depth = 5;
+    /** @brief Remove the name when the publisher closes. Mapped readers keep the last state. */
+    bool unlink_on_close = true;
+};
+
+/**
+ * @brief Writes products, top-N books and a BBO table into a shared-memory segment laid out as
+ *        described in shm_layout.h, for `ShmBookReader`s in other processes.
+ *
+ * Every record is seqlock protected, so the single writer (the thread calling
+ * `TaifexSdk::process_message`) never waits for readers and readers never see torn records.
+ */
+class ShmBookPublisher {
+public:
+    ShmBookPublisher() = default;
+    ~ShmBookPublisher();
+
+    ShmBookPublisher(const ShmBookPublisher&) = delete;
+    ShmBookPublisher& operator=(const ShmBookPublisher&) = delete;
+
+    /**
+     * @brief Creates and maps the segment. A segment left behind by a publisher that is no longer
+     *        running is replaced.
+     * @return False if the name is in use by a live publisher or the segment could not be
+     *         created or mapped.
+     */
+    bool open(const ShmPublicationConfig& config);
+
+    /** @brief Marks the segment closed for readers and unmaps it. */
+    void close();
+
+    bool is_open() const { return segment_.is_open(); }
+    /** @brief The mapped segment, e.g. for `TaifexSdk::warm_up` to prefault. */
+    const ShmSegment& segment() const { return segment_; }
+
+    /** @brief Publishes the product at its handle. */
+    void publish_product(ProductHandle handle, const ProductInfo& info);
+
+    /**
+     * @brief Adds a book to the directory and publishes its current state.
+     * @return The book's index, or `INVALID_SHM_BOOK_INDEX` if the directory is full.
+     */
+    ShmBookIndex add_book(const OrderBookManagement::OrderBook& book, ProductHandle product);
+
+    /** @brief Republishes the book's top levels and BBO entry. */
+    void publish_book(ShmBookIndex index, const OrderBookManagement::OrderBook& book);
+
+    uint32_t book_count() const;
+
+    static size_t segment_size_for(uint32_t product_capacity, uint32_t book_capacity);
+
+private:
+    ShmProductRecord* products() const;
+    ShmBookRecord* books() const;
+    ShmBboRecord* bbos() const;
+
+    ShmSegment segment_;
+    ShmSegmentHeader* header_ = nullptr; // Start of segment_, null while closed.
+};
+
+} // namespace Taifex
+#endif // SHM_BOOK_PUBLISHER_H
@@ -0,0 +1,145 @@
+#include "sdk/shm_book_reader.h"
+
+#include <algorithm> // For std::min
+
+namespace Taifex {
+
+namespace {
+std::string_view trim_trailing_spaces(std::string_view value) {
+    const size_t end = value.find_last_not_of(' ');
+    return end == std::string_view::npos ? std::string_view() : value.substr(0, end + 1);
+}
+} // namespace
+
+ShmBookReader::~ShmBookReader() {
+    close();
+}
+
+const ShmProductRecord* ShmBookReader::products() const {
+    return reinterpret_cast<const ShmProductRecord*>(reinterpret_cast<const unsigned char*>(header_) +
+                                                     header_->products_offset);
+}
+
+const ShmBookRecord* ShmBookReader::books() const {
+    return reinterpret_cast<const ShmBookRecord*>(reinterpret_cast<const unsigned char*>(header_) +
+                                                  header_->books_offset);
+}
+
+const ShmBboRecord* ShmBookReader::bbos() const {
+    return reinterpret_cast<const ShmBboRecord*>(reinterpret_cast<const unsigned char*>(header_) +
+                                                 header_->bbo_offset);
+}
+
+bool ShmBookReader::open(const std::string& name) {
+    close();
+    if (!segment_.attach(name, SHM_SEGMENT_MAGIC, SHM_LAYOUT_VERSION, false)) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const ShmSegmentHeader*>(segment_.data());
+    if (segment_.size() < sizeof(ShmSegmentHeader) || header->total_size > segment_.size()) {
+        segment_.close();
+        return false;
+    }
+    header_ = header;
+    refresh();
+    return true;
+}
+
+void ShmBookReader::close() {
+    segment_.close();
+    header_ = nullptr;
+    indexed_products_ = 0;
+    indexed_books_ = 0;
+    product_index_.clear();
+    book_index_.clear();
+}
+
+bool ShmBookReader::publisher_alive() const {
+    return segment_.publisher_alive();
+}
+
+size_t ShmBookReader::refresh() {
+    if (!header_) {
+        return 0;
+    }
+    size_t added = 0;
+    const uint32_t product_count = this->product_count();
+    for (uint32_t handle = indexed_products_; handle < product_count; ++handle) {
+        ProductInfo info;
+        // Handles may be published out of order; unwritten ones are picked up by a later refresh.
+        if (products()[handle].info.sequence() == 0 || !products()[handle].info.load(info)) {
+            break;
+        }
+        product_index_.emplace(std::string(info.id()), handle);
+        indexed_products_ = handle + 1;
+        ++added;
+    }
+    const uint32_t book_count = this->book_count();
+    for (ShmBookIndex index = indexed_books_; index < book_count; ++index) {
+        book_index_.emplace(std::string(book_prod_id(index)), index);
+        ++added;
+    }
+    indexed_books_ = book_count;
+    return added;
+}
+
+uint32_t ShmBookReader::product_count() const {
+    return header_ ? std::min(header_->product_count.load(std::memory_order_acquire), header_->product_capacity) : 0;
+}
+
+uint32_t ShmBookReader::book_count() const {
+    return header_ ? std::min(header_->book_count.load(std::memory_order_acquire), header_->book_capacity) : 0;
+}
+
+uint32_t ShmBookReader::depth() const {
+    return header_ ? header_->depth : 0;
+}
+
+std::optional<ProductInfo> ShmBookReader::get_product_info(std::string_view prod_id_s) const {
+    auto it = product_index_.find(std::string(trim_trailing_spaces(prod_id_s)));
+    if (it == product_index_.end()) {
+        return std::nullopt;
+    }
+    return get_product_info(it->second);
+}
+
+std::optional<ProductInfo> ShmBookReader::get_product_info(ProductHandle handle) const {
+    if (handle >= product_count() || products()[handle].info.sequence() == 0) {
+        return std::nullopt;
+    }
+    ProductInfo info;
+    if (!products()[handle].info.load(info)) {
+        return std::nullopt;
+    }
+    return info;
+}
+
+ShmBookIndex ShmBookReader::find_book(std::string_view prod_id) const {
+    auto it = book_index_.find(std::string(trim_trailing_spaces(prod_id)));
+    return it == book_index_.end() ? INVALID_SHM_BOOK_INDEX : it->second;
+}
+
+std::string_view ShmBookReader::book_prod_id(ShmBookIndex index) const {
+    if (index >= book_count()) {
+        return {};
+    }
+    return trim_trailing_spaces(std::string_view(books()[index].prod_id, ShmBookRecord::PROD_ID_LENGTH));
+}
+
+ProductHandle ShmBookReader::book_product(ShmBookIndex index) const {
+    return index < book_count() ? books()[index].product : INVALID_PRODUCT_HANDLE;
+}
+
+bool ShmBookReader::read_book(ShmBookIndex index, BookSnapshot& out) const {
+    return index < book_count() && books()[index].snapshot.load(out);
+}
+
+bool ShmBookReader::read_bbo(ShmBookIndex index, ShmBbo& out) const {
+    return index < book_count() && bbos()[index].bbo.load(out);
+}
+
+bool ShmBookReader::get_order_book(std::string_view prod_id, BookSnapshot& out) const {
+    return read_book(find_book(prod_id), out);
+}
+
+} // namespace Taifex
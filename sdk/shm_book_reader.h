@@ -0,0 +1,86 @@
+#ifndef SHM_BOOK_READER_H
+#define SHM_BOOK_READER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "sdk/shm_layout.h"
+#include "sdk/shm_segment.h"
+
+namespace Taifex {
+
+/**
+ * @brief Read-only view of a segment written by `ShmBookPublisher` (see shm_layout.h), for
+ *        processes that consume books without running their own `TaifexSdk`.
+ *
+ * Reads copy single records out of the mapping under their seqlock; nothing is parsed or
+ * rebuilt. Name lookups use a local index of the directories, extended by `refresh()`; lookups
+ * by index need no refresh. Built as the standalone `taifex_shm_reader` library.
+ *
+ * A reader is used from one thread; open several for several threads.
+ */
+class ShmBookReader {
+public:
+    ShmBookReader() = default;
+    ~ShmBookReader();
+
+    ShmBookReader(const ShmBookReader&) = delete;
+    ShmBookReader& operator=(const ShmBookReader&) = delete;
+
+    /**
+     * @brief Maps the named segment and indexes its directories.
+     * @return False if it does not exist or has an unknown layout.
+     */
+    bool open(const std::string& name);
+    void close();
+    bool is_open() const { return segment_.is_open(); }
+
+    /** @brief False once the publisher has closed the segment; the last published state stays readable. */
+    bool publisher_alive() const;
+
+    /** @brief Indexes products and books published since the last call. @return Number of new entries. */
+    size_t refresh();
+
+    uint32_t product_count() const;
+    uint32_t book_count() const;
+    /** @brief Levels per side the publisher copies into each book. */
+    uint32_t depth() const;
+
+    /** @brief Product reference data by PROD-ID-S (trimmed or space padded), as of the last `refresh()`. */
+    std::optional<ProductInfo> get_product_info(std::string_view prod_id_s) const;
+    std::optional<ProductInfo> get_product_info(ProductHandle handle) const;
+
+    /** @brief Book index by PROD-ID (trimmed or space padded), as of the last `refresh()`. */
+    ShmBookIndex find_book(std::string_view prod_id) const;
+
+    /** @brief PROD-ID of a book, without trailing spaces. Empty for an unknown index. */
+    std::string_view book_prod_id(ShmBookIndex index) const;
+    /** @brief Handle of the I010 product a book derives from. */
+    ProductHandle book_product(ShmBookIndex index) const;
+
+    /** @return False for an unknown index or if no consistent copy could be taken. */
+    bool read_book(ShmBookIndex index, BookSnapshot& out) const;
+    bool read_bbo(ShmBookIndex index, ShmBbo& out) const;
+
+    /** @brief Convenience: `find_book` then `read_book`. */
+    bool get_order_book(std::string_view prod_id, BookSnapshot& out) const;
+
+private:
+    const ShmProductRecord* products() const;
+    const ShmBookRecord* books() const;
+    const ShmBboRecord* bbos() const;
+
+    ShmSegment segment_;
+    const ShmSegmentHeader* header_ = nullptr; // Start of segment_, null while closed.
+    uint32_t indexed_products_ = 0;
+    uint32_t indexed_books_ = 0;
+    std::unordered_map<std::string, ProductHandle> product_index_; // Trimmed PROD-ID-S
+    std::unordered_map<std::string, ShmBookIndex> book_index_;     // Trimmed PROD-ID
+};
+
+} // namespace Taifex
+#endif // SHM_BOOK_READER_H
@@ -0,0 +1,147 @@
+#include "sdk/shm_event_publisher.h"
+
+#include "logger.h"
+
+#include <algorithm> // For std::min
+#include <bit>
+#include <cerrno>
+#include <cstring>   // For std::memcpy, std::memset, std::strerror
+
+#include <signal.h>
+
+namespace Taifex {
+
+namespace {
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+struct Layout {
+    uint32_t capacity;
+    size_t books_offset;
+    size_t readers_offset;
+    size_t slots_offset;
+    size_t total_size;
+};
+
+Layout compute_layout(uint32_t capacity, uint32_t book_capacity, uint32_t max_readers) {
+    Layout layout;
+    layout.capacity = std::bit_ceil(std::max<uint32_t>(capacity, 2));
+    layout.books_offset = align_up(sizeof(ShmEventRingHeader), 64);
+    layout.readers_offset = align_up(layout.books_offset + sizeof(ShmEventBookRecord) * book_capacity, 64);
+    layout.slots_offset = align_up(layout.readers_offset + sizeof(ShmEventReaderRecord) * max_readers, 64);
+    layout.total_size = layout.slots_offset + sizeof(ShmEventSlot) * layout.capacity;
+    return layout;
+}
+} // namespace
+
+ShmEventPublisher::~ShmEventPublisher() {
+    close();
+}
+
+size_t ShmEventPublisher::segment_size_for(uint32_t capacity, uint32_t book_capacity, uint32_t max_readers) {
+    return compute_layout(capacity, book_capacity, max_readers).total_size;
+}
+
+bool ShmEventPublisher::open(const ShmEventRingConfig& config) {
+    close();
+    if (config.name.empty()) {
+        LOG_ERROR << "ShmEventPublisher: no segment name configured.";
+        return false;
+    }
+    const Layout layout = compute_layout(config.capacity, config.book_capacity, config.max_readers);
+    if (!segment_.create(config.name, layout.total_size, SHM_EVENT_RING_MAGIC, SHM_EVENT_RING_VERSION,
+                         config.unlink_on_close)) {
+        LOG_ERROR << "ShmEventPublisher: cannot create " << config.name << ": "
+                  << (errno == EEXIST ? "in use by another running publisher" : std::strerror(errno));
+        return false;
+    }
+    header_ = reinterpret_cast<ShmEventRingHeader*>(segment_.data());
+    header_->capacity = layout.capacity;
+    header_->book_capacity = config.book_capacity;
+    header_->max_readers = config.max_readers;
+    header_->books_offset = layout.books_offset;
+    header_->readers_offset = layout.readers_offset;
+    header_->slots_offset = layout.slots_offset;
+    header_->total_size = layout.total_size;
+    slots_ = reinterpret_cast<ShmEventSlot*>(segment_.data() + layout.slots_offset);
+    mask_ = layout.capacity - 1;
+    next_sequence_ = 0;
+    segment_.set_state(ShmSegmentState::LIVE);
+    LOG_INFO << "ShmEventPublisher: created " << config.name << " (" << layout.capacity << " events, "
+             << layout.total_size << " bytes).";
+    return true;
+}
+
+void ShmEventPublisher::close() {
+    if (!segment_.is_open()) {
+        return;
+    }
+    LOG_INFO << "ShmEventPublisher: closed " << segment_.name() << " after " << next_sequence_ << " events.";
+    segment_.close();
+    header_ = nullptr;
+    slots_ = nullptr;
+}
+
+void ShmEventPublisher::add_book(BookHandle book, std::string_view prod_id, ProductHandle product) {
+    if (!header_ || book >= header_->book_capacity) {
+        return;
+    }
+    auto* records = reinterpret_cast<ShmEventBookRecord*>(segment_.data() + header_->books_offset);
+    ShmEventBookRecord& record = records[book];
+    std::memset(record.prod_id, ' ', ShmEventBookRecord::PROD_ID_LENGTH);
+    std::memcpy(record.prod_id, prod_id.data(), std::min(prod_id.size(), ShmEventBookRecord::PROD_ID_LENGTH));
+    record.product = product;
+    if (book >= header_->book_count.load(std::memory_order_relaxed)) {
+        header_->book_count.store(book + 1, std::memory_order_release);
+    }
+}
+
+void ShmEventPublisher::publish(std::span<const CoreUtils::NormalizedEvent> events) {
+    if (!header_ || events.empty()) {
+        return;
+    }
+    // In chunks of at most one ring, so claimed never runs more than a lap ahead of published.
+    while (!events.empty()) {
+        const size_t count = std::min<size_t>(events.size(), header_->capacity);
+        const uint64_t end = next_sequence_ + count;
+        header_->claimed.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t words[ShmEventSlot::WORD_COUNT];
+            std::memcpy(words, &events[i], sizeof(words));
+            ShmEventSlot& slot = slots_[(next_sequence_ + i) & mask_];
+            for (size_t w = 0; w < ShmEventSlot::WORD_COUNT; ++w) {
+                slot.words[w].store(words[w], std::memory_order_relaxed);
+            }
+        }
+        header_->published.store(end, std::memory_order_release);
+        next_sequence_ = end;
+        events = events.subspan(count);
+    }
+}
+
+uint64_t ShmEventPublisher::published_count() const {
+    return next_sequence_;
+}
+
+uint64_t ShmEventPublisher::max_reader_lag() const {
+    if (!header_) {
+        return 0;
+    }
+    const auto* readers = reinterpret_cast<const ShmEventReaderRecord*>(segment_.data() + header_->readers_offset);
+    uint64_t lag = 0;
+    for (uint32_t i = 0; i < header_->max_readers; ++i) {
+        const int32_t pid = readers[i].pid.load(std::memory_order_acquire);
+        if (pid <= 0 || (kill(pid, 0) != 0 && errno != EPERM)) {
+            continue;
+        }
+        const uint64_t cursor = readers[i].cursor.load(std::memory_order_relaxed);
+        if (cursor < next_sequence_) {
+            lag = std::max(lag, next_sequence_ - cursor);
+        }
+    }
+    return lag;
+}
+
+} // namespace Taifex
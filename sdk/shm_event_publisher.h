@@ -0,0 +1,76 @@
+#ifndef SHM_EVENT_PUBLISHER_H
+#define SHM_EVENT_PUBLISHER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "normalized_event.h"
+#include "sdk/shm_layout.h"
+#include "sdk/shm_segment.h"
+
+namespace Taifex {
+
+/** @brief Settings for the shared-memory event ring. */
+struct ShmEventRingConfig {
+    /** @brief shm_open name, e.g. "/taifex_events". */
+    std::string name;
+    /** @brief Events kept; rounded up to a power of two. 64 bytes each. */
+    uint32_t capacity = 1u << 20;
+    /** @brief BookHandles beyond this have no directory entry (their events are still published). */
+    uint32_t book_capacity = 65536;
+    /** @brief Readers that can register their cursor for `max_reader_lag`. */
+    uint32_t max_readers = 32;
+    bool unlink_on_close = true;
+};
+
+/**
+ * @brief Single producer of a shared-memory `NormalizedEvent` ring (layout in shm_layout.h) read
+ *        by any number of `ShmEventReader`s, each at its own cursor.
+ *
+ * Publishing never waits: a reader that falls more than `capacity` events behind is overrun and
+ * detects it. Called from the thread running `TaifexSdk::process_message`.
+ */
+class ShmEventPublisher {
+public:
+    ShmEventPublisher() = default;
+    ~ShmEventPublisher();
+
+    ShmEventPublisher(const ShmEventPublisher&) = delete;
+    ShmEventPublisher& operator=(const ShmEventPublisher&) = delete;
+
+    /** @return False if the name is held by a live publisher or the segment could not be created. */
+    bool open(const ShmEventRingConfig& config);
+    void close();
+    bool is_open() const { return segment_.is_open(); }
+    /** @brief The mapped segment, e.g. for `TaifexSdk::warm_up` to prefault. */
+    const ShmSegment& segment() const { return segment_; }
+
+    /** @brief Adds the directory entry for a book. Call before publishing its first event. */
+    void add_book(BookHandle book, std::string_view prod_id, ProductHandle product);
+
+    /** @brief Appends events and makes them visible to readers at once. */
+    void publish(std::span<const CoreUtils::NormalizedEvent> events);
+
+    /** @brief Events published since the ring was opened. */
+    uint64_t published_count() const;
+
+    /** @brief How many published events the slowest registered live reader has not read yet. */
+    uint64_t max_reader_lag() const;
+
+    uint32_t capacity() const { return header_ ? header_->capacity : 0; }
+
+    static size_t segment_size_for(uint32_t capacity, uint32_t book_capacity, uint32_t max_readers);
+
+private:
+    ShmSegment segment_;
+    ShmEventRingHeader* header_ = nullptr; // Start of segment_, null while closed.
+    ShmEventSlot* slots_ = nullptr;
+    uint64_t mask_ = 0;
+    uint64_t next_sequence_ = 0;
+};
+
+} // namespace Taifex
+#endif // SHM_EVENT_PUBLISHER_H
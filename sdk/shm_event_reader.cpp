@@ -0,0 +1,150 @@
+#include "sdk/shm_event_reader.h"
+
+#include <algorithm> // For std::min, std::copy
+#include <bit>
+#include <cerrno>
+#include <cstring>   // For std::memcpy
+
+#include <signal.h>
+#include <unistd.h>
+
+namespace Taifex {
+
+ShmEventReader::~ShmEventReader() {
+    close();
+}
+
+const ShmEventRingHeader* ShmEventReader::header() const {
+    return reinterpret_cast<const ShmEventRingHeader*>(segment_.data());
+}
+
+const ShmEventBookRecord* ShmEventReader::books() const {
+    return reinterpret_cast<const ShmEventBookRecord*>(segment_.data() + header()->books_offset);
+}
+
+const ShmEventSlot* ShmEventReader::slots() const {
+    return reinterpret_cast<const ShmEventSlot*>(segment_.data() + header()->slots_offset);
+}
+
+bool ShmEventReader::open(const std::string& name, StartAt start) {
+    close();
+    if (!segment_.attach(name, SHM_EVENT_RING_MAGIC, SHM_EVENT_RING_VERSION, true)) {
+        return false;
+    }
+    const ShmEventRingHeader* hdr = header();
+    if (segment_.size() < sizeof(ShmEventRingHeader) || hdr->total_size > segment_.size() ||
+        !std::has_single_bit(hdr->capacity)) {
+        segment_.close();
+        return false;
+    }
+    mask_ = hdr->capacity - 1;
+    const uint64_t published = hdr->published.load(std::memory_order_acquire);
+    if (start == StartAt::LATEST) {
+        cursor_ = published;
+    } else {
+        cursor_ = published > hdr->capacity ? published - hdr->capacity : 0;
+    }
+
+    // Take a free registration slot, or one left by a reader that no longer runs.
+    auto* readers = reinterpret_cast<ShmEventReaderRecord*>(segment_.data() + hdr->readers_offset);
+    const int32_t self = static_cast<int32_t>(getpid());
+    for (uint32_t i = 0; i < hdr->max_readers && !registration_; ++i) {
+        int32_t pid = readers[i].pid.load(std::memory_order_relaxed);
+        const bool free = pid == 0 || (pid != self && kill(pid, 0) != 0 && errno == ESRCH);
+        if (free && readers[i].pid.compare_exchange_strong(pid, self, std::memory_order_acq_rel)) {
+            registration_ = &readers[i];
+            registration_->overruns.store(0, std::memory_order_relaxed);
+        }
+    }
+    publish_cursor();
+    return true;
+}
+
+void ShmEventReader::close() {
+    if (registration_) {
+        registration_->pid.store(0, std::memory_order_release);
+        registration_ = nullptr;
+    }
+    segment_.close();
+    cursor_ = 0;
+    overruns_ = 0;
+    mask_ = 0;
+}
+
+bool ShmEventReader::publisher_alive() const {
+    return segment_.publisher_alive();
+}
+
+void ShmEventReader::publish_cursor() {
+    if (registration_) {
+        registration_->cursor.store(cursor_, std::memory_order_relaxed);
+        registration_->overruns.store(overruns_, std::memory_order_relaxed);
+    }
+}
+
+uint64_t ShmEventReader::available() const {
+    if (!is_open()) {
+        return 0;
+    }
+    const uint64_t published = header()->published.load(std::memory_order_acquire);
+    return published > cursor_ ? std::min<uint64_t>(published - cursor_, header()->capacity) : 0;
+}
+
+size_t ShmEventReader::poll(std::span<CoreUtils::NormalizedEvent> out) {
+    if (!is_open() || out.empty()) {
+        return 0;
+    }
+    const ShmEventRingHeader* hdr = header();
+    const uint64_t capacity = hdr->capacity;
+    const uint64_t published = hdr->published.load(std::memory_order_acquire);
+    if (published <= cursor_) {
+        return 0;
+    }
+    if (published - cursor_ > capacity) {
+        overruns_ += published - capacity - cursor_;
+        cursor_ = published - capacity;
+    }
+
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(out.size(), published - cursor_));
+    const ShmEventSlot* ring = slots();
+    for (size_t i = 0; i < count; ++i) {
+        const ShmEventSlot& slot = ring[(cursor_ + i) & mask_];
+        uint64_t words[ShmEventSlot::WORD_COUNT];
+        for (size_t w = 0; w < ShmEventSlot::WORD_COUNT; ++w) {
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&out[i], words, sizeof(words));
+    }
+    // Slots the publisher may have started overwriting while they were copied are discarded.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = hdr->claimed.load(std::memory_order_relaxed);
+    size_t valid_from = 0;
+    if (claimed > cursor_ + capacity) {
+        valid_from = static_cast<size_t>(std::min<uint64_t>(claimed - capacity - cursor_, count));
+    }
+    if (valid_from > 0) {
+        std::copy(out.begin() + valid_from, out.begin() + count, out.begin());
+        overruns_ += valid_from;
+    }
+    cursor_ += count;
+    publish_cursor();
+    return count - valid_from;
+}
+
+std::string_view ShmEventReader::book_prod_id(BookHandle book) const {
+    if (!is_open() || book >= std::min(header()->book_count.load(std::memory_order_acquire), header()->book_capacity)) {
+        return {};
+    }
+    std::string_view prod_id(books()[book].prod_id, ShmEventBookRecord::PROD_ID_LENGTH);
+    const size_t end = prod_id.find_last_not_of(' ');
+    return end == std::string_view::npos ? std::string_view() : prod_id.substr(0, end + 1);
+}
+
+ProductHandle ShmEventReader::book_product(BookHandle book) const {
+    if (!is_open() || book >= std::min(header()->book_count.load(std::memory_order_acquire), header()->book_capacity)) {
+        return INVALID_PRODUCT_HANDLE;
+    }
+    return books()[book].product;
+}
+
+} // namespace Taifex
@@ -0,0 +1,81 @@
+#ifndef SHM_EVENT_READER_H
+#define SHM_EVENT_READER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "normalized_event.h"
+#include "sdk/shm_layout.h"
+#include "sdk/shm_segment.h"
+
+namespace Taifex {
+
+/**
+ * @brief Consumer of a shared-memory event ring written by `ShmEventPublisher`. Each reader has
+ *        its own cursor; readers never slow the publisher or each other.
+ *
+ * If the reader falls more than the ring's capacity behind, the events it missed are skipped and
+ * counted in `overrun_count()`; books built from the stream should then be rebuilt from the
+ * next snapshot (BOOK_CLEAR) of each book or from an `ShmBookReader`. Part of the
+ * `taifex_shm_reader` library. One thread per reader.
+ */
+class ShmEventReader {
+public:
+    enum class StartAt {
+        LATEST, ///< Only events published after `open()`.
+        OLDEST  ///< The oldest event still in the ring.
+    };
+
+    ShmEventReader() = default;
+    ~ShmEventReader();
+
+    ShmEventReader(const ShmEventReader&) = delete;
+    ShmEventReader& operator=(const ShmEventReader&) = delete;
+
+    /**
+     * @brief Maps the ring and registers this reader's cursor in it (if a registration slot is free).
+     * @return False if the ring does not exist or has an unknown layout.
+     */
+    bool open(const std::string& name, StartAt start = StartAt::LATEST);
+    void close();
+    bool is_open() const { return segment_.is_open(); }
+
+    /** @brief False once the publisher has closed the ring; events already published stay readable. */
+    bool publisher_alive() const;
+
+    /**
+     * @brief Copies the next events, in order, into `out`.
+     * @return Number copied; 0 if none are available (or every copied event was overrun, in
+     *         which case the next call continues after the loss).
+     */
+    size_t poll(std::span<CoreUtils::NormalizedEvent> out);
+
+    /** @brief Sequence of the next event this reader will return. */
+    uint64_t cursor() const { return cursor_; }
+    /** @brief Events published but not read yet (capped at the ring capacity). */
+    uint64_t available() const;
+    /** @brief Events lost because the publisher lapped this reader. */
+    uint64_t overrun_count() const { return overruns_; }
+
+    /** @brief PROD-ID of a `NormalizedEvent::book`, without trailing spaces. Empty if unknown. */
+    std::string_view book_prod_id(BookHandle book) const;
+    ProductHandle book_product(BookHandle book) const;
+
+private:
+    const ShmEventRingHeader* header() const;
+    const ShmEventBookRecord* books() const;
+    const ShmEventSlot* slots() const;
+    void publish_cursor();
+
+    ShmSegment segment_;
+    ShmEventReaderRecord* registration_ = nullptr;
+    uint64_t cursor_ = 0;
+    uint64_t overruns_ = 0;
+    uint64_t mask_ = 0;
+};
+
+} // namespace Taifex
+#endif // SHM_EVENT_READER_H
@@ -0,0 +1,220 @@
+#ifndef SHM_LAYOUT_H
+#define SHM_LAYOUT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring> // For std::memcpy
+#include <limits>
+#include <type_traits>
+
+#include "normalized_event.h"
+#include "order_book/order_book.h"
+#include "sdk/product_registry.h"
+#include "sdk/sdk_reader.h" // For BookSnapshot
+
+namespace Taifex {
+
+/**
+ * Layouts of the shared-memory segments written by `ShmBookPublisher` / `ShmEventPublisher` and
+ * mapped by `ShmBookReader` / `ShmEventReader`. Everything is addressed by offsets from the start
+ * of the segment, so each process may map it anywhere. Both start with a `ShmSegmentPrefix`.
+ *
+ * Book segment:
+ *   ShmSegmentHeader | ShmProductRecord[product_capacity] | ShmBookRecord[book_capacity]
+ *                    | ShmBboRecord[book_capacity]
+ *
+ * Products are stored at their `ProductHandle`; books and their BBO entries share an index
+ * assigned when the book is created. Directory entries are appended, never moved or removed.
+ *
+ * Event ring segment:
+ *   ShmEventRingHeader | ShmEventBookRecord[book_capacity] | ShmEventReaderRecord[max_readers]
+ *                      | ShmEventSlot[capacity]
+ *
+ * Event sequence s is stored in slot s % capacity. The publisher never waits for readers: it
+ * raises `claimed` before overwriting slots and `published` once they are complete, and a reader
+ * that finds `claimed` more than `capacity` ahead of what it copied knows it was overrun.
+ */
+
+inline constexpr char SHM_SEGMENT_MAGIC[8] = {'T', 'X', 'S', 'H', 'M', 'B', 'K', '\0'};
+inline constexpr uint32_t SHM_LAYOUT_VERSION = 1;
+
+/** @brief Index of a book (and its BBO entry) in the segment. */
+using ShmBookIndex = uint32_t;
+constexpr ShmBookIndex INVALID_SHM_BOOK_INDEX = std::numeric_limits<ShmBookIndex>::max();
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "Atomics in shared memory must be lock-free to be address-free.");
+
+/**
+ * @brief Seqlock over a trivially copyable value placed in shared memory. One writer; readers in
+ *        any process retry while a write is in progress and never block the writer.
+ *
+ * The value is held in atomic words so that concurrent reads are not data races. A zero-filled
+ * instance is valid and reads as never written (`sequence() == 0`).
+ */
+template <typename T>
+class ShmSeqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "ShmSeqlock copies values word by word.");
+
+public:
+    /** @brief Single writer. */
+    void store(const T& value) {
+        uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the value, retrying up to `max_attempts` times while it is being written.
+     * @return False if no consistent copy was obtained (e.g. the writer died mid-write).
+     */
+    bool load(T& out, uint32_t max_attempts = 1u << 16) const {
+        uint64_t words[WORD_COUNT];
+        for (uint32_t attempt = 0; attempt < max_attempts; ++attempt) {
+            const uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue; // Write in progress.
+            }
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&out, words, sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief Twice the number of completed writes (odd during a write). */
+    uint64_t sequence() const { return sequence_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_;
+    std::atomic<uint64_t> words_[WORD_COUNT];
+};
+
+/** @brief Segment state in `ShmSegmentPrefix::state`. */
+enum class ShmSegmentState : uint32_t {
+    INITIALISING = 0,
+    LIVE = 1,   ///< A publisher is attached.
+    CLOSED = 2  ///< The publisher detached; contents are the last state it published.
+};
+
+/** @brief First bytes of every segment: identity and publisher liveness. */
+struct ShmSegmentPrefix {
+    char     magic[8];
+    uint32_t version;
+    std::atomic<uint32_t> state; // ShmSegmentState
+    int32_t  publisher_pid;
+    uint32_t reserved;
+};
+
+struct alignas(64) ShmSegmentHeader {
+    ShmSegmentPrefix prefix;
+    uint32_t depth;           // Levels per side published in each book (at most BookSnapshot::MAX_LEVELS).
+    uint32_t product_capacity;
+    uint32_t book_capacity;
+    uint32_t reserved;
+    uint64_t products_offset;
+    uint64_t books_offset;
+    uint64_t bbo_offset;
+    uint64_t total_size;
+    std::atomic<uint32_t> product_count; // One past the highest product handle published.
+    std::atomic<uint32_t> book_count;    // Books in the directory; entries below it are complete.
+};
+
+/** @brief Product directory entry, at the product's handle. Never written: `sequence() == 0`. */
+struct alignas(64) ShmProductRecord {
+    ShmSeqlock<ProductInfo> info;
+};
+
+/**
+ * @brief Book directory entry. `prod_id` and `product` are written once, before the entry is
+ *        counted in `ShmSegmentHeader::book_count`; `snapshot` is republished on every change.
+ */
+struct alignas(64) ShmBookRecord {
+    static constexpr size_t PROD_ID_LENGTH = 20;
+
+    char          prod_id[PROD_ID_LENGTH]; // Space padded, as in I081/I083.
+    ProductHandle product;                 // Handle of the I010 product the book derives from.
+    uint32_t      reserved;
+    ShmSeqlock<BookSnapshot> snapshot;     // `version` counts publications of this book.
+};
+
+/** @brief Best bid and offer of one book; the compact table for scanning many books. */
+struct ShmBbo {
+    uint32_t last_prod_msg_seq;
+    uint8_t  decimal_locator;
+    bool     stale;
+    bool     has_bid;
+    bool     has_ask;
+    OrderBookManagement::PriceQuantityLevel bid;
+    OrderBookManagement::PriceQuantityLevel ask;
+};
+
+struct alignas(64) ShmBboRecord {
+    ShmSeqlock<ShmBbo> bbo;
+};
+
+static_assert(sizeof(ShmBboRecord) == 64, "A BBO entry fills one cache line.");
+
+// --- Event ring ---
+
+inline constexpr char SHM_EVENT_RING_MAGIC[8] = {'T', 'X', 'S', 'H', 'M', 'E', 'V', '\0'};
+inline constexpr uint32_t SHM_EVENT_RING_VERSION = 1;
+
+struct alignas(64) ShmEventRingHeader {
+    ShmSegmentPrefix prefix;
+    uint32_t capacity;     // Slots; a power of two.
+    uint32_t book_capacity;
+    uint32_t max_readers;
+    uint32_t reserved;
+    uint64_t books_offset;
+    uint64_t readers_offset;
+    uint64_t slots_offset;
+    uint64_t total_size;
+    std::atomic<uint32_t> book_count; // One past the highest BookHandle in the directory.
+    alignas(64) std::atomic<uint64_t> claimed;   // Events below this sequence are written or being written.
+    alignas(64) std::atomic<uint64_t> published; // Events below this sequence are complete.
+};
+
+/**
+ * @brief Directory entry of a `NormalizedEvent::book`, at the BookHandle. Written before the
+ *        handle is counted in `book_count`, which happens before any event for it is published.
+ */
+struct ShmEventBookRecord {
+    static constexpr size_t PROD_ID_LENGTH = 20;
+
+    char          prod_id[PROD_ID_LENGTH]; // Space padded.
+    ProductHandle product;
+};
+
+/** @brief A reader's registration, so the publisher can report how far behind readers are. */
+struct alignas(64) ShmEventReaderRecord {
+    std::atomic<int32_t>  pid;      // 0 when free.
+    std::atomic<uint64_t> cursor;   // Next sequence the reader will read.
+    std::atomic<uint64_t> overruns; // Events it lost to being lapped.
+};
+
+/** @brief One `NormalizedEvent`, held in atomic words so that lapping readers are not data races. */
+struct alignas(64) ShmEventSlot {
+    static constexpr size_t WORD_COUNT = sizeof(CoreUtils::NormalizedEvent) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> words[WORD_COUNT];
+};
+
+static_assert(sizeof(ShmEventSlot) == sizeof(CoreUtils::NormalizedEvent), "An event slot holds exactly one event.");
+
+} // namespace Taifex
+#endif // SHM_LAYOUT_H
@@ -0,0 +1,136 @@
+#include "sdk/shm_segment.h"
+
+#include <cerrno>
+#include <cstring> // For std::memcmp, std::memcpy, std::strerror
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Taifex {
+
+namespace {
+// True if `name` exists and belongs to a publisher that is still running.
+bool held_by_live_publisher(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    bool live = false;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(ShmSegmentPrefix)) {
+        void* mapping = mmap(nullptr, sizeof(ShmSegmentPrefix), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            const auto* prefix = static_cast<const ShmSegmentPrefix*>(mapping);
+            live = prefix->state.load(std::memory_order_acquire) == static_cast<uint32_t>(ShmSegmentState::LIVE) &&
+                   prefix->publisher_pid > 0 && (kill(prefix->publisher_pid, 0) == 0 || errno == EPERM);
+            munmap(mapping, sizeof(ShmSegmentPrefix));
+        }
+    }
+    ::close(fd);
+    return live;
+}
+} // namespace
+
+ShmSegment::~ShmSegment() {
+    close();
+}
+
+bool ShmSegment::create(const std::string& name, size_t size, const char (&magic)[8], uint32_t version,
+                        bool unlink_on_close) {
+    close();
+    if (name.empty() || size < sizeof(ShmSegmentPrefix)) {
+        return false;
+    }
+    if (held_by_live_publisher(name)) {
+        errno = EEXIST;
+        return false;
+    }
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        const int saved = errno;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        errno = saved;
+        return false;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        const int saved = errno;
+        shm_unlink(name.c_str());
+        errno = saved;
+        return false;
+    }
+    base_ = static_cast<unsigned char*>(mapping);
+    size_ = size;
+    name_ = name;
+    created_ = true;
+    unlink_on_close_ = unlink_on_close;
+    ShmSegmentPrefix* header = prefix();
+    std::memcpy(header->magic, magic, sizeof(header->magic));
+    header->version = version;
+    header->publisher_pid = static_cast<int32_t>(getpid());
+    return true;
+}
+
+bool ShmSegment::attach(const std::string& name, const char (&magic)[8], uint32_t version, bool writable) {
+    close();
+    int fd = shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmSegmentPrefix)) {
+        ::close(fd);
+        return false;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    const auto* header = static_cast<const ShmSegmentPrefix*>(mapping);
+    if (std::memcmp(header->magic, magic, sizeof(header->magic)) != 0 || header->version != version) {
+        munmap(mapping, size);
+        return false;
+    }
+    base_ = static_cast<unsigned char*>(mapping);
+    size_ = size;
+    name_ = name;
+    created_ = false;
+    return true;
+}
+
+void ShmSegment::close() {
+    if (!base_) {
+        return;
+    }
+    if (created_) {
+        set_state(ShmSegmentState::CLOSED);
+    }
+    munmap(base_, size_);
+    if (created_ && unlink_on_close_) {
+        shm_unlink(name_.c_str());
+    }
+    base_ = nullptr;
+    size_ = 0;
+    created_ = false;
+}
+
+void ShmSegment::set_state(ShmSegmentState state) {
+    prefix()->state.store(static_cast<uint32_t>(state), std::memory_order_release);
+}
+
+bool ShmSegment::publisher_alive() const {
+    return base_ && prefix()->state.load(std::memory_order_acquire) == static_cast<uint32_t>(ShmSegmentState::LIVE);
+}
+
+} // namespace Taifex
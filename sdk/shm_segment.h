@@ -0,0 +1,61 @@
+#ifndef SHM_SEGMENT_H
+#define SHM_SEGMENT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include "sdk/shm_layout.h"
+
+namespace Taifex {
+
+/**
+ * @brief A named POSIX shared-memory segment that starts with a `ShmSegmentPrefix`. Publishers
+ *        `create()` it, readers `attach()` to it; unmapped on destruction.
+ */
+class ShmSegment {
+public:
+    ShmSegment() = default;
+    ~ShmSegment();
+
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+
+    /**
+     * @brief Creates the segment, zero filled, with its prefix set and state INITIALISING. A
+     *        segment left behind by a publisher that is no longer running is replaced; readers
+     *        still mapping it keep the old contents.
+     * @return False if the name is held by a live publisher or the segment could not be created.
+     */
+    bool create(const std::string& name, size_t size, const char (&magic)[8], uint32_t version,
+                bool unlink_on_close);
+
+    /**
+     * @brief Maps an existing segment.
+     * @return False if it does not exist, is too small or has another magic or version.
+     */
+    bool attach(const std::string& name, const char (&magic)[8], uint32_t version, bool writable);
+
+    /** @brief A created segment is marked CLOSED (and unlinked if requested); then it is unmapped. */
+    void close();
+
+    bool is_open() const { return base_ != nullptr; }
+    unsigned char* data() const { return base_; }
+    size_t size() const { return size_; }
+    const std::string& name() const { return name_; }
+
+    ShmSegmentPrefix* prefix() const { return reinterpret_cast<ShmSegmentPrefix*>(base_); }
+    /** @brief Sets the state readers see. */
+    void set_state(ShmSegmentState state);
+    bool publisher_alive() const;
+
+private:
+    unsigned char* base_ = nullptr;
+    size_t size_ = 0;
+    std::string name_;
+    bool created_ = false;
+    bool unlink_on_close_ = false;
+};
+
+} // namespace Taifex
+#endif // SHM_SEGMENT_H
@@ -0,0 +1,399 @@
+#include "sdk/state_store.h"
+
+#include "channel_state.h" // For CoreUtils::ChannelStateTable::CHANNEL_COUNT
+#include "logger.h"
+
+#include <algorithm> // For std::min, std::max
+#include <atomic>
+#include <cerrno>
+#include <cstring>   // For std::memcpy, std::memset, std::strerror
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Taifex {
+
+namespace {
+constexpr char STATE_FILE_MAGIC[8] = {'T', 'X', 'S', 'T', 'A', 'T', 'E', '\0'};
+constexpr uint32_t STATE_FILE_VERSION = 2; // 2: book channels.
+constexpr size_t HEADER_REGION_SIZE = 128;
+
+constexpr uint8_t BOOK_FLAG_STALE = 0x01;
+constexpr uint8_t BOOK_FLAG_DERIVED_BID = 0x02;
+constexpr uint8_t BOOK_FLAG_DERIVED_ASK = 0x04;
+
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Generation protocol: odd while a record is being rewritten, even once it is complete.
+void begin_write(uint32_t& generation) {
+    std::atomic_ref<uint32_t> gen(generation);
+    gen.store(gen.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void end_write(uint32_t& generation) {
+    std::atomic_ref<uint32_t> gen(generation);
+    gen.store(gen.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// atomic_ref of a const type is C++26; the records live in the writable mapping, so a load
+// through a non-const atomic_ref is fine.
+template <typename T>
+T load_acquire(const T& value) {
+    return std::atomic_ref<T>(const_cast<T&>(value)).load(std::memory_order_acquire);
+}
+
+uint32_t load_generation(const uint32_t& generation) {
+    return load_acquire(generation);
+}
+} // namespace
+
+struct StateStore::FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t product_capacity;
+    uint32_t book_capacity;
+    uint32_t channel_count;
+    uint32_t max_levels;
+    uint32_t product_count; // One past the highest stored handle.
+    uint32_t book_count;
+    uint32_t reserved;
+    uint64_t products_offset;
+    uint64_t books_offset;
+    uint64_t channels_offset;
+};
+
+static_assert(sizeof(StateStore::FileHeader) <= HEADER_REGION_SIZE, "FileHeader must fit its region.");
+
+struct StateStore::ProductRecord {
+    uint32_t    generation;
+    uint32_t    reserved;
+    ProductInfo info;
+};
+
+struct alignas(64) StateStore::BookRecord {
+    uint32_t generation;
+    uint32_t last_prod_msg_seq;
+    char     prod_id[BOOK_PROD_ID_LENGTH]; // As used for the order book key; NUL padded.
+    uint8_t  decimal_locator;
+    uint8_t  flags;                        // BOOK_FLAG_*
+    uint8_t  bid_count;
+    uint8_t  ask_count;
+    uint8_t  channel_count;
+    uint16_t channels[MAX_BOOK_CHANNELS];  // CHANNEL-IDs the book's messages arrive on.
+    OrderBookManagement::PriceQuantityLevel bids[MAX_LEVELS];
+    OrderBookManagement::PriceQuantityLevel asks[MAX_LEVELS];
+    OrderBookManagement::PriceQuantityLevel derived_bid;
+    OrderBookManagement::PriceQuantityLevel derived_ask;
+};
+
+static_assert(std::is_trivially_copyable<OrderBookManagement::PriceQuantityLevel>::value,
+              "Book levels are stored in the state file as raw bytes.");
+
+namespace {
+struct Layout {
+    size_t products_offset;
+    size_t books_offset;
+    size_t channels_offset;
+    size_t total_size;
+};
+
+template <typename Product, typename Book>
+Layout compute_layout(uint32_t product_capacity, uint32_t book_capacity) {
+    Layout layout;
+    layout.products_offset = HEADER_REGION_SIZE;
+    layout.books_offset = align_up(layout.products_offset + sizeof(Product) * product_capacity, 64);
+    layout.channels_offset = align_up(layout.books_offset + sizeof(Book) * book_capacity, 64);
+    layout.total_size = layout.channels_offset + sizeof(uint64_t) * CoreUtils::ChannelStateTable::CHANNEL_COUNT;
+    return layout;
+}
+} // namespace
+
+StateStore::~StateStore() {
+    close();
+}
+
+size_t StateStore::file_size_for(uint32_t product_capacity, uint32_t book_capacity) {
+    return compute_layout<ProductRecord, BookRecord>(product_capacity, book_capacity).total_size;
+}
+
+StateStore::FileHeader* StateStore::header() const {
+    return reinterpret_cast<FileHeader*>(base_);
+}
+
+StateStore::ProductRecord* StateStore::product_record(uint32_t index) const {
+    return reinterpret_cast<ProductRecord*>(base_ + header()->products_offset) + index;
+}
+
+StateStore::BookRecord* StateStore::book_record(uint32_t index) const {
+    return reinterpret_cast<BookRecord*>(base_ + header()->books_offset) + index;
+}
+
+uint64_t* StateStore::channel_seqs() const {
+    return reinterpret_cast<uint64_t*>(base_ + header()->channels_offset);
+}
+
+bool StateStore::map_file(int fd, size_t size) {
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR << "StateStore: mmap failed: " << std::strerror(errno);
+        return false;
+    }
+    base_ = static_cast<unsigned char*>(mapping);
+    mapped_size_ = size;
+    return true;
+}
+
+void StateStore::initialise(const StateStoreConfig& config) {
+    const Layout layout = compute_layout<ProductRecord, BookRecord>(config.product_capacity, config.book_capacity);
+    FileHeader* hdr = header();
+    std::memset(hdr, 0, HEADER_REGION_SIZE);
+    hdr->version = STATE_FILE_VERSION;
+    hdr->product_capacity = config.product_capacity;
+    hdr->book_capacity = config.book_capacity;
+    hdr->channel_count = static_cast<uint32_t>(CoreUtils::ChannelStateTable::CHANNEL_COUNT);
+    hdr->max_levels = static_cast<uint32_t>(MAX_LEVELS);
+    hdr->products_offset = layout.products_offset;
+    hdr->books_offset = layout.books_offset;
+    hdr->channels_offset = layout.channels_offset;
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(hdr->magic, STATE_FILE_MAGIC, sizeof(STATE_FILE_MAGIC)); // Last: marks the file valid.
+}
+
+bool StateStore::open(const StateStoreConfig& config, bool& out_reattached) {
+    out_reattached = false;
+    close();
+
+    const Layout layout = compute_layout<ProductRecord, BookRecord>(config.product_capacity, config.book_capacity);
+    int fd = ::open(config.path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        LOG_ERROR << "StateStore: cannot open " << config.path << ": " << std::strerror(errno);
+        return false;
+    }
+
+    struct stat st {};
+    bool reusable = (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == layout.total_size);
+    const bool zeroed = !reusable;
+    if (!reusable) {
+        // Truncating to zero first guarantees every record starts zeroed (generation 0 = never written).
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(layout.total_size)) != 0) {
+            LOG_ERROR << "StateStore: cannot size " << config.path << ": " << std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+    }
+    const bool mapped = map_file(fd, layout.total_size);
+    ::close(fd); // The mapping keeps the file referenced.
+    if (!mapped) {
+        return false;
+    }
+
+    const FileHeader* hdr = header();
+    if (reusable) {
+        reusable = std::memcmp(hdr->magic, STATE_FILE_MAGIC, sizeof(STATE_FILE_MAGIC)) == 0 &&
+                   hdr->version == STATE_FILE_VERSION &&
+                   hdr->product_capacity == config.product_capacity &&
+                   hdr->book_capacity == config.book_capacity &&
+                   hdr->channel_count == CoreUtils::ChannelStateTable::CHANNEL_COUNT &&
+                   hdr->max_levels == MAX_LEVELS &&
+                   hdr->products_offset == layout.products_offset &&
+                   hdr->books_offset == layout.books_offset &&
+                   hdr->channels_offset == layout.channels_offset;
+    }
+    if (!reusable) {
+        if (static_cast<size_t>(st.st_size) != 0) {
+            LOG_WARNING << "StateStore: " << config.path << " does not match the configured layout. Starting fresh.";
+        }
+        if (!zeroed) {
+            std::memset(base_, 0, mapped_size_);
+        }
+        initialise(config);
+        LOG_INFO << "StateStore: created " << config.path << " (" << mapped_size_ << " bytes).";
+        return true;
+    }
+
+    out_reattached = true;
+    LOG_INFO << "StateStore: reattached to " << config.path << " with " << hdr->product_count << " products and "
+             << hdr->book_count << " books.";
+    return true;
+}
+
+void StateStore::close() {
+    if (base_) {
+        munmap(base_, mapped_size_);
+        base_ = nullptr;
+        mapped_size_ = 0;
+    }
+}
+
+void StateStore::flush() {
+    if (base_) {
+        msync(base_, mapped_size_, MS_ASYNC);
+    }
+}
+
+void StateStore::store_product(ProductHandle handle, const ProductInfo& info) {
+    if (!base_ || handle >= header()->product_capacity) {
+        return;
+    }
+    ProductRecord* record = product_record(handle);
+    begin_write(record->generation);
+    record->info = info;
+    end_write(record->generation);
+
+    std::atomic_ref<uint32_t> count(header()->product_count);
+    if (count.load(std::memory_order_relaxed) <= handle) {
+        count.store(handle + 1, std::memory_order_release);
+    }
+}
+
+uint32_t StateStore::product_count() const {
+    return base_ ? std::atomic_ref<uint32_t>(header()->product_count).load(std::memory_order_acquire) : 0;
+}
+
+bool StateStore::load_product(ProductHandle handle, ProductInfo& out_info) const {
+    if (handle >= product_count()) {
+        return false;
+    }
+    const ProductRecord* record = product_record(handle);
+    const uint32_t generation = load_generation(record->generation);
+    if (generation == 0) {
+        return false;
+    }
+    if ((generation & 1u) != 0) {
+        // A handle always belongs to the same PROD-ID-S, so only the reference data can be mixed;
+        // the next I010 rebroadcast for the product overwrites it.
+        LOG_WARNING << "StateStore: product record " << handle << " was torn by a crash; loaded until the next I010.";
+    }
+    out_info = record->info;
+    return true;
+}
+
+BookSlot StateStore::add_book(const OrderBookManagement::OrderBook& book) {
+    if (!base_) {
+        return INVALID_BOOK_SLOT;
+    }
+    std::atomic_ref<uint32_t> count(header()->book_count);
+    const uint32_t slot = count.load(std::memory_order_relaxed);
+    if (slot >= header()->book_capacity) {
+        LOG_WARNING << "StateStore: book capacity " << header()->book_capacity << " reached; "
+                    << book.get_product_id() << " will not be persisted.";
+        return INVALID_BOOK_SLOT;
+    }
+    BookRecord* record = book_record(slot);
+    const std::string& prod_id = book.get_product_id();
+    std::memset(record->prod_id, 0, BOOK_PROD_ID_LENGTH);
+    std::memcpy(record->prod_id, prod_id.data(), std::min(prod_id.size(), BOOK_PROD_ID_LENGTH));
+    record->decimal_locator = book.get_decimal_locator();
+    record->channel_count = 0;
+    store_book(slot, book);
+    count.store(slot + 1, std::memory_order_release);
+    return slot;
+}
+
+void StateStore::store_book(BookSlot slot, const OrderBookManagement::OrderBook& book) {
+    if (!base_ || slot >= header()->book_capacity) {
+        return;
+    }
+    BookRecord* record = book_record(slot);
+    begin_write(record->generation);
+    record->last_prod_msg_seq = book.get_last_prod_msg_seq();
+    record->bid_count = static_cast<uint8_t>(book.copy_top_bids(record->bids));
+    record->ask_count = static_cast<uint8_t>(book.copy_top_asks(record->asks));
+    uint8_t flags = book.is_stale() ? BOOK_FLAG_STALE : 0;
+    if (auto derived = book.get_derived_bid()) {
+        record->derived_bid = *derived;
+        flags |= BOOK_FLAG_DERIVED_BID;
+    }
+    if (auto derived = book.get_derived_ask()) {
+        record->derived_ask = *derived;
+        flags |= BOOK_FLAG_DERIVED_ASK;
+    }
+    record->flags = flags;
+    end_write(record->generation);
+}
+
+uint32_t StateStore::book_count() const {
+    return base_ ? std::atomic_ref<uint32_t>(header()->book_count).load(std::memory_order_acquire) : 0;
+}
+
+bool StateStore::load_book(BookSlot slot, OrderBookManagement::OrderBook& out_book) const {
+    if (slot >= book_count()) {
+        return false;
+    }
+    const BookRecord* record = book_record(slot);
+    // add_book writes the full record before publishing the slot, so identity is always intact.
+    out_book = OrderBookManagement::OrderBook(std::string(record->prod_id, strnlen(record->prod_id, BOOK_PROD_ID_LENGTH)),
+                                              record->decimal_locator, std::pmr::get_default_resource(),
+                                              out_book.get_max_depth());
+
+    const uint32_t generation = load_generation(record->generation);
+    if ((generation & 1u) != 0) {
+        LOG_WARNING << "StateStore: book record " << slot << " was torn by a crash; restored stale.";
+        out_book.mark_stale();
+        return true;
+    }
+    std::optional<OrderBookManagement::PriceQuantityLevel> derived_bid;
+    std::optional<OrderBookManagement::PriceQuantityLevel> derived_ask;
+    if (record->flags & BOOK_FLAG_DERIVED_BID) {
+        derived_bid = record->derived_bid;
+    }
+    if (record->flags & BOOK_FLAG_DERIVED_ASK) {
+        derived_ask = record->derived_ask;
+    }
+    out_book.restore(record->last_prod_msg_seq, (record->flags & BOOK_FLAG_STALE) != 0,
+                     std::span<const OrderBookManagement::PriceQuantityLevel>(record->bids, std::min<size_t>(record->bid_count, MAX_LEVELS)),
+                     std::span<const OrderBookManagement::PriceQuantityLevel>(record->asks, std::min<size_t>(record->ask_count, MAX_LEVELS)),
+                     derived_bid, derived_ask);
+    return true;
+}
+
+void StateStore::add_book_channel(BookSlot slot, uint32_t channel_id) {
+    if (!base_ || slot >= book_count() || channel_id >= CoreUtils::ChannelStateTable::CHANNEL_COUNT) {
+        return;
+    }
+    BookRecord* record = book_record(slot);
+    std::atomic_ref<uint8_t> count(record->channel_count);
+    const uint8_t known = count.load(std::memory_order_relaxed);
+    if (std::find(record->channels, record->channels + known, channel_id) != record->channels + known) {
+        return;
+    }
+    if (known >= MAX_BOOK_CHANNELS) {
+        LOG_WARNING << "StateStore: book record " << slot << " already has " << MAX_BOOK_CHANNELS
+                    << " channels; channel " << channel_id << " not kept.";
+        return;
+    }
+    record->channels[known] = static_cast<uint16_t>(channel_id);
+    count.store(known + 1, std::memory_order_release); // The channel is written before it is counted.
+}
+
+size_t StateStore::load_book_channels(BookSlot slot, std::span<uint16_t> out) const {
+    if (slot >= book_count()) {
+        return 0;
+    }
+    const BookRecord* record = book_record(slot);
+    const size_t count = std::min<size_t>({load_acquire(record->channel_count), MAX_BOOK_CHANNELS, out.size()});
+    std::copy(record->channels, record->channels + count, out.begin());
+    return count;
+}
+
+void StateStore::commit_channel(uint32_t channel_id, uint64_t channel_seq) {
+    if (!base_ || channel_id >= CoreUtils::ChannelStateTable::CHANNEL_COUNT) {
+        return;
+    }
+    std::atomic_ref<uint64_t>(channel_seqs()[channel_id]).store(channel_seq, std::memory_order_release);
+}
+
+uint64_t StateStore::committed_seq(uint32_t channel_id) const {
+    if (!base_ || channel_id >= CoreUtils::ChannelStateTable::CHANNEL_COUNT) {
+        return 0;
+    }
+    return std::atomic_ref<uint64_t>(channel_seqs()[channel_id]).load(std::memory_order_acquire);
+}
+
+} // namespace Taifex
@@ -0,0 +1,147 @@
+#ifndef STATE_STORE_H
+#define STATE_STORE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string>
+
+#include "sdk/product_registry.h"
+#include "order_book/order_book.h"
+
+namespace Taifex {
+
+/**
+ * @brief Settings for the memory-mapped SDK state file.
+ *
+ * The capacities fix the file layout; reattaching to a file created with different capacities
+ * discards it and starts fresh.
+ */
+struct StateStoreConfig {
+    /** @brief Path of the state file. Created if missing. */
+    std::string path;
+    uint32_t product_capacity = 65536;
+    uint32_t book_capacity = 65536;
+};
+
+/** @brief Index of a book record in the state file. */
+using BookSlot = uint32_t;
+constexpr BookSlot INVALID_BOOK_SLOT = std::numeric_limits<BookSlot>::max();
+
+/**
+ * @brief Live SDK state in a memory-mapped file: the product table, one record per order book and
+ *        the last committed CHANNEL-SEQ of every channel.
+ *
+ * The file has a fixed layout addressed by offsets from its start, with no pointers, so a
+ * restarted process can map it and continue from where the previous one stopped. Records are
+ * written through as the SDK applies frames. The mapping is shared, so the contents survive a
+ * crash of the process (not of the host, unless `flush()` was called).
+ *
+ * Each product and book record carries a generation that is odd while the record is being
+ * written. A record found with an odd generation on reattach was torn by a crash: a torn product
+ * is loaded as found and corrected by the next I010 rebroadcast, and a torn book is restored
+ * empty and stale so it resyncs from the next I083.
+ *
+ * Books are stored to `MAX_LEVELS` levels per side, which covers the disclosed depth.
+ * Single writer (the thread calling `TaifexSdk::process_message`).
+ */
+class StateStore {
+public:
+    static constexpr size_t MAX_LEVELS = 10;
+    static constexpr size_t BOOK_PROD_ID_LENGTH = 20;
+    /** @brief CHANNEL-IDs kept per book; a book is normally carried on one channel. */
+    static constexpr size_t MAX_BOOK_CHANNELS = 4;
+
+    StateStore() = default;
+    ~StateStore();
+
+    StateStore(const StateStore&) = delete;
+    StateStore& operator=(const StateStore&) = delete;
+
+    /**
+     * @brief Maps the state file, creating or re-initialising it if it is missing, invalid or was
+     *        created with different capacities.
+     * @param out_reattached Set to true if existing state was found and can be restored.
+     * @return False if the file could not be created or mapped.
+     */
+    bool open(const StateStoreConfig& config, bool& out_reattached);
+
+    /** @brief Unmaps the file. The contents stay on disk. */
+    void close();
+
+    bool is_open() const { return base_ != nullptr; }
+    /** @brief The mapping, e.g. for `TaifexSdk::warm_up` to prefault; null while closed. */
+    unsigned char* data() const { return base_; }
+    size_t size() const { return mapped_size_; }
+
+    /** @brief Schedules write-back of the mapping to disk (msync MS_ASYNC). */
+    void flush();
+
+    // --- Products, addressed by ProductHandle ---
+
+    /** @brief Writes the product's record. Handles beyond `product_capacity` are not persisted. */
+    void store_product(ProductHandle handle, const ProductInfo& info);
+    /** @return One past the highest handle stored. */
+    uint32_t product_count() const;
+    /** @return False if the handle was never stored. */
+    bool load_product(ProductHandle handle, ProductInfo& out_info) const;
+
+    // --- Order books ---
+
+    /**
+     * @brief Reserves a record for a new book and writes its current state.
+     * @return The book's slot, or `INVALID_BOOK_SLOT` if the file is full.
+     */
+    BookSlot add_book(const OrderBookManagement::OrderBook& book);
+    /** @brief Rewrites the book's record from its current state. */
+    void store_book(BookSlot slot, const OrderBookManagement::OrderBook& book);
+    uint32_t book_count() const;
+    /**
+     * @brief Rebuilds the book in `slot`.
+     * @return False if the slot was never written.
+     */
+    bool load_book(BookSlot slot, OrderBookManagement::OrderBook& out_book) const;
+    /**
+     * @brief Records that the book's I081/I083 arrive on `channel_id`, so that after a restart an
+     *        I002 on that channel still clears it. Known channels are ignored; channels beyond
+     *        `MAX_BOOK_CHANNELS` are not kept.
+     */
+    void add_book_channel(BookSlot slot, uint32_t channel_id);
+    /**
+     * @brief Copies the book's recorded CHANNEL-IDs into `out`.
+     * @return The number copied.
+     */
+    size_t load_book_channels(BookSlot slot, std::span<uint16_t> out) const;
+
+    // --- Channels ---
+
+    /** @brief Records that every frame up to `channel_seq` on the channel has been applied. */
+    void commit_channel(uint32_t channel_id, uint64_t channel_seq);
+    /** @brief Forgets the channel's committed sequence (e.g. after an I002). */
+    void clear_channel(uint32_t channel_id) { commit_channel(channel_id, 0); }
+    /** @return The last committed CHANNEL-SEQ, or 0 if none. */
+    uint64_t committed_seq(uint32_t channel_id) const;
+
+    static size_t file_size_for(uint32_t product_capacity, uint32_t book_capacity);
+
+    // On-disk record layouts, defined in state_store.cpp.
+    struct FileHeader;
+    struct ProductRecord;
+    struct BookRecord;
+
+private:
+    FileHeader* header() const;
+    ProductRecord* product_record(uint32_t index) const;
+    BookRecord* book_record(uint32_t index) const;
+    uint64_t* channel_seqs() const;
+
+    bool map_file(int fd, size_t size);
+    void initialise(const StateStoreConfig& config);
+
+    unsigned char* base_ = nullptr;
+    size_t mapped_size_ = 0;
+};
+
+} // namespace Taifex
+#endif // STATE_STORE_H
@@ -6,6 +6,11 @@
 #include "logger.h"                // Removed core_utils/ prefix
 #include "checksum.h"              // Removed core_utils/ prefix
 #include "string_utils.h"          // Added string_utils.h
+#include "error_codes.h"           // For CoreUtils::ParsingError from header getters
+#include "metrics.h"
+#include "latency_histogram.h"
+#include "allocation_tracker.h"
+#include "memory_utils.h"
 
 // Specific Message Parser function headers
 #include "messages/message_i010.h"
@@ -18,37 +23,957 @@
 #include "order_book/order_book.h" // For OrderBook type
 
 #include <iostream> // For temporary product_id extraction, remove later
+#include <algorithm>
+#include <cstdlib>  // For std::abort
+
+// Stage timestamps for the latency histograms; compiled out without TAIFEX_ENABLE_LATENCY_STATS.
+#ifdef TAIFEX_ENABLE_LATENCY_STATS
+#define TAIFEX_LATENCY_BEGIN() latency_probe_.begin()
+#define TAIFEX_LATENCY_MARK(stage) latency_probe_.mark(CoreUtils::LatencyStage::stage)
+#define TAIFEX_LATENCY_COMMIT(msg_type) latency_recorder_.commit(msg_type, latency_probe_)
+#else
+#define TAIFEX_LATENCY_BEGIN() ((void)0)
+#define TAIFEX_LATENCY_MARK(stage) ((void)0)
+#define TAIFEX_LATENCY_COMMIT(msg_type) ((void)0)
+#endif
 
 
 namespace Taifex {
 
 TaifexSdk::TaifexSdk() : initialized_(false) {
-    // Maps (product_info_cache_, order_books_, channel_sequences_) are default constructed.
+    // Maps (product_info_cache_, order_books_) and the channel state table are default constructed.
     // If a logger instance was to be owned by TaifexSdk, it would be initialized here or in initialize().
     // For now, assuming logger is globally accessible or configured elsewhere if needed by CoreUtils.
+    liveness_.set_timer_handler([this](LivenessMonitor::ChannelTimer timer, uint32_t channel_id,
+                                       ChannelGapManager::Clock::time_point now) {
+        on_channel_timer(timer, channel_id, now);
+    });
     LOG_INFO << "TaifexSdk instance created.";
 }
 
 TaifexSdk::~TaifexSdk() {
+    if (initialized_ && product_cache_config_.save_on_shutdown && !product_cache_config_.path.empty()) {
+        save_product_cache();
+    }
+    for (const auto& stream : update_streams_) {
+        stream->close();
+    }
     LOG_INFO << "TaifexSdk instance destroyed.";
     // std::map members will automatically clean up their contents.
 }
 
-bool TaifexSdk::initialize(/* Potential config parameters */) {
+bool TaifexSdk::initialize(const GapRecoveryConfig& gap_config) {
+    SdkConfig config;
+    config.gap_recovery = gap_config;
+    return initialize(config);
+}
+
+bool TaifexSdk::initialize(const SdkConfig& config) {
     // Example: Configure logger if it has such an API and if TaifexSdk manages its settings.
     // CoreUtils::Logger::SetLevel(CoreUtils::LogLevel::DEBUG); // Example
 
     LOG_INFO << "TaifexSdk initializing...";
-    // Perform any other one-time setup for the SDK.
+    CoreUtils::samplePageFaults(); // PAGE_FAULTS counts from here on.
+    const GapRecoveryConfig& gap_config = config.gap_recovery;
+    gap_manager_.configure(gap_config);
+    LOG_INFO << "Gap recovery: reorder capacity " << gap_config.reorder_capacity
+             << " frames per channel, timeout " << gap_config.gap_timeout.count() << " ms.";
+
+    pending_frames_.configure(config.pending_frames);
+    presize(config.capacity, gap_config);
+    allocation_check_ = config.allocation_check;
+    if (allocation_check_ != AllocationCheck::OFF && !CoreUtils::allocationHooksInstalled()) {
+        LOG_WARNING << "TaifexSdk: allocation check requested but taifex_allocation_hooks is not linked; "
+                    << "no allocations will be seen.";
+    }
+    reader_publish_interval_ = config.reader_publish_interval;
+    product_cache_config_ = config.product_cache;
+    if (!product_cache_config_.path.empty()) {
+        std::vector<ProductInfo> cached;
+        if (load_product_cache(product_cache_config_.path, product_cache_config_.trading_date,
+                               product_cache_config_.max_age_days, cached)) {
+            products_.reserve(cached.size());
+            for (const ProductInfo& info : cached) {
+                bool changed = false;
+                products_.upsert(info, changed);
+            }
+        }
+    }
 
     initialized_ = true;
     LOG_INFO << "TaifexSdk initialized successfully.";
     return true;
 }
 
-// --- Stubs for other methods to be implemented later ---
+// Bytes of pool per expected price level: a map node (48 bytes) rounded up to the pool's block size.
+static constexpr size_t BOOK_LEVEL_BYTES = 64;
+// Levels per side I081/I083 disclose; books never keep fewer, or levels coming back into view would be missing.
+static constexpr size_t FEED_DEPTH = 5;
+
+static std::string_view trim_trailing_spaces(std::string_view value) {
+    const size_t end = value.find_last_not_of(' ');
+    return end == std::string_view::npos ? std::string_view() : value.substr(0, end + 1);
+}
+
+static std::string get_base_prod_id_for_i010_lookup(const std::string& prod_id_from_message); // Defined below.
+
+void TaifexSdk::presize(const CapacityConfig& capacity, const GapRecoveryConfig& gap_config) {
+    subscriptions_.clear();
+    subscriptions_.reserve(capacity.subscriptions.size());
+    for (const std::string& prod_id_s : capacity.subscriptions) {
+        subscriptions_.emplace_back(trim_trailing_spaces(prod_id_s));
+    }
+    std::sort(subscriptions_.begin(), subscriptions_.end());
+    subscriptions_.erase(std::unique(subscriptions_.begin(), subscriptions_.end()), subscriptions_.end());
+
+    const size_t expected_products = std::max(capacity.expected_products, subscriptions_.size());
+    products_.reserve(expected_products);
+    i010_body_hashes_.reserve(expected_products);
+    book_slots_.reserve(capacity.expected_books);
+    book_snapshots_.reserve(capacity.expected_books);
+    event_prod_id_.reserve(20);
+    book_identities_.reserve(capacity.expected_books);
+
+    for (uint32_t channel_id : capacity.channels) {
+        register_channel(channel_id);
+    }
+
+    // Books drop levels past book_depth_, so the pool covers every book at full depth. Headroom of
+    // 2x: a new level is inserted before the level it pushes out of the book is removed.
+    book_depth_ = std::max(capacity.max_depth, FEED_DEPTH);
+    const size_t ring_bytes = capacity.channels.size() * gap_config.reorder_capacity * gap_config.max_frame_length;
+    size_t pool_bytes = capacity.expected_books * 2 * book_depth_ * BOOK_LEVEL_BYTES * 2;
+    if (capacity.memory_budget_bytes != 0 && ring_bytes + pool_bytes > capacity.memory_budget_bytes) {
+        const size_t available = capacity.memory_budget_bytes > ring_bytes ? capacity.memory_budget_bytes - ring_bytes : 0;
+        LOG_WARNING << "TaifexSdk: memory budget of " << capacity.memory_budget_bytes << " bytes leaves "
+                    << available << " of the " << pool_bytes << " bytes wanted for the book pool.";
+        pool_bytes = available;
+    }
+
+    if (!book_pool_) { // Books already created keep pointing at the existing pool.
+        if (pool_bytes != 0) {
+            book_arena_buffer_ = std::make_unique<std::byte[]>(pool_bytes);
+            book_arena_bytes_ = pool_bytes;
+            book_arena_ = std::make_unique<std::pmr::monotonic_buffer_resource>(book_arena_buffer_.get(), pool_bytes);
+        } else {
+            book_arena_ = std::make_unique<std::pmr::monotonic_buffer_resource>();
+        }
+        book_pool_ = std::make_unique<std::pmr::unsynchronized_pool_resource>(book_arena_.get());
+    }
+    LOG_INFO << "TaifexSdk presized for " << expected_products << " products, " << capacity.expected_books
+             << " books (" << pool_bytes << " bytes of book pool), " << capacity.channels.size()
+             << " channels (" << ring_bytes << " bytes of reorder rings), "
+             << (subscriptions_.empty() ? std::string("all products") :
+                 std::to_string(subscriptions_.size()) + " subscribed products") << ".";
+}
+
+std::pmr::memory_resource* TaifexSdk::book_memory() {
+    return book_pool_ ? book_pool_.get() : std::pmr::get_default_resource();
+}
+
+bool TaifexSdk::attach_state_store(const StateStoreConfig& config) {
+    bool reattached = false;
+    if (!state_store_.open(config, reattached)) {
+        LOG_ERROR << "TaifexSdk: state store " << config.path << " unavailable; running without persistence.";
+        return false;
+    }
+    book_slots_.clear();
+    if (reattached) {
+        restore_from_state_store();
+    } else {
+        write_to_state_store();
+    }
+    return true;
+}
+
+bool TaifexSdk::save_product_cache() const {
+    if (product_cache_config_.path.empty()) {
+        return false;
+    }
+    return Taifex::save_product_cache(product_cache_config_.path, product_cache_config_.trading_date, products_);
+}
+
+void TaifexSdk::flush_state_store() {
+    state_store_.flush();
+}
+
+bool TaifexSdk::publish_to_shared_memory(const ShmPublicationConfig& config) {
+    if (!shm_publisher_.open(config)) {
+        LOG_ERROR << "TaifexSdk: shared-memory publication " << config.name << " unavailable.";
+        return false;
+    }
+    shm_books_.clear();
+    write_to_shared_memory();
+    return true;
+}
+
+void TaifexSdk::write_to_shared_memory() {
+    for (ProductHandle handle = 0; handle < products_.size(); ++handle) {
+        shm_publisher_.publish_product(handle, *products_.get(handle));
+    }
+    for (const auto& pair_ob : order_books_) {
+        auto it = shm_books_.find(&pair_ob.second);
+        if (it != shm_books_.end()) {
+            shm_publisher_.publish_book(it->second, pair_ob.second);
+            continue;
+        }
+        const ProductHandle product = products_.find(get_base_prod_id_for_i010_lookup(pair_ob.first));
+        const ShmBookIndex index = shm_publisher_.add_book(pair_ob.second, product);
+        if (index != INVALID_SHM_BOOK_INDEX) {
+            shm_books_[&pair_ob.second] = index;
+        }
+    }
+}
+
+bool TaifexSdk::publish_events_to_shared_memory(const ShmEventRingConfig& config) {
+    if (!event_publisher_.open(config)) {
+        LOG_ERROR << "TaifexSdk: shared-memory event ring " << config.name << " unavailable.";
+        return false;
+    }
+    for (const auto& pair_ob : order_books_) {
+        auto it = book_identities_.find(&pair_ob.second);
+        if (it != book_identities_.end()) {
+            event_publisher_.add_book(it->second.handle, pair_ob.first, it->second.product);
+        }
+    }
+    return true;
+}
+
+bool TaifexSdk::start_fanout_server(const UdsFanoutConfig& config) {
+    if (!fanout_server_.start(config)) {
+        LOG_ERROR << "TaifexSdk: fan-out server on " << config.path << " unavailable.";
+        return false;
+    }
+    for (const auto& pair_ob : order_books_) {
+        auto it = book_identities_.find(&pair_ob.second);
+        if (it != book_identities_.end()) {
+            fanout_server_.add_book(it->second.handle, pair_ob.first, pair_ob.second.get_decimal_locator());
+            fanout_server_.publish(it->second.handle, pair_ob.second);
+        }
+    }
+    return true;
+}
+
+bool TaifexSdk::journal_events(const EventJournalConfig& config) {
+    CoreUtils::ColdPathScope cold_path;
+    if (!event_journal_.open(config.path, config.buffer_bytes)) {
+        LOG_ERROR << "TaifexSdk: event journal " << config.path << " unavailable.";
+        return false;
+    }
+    journal_checkpoint_interval_us_ = config.checkpoint_interval_us;
+    journal_book_checkpoint_events_ = config.book_checkpoint_events;
+    journal_book_events_.assign(book_identities_.size(), 0);
+    journal_levels_.resize(EventJournalWriter::CHECKPOINT_DEPTH);
+    journal_image_.reserve(SpecificMessageParsers::MAX_BOOK_MESSAGE_EVENTS);
+    for (ProductHandle handle = 0; handle < products_.size(); ++handle) {
+        event_journal_.add_product(handle, *products_.get(handle));
+    }
+    for (const auto& pair_ob : order_books_) {
+        auto it = book_identities_.find(&pair_ob.second);
+        if (it != book_identities_.end()) {
+            event_journal_.add_book(it->second.handle, pair_ob.first, it->second.product,
+                                    pair_ob.second.get_decimal_locator());
+        }
+    }
+    // The books as they are now, so the journal replays correctly even when started mid-session.
+    write_journal_checkpoint(0);
+    return true;
+}
+
+void TaifexSdk::aggregate_bars(const BarConfig& config) {
+    CoreUtils::ColdPathScope cold_path;
+    BarConfig sized = config;
+    sized.expected_books = std::max(config.expected_books, book_identities_.size());
+    bars_.configure(sized);
+}
+
+void TaifexSdk::set_bar_callback(BarAggregator::BarCallback callback) {
+    bars_.set_callback(std::move(callback));
+}
+
+size_t TaifexSdk::get_bars(const std::string& product_id, BarInterval interval, std::span<Bar> out) const {
+    const BookHandle book = get_book_handle(product_id);
+    return book == INVALID_BOOK_HANDLE ? 0 : bars_.copy_bars(book, interval, out);
+}
+
+std::optional<Bar> TaifexSdk::get_open_bar(const std::string& product_id, BarInterval interval) const {
+    const BookHandle book = get_book_handle(product_id);
+    const Bar* bar = book == INVALID_BOOK_HANDLE ? nullptr : bars_.open_bar(book, interval);
+    return bar ? std::optional<Bar>(*bar) : std::nullopt;
+}
+
+void TaifexSdk::update_bars(const OrderBookManagement::OrderBook& order_book, uint64_t exchange_time_us) {
+    if (!bars_.enabled()) {
+        return;
+    }
+    auto it = book_identities_.find(&order_book);
+    OrderBookManagement::PriceQuantityLevel bid;
+    OrderBookManagement::PriceQuantityLevel ask;
+    if (it != book_identities_.end() && order_book.copy_top_bids({&bid, 1}) == 1 &&
+        order_book.copy_top_asks({&ask, 1}) == 1) {
+        bars_.on_quote(it->second.handle, exchange_time_us, bid.price, ask.price);
+    } else {
+        bars_.advance(exchange_time_us); // A one-sided book has no mid, but time still moves.
+    }
+}
+
+bool TaifexSdk::record_tick_history(const TickStoreConfig& config) {
+    CoreUtils::ColdPathScope cold_path;
+    if (!tick_store_.start(config)) {
+        LOG_ERROR << "TaifexSdk: tick store under " << config.root_dir << " unavailable.";
+        return false;
+    }
+    for (const auto& pair_ob : order_books_) {
+        auto it = book_identities_.find(&pair_ob.second);
+        if (it != book_identities_.end()) {
+            tick_store_.add_book(it->second.handle, pair_ob.first, pair_ob.second.get_decimal_locator());
+        }
+    }
+    return true;
+}
+
+void TaifexSdk::stop_tick_history() {
+    tick_store_.stop();
+}
+
+uint64_t TaifexSdk::get_tick_history_dropped_count() const {
+    return tick_store_.dropped_count();
+}
+
+void TaifexSdk::record_tick(const OrderBookManagement::OrderBook& order_book, uint64_t exchange_time_us, uint8_t flags) {
+    if (!tick_store_.is_running()) {
+        return;
+    }
+    auto it = book_identities_.find(&order_book);
+    if (it != book_identities_.end()) {
+        tick_store_.record(it->second.handle, exchange_time_us, order_book, flags);
+    }
+}
+
+void TaifexSdk::close_event_journal() {
+    event_journal_.close();
+}
+
+void TaifexSdk::stop_fanout_server() {
+    fanout_server_.stop();
+}
+
+size_t TaifexSdk::get_fanout_client_count() const {
+    return fanout_server_.client_count();
+}
+
+uint64_t TaifexSdk::get_event_reader_lag() const {
+    return event_publisher_.is_open() ? event_publisher_.max_reader_lag() : 0;
+}
+
+BookHandle TaifexSdk::get_book_handle(const std::string& product_id) const {
+    auto it_ob = order_books_.find(product_id);
+    if (it_ob == order_books_.end()) {
+        return INVALID_BOOK_HANDLE;
+    }
+    auto it = book_identities_.find(&it_ob->second);
+    return it == book_identities_.end() ? INVALID_BOOK_HANDLE : it->second.handle;
+}
+
+void TaifexSdk::register_book(const OrderBookManagement::OrderBook& order_book, ProductHandle product) {
+    auto result = book_identities_.try_emplace(&order_book, BookIdentity{static_cast<BookHandle>(book_identities_.size()), product});
+    if (!result.second) {
+        return;
+    }
+    if (event_publisher_.is_open()) {
+        event_publisher_.add_book(result.first->second.handle, order_book.get_product_id(), product);
+    }
+    if (fanout_server_.is_running()) {
+        fanout_server_.add_book(result.first->second.handle, order_book.get_product_id(), order_book.get_decimal_locator());
+    }
+    if (event_journal_.is_open()) {
+        event_journal_.add_book(result.first->second.handle, order_book.get_product_id(), product,
+                                order_book.get_decimal_locator());
+        journal_book_events_.resize(book_identities_.size(), 0);
+    }
+    if (bars_.enabled()) {
+        bars_.add_book(result.first->second.handle);
+    }
+    if (liveness_.products_enabled()) {
+        liveness_.add_book(result.first->second.handle, result.first->second.last_channel, frame_time_);
+    }
+    if (tick_store_.is_running()) {
+        tick_store_.add_book(result.first->second.handle, order_book.get_product_id(), order_book.get_decimal_locator());
+    }
+}
+
+void TaifexSdk::index_book_channel(OrderBookManagement::OrderBook& order_book, uint32_t channel_id) {
+    auto it = book_identities_.find(&order_book);
+    if (it == book_identities_.end()) {
+        return;
+    }
+    if (liveness_.products_enabled()) {
+        liveness_.on_book_message(it->second.handle, channel_id, frame_time_);
+    }
+    if (it->second.last_channel == channel_id || channel_id >= CoreUtils::ChannelStateTable::CHANNEL_COUNT) [[likely]] {
+        return;
+    }
+    // First frame of the book on this channel, or a book alternating between channels.
+    BookIdentity& identity = it->second;
+    identity.last_channel = channel_id;
+    if (std::find(identity.channels.begin(), identity.channels.end(), channel_id) != identity.channels.end()) {
+        return;
+    }
+    CoreUtils::ColdPathScope cold_path; // Once per book and channel.
+    add_channel_book(order_book, identity, channel_id);
+    if (state_store_.is_open()) {
+        auto slot = book_slots_.find(&order_book);
+        if (slot != book_slots_.end()) {
+            state_store_.add_book_channel(slot->second, channel_id);
+        }
+    }
+}
+
+void TaifexSdk::add_channel_book(OrderBookManagement::OrderBook& order_book, BookIdentity& identity, uint32_t channel_id) {
+    if (std::find(identity.channels.begin(), identity.channels.end(), channel_id) != identity.channels.end()) {
+        return;
+    }
+    identity.channels.push_back(static_cast<uint16_t>(channel_id));
+    if (channel_id >= channel_books_.size()) {
+        channel_books_.resize(channel_id + 1);
+    }
+    channel_books_[channel_id].push_back(&order_book);
+}
+
+CoreUtils::NormalizedEvent TaifexSdk::event_stamp(const CoreUtils::CommonHeader& header) {
+    CoreUtils::NormalizedEvent stamp{};
+    stamp.channel_seq = header.getChannelSeq();
+    stamp.exchange_time_us = header.getInformationTimeMicros();
+    stamp.channel_id = static_cast<uint16_t>(header.getChannelId());
+    stamp.book = INVALID_BOOK_HANDLE;
+    stamp.product = INVALID_PRODUCT_HANDLE;
+    return stamp;
+}
+
+void TaifexSdk::stamp_book(CoreUtils::NormalizedEvent& stamp, const OrderBookManagement::OrderBook& order_book) const {
+    auto it = book_identities_.find(&order_book);
+    stamp.book = it != book_identities_.end() ? it->second.handle : INVALID_BOOK_HANDLE;
+    stamp.product = it != book_identities_.end() ? it->second.product : INVALID_PRODUCT_HANDLE;
+    stamp.decimal_locator = order_book.get_decimal_locator();
+}
+
+CoreUtils::NormalizedEvent& TaifexSdk::append_event(const OrderBookManagement::OrderBook& order_book,
+                                                    const CoreUtils::CommonHeader& header, CoreUtils::EventType type,
+                                                    uint32_t prod_msg_seq) {
+    if (event_count_ == event_batch_.size()) {
+        flush_events(false);
+    }
+    CoreUtils::NormalizedEvent& event = event_batch_[event_count_++];
+    event = event_stamp(header);
+    stamp_book(event, order_book);
+    event.type = type;
+    event.prod_msg_seq = prod_msg_seq;
+    return event;
+}
+
+void TaifexSdk::flush_frame_events(const OrderBookManagement::OrderBook& order_book, size_t count,
+                                   bool end_of_message) {
+    if (!events_enabled()) {
+        return;
+    }
+    // The decoder could not know the book: its PROD-ID is only resolved after decoding.
+    CoreUtils::NormalizedEvent identity;
+    stamp_book(identity, order_book);
+    for (size_t i = 0; i < count; ++i) {
+        event_batch_[i].book = identity.book;
+        event_batch_[i].product = identity.product;
+        event_batch_[i].decimal_locator = identity.decimal_locator;
+    }
+    event_count_ = count;
+    flush_events(end_of_message);
+    if (journal_book_checkpoint_events_ != 0 && event_journal_.is_open() && end_of_message &&
+        identity.book < journal_book_events_.size() &&
+        (journal_book_events_[identity.book] += static_cast<uint32_t>(count)) >= journal_book_checkpoint_events_) {
+        // An active book gets its own image, so an as-of query never replays more than this.
+        event_journal_.begin_book_checkpoint(event_batch_[count - 1].exchange_time_us, identity.book);
+        append_journal_image(order_book, event_batch_[count - 1].exchange_time_us);
+        journal_book_events_[identity.book] = 0;
+    }
+}
+
+void TaifexSdk::flush_events(bool end_of_message) {
+    if (event_count_ == 0) {
+        return;
+    }
+    const std::span<const CoreUtils::NormalizedEvent> events(event_batch_.data(), event_count_);
+    event_count_ = 0;
+    if (end_of_message) {
+        event_batch_[events.size() - 1].flags |= CoreUtils::NormalizedEvent::FLAG_END_OF_MESSAGE;
+    }
+    if (event_publisher_.is_open()) {
+        event_publisher_.publish(events);
+    }
+    if (event_callback_) {
+        event_callback_(events);
+    }
+    if (event_journal_.is_open()) {
+        event_journal_.append(events);
+        const uint64_t exchange_time_us = events.back().exchange_time_us;
+        if (journal_last_checkpoint_us_ == 0) {
+            journal_last_checkpoint_us_ = exchange_time_us; // The interval runs from the first journaled event.
+        } else if (end_of_message && journal_checkpoint_interval_us_ != 0 &&
+                   (exchange_time_us >= journal_last_checkpoint_us_ + journal_checkpoint_interval_us_ ||
+                    exchange_time_us < journal_last_checkpoint_us_)) { // INFORMATION-TIME wrapped at midnight.
+            write_journal_checkpoint(exchange_time_us);
+        }
+    }
+}
+
+void TaifexSdk::product_changed(ProductHandle handle) {
+    const ProductInfo& info = *products_.get(handle);
+    state_store_.store_product(handle, info);
+    shm_publisher_.publish_product(handle, info);
+    event_journal_.add_product(handle, info);
+    if (reader_publication_) {
+        reader_changed_products_.push_back(handle);
+        reader_products_dirty_ = true;
+    }
+    if (product_info_callback_) {
+        product_info_callback_(handle, info);
+    }
+}
+
+void TaifexSdk::write_journal_checkpoint(uint64_t exchange_time_us) {
+    CoreUtils::ColdPathScope cold_path; // Once per checkpoint interval.
+    event_journal_.begin_checkpoint(exchange_time_us, static_cast<uint32_t>(order_books_.size()));
+    for (const auto& pair_ob : order_books_) {
+        append_journal_image(pair_ob.second, exchange_time_us);
+    }
+    std::fill(journal_book_events_.begin(), journal_book_events_.end(), 0);
+    journal_last_checkpoint_us_ = exchange_time_us;
+}
+
+void TaifexSdk::append_journal_image(const OrderBookManagement::OrderBook& order_book, uint64_t exchange_time_us) {
+    CoreUtils::NormalizedEvent stamp{};
+    stamp_book(stamp, order_book);
+    stamp.exchange_time_us = exchange_time_us;
+    stamp.prod_msg_seq = order_book.get_last_prod_msg_seq();
+    stamp.flags = CoreUtils::NormalizedEvent::FLAG_CHECKPOINT;
+    auto& image = journal_image_;
+    auto add = [&](CoreUtils::EventType type, CoreUtils::EventSide side,
+                   const OrderBookManagement::PriceQuantityLevel& level, uint8_t index) {
+        CoreUtils::NormalizedEvent& event = image.emplace_back(stamp);
+        event.type = type;
+        event.side = side;
+        event.price = level.price;
+        event.quantity = static_cast<int64_t>(level.quantity);
+        event.level = index;
+    };
+
+    image.clear();
+    add(CoreUtils::EventType::BOOK_CLEAR, CoreUtils::EventSide::NONE, {0, 0}, 0);
+    size_t count = order_book.copy_top_bids(journal_levels_);
+    for (size_t i = 0; i < count; ++i) {
+        add(CoreUtils::EventType::SNAPSHOT_LEVEL, CoreUtils::EventSide::BID, journal_levels_[i], static_cast<uint8_t>(i + 1));
+    }
+    count = order_book.copy_top_asks(journal_levels_);
+    for (size_t i = 0; i < count; ++i) {
+        add(CoreUtils::EventType::SNAPSHOT_LEVEL, CoreUtils::EventSide::ASK, journal_levels_[i], static_cast<uint8_t>(i + 1));
+    }
+    if (auto derived = order_book.get_derived_bid()) {
+        add(CoreUtils::EventType::SNAPSHOT_LEVEL, CoreUtils::EventSide::DERIVED_BID, *derived, 1);
+    }
+    if (auto derived = order_book.get_derived_ask()) {
+        add(CoreUtils::EventType::SNAPSHOT_LEVEL, CoreUtils::EventSide::DERIVED_ASK, *derived, 1);
+    }
+    if (order_book.is_stale()) {
+        add(CoreUtils::EventType::BOOK_STALE, CoreUtils::EventSide::NONE, {0, 0}, 0);
+    }
+    image.back().flags |= CoreUtils::NormalizedEvent::FLAG_END_OF_MESSAGE;
+    event_journal_.append(image);
+}
+
+bool TaifexSdk::replay_journal(const std::string& path, uint64_t from_exchange_time_us) {
+    EventJournalReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    size_t start = 0;
+    if (from_exchange_time_us > 0) {
+        const size_t checkpoint = reader.find_checkpoint(from_exchange_time_us);
+        start = checkpoint == EventJournalReader::NPOS ? 0 : checkpoint;
+    }
+    LOG_INFO << "Replaying event journal " << path << " (" << reader.record_count() << " records) from record "
+             << start << ".";
+
+    // The journal's handles are those of the recording instance; map them to this one's books.
+    std::vector<OrderBookManagement::OrderBook*> books;
+    frame_time_ = clock_now(); // Books replayed count as heard from now for the liveness monitor.
+    // Only the first checkpoint replayed is applied; later ones repeat what the events built.
+    bool checkpoint_applied = false;
+    bool apply_checkpoint = false;
+    const size_t record_count = reader.record_count();
+    size_t index = 0;
+    while (index < record_count) {
+        switch (reader.record_type(index)) {
+            case JournalRecordType::PRODUCT: {
+                CoreUtils::ColdPathScope cold_path;
+                bool changed = false;
+                const ProductHandle handle = products_.upsert(reader.product(index).info, changed);
+                if (handle >= i010_body_hashes_.size()) {
+                    i010_body_hashes_.resize(handle + 1, 0);
+                }
+                if (changed) {
+                    product_changed(handle);
+                }
+                ++index;
+                continue;
+            }
+            case JournalRecordType::BOOK: {
+                const JournalBookRecord& record = reader.book(index);
+                if (record.book >= books.size()) {
+                    books.resize(record.book + 1, nullptr);
+                }
+                books[record.book] = get_or_create_order_book(std::string(record.prod_id, sizeof(record.prod_id)));
+                ++index;
+                continue;
+            }
+            case JournalRecordType::CHECKPOINT:
+                // Single-book images repeat what the events built; only BookHistory starts from them.
+                apply_checkpoint = index >= start && !checkpoint_applied && !reader.checkpoint(index).single_book;
+                checkpoint_applied = checkpoint_applied || apply_checkpoint;
+                ++index;
+                continue;
+            case JournalRecordType::EVENT:
+                break;
+        }
+        if (index < start) {
+            ++index;
+            continue;
+        }
+
+        // One frame's events for one book, as they were flushed.
+        const CoreUtils::NormalizedEvent& first = reader.event(index);
+        const size_t end = reader.run_end(index, event_batch_.size());
+        const bool is_checkpoint = (first.flags & CoreUtils::NormalizedEvent::FLAG_CHECKPOINT) != 0;
+        if (first.book < books.size() && books[first.book] && (!is_checkpoint || apply_checkpoint)) {
+            apply_journal_events(*books[first.book], std::span(&first, end - index));
+        }
+        index = end;
+    }
+    if (reader_publication_ && (reader_products_dirty_ || !reader_added_books_.empty())) {
+        publish_reader_index(clock_now());
+    }
+    return true;
+}
+
+void TaifexSdk::apply_journal_events(OrderBookManagement::OrderBook& order_book,
+                                     std::span<const CoreUtils::NormalizedEvent> events) {
+    const CoreUtils::NormalizedEvent& first = events.front();
+    const JournalRunResult result = apply_journal_run(order_book, events);
+    if (result == JournalRunResult::IGNORED) {
+        return;
+    }
+    const bool notify = result == JournalRunResult::SNAPSHOT || result == JournalRunResult::UPDATE;
+    book_changed(order_book);
+    const bool checkpoint = (first.flags & CoreUtils::NormalizedEvent::FLAG_CHECKPOINT) != 0; // Not market activity.
+    if (!checkpoint) {
+        index_book_channel(order_book, first.channel_id);
+        record_tick(order_book, events.back().exchange_time_us,
+                    (first.flags & CoreUtils::NormalizedEvent::FLAG_RESET) ? TickStore::FLAG_RESET : 0);
+    }
+    std::copy(events.begin(), events.end(), event_batch_.begin());
+    flush_frame_events(order_book, events.size(),
+                       (events.back().flags & CoreUtils::NormalizedEvent::FLAG_END_OF_MESSAGE) != 0);
+    if (notify) {
+        if (!checkpoint) {
+            update_bars(order_book, events.back().exchange_time_us);
+        }
+        notify_order_book_update(order_book);
+    }
+}
+
+void TaifexSdk::restore_from_state_store() {
+    for (ProductHandle handle = 0; handle < state_store_.product_count(); ++handle) {
+        ProductInfo info;
+        if (!state_store_.load_product(handle, info)) {
+            continue;
+        }
+        bool changed = false;
+        products_.upsert(info, changed);
+    }
+
+    // Products preloaded from the product cache may have taken other handles; rewrite the table so
+    // record indices match this registry again.
+    for (ProductHandle handle = 0; handle < products_.size(); ++handle) {
+        state_store_.store_product(handle, *products_.get(handle));
+        if (reader_publication_) {
+            reader_changed_products_.push_back(handle);
+        }
+    }
+
+    for (BookSlot slot = 0; slot < state_store_.book_count(); ++slot) {
+        OrderBookManagement::OrderBook book(std::string(), 0, book_memory(), book_depth_);
+        if (!state_store_.load_book(slot, book)) {
+            continue;
+        }
+        std::string prod_id = book.get_product_id();
+        auto it = order_books_.insert_or_assign(std::move(prod_id), std::move(book)).first;
+        book_slots_[&it->second] = slot;
+        register_book(it->second, products_.find(get_base_prod_id_for_i010_lookup(it->first)));
+        // Indexed under its channels again, so an I002 before its next frame still clears it.
+        std::array<uint16_t, StateStore::MAX_BOOK_CHANNELS> channels{};
+        const size_t channel_count = state_store_.load_book_channels(slot, channels);
+        BookIdentity& identity = book_identities_.find(&it->second)->second;
+        for (size_t i = 0; i < channel_count; ++i) {
+            add_channel_book(it->second, identity, channels[i]);
+            identity.last_channel = channels[i];
+        }
+        if (reader_publication_) {
+            auto snapshot = book_snapshots_.find(&it->second);
+            if (snapshot == book_snapshots_.end()) {
+                add_book_snapshot(it->second);
+            } else {
+                snapshot->second->publish(it->second);
+            }
+        }
+    }
+
+    size_t resumed_channels = 0;
+    for (uint32_t channel_id = 0; channel_id < CoreUtils::ChannelStateTable::CHANNEL_COUNT; ++channel_id) {
+        const uint64_t committed = state_store_.committed_seq(channel_id);
+        if (committed == 0) {
+            continue;
+        }
+        CoreUtils::ChannelState* state = channel_states_.find(channel_id);
+        state->synced = true;
+        state->expected_seq = committed + 1;
+        register_channel(channel_id);
+        ++resumed_channels;
+    }
+    reader_products_dirty_ = true;
+    if (shm_publisher_.is_open()) {
+        write_to_shared_memory();
+    }
+    LOG_INFO << "TaifexSdk: restored " << products_.size() << " products, " << order_books_.size()
+             << " order books and " << resumed_channels << " channels from the state store.";
+}
+
+void TaifexSdk::write_to_state_store() {
+    for (ProductHandle handle = 0; handle < products_.size(); ++handle) {
+        state_store_.store_product(handle, *products_.get(handle));
+    }
+    for (const auto& pair_ob : order_books_) {
+        BookSlot slot = state_store_.add_book(pair_ob.second);
+        if (slot != INVALID_BOOK_SLOT) {
+            book_slots_[&pair_ob.second] = slot;
+            auto identity = book_identities_.find(&pair_ob.second);
+            if (identity != book_identities_.end()) {
+                for (uint16_t channel_id : identity->second.channels) {
+                    state_store_.add_book_channel(slot, channel_id);
+                }
+            }
+        }
+    }
+    for (uint32_t channel_id = 0; channel_id < CoreUtils::ChannelStateTable::CHANNEL_COUNT; ++channel_id) {
+        persist_channel(channel_id, *channel_states_.find(channel_id));
+    }
+}
+
+void TaifexSdk::persist_book(const OrderBookManagement::OrderBook& order_book) {
+    if (!state_store_.is_open()) {
+        return;
+    }
+    auto it = book_slots_.find(&order_book);
+    if (it != book_slots_.end()) {
+        state_store_.store_book(it->second, order_book);
+    }
+}
+
+void TaifexSdk::book_changed(const OrderBookManagement::OrderBook& order_book) {
+    persist_book(order_book);
+    if (shm_publisher_.is_open()) {
+        auto it = shm_books_.find(&order_book);
+        if (it != shm_books_.end()) {
+            shm_publisher_.publish_book(it->second, order_book);
+        }
+    }
+    if (reader_publication_) {
+        auto it = book_snapshots_.find(&order_book);
+        if (it != book_snapshots_.end()) {
+            it->second->publish(order_book);
+        }
+    }
+    if (fanout_server_.is_running()) {
+        auto it = book_identities_.find(&order_book);
+        if (it != book_identities_.end()) {
+            fanout_server_.publish(it->second.handle, order_book);
+        }
+    }
+}
+
+void TaifexSdk::add_book_snapshot(const OrderBookManagement::OrderBook& order_book) {
+    auto slot = std::make_shared<BookSnapshotSlot>();
+    slot->publish(order_book);
+    reader_added_books_.emplace_back(order_book.get_product_id(), slot);
+    book_snapshots_[&order_book] = std::move(slot);
+}
+
+void TaifexSdk::publish_reader_index(ChannelGapManager::Clock::time_point now) {
+    CoreUtils::ColdPathScope cold_path; // Periodic; copies the changed product chunks and book shards.
+    auto index = std::make_unique<ReaderIndex>();
+    published_products_ = ReaderProductTable::update(published_products_, products_, reader_changed_products_);
+    reader_changed_products_.clear();
+    index->products = published_products_;
+    published_books_ = ReaderBookTable::update(published_books_, reader_added_books_);
+    reader_added_books_.clear();
+    index->books = published_books_;
+    reader_publication_->publish(std::move(index));
+    reader_products_dirty_ = false;
+    last_reader_publish_ = now;
+}
+
+void TaifexSdk::publish_reader_index_if_due(ChannelGapManager::Clock::time_point now) {
+    if (reader_publication_ && (reader_products_dirty_ || !reader_added_books_.empty()) &&
+        now - last_reader_publish_ >= reader_publish_interval_) {
+        publish_reader_index(now);
+    }
+}
+
+SdkReader TaifexSdk::create_reader() {
+    if (!reader_publication_) {
+        reader_publication_ = std::make_shared<ReaderPublication>();
+        for (const auto& pair_ob : order_books_) {
+            add_book_snapshot(pair_ob.second);
+        }
+        publish_reader_index(clock_now());
+        LOG_INFO << "TaifexSdk: reader publication enabled with " << products_.size() << " products and "
+                 << book_snapshots_.size() << " books.";
+    }
+    return SdkReader(reader_publication_);
+}
+
+std::shared_ptr<UpdateStream> TaifexSdk::subscribe_updates(UpdateExecutor& executor, std::vector<std::string> prod_ids,
+                                                           size_t capacity) {
+    CoreUtils::ColdPathScope cold_path;
+    auto stream = std::make_shared<UpdateStream>(executor, std::move(prod_ids), capacity);
+    update_streams_.push_back(stream);
+    LOG_INFO << "TaifexSdk: update stream opened (" << update_streams_.size() << " open).";
+    return stream;
+}
+
+void TaifexSdk::persist_channel(uint32_t channel_id, const CoreUtils::ChannelState& state) {
+    if (!state_store_.is_open()) {
+        return;
+    }
+    // Unsynced channels (fresh or after an I002) have nothing to resume from.
+    state_store_.commit_channel(channel_id, state.synced ? state.expected_seq - 1 : 0);
+}
+
+void TaifexSdk::set_order_book_update_callback(OrderBookUpdateCallback callback) {
+    order_book_update_callback_ = std::move(callback);
+}
+
+void TaifexSdk::set_event_callback(EventCallback callback) {
+    event_callback_ = std::move(callback);
+}
+
+void TaifexSdk::set_product_info_callback(ProductInfoCallback callback) {
+    product_info_callback_ = std::move(callback);
+}
+
+uint64_t TaifexSdk::get_unchanged_i010_skipped_count() const {
+    return unchanged_i010_skipped_;
+}
+
+size_t TaifexSdk::get_pending_frame_count() const {
+    return pending_frames_.frame_count();
+}
+
+CoreUtils::MetricsSnapshot TaifexSdk::get_metrics() const {
+    CoreUtils::samplePageFaults();
+    return CoreUtils::getMetricsSnapshot();
+}
+
+CoreUtils::LatencySummary TaifexSdk::get_latency_summary(CoreUtils::MessageType type, CoreUtils::LatencyStage stage) const {
+#ifdef TAIFEX_ENABLE_LATENCY_STATS
+    return latency_recorder_.summary(type, stage);
+#else
+    return {};
+#endif
+}
+
+double TaifexSdk::get_latency_percentile_ns(CoreUtils::MessageType type, CoreUtils::LatencyStage stage,
+                                            double percentile) const {
+#ifdef TAIFEX_ENABLE_LATENCY_STATS
+    return latency_recorder_.percentile_ns(type, stage, percentile);
+#else
+    return 0.0;
+#endif
+}
+
+void TaifexSdk::reset_latency_stats() {
+#ifdef TAIFEX_ENABLE_LATENCY_STATS
+    latency_recorder_.reset();
+#endif
+}
+
+void TaifexSdk::notify_order_book_update(const OrderBookManagement::OrderBook& order_book) {
+    if (order_book_update_callback_) {
+        order_book_update_callback_(order_book);
+    }
+    if (!update_streams_.empty()) {
+        publish_update(order_book);
+    }
+    TAIFEX_LATENCY_MARK(CALLBACKS);
+}
+
+void TaifexSdk::publish_update(const OrderBookManagement::OrderBook& order_book) {
+    const BookUpdate update = BookUpdate::from_book(order_book);
+    const std::string_view prod_id = update.product_id();
+    bool any_closed = false;
+    for (const auto& stream : update_streams_) {
+        if (stream->is_closed()) {
+            any_closed = true;
+        } else if (stream->matches(prod_id)) {
+            stream->push(update);
+        }
+    }
+    if (any_closed) {
+        std::erase_if(update_streams_, [](const auto& stream) { return stream->is_closed(); });
+    }
+}
+
+void TaifexSdk::set_retransmission_requester(ChannelGapManager::RetransmissionRequester requester) {
+    gap_manager_.set_retransmission_requester(std::move(requester));
+}
 
 void TaifexSdk::process_message(const unsigned char* raw_message, size_t length) {
+    if (allocation_check_ == AllocationCheck::OFF) {
+        process_frame(raw_message, length);
+        return;
+    }
+    const uint64_t before = CoreUtils::hotPathAllocations();
+    {
+        CoreUtils::HotPathScope hot_path;
+        process_frame(raw_message, length);
+    }
+    const uint64_t allocations = CoreUtils::hotPathAllocations() - before;
+    if (allocations != 0) {
+        report_hot_path_allocations(raw_message, length, allocations);
+    }
+}
+
+void TaifexSdk::report_hot_path_allocations(const unsigned char* raw_message, size_t length, uint64_t allocations) {
+    CoreUtils::CommonHeader header;
+    const std::string frame_type = CoreUtils::CommonHeader::parse(raw_message, length, header)
+                                       ? CoreUtils::messageTypeToString(CoreUtils::identifyMessageType(header))
+                                       : std::string("unparsed");
+    if (allocation_check_ == AllocationCheck::ABORT) {
+        LOG_ERROR << "TaifexSdk: " << allocations << " heap allocation(s) while processing a " << frame_type
+                  << " frame. Aborting (AllocationCheck::ABORT).";
+        std::abort();
+    }
+    CoreUtils::incrementMetric(CoreUtils::Metric::HOT_PATH_ALLOCATIONS, allocations);
+    LOG_WARNING << "TaifexSdk: " << allocations << " heap allocation(s) while processing a " << frame_type << " frame.";
+}
+
+void TaifexSdk::process_frame(const unsigned char* raw_message, size_t length) {
     if (!initialized_) {
         LOG_WARNING << "TaifexSdk::process_message called before initialization.";
         return;
@@ -58,37 +983,259 @@ void TaifexSdk::process_message(const unsigned char* raw_message, size_t length)
         return;
     }
 
-    // 1. Checksum Validation (Dept A)
+    TAIFEX_LATENCY_BEGIN();
+
+    // 1. Length and checksum validation, 2. Common header parse
+    CoreUtils::CommonHeader header;
+    if (!validate_frame(raw_message, length, header)) {
+        return;
+    }
+    TAIFEX_LATENCY_MARK(VALIDATION);
+
+    uint32_t channel_id = 0;
+    uint64_t channel_seq = 0;
+    try {
+        channel_id = header.getChannelId();
+        channel_seq = header.getChannelSeq();
+    } catch (const CoreUtils::ParsingError& e) {
+        LOG_ERROR << "Invalid CHANNEL-ID/CHANNEL-SEQ in header: " << e.what();
+        CoreUtils::incrementMetric(CoreUtils::Metric::HEADER_ERRORS);
+        return;
+    }
+    LOG_DEBUG << "CommonHeader parsed. ChannelID: " << channel_id << ", ChannelSeq: " << channel_seq;
+
+    CoreUtils::ChannelState* state = channel_states_.find(channel_id);
+    if (!state) {
+        LOG_ERROR << "CHANNEL-ID " << channel_id << " out of range.";
+        return;
+    }
+
+    // 3. Sequence Number Validation (per Channel), with reordering of out-of-sequence frames
+    const auto now = clock_now();
+    frame_time_ = now;
+    switch (classify_sequence(*state, channel_id, channel_seq, raw_message, length, now)) {
+        case SequenceStatus::IN_SEQUENCE:
+            // 4./5. Identify, dispatch and apply; then apply anything held behind this frame.
+            apply_frame(raw_message, header);
+            if (drain_reorder_buffer(*state, channel_id, now)) {
+                state->gaps_recovered.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        case SequenceStatus::HELD:
+            liveness_.arm(LivenessMonitor::ChannelTimer::GAP, channel_id, gap_manager_.gap_deadline(channel_id));
+            if (gap_manager_.config().retransmission_timeout.count() > 0) {
+                liveness_.arm(LivenessMonitor::ChannelTimer::RETRANSMISSION, channel_id,
+                              now + gap_manager_.config().retransmission_timeout);
+            }
+            break;
+        case SequenceStatus::DUPLICATE:
+            state->duplicates.fetch_add(1, std::memory_order_relaxed);
+            CoreUtils::incrementMetric(CoreUtils::Metric::SEQUENCE_DUPLICATES);
+            break;
+    }
+
+    // The gap timer would catch this too, but only once its millisecond tick has passed.
+    if (gap_manager_.has_timed_out(channel_id, now)) {
+        abandon_gap(*state, channel_id, now);
+    }
+    // After the books it covers have been written, so a crash never skips unapplied frames.
+    persist_channel(channel_id, *state);
+    liveness_.on_channel_message(channel_id, now);
+    liveness_.advance(now);
+
+    publish_reader_index_if_due(now);
+}
+
+WarmUpReport TaifexSdk::warm_up(const WarmUpConfig& config) {
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t faults_before = CoreUtils::processPageFaults();
+    WarmUpReport report;
+    frame_time_ = clock_now(); // Liveness times the new books from now.
+
+    if (config.create_books) {
+        std::string prod_id;
+        for (ProductHandle handle = 0; handle < products_.size(); ++handle) {
+            const ProductInfo* info = products_.get(handle);
+            if (info == nullptr || !is_subscribed(info->id())) {
+                continue;
+            }
+            prod_id.assign(info->id());
+            prod_id.resize(20, ' '); // Books are keyed by the X(20) PROD-ID of their I081/I083.
+            if (order_books_.find(prod_id) == order_books_.end() && get_or_create_order_book(prod_id)) {
+                ++report.books_created;
+            }
+        }
+    }
+
+    if (config.prefault) {
+        auto cover = [&](void* data, size_t length) {
+            report.bytes_prefaulted += CoreUtils::prefaultMemory(data, length);
+            if (config.lock_memory) {
+                report.bytes_locked += CoreUtils::lockMemory(data, length);
+            }
+        };
+        cover(book_arena_buffer_.get(), book_arena_bytes_);
+        cover(event_batch_.data(), sizeof(event_batch_));
+        report.bytes_prefaulted += gap_manager_.prefault(config.lock_memory, report.bytes_locked);
+        if (state_store_.is_open()) {
+            cover(state_store_.data(), state_store_.size());
+        }
+        if (shm_publisher_.is_open()) {
+            cover(shm_publisher_.segment().data(), shm_publisher_.segment().size());
+        }
+        if (event_publisher_.is_open()) {
+            cover(event_publisher_.segment().data(), event_publisher_.segment().size());
+        }
+    }
+
+    if (config.synthetic_rounds > 0) {
+        report.synthetic_frames = run_warm_up_frames(config.synthetic_rounds);
+    }
+
+    CoreUtils::samplePageFaults();
+    report.page_faults = CoreUtils::processPageFaults() - faults_before;
+    report.elapsed = std::chrono::steady_clock::now() - start;
+    LOG_INFO << "TaifexSdk warmed up in " << std::chrono::duration_cast<std::chrono::microseconds>(report.elapsed).count()
+             << " us: " << report.books_created << " books created, " << report.bytes_prefaulted << " bytes prefaulted ("
+             << report.bytes_locked << " locked), " << report.synthetic_frames << " synthetic frames, "
+             << report.page_faults << " page faults.";
+    return report;
+}
+
+// Runs the I083/I081 hot path up to the book, on a scratch book no consumer knows about: the
+// frames go through validation and decoding into event_batch_, and their levels come from (and go
+// back to) the book pool.
+uint64_t TaifexSdk::run_warm_up_frames(uint32_t rounds) {
+    static constexpr size_t WARM_UP_DEPTH = 5;
+    const WarmUpFrames frames = make_warm_up_frames(WARM_UP_DEPTH);
+    OrderBookManagement::OrderBook scratch(std::string(WARM_UP_PROD_ID), 0, book_memory());
+    std::array<OrderBookManagement::PriceQuantityLevel, WARM_UP_DEPTH> top{};
+    uint64_t frame_count = 0;
+
+    auto run = [&](const std::vector<unsigned char>& frame) {
+        CoreUtils::CommonHeader header;
+        if (!validate_frame(frame.data(), frame.size(), header)) {
+            return false;
+        }
+        const CoreUtils::MessageType msg_type = CoreUtils::identifyMessageType(header);
+        const unsigned char* body_ptr = frame.data() + CoreUtils::CommonHeader::HEADER_SIZE;
+        const uint16_t body_len = header.getBodyLength();
+        const CoreUtils::NormalizedEvent stamp = event_stamp(header);
+        SpecificMessageParsers::BookMessageEvents decoded;
+        if (msg_type == CoreUtils::MessageType::I083_ORDER_BOOK_SNAPSHOT) {
+            if (!SpecificMessageParsers::decode_i083_events(body_ptr, body_len, stamp, event_batch_, decoded) ||
+                !scratch.apply_snapshot(decoded.prod_msg_seq, std::span(event_batch_.data(), decoded.event_count))) {
+                return false;
+            }
+        } else if (!SpecificMessageParsers::decode_i081_events(body_ptr, body_len, stamp, event_batch_, decoded) ||
+                   scratch.apply_update(decoded.prod_msg_seq, std::span(event_batch_.data(), decoded.event_count)) !=
+                       OrderBookManagement::UpdateResult::APPLIED) {
+            return false;
+        }
+        scratch.copy_top_bids(top);
+        scratch.copy_top_asks(top);
+        ++frame_count;
+        return true;
+    };
+
+    for (uint32_t round = 0; round < rounds; ++round) {
+        scratch.reset();
+        bool ok = run(frames.snapshot);
+        for (const auto& update : frames.updates) {
+            ok = ok && run(update);
+        }
+        if (!ok) {
+            LOG_ERROR << "TaifexSdk: synthetic warm-up frame rejected; warm-up frames stopped.";
+            break;
+        }
+    }
+    return frame_count;
+}
+
+const CoreUtils::ChannelStateTable& TaifexSdk::channel_states() const {
+    return channel_states_;
+}
+
+CoreUtils::ChannelStateTable& TaifexSdk::channel_states() {
+    return channel_states_;
+}
+
+void TaifexSdk::poll_timers() {
+    const auto now = clock_now();
+    liveness_.advance(now);
+    // Changes from the last frames before a quiet spell would otherwise wait for the next frame.
+    publish_reader_index_if_due(now);
+    CoreUtils::samplePageFaults();
+}
+
+void TaifexSdk::poll_gap_timeouts() {
+    poll_timers();
+}
+
+void TaifexSdk::set_time_source(TimeSource time_source) {
+    time_source_ = std::move(time_source);
+    liveness_.reset(clock_now());
+}
+
+void TaifexSdk::monitor_liveness(const LivenessConfig& config) {
+    liveness_.configure(config);
+    if (liveness_.products_enabled()) {
+        const auto now = clock_now();
+        for (const auto& [book, identity] : book_identities_) {
+            liveness_.add_book(identity.handle, identity.last_channel, now);
+        }
+    }
+    LOG_INFO << "TaifexSdk: liveness monitoring with channel timeout " << config.channel_timeout.count()
+             << " ms, product timeout " << config.product_timeout.count() << " ms.";
+}
+
+void TaifexSdk::set_liveness_callback(LivenessMonitor::EventCallback callback) {
+    liveness_.set_event_callback(std::move(callback));
+}
+
+ChannelGapManager::Clock::time_point TaifexSdk::get_channel_last_message_time(uint32_t channel_id) const {
+    return liveness_.last_message_time(channel_id);
+}
+
+bool TaifexSdk::is_channel_stale(uint32_t channel_id) const {
+    return liveness_.is_channel_stale(channel_id);
+}
+
+bool TaifexSdk::validate_frame(const unsigned char* raw_message, size_t length, CoreUtils::CommonHeader& out_header) {
     // Assuming header is 19 bytes, body is body_length, then 1 byte checksum, 2 bytes terminal_code
     // Total expected length = CommonHeader::HEADER_SIZE + body_length_from_header + 1 (checksum) + 2 (term_code)
     // Checksum is calculated from byte 1 (ESC is byte 0) up to the byte before checksum.
     if (length < CoreUtils::CommonHeader::HEADER_SIZE + 1 + 2) { // Min length for header, checksum, term_code
         LOG_ERROR << "Message too short for even basic validation.";
-        return;
+        CoreUtils::incrementMetric(CoreUtils::Metric::LENGTH_MISMATCHES);
+        return false;
     }
 
-    // Temporarily parse header to get body_length for full length check and checksum position
-    CoreUtils::CommonHeader temp_header;
-    if (!CoreUtils::CommonHeader::parse(raw_message, length, temp_header)) {
-         LOG_ERROR << "Initial header parse for validation failed (message too short for header).";
-        return;
+    if (!CoreUtils::CommonHeader::parse(raw_message, length, out_header)) {
+        LOG_ERROR << "Initial header parse for validation failed (message too short for header).";
+        CoreUtils::incrementMetric(CoreUtils::Metric::LENGTH_MISMATCHES);
+        return false;
+    }
+    uint16_t body_len_from_header = 0;
+    try {
+        body_len_from_header = out_header.getBodyLength();
+    } catch (const CoreUtils::ParsingError& e) {
+        LOG_ERROR << "Invalid BODY-LENGTH in header: " << e.what();
+        CoreUtils::incrementMetric(CoreUtils::Metric::HEADER_ERRORS);
+        return false;
     }
-    uint16_t body_len_from_header = temp_header.getBodyLength();
     size_t expected_total_length = CoreUtils::CommonHeader::HEADER_SIZE + body_len_from_header + 1 + 2;
 
     if (length != expected_total_length) {
         LOG_ERROR << "Message length mismatch. Expected: " +
                                std::to_string(expected_total_length) + ", Got: " + std::to_string(length);
-        return;
+        CoreUtils::incrementMetric(CoreUtils::Metric::LENGTH_MISMATCHES);
+        return false;
     }
 
     // Checksum byte is at offset: CommonHeader::HEADER_SIZE + body_len_from_header
     unsigned char received_checksum = raw_message[CoreUtils::CommonHeader::HEADER_SIZE + body_len_from_header];
-    // Data to checksum: from raw_message[1] up to raw_message[CommonHeader::HEADER_SIZE + body_len_from_header - 1]
-    // Length of data to checksum = (CommonHeader::HEADER_SIZE + body_len_from_header - 1) - 1 + 1
-    //                             = CommonHeader::HEADER_SIZE + body_len_from_header - 1
-    // Start pointer for checksum is raw_message + 1 (skip ESC)
-    // Length of data to checksum = CommonHeader::HEADER_SIZE (excluding ESC) + body_len_from_header - 1 (actual checksum byte itself)
+    // Data to checksum: from raw_message[1] (skip ESC) up to the byte before the checksum.
     size_t checksum_data_length = (CoreUtils::CommonHeader::HEADER_SIZE -1) + body_len_from_header;
     std::span<const unsigned char> checksum_data_uchars(raw_message + 1, checksum_data_length);
     unsigned char calculated_checksum = CoreUtils::calculateXorChecksum(std::as_bytes(checksum_data_uchars));
@@ -96,76 +1243,88 @@ void TaifexSdk::process_message(const unsigned char* raw_message, size_t length)
     if (calculated_checksum != received_checksum) {
         LOG_ERROR << "Checksum validation failed. Calculated: " +
                                std::to_string(calculated_checksum) + ", Received: " + std::to_string(received_checksum);
-        return;
+        CoreUtils::incrementMetric(CoreUtils::Metric::CHECKSUM_FAILURES);
+        return false;
     }
     LOG_DEBUG << "Checksum validation passed.";
+    return true;
+}
 
-    // 2. Parse Common Header (Dept B)
-    CoreUtils::CommonHeader header; // Already have temp_header, can use it or re-parse for clarity. Let's use temp_header.
-    header = temp_header; // Or re-parse: CoreUtils::CommonHeader::parse(raw_message, length, header);
-
-    LOG_DEBUG << "CommonHeader parsed. BodyLength: " + std::to_string(header.getBodyLength()) +
-                           ", ChannelID: " + std::to_string(header.getChannelId()) +
-                           ", ChannelSeq: " + std::to_string(header.getChannelSeq());
+void TaifexSdk::apply_frame(const unsigned char* raw_message, const CoreUtils::CommonHeader& header) {
+    // Identify Message Type
+    CoreUtils::MessageType msg_type = CoreUtils::identifyMessageType(header);
+    TAIFEX_LATENCY_MARK(HEADER_DECODE);
 
+    // Dispatch to Body Parser/Handler. Handlers extract PROD-ID from the body themselves.
+    const unsigned char* body_ptr = raw_message + CoreUtils::CommonHeader::HEADER_SIZE;
+    const uint16_t body_len = header.getBodyLength();
+    CoreUtils::countMessage(msg_type, CoreUtils::CommonHeader::HEADER_SIZE + body_len + 1 + 2);
+    dispatch_message_body(body_ptr, body_len, msg_type, header);
+    TAIFEX_LATENCY_COMMIT(msg_type);
+}
 
-    // 3. Sequence Number Validation (Basic - per Channel)
-    if (!is_sequence_valid(header)) {
-        // is_sequence_valid should log the details of the error.
-        // Depending on strategy, might return or just flag. For now, assume it logs and we continue.
-        // If strict, could return here.
+void TaifexSdk::dispatch_message_body(const unsigned char* body_ptr,
+                                      uint16_t body_len,
+                                      CoreUtils::MessageType msg_type,
+                                      const CoreUtils::CommonHeader& header) {
+    switch (msg_type) {
+        case CoreUtils::MessageType::I010_PRODUCT_BASIC_DATA:
+            handle_i010(body_ptr, body_len, header);
+            break;
+        case CoreUtils::MessageType::I081_ORDER_BOOK_UPDATE:
+            handle_i081(body_ptr, body_len, header);
+            break;
+        case CoreUtils::MessageType::I083_ORDER_BOOK_SNAPSHOT:
+            handle_i083(body_ptr, body_len, header);
+            break;
+        case CoreUtils::MessageType::I084_SNAPSHOT_REFRESH:
+            // Not decoded yet: the SDK has no I084 body parser. A stale book resyncs from its next I083.
+            LOG_DEBUG << "I084 snapshot refresh ignored; stale books wait for their next I083.";
+            CoreUtils::incrementMetric(CoreUtils::Metric::FILTERED_MESSAGES);
+            break;
+        case CoreUtils::MessageType::I001_HEARTBEAT:
+            handle_i001(header);
+            break;
+        case CoreUtils::MessageType::I002_SEQUENCE_RESET:
+            handle_i002(header);
+            break;
+        case CoreUtils::MessageType::UNKNOWN:
+            LOG_WARNING << "Unknown message type. TRANSMISSION-CODE/MESSAGE-KIND not recognized.";
+            CoreUtils::incrementMetric(CoreUtils::Metric::FILTERED_MESSAGES);
+            break;
+        default:
+            LOG_DEBUG << "No handler for " << CoreUtils::messageTypeToString(msg_type) << ". Message ignored.";
+            CoreUtils::incrementMetric(CoreUtils::Metric::FILTERED_MESSAGES);
+            break;
     }
+}
 
-    // 4. Identify Message Type (Dept B)
-    std::string msg_type_str = CoreUtils::identifyMessageId(header); // Changed to use existing fn
-    // CoreUtils::Logger::Log(CoreUtils::LogLevel::INFO, "Identified MessageType: " + CoreUtils::messageTypeToString(msg_type)); // Commented out due to missing fn and type
-    LOG_INFO << "Identified Message ID: " + msg_type_str;
+std::optional<std::reference_wrapper<const OrderBookManagement::OrderBook>>
+TaifexSdk::get_order_book(const std::string& product_id) const {
+    if (!initialized_) {
+        return std::nullopt;
+    }
+    auto it = order_books_.find(product_id);
+    if (it == order_books_.end()) {
+        return std::nullopt;
+    }
+    return std::cref(it->second);
+}
 
+std::optional<ProductInfo> TaifexSdk::get_product_info(const std::string& product_id) const {
+    if (!initialized_) {
+        return std::nullopt;
+    }
+    const ProductInfo* info = products_.get(products_.find(product_id));
+    if (!info) {
+        return std::nullopt;
+    }
+    return *info;
+}
 
-    // 5. Dispatch to Body Parser/Handler (Dept E)
-    const unsigned char* body_ptr = raw_message + CoreUtils::CommonHeader::HEADER_SIZE;
-    uint16_t body_length = header.getBodyLength();
-
-    // For messages like I081, I083, I010, product ID is in the body.
-    // We need to extract it before calling get_or_create_order_book in some cases.
-    // This is a bit tricky as product_id is needed by the handle_XXX methods.
-    // For now, dispatch_message_body will call the specific parser, then the handler.
-    // The handler will then extract product_id if needed.
-
-    // A temporary way to get product_id for relevant messages before full parsing in handlers.
-    // This is simplified. Ideally, handlers extract this.
-    // std::string product_id_for_handler; // Commented out as msg_type logic is disabled
-    // if (msg_type == CoreUtils::MessageType::I010_PRODUCT_BASIC_DATA) { // Commented out
-        // PROD-ID-S is X(10) at offset 0 of I010 body
-        // if (body_length >= 10) {
-        //     product_id_for_handler.assign(reinterpret_cast<const char*>(body_ptr), 10);
-        // }
-    // } else if (msg_type == CoreUtils::MessageType::I081_ORDER_BOOK_UPDATE || msg_type == CoreUtils::MessageType::I083_ORDER_BOOK_SNAPSHOT) { // Commented out
-        // PROD-ID is X(20) at offset 0 of I081/I083 body
-        // if (body_length >= 20) {
-        //     product_id_for_handler.assign(reinterpret_cast<const char*>(body_ptr), 20);
-        // }
-    // }
-    // For I001, I002, product_id is not in the body.
-
-    // Commenting out dispatch logic due to msg_type_str being a string and MessageType enum missing
-    // if (msg_type_str == "I010") { // Example, actual string values from identifyMessageId not known here
-    //     // PROD-ID-S is X(10) at offset 0 of I010 body
-    //     if (body_length >= 10) {
-    //         product_id_for_handler.assign(reinterpret_cast<const char*>(body_ptr), 10);
-    //     }
-    // } else if (msg_type_str == "I081" || msg_type_str == "I083") { // Example
-    //     // PROD-ID is X(20) at offset 0 of I081/I083 body
-    //     if (body_length >= 20) {
-    //         product_id_for_handler.assign(reinterpret_cast<const char*>(body_ptr), 20);
-    //     }
-    // }
-    // dispatch_message_body(body_ptr, body_length, msg_type_str, header, product_id_for_handler); // msg_type_str is std::string
-    LOG_WARNING << "Message dispatch logic currently commented out due to interface mismatches (MessageType enum).";
-}
-
-
-// ... (get_order_book, get_product_info remain as previously implemented) ...
+const ProductRegistry& TaifexSdk::products() const {
+    return products_;
+}
 
 
 // Specific Message Parser function headers
@@ -180,9 +1339,6 @@ void TaifexSdk::process_message(const unsigned char* raw_message, size_t length)
                        // Sticking to std::string for keys for C++11 compatibility.
 
 
-// Note: process_message's temporary product_id extraction will be superseded by logic in handlers.
-// The dispatch_message_body's temp_product_id parameter will also be removed or ignored.
-
 // --- Private Helper Method Implementations for State Management ---
 
 // Helper to extract the base product ID (PROD-ID-S, typically 10 chars or less if part of a complex ID)
@@ -218,6 +1374,22 @@ static std::string get_base_prod_id_for_i010_lookup(const std::string& prod_id_f
     return prod_id_from_message; // Assume it's already a PROD-ID-S or compatible
 }
 
+// PROD-ID-S whose I010 a book's PROD-ID depends on, without trailing spaces. Same rule as above.
+static std::string_view base_prod_id_s(std::string_view prod_id) {
+    const size_t slash_pos = prod_id.find('/');
+    if (slash_pos != std::string_view::npos) {
+        prod_id = prod_id.substr(0, slash_pos);
+    } else if (prod_id.length() > ProductInfo::PROD_ID_S_LENGTH) {
+        prod_id = prod_id.substr(0, ProductInfo::PROD_ID_S_LENGTH);
+    }
+    return trim_trailing_spaces(prod_id);
+}
+
+bool Taifex::TaifexSdk::is_subscribed(std::string_view prod_id) const {
+    return subscriptions_.empty() ||
+           std::binary_search(subscriptions_.begin(), subscriptions_.end(), base_prod_id_s(prod_id), std::less<>());
+}
+
 OrderBookManagement::OrderBook* Taifex::TaifexSdk::get_or_create_order_book(const std::string& product_id_from_message_body) { // Added Taifex::
     auto it_ob = order_books_.find(product_id_from_message_body);
     if (it_ob != order_books_.end()) {
@@ -226,45 +1398,142 @@ OrderBookManagement::OrderBook* Taifex::TaifexSdk::get_or_create_order_book(cons
 
     // Order book not found, try to create it.
     // Need to find its I010 data for decimal_locator.
+    CoreUtils::ColdPathScope cold_path; // Once per book.
     std::string base_prod_id_for_i010 = get_base_prod_id_for_i010_lookup(product_id_from_message_body); // Now calls the static function defined above
 
-    auto it_info = product_info_cache_.find(base_prod_id_for_i010);
-    if (it_info != product_info_cache_.end()) {
-        const auto& product_info = it_info->second;
-        LOG_INFO << "Creating new OrderBook for PROD-ID: " + product_id_from_message_body +
-                               " using I010 from PROD-ID-S: " + base_prod_id_for_i010 +
-                               " with DecimalLocator: " + std::to_string(product_info.decimal_locator);
+    const ProductInfo* product_info_ptr = products_.get(products_.find(base_prod_id_for_i010));
+    if (product_info_ptr) {
+        const ProductInfo& product_info = *product_info_ptr;
+        LOG_INFO << "Creating new OrderBook for PROD-ID: " << product_id_from_message_body
+                 << " using I010 from PROD-ID-S: " << base_prod_id_for_i010
+                 << " with DecimalLocator: " << static_cast<int>(product_info.decimal_locator);
 
         // Use emplace to construct in place if possible, or insert.
         // Using product_id_from_message_body (which can be 10 or 20 char) as key for order_books_ map.
         auto result = order_books_.emplace(
             std::piecewise_construct,
             std::forward_as_tuple(product_id_from_message_body),
-            std::forward_as_tuple(product_id_from_message_body, product_info.decimal_locator)
+            std::forward_as_tuple(product_id_from_message_body, product_info.decimal_locator, book_memory(), book_depth_)
         );
+        CoreUtils::incrementMetric(CoreUtils::Metric::ORDER_BOOKS_CREATED);
+        register_book(result.first->second, products_.find(base_prod_id_for_i010));
+        if (reader_publication_) {
+            add_book_snapshot(result.first->second);
+        }
+        if (shm_publisher_.is_open()) {
+            const ShmBookIndex index = shm_publisher_.add_book(result.first->second, products_.find(base_prod_id_for_i010));
+            if (index != INVALID_SHM_BOOK_INDEX) {
+                shm_books_[&result.first->second] = index;
+            }
+        }
+        if (state_store_.is_open()) {
+            BookSlot slot = state_store_.add_book(result.first->second);
+            if (slot != INVALID_BOOK_SLOT) {
+                book_slots_[&result.first->second] = slot;
+            }
+        }
         return &result.first->second; // Pointer to the newly created OrderBook
     } else {
-        LOG_WARNING << "No I010 product info found for PROD-ID-S: " +
-                               base_prod_id_for_i010 + " (derived from: " + product_id_from_message_body +
-                               "). Cannot create OrderBook.";
+        LOG_WARNING << "No I010 product info found for PROD-ID-S: " << base_prod_id_for_i010
+                    << " (derived from: " << product_id_from_message_body << "). Cannot create OrderBook.";
         return nullptr;
     }
 }
 
+// Book frames for a product without I010 yet are held (whole frame, so the replay goes through the
+// normal dispatch) keyed by the trimmed PROD-ID-S that the I010 will carry.
+void Taifex::TaifexSdk::hold_pending_frame(const std::string& product_id, uint32_t channel_id, bool is_snapshot,
+                                           const unsigned char* body_ptr, uint16_t body_len) {
+    CoreUtils::ColdPathScope cold_path; // Only before the product's I010.
+    std::string key = get_base_prod_id_for_i010_lookup(product_id);
+    key.erase(key.find_last_not_of(' ') + 1);
+    const unsigned char* frame = body_ptr - CoreUtils::CommonHeader::HEADER_SIZE;
+    const size_t frame_len = CoreUtils::CommonHeader::HEADER_SIZE + body_len + 1 + 2;
+
+    const uint64_t dropped_before = pending_frames_.dropped_count();
+    if (pending_frames_.push(key, channel_id, is_snapshot, frame, frame_len)) {
+        CoreUtils::incrementMetric(CoreUtils::Metric::PENDING_FRAMES_QUEUED);
+        LOG_DEBUG << "Holding " << (is_snapshot ? "I083" : "I081") << " for PROD-ID: " << product_id
+                  << " until I010 for PROD-ID-S: " << key << " arrives.";
+    } else {
+        LOG_WARNING << "Pending frame buffer full. " << (is_snapshot ? "I083" : "I081") << " for PROD-ID: "
+                    << product_id << " without I010 dropped.";
+    }
+    const uint64_t dropped = pending_frames_.dropped_count() - dropped_before;
+    if (dropped != 0) {
+        CoreUtils::incrementMetric(CoreUtils::Metric::PENDING_FRAMES_DROPPED, dropped);
+    }
+}
+
+void Taifex::TaifexSdk::replay_pending_frames(std::string_view prod_id_s) {
+    std::vector<PendingFrameBuffer::Frame> frames = pending_frames_.take(prod_id_s);
+    if (frames.empty()) {
+        return;
+    }
+    LOG_INFO << "Replaying " << frames.size() << " held book frames for PROD-ID-S: " << prod_id_s << ".";
+    for (const PendingFrameBuffer::Frame& frame : frames) {
+        CoreUtils::CommonHeader header;
+        if (!CoreUtils::CommonHeader::parse(frame.data(), frame.size(), header)) {
+            continue; // Validated on arrival; cannot happen.
+        }
+        dispatch_message_body(frame.data() + CoreUtils::CommonHeader::HEADER_SIZE, header.getBodyLength(),
+                              CoreUtils::identifyMessageType(header), header);
+    }
+    CoreUtils::incrementMetric(CoreUtils::Metric::PENDING_FRAMES_REPLAYED, frames.size());
+}
+
 // Moved handle_i010, handle_i081, etc. after get_or_create_order_book and get_base_prod_id_for_i010_lookup
 // to ensure functions are defined before use or declared appropriately.
 // The actual order of these handler functions (handle_i010, handle_i081, etc.) among themselves doesn't matter
-// as they are methods of TaifexSdk and called from dispatch_message_body (which is currently commented out).
+// as they are methods of TaifexSdk and called from dispatch_message_body.
 
 void Taifex::TaifexSdk::handle_i010(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header) { // Added Taifex::
+    TAIFEX_LATENCY_MARK(DISPATCH);
+    // I010 is rebroadcast for every product all day. Hash the raw body and skip parsing entirely
+    // when it is byte-identical to the last one seen for this PROD-ID-S (the first 10 bytes).
+    const uint64_t body_hash = CoreUtils::calculateFnv1a64(
+        std::as_bytes(std::span<const unsigned char>(body_ptr, body_len)));
+    if (body_len >= ProductInfo::PROD_ID_S_LENGTH) {
+        ProductHandle known = products_.find(std::string_view(reinterpret_cast<const char*>(body_ptr),
+                                                              ProductInfo::PROD_ID_S_LENGTH));
+        if (known < i010_body_hashes_.size() && i010_body_hashes_[known] == body_hash) {
+            ++unchanged_i010_skipped_;
+            return;
+        }
+    }
+    if (!is_subscribed(std::string_view(reinterpret_cast<const char*>(body_ptr),
+                                        std::min<size_t>(body_len, ProductInfo::PROD_ID_S_LENGTH)))) {
+        CoreUtils::incrementMetric(CoreUtils::Metric::FILTERED_MESSAGES);
+        return;
+    }
+
+    CoreUtils::ColdPathScope cold_path; // Reference data changes; also replays held frames.
     SpecificMessageParsers::MessageI010 i010_msg;
     if (SpecificMessageParsers::parse_i010_body(body_ptr, body_len, i010_msg)) {
-        std::string prod_id_s = i010_msg.prod_id_s;
-        // CoreUtils::trim(prod_id_s); // Ensure key is clean // Commented out
+        TAIFEX_LATENCY_MARK(BODY_PARSE);
+        ProductInfo info;
+        if (!ProductInfo::from_message(i010_msg, info)) {
+            LOG_ERROR << "Invalid date field in I010 for PROD-ID-S: " + i010_msg.prod_id_s;
+            return;
+        }
+        bool changed = false;
+        ProductHandle handle = products_.upsert(info, changed);
+        if (handle >= i010_body_hashes_.size()) {
+            i010_body_hashes_.resize(handle + 1, 0);
+        }
+        i010_body_hashes_[handle] = body_hash;
+        TAIFEX_LATENCY_MARK(BOOK_APPLY);
 
-        LOG_INFO << "Parsed I010 for PROD-ID-S: " + prod_id_s +
-                               ", DecLoc: " + std::to_string(i010_msg.decimal_locator);
-        product_info_cache_[prod_id_s] = i010_msg;
+        if (changed) {
+            LOG_INFO << "Parsed I010 for PROD-ID-S: " + i010_msg.prod_id_s +
+                                   ", DecLoc: " + std::to_string(i010_msg.decimal_locator) +
+                                   ", Handle: " + std::to_string(handle);
+            product_changed(handle);
+            TAIFEX_LATENCY_MARK(CALLBACKS);
+        }
+        if (!pending_frames_.empty()) {
+            replay_pending_frames(info.id());
+        }
 
         // If an order book for this product (or a complex one deriving from it) exists
         // but was created before I010 arrived (e.g. if it used a default decimal_locator),
@@ -279,43 +1548,108 @@ void Taifex::TaifexSdk::handle_i010(const unsigned char* body_ptr, uint16_t body
 }
 
 
-void Taifex::TaifexSdk::handle_i081(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header, const std::string& /*temp_product_id_from_dispatch*/) { // Added Taifex::
-    SpecificMessageParsers::MessageI081 i081_msg;
-    if (SpecificMessageParsers::parse_i081_body(body_ptr, body_len, i081_msg)) {
-        std::string current_prod_id = i081_msg.prod_id;
-        // CoreUtils::trim(current_prod_id); // Commented out
+void Taifex::TaifexSdk::handle_i081(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header) { // Added Taifex::
+    TAIFEX_LATENCY_MARK(DISPATCH);
+    if (!is_subscribed(std::string_view(reinterpret_cast<const char*>(body_ptr), std::min<size_t>(body_len, 20)))) {
+        CoreUtils::incrementMetric(CoreUtils::Metric::FILTERED_MESSAGES);
+        return;
+    }
+    // The body decodes straight into event_batch_: the book applies those events and the same
+    // buffer is then handed to the event callback and ring.
+    const CoreUtils::NormalizedEvent stamp = event_stamp(header);
+    SpecificMessageParsers::BookMessageEvents decoded;
+    if (SpecificMessageParsers::decode_i081_events(body_ptr, body_len, stamp, event_batch_, decoded)) {
+        TAIFEX_LATENCY_MARK(BODY_PARSE);
+        event_prod_id_.assign(decoded.prod_id);
+        const std::string& current_prod_id = event_prod_id_;
 
-        LOG_INFO << "Parsed I081 for PROD-ID: " + current_prod_id +
-                               ", MsgSeq: " + std::to_string(i081_msg.prod_msg_seq) +
-                               ", Entries: " + std::to_string(i081_msg.no_md_entries);
+        LOG_DEBUG << "Parsed I081 for PROD-ID: " << current_prod_id << ", MsgSeq: " << decoded.prod_msg_seq
+                  << ", Events: " << decoded.event_count;
 
         OrderBookManagement::OrderBook* ob = get_or_create_order_book(current_prod_id);
         if (ob) {
-            ob->apply_update(i081_msg);
+            index_book_channel(*ob, header.getChannelId());
+            const std::span<CoreUtils::NormalizedEvent> events(event_batch_.data(), decoded.event_count);
+            const OrderBookManagement::UpdateResult result = ob->apply_update(decoded.prod_msg_seq, events);
+            if (result == OrderBookManagement::UpdateResult::APPLIED ||
+                result == OrderBookManagement::UpdateResult::GAP_DETECTED) {
+                book_changed(*ob);
+            }
+            TAIFEX_LATENCY_MARK(BOOK_APPLY);
+            switch (result) {
+                case OrderBookManagement::UpdateResult::APPLIED:
+                    update_bars(*ob, stamp.exchange_time_us);
+                    record_tick(*ob, stamp.exchange_time_us);
+                    flush_frame_events(*ob, events.size());
+                    notify_order_book_update(*ob);
+                    break;
+                case OrderBookManagement::UpdateResult::GAP_DETECTED:
+                    record_tick(*ob, stamp.exchange_time_us);
+                    if (events_enabled()) {
+                        append_event(*ob, header, CoreUtils::EventType::BOOK_STALE, decoded.prod_msg_seq);
+                        flush_events();
+                    }
+                    CoreUtils::incrementMetric(CoreUtils::Metric::PRODUCT_SEQUENCE_GAPS);
+                    LOG_WARNING << "PROD-MSG-SEQ gap for PROD-ID: " << current_prod_id << ". Expected: "
+                                << ob->get_last_prod_msg_seq() + 1 << ", Got: " << decoded.prod_msg_seq
+                                << ". Book marked stale until next I083.";
+                    break;
+                case OrderBookManagement::UpdateResult::DUPLICATE:
+                    LOG_DEBUG << "Old PROD-MSG-SEQ " << decoded.prod_msg_seq << " for PROD-ID: " << current_prod_id
+                              << " ignored.";
+                    break;
+                case OrderBookManagement::UpdateResult::IGNORED_STALE:
+                    LOG_DEBUG << "OrderBook for PROD-ID: " << current_prod_id << " is stale; I081 ignored until next snapshot.";
+                    break;
+            }
         } else {
-            LOG_ERROR << "Failed to get/create OrderBook for PROD-ID: " + current_prod_id + " for I081. Message unprocessed.";
-            // TODO: Strategy for messages for products without I010? Queue them? Discard?
+            hold_pending_frame(current_prod_id, header.getChannelId(), false, body_ptr, body_len);
         }
     } else {
         LOG_ERROR << "Failed to parse I081 body.";
     }
 }
 
-void Taifex::TaifexSdk::handle_i083(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header, const std::string& /*temp_product_id_from_dispatch*/) { // Added Taifex::
-    SpecificMessageParsers::MessageI083 i083_msg;
-    if (SpecificMessageParsers::parse_i083_body(body_ptr, body_len, i083_msg)) {
-        std::string current_prod_id = i083_msg.prod_id;
-        // CoreUtils::trim(current_prod_id); // Commented out
+void Taifex::TaifexSdk::handle_i083(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header) { // Added Taifex::
+    TAIFEX_LATENCY_MARK(DISPATCH);
+    if (!is_subscribed(std::string_view(reinterpret_cast<const char*>(body_ptr), std::min<size_t>(body_len, 20)))) {
+        CoreUtils::incrementMetric(CoreUtils::Metric::FILTERED_MESSAGES);
+        return;
+    }
+    const CoreUtils::NormalizedEvent stamp = event_stamp(header);
+    SpecificMessageParsers::BookMessageEvents decoded;
+    if (SpecificMessageParsers::decode_i083_events(body_ptr, body_len, stamp, event_batch_, decoded)) {
+        TAIFEX_LATENCY_MARK(BODY_PARSE);
+        event_prod_id_.assign(decoded.prod_id);
+        const std::string& current_prod_id = event_prod_id_;
 
-        LOG_INFO << "Parsed I083 for PROD-ID: " + current_prod_id +
-                               ", MsgSeq: " + std::to_string(i083_msg.prod_msg_seq) +
-                               ", Entries: " + std::to_string(i083_msg.no_md_entries);
+        LOG_DEBUG << "Parsed I083 for PROD-ID: " << current_prod_id << ", MsgSeq: " << decoded.prod_msg_seq
+                  << ", Events: " << decoded.event_count;
 
         OrderBookManagement::OrderBook* ob = get_or_create_order_book(current_prod_id);
         if (ob) {
-            ob->apply_snapshot(i083_msg);
+            index_book_channel(*ob, header.getChannelId());
+            const std::span<CoreUtils::NormalizedEvent> events(event_batch_.data(), decoded.event_count);
+            const bool was_stale = ob->is_stale();
+            const bool applied = ob->apply_snapshot(decoded.prod_msg_seq, events);
+            if (applied) {
+                book_changed(*ob);
+            }
+            TAIFEX_LATENCY_MARK(BOOK_APPLY);
+            if (applied) {
+                if (was_stale) {
+                    LOG_INFO << "OrderBook for PROD-ID: " << current_prod_id << " resynchronized from I083 at PROD-MSG-SEQ "
+                             << decoded.prod_msg_seq << ".";
+                }
+                update_bars(*ob, stamp.exchange_time_us);
+                record_tick(*ob, stamp.exchange_time_us);
+                flush_frame_events(*ob, events.size());
+                notify_order_book_update(*ob);
+            } else {
+                LOG_DEBUG << "Outdated I083 for PROD-ID: " << current_prod_id << " ignored.";
+            }
         } else {
-            LOG_ERROR << "Failed to get/create OrderBook for PROD-ID: " + current_prod_id + " for I083. Message unprocessed.";
+            hold_pending_frame(current_prod_id, header.getChannelId(), true, body_ptr, body_len);
         }
     } else {
         LOG_ERROR << "Failed to parse I083 body.";
@@ -323,60 +1657,181 @@ void Taifex::TaifexSdk::handle_i083(const unsigned char* body_ptr, uint16_t body
 }
 
 void Taifex::TaifexSdk::handle_i001(const CoreUtils::CommonHeader& header) { // Added Taifex::
-    LOG_INFO << "Processing Heartbeat I001. Channel: " + std::to_string(header.getChannelId()) + ", Seq: " + std::to_string(header.getChannelSeq());
-    // No specific state change other than sequence number already handled by is_sequence_valid
+    TAIFEX_LATENCY_MARK(DISPATCH);
+    LOG_DEBUG << "Processing Heartbeat I001. Channel: " << header.getChannelId() << ", Seq: " << header.getChannelSeq();
+    // No book state changes: classify_sequence has already accepted this CHANNEL-SEQ as the next
+    // one, process_message has noted the channel alive for the liveness monitor, and its
+    // INFORMATION-TIME still closes bars on a quiet market.
+    bars_.advance(header.getInformationTimeMicros());
 }
 
 void Taifex::TaifexSdk::handle_i002(const CoreUtils::CommonHeader& header) { // Added Taifex::
     // I002: "若該CHANNEL屬即時行情群組則須清空各商品委託簿,並重置該傳輸群組之群組序號,同時重置各商品行情訊息流水序號"
+    TAIFEX_LATENCY_MARK(DISPATCH);
+    CoreUtils::ColdPathScope cold_path;
     LOG_INFO << "Processing Sequence Reset I002 for Channel: " + std::to_string(header.getChannelId());
 
-    // For now, reset ALL order books. A more granular approach might be needed if OrderBook
-    // objects were associated with specific channels, or if the I002 implies a global reset.
-    // The spec says "清空各商品委託簿" (clear all products' order books) for that channel.
-    // If we don't map books to channels here, we reset all.
-    for (auto& pair_ob : order_books_) { // C++11: auto& pair_ob : order_books_
-        LOG_DEBUG << "Resetting OrderBook for PROD-ID: " + pair_ob.first + " due to I002.";
-        pair_ob.second.reset();
+    // "清空各商品委託簿" applies to the books of this channel only; books on other channels keep
+    // their state. The channel's books are one contiguous array of pointers, walked once.
+    const uint32_t channel_id = header.getChannelId();
+    const auto reset_start = std::chrono::steady_clock::now();
+    const uint64_t exchange_time_us = header.getInformationTimeMicros();
+    const std::span<OrderBookManagement::OrderBook* const> books =
+        channel_id < channel_books_.size() ? std::span<OrderBookManagement::OrderBook* const>(channel_books_[channel_id])
+                                           : std::span<OrderBookManagement::OrderBook* const>();
+    for (OrderBookManagement::OrderBook* book : books) {
+        book->reset();
+    }
+    for (OrderBookManagement::OrderBook* book : books) {
+        book_changed(*book);
+        record_tick(*book, exchange_time_us, TickStore::FLAG_RESET);
+        if (events_enabled()) {
+            append_event(*book, header, CoreUtils::EventType::BOOK_CLEAR, 0).flags |=
+                CoreUtils::NormalizedEvent::FLAG_RESET;
+        }
     }
+    flush_events(); // The whole reset is one message: only its last event carries END.
 
-    // Reset channel sequence number for this specific channel
-    uint32_t channel_id = header.getChannelId();
-    channel_sequences_[channel_id] = 0; // Reset to 0, next expected will be 1 (or as per actual start seq)
-                                        // Or, remove the entry: channel_sequences_.erase(channel_id);
-                                        // Setting to 0 seems safer if first seq is > 0.
+    CoreUtils::incrementMetric(CoreUtils::Metric::SEQUENCE_RESETS);
+    CoreUtils::incrementMetric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS, books.size());
+    CoreUtils::incrementMetric(CoreUtils::Metric::SEQUENCE_RESET_NANOS,
+                               static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                         std::chrono::steady_clock::now() - reset_start)
+                                                         .count()));
+    LOG_INFO << "I002 cleared " << books.size() << " books of Channel " << channel_id << ".";
+
+    // Reset channel sequence number for this specific channel. The channel is unsynced so the next
+    // message on it re-establishes the baseline, whatever sequence it restarts from.
+    if (CoreUtils::ChannelState* state = channel_states_.find(channel_id)) {
+        state->synced = false;
+        state->reset_epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+    gap_manager_.reset_channel(channel_id); // Frames held from before the reset are obsolete,
+    pending_frames_.clear_channel(channel_id); // as are the channel's frames waiting for an I010.
+    TAIFEX_LATENCY_MARK(BOOK_APPLY);
     LOG_INFO << "Channel sequence for Channel " + std::to_string(channel_id) + " reset.";
 
     // "同時重置各商品行情訊息流水序號" - this is handled by OrderBook::reset() which sets its last_prod_msg_seq_ to 0.
 }
 
-bool Taifex::TaifexSdk::is_sequence_valid(const CoreUtils::CommonHeader& header) { // Added Taifex::
-    uint32_t channel_id = header.getChannelId();
-    uint64_t current_channel_seq = header.getChannelSeq();
-
-    auto it = channel_sequences_.find(channel_id);
-    if (it == channel_sequences_.end()) {
-        // First message for this channel
+Taifex::TaifexSdk::SequenceStatus Taifex::TaifexSdk::classify_sequence(CoreUtils::ChannelState& state, uint32_t channel_id,
+                                                                       uint64_t current_channel_seq,
+                                                                       const unsigned char* raw_message, size_t length,
+                                                                       ChannelGapManager::Clock::time_point now) {
+    if (!state.synced) {
+        // First message for this channel (or first after an I002)
+        CoreUtils::ColdPathScope cold_path;
         LOG_INFO << "First message for Channel " + std::to_string(channel_id) +
                                ", received Seq: " + std::to_string(current_channel_seq) + ". Storing.";
-        channel_sequences_[channel_id] = current_channel_seq;
-        return true;
+        state.synced = true;
+        state.expected_seq = current_channel_seq + 1;
+        register_channel(channel_id);
+        return SequenceStatus::IN_SEQUENCE;
     }
 
-    uint64_t last_known_seq = it->second;
-    if (current_channel_seq == last_known_seq + 1) {
+    if (current_channel_seq == state.expected_seq) {
         // Expected sequence
-        it->second = current_channel_seq;
-        return true;
-    } else if (current_channel_seq <= last_known_seq) {
-        LOG_WARNING << "Out-of-order/replay Channel Seq for Channel " + std::to_string(channel_id) +
-                               ". Expected > " + std::to_string(last_known_seq) + ", Got: " + std::to_string(current_channel_seq);
-        return false; // Or a special status
-    } else { // current_channel_seq > last_known_seq + 1
-        LOG_WARNING << "Gap detected in Channel Seq for Channel " + std::to_string(channel_id) +
-                               ". Expected: " + std::to_string(last_known_seq + 1) + ", Got: " + std::to_string(current_channel_seq);
-        it->second = current_channel_seq; // Update to current to resync past the gap
-        return false; // Or a special status indicating gap
+        ++state.expected_seq;
+        return SequenceStatus::IN_SEQUENCE;
+    } else if (current_channel_seq < state.expected_seq) {
+        // Also the normal fate of retransmitted frames that were already recovered via another path.
+        LOG_DEBUG << "Out-of-order/replay Channel Seq for Channel " << channel_id << ". Expected "
+                  << state.expected_seq << ", Got: " << current_channel_seq;
+        return SequenceStatus::DUPLICATE;
+    }
+
+    // current_channel_seq > expected: hold it until the gap is filled.
+    const bool new_gap = !gap_manager_.is_recovering(channel_id);
+    if (gap_manager_.hold(channel_id, state.expected_seq, current_channel_seq, raw_message, length, now)) {
+        if (new_gap) {
+            state.gaps_detected.fetch_add(1, std::memory_order_relaxed);
+            CoreUtils::incrementMetric(CoreUtils::Metric::SEQUENCE_GAPS);
+        }
+        return SequenceStatus::HELD;
+    }
+    // Too far ahead to buffer: give up on the gap now and continue from this frame.
+    if (new_gap) {
+        state.gaps_detected.fetch_add(1, std::memory_order_relaxed);
+        CoreUtils::incrementMetric(CoreUtils::Metric::SEQUENCE_GAPS);
+        state.gaps_abandoned.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        abandon_gap(state, channel_id, now);
+    }
+    state.synced = true; // A drained I002 may have unsynced the channel; this frame is the new baseline.
+    state.expected_seq = current_channel_seq + 1;
+    return SequenceStatus::IN_SEQUENCE;
+}
+
+bool Taifex::TaifexSdk::drain_reorder_buffer(CoreUtils::ChannelState& state, uint32_t channel_id,
+                                             ChannelGapManager::Clock::time_point now) {
+    if (!gap_manager_.is_recovering(channel_id)) {
+        return false;
+    }
+    while (state.synced) { // Unsynced if a drained frame was an I002.
+        const uint64_t next_seq = state.expected_seq;
+        const std::vector<unsigned char>* frame = gap_manager_.held_frame(channel_id, next_seq);
+        if (!frame) {
+            break;
+        }
+        ++state.expected_seq;
+        CoreUtils::CommonHeader header;
+        if (CoreUtils::CommonHeader::parse(frame->data(), frame->size(), header)) { // Validated when held.
+            apply_frame(frame->data(), header);
+        }
+        gap_manager_.release(channel_id, next_seq);
+    }
+    if (state.synced) {
+        gap_manager_.on_drained(channel_id, state.expected_seq, now);
+    }
+    return !gap_manager_.is_recovering(channel_id);
+}
+
+void Taifex::TaifexSdk::register_channel(uint32_t channel_id) {
+    gap_manager_.register_channel(channel_id);
+    liveness_.register_channel(channel_id);
+}
+
+void Taifex::TaifexSdk::on_channel_timer(LivenessMonitor::ChannelTimer timer, uint32_t channel_id,
+                                         ChannelGapManager::Clock::time_point now) {
+    if (!gap_manager_.is_recovering(channel_id)) {
+        return; // Recovered, skipped or reset since the timer was armed.
+    }
+    CoreUtils::ChannelState& state = *channel_states_.find(channel_id);
+    switch (timer) {
+        case LivenessMonitor::ChannelTimer::GAP:
+            if (gap_manager_.has_timed_out(channel_id, now)) {
+                abandon_gap(state, channel_id, now);
+                persist_channel(channel_id, state);
+            } else {
+                // Drained part of the way since, which restarted the window; or a newer gap.
+                liveness_.arm(timer, channel_id, gap_manager_.gap_deadline(channel_id));
+            }
+            break;
+        case LivenessMonitor::ChannelTimer::RETRANSMISSION:
+            CoreUtils::incrementMetric(CoreUtils::Metric::RETRANSMISSION_RETRIES,
+                                       gap_manager_.request_missing(channel_id, state.expected_seq));
+            liveness_.arm(timer, channel_id, now + gap_manager_.config().retransmission_timeout);
+            break;
+    }
+}
+
+void Taifex::TaifexSdk::abandon_gap(CoreUtils::ChannelState& state, uint32_t channel_id,
+                                    ChannelGapManager::Clock::time_point now) {
+    LOG_WARNING << "Gap on Channel " << channel_id << " could not be recovered by retransmission. Skipping it.";
+    state.gaps_abandoned.fetch_add(1, std::memory_order_relaxed);
+
+    // Books that lost an I081 in the skipped range notice it themselves from the PROD-MSG-SEQ of
+    // their next update and wait for their own I083; every other book keeps flowing.
+
+    // Apply whatever is held, skipping over the holes, so the channel resumes in order.
+    uint64_t next_held = 0;
+    while ((next_held = gap_manager_.lowest_held_seq(channel_id)) != 0) {
+        if (!state.synced) {
+            gap_manager_.reset_channel(channel_id);
+            break;
+        }
+        state.expected_seq = next_held;
+        drain_reorder_buffer(state, channel_id, now); // Closes the gap once nothing is held.
     }
 }
 
@@ -5,8 +5,33 @@
 #include <vector>
 #include <map>
 #include <memory> // For std::unique_ptr if managing OrderBooks that way, or just direct objects in map.
+#include <memory_resource>
 #include <optional>
 #include <functional> // For std::reference_wrapper if returning const references via optional
+#include <chrono>
+#include <span>
+#include <unordered_map>
+#include <array>
+
+#include "channel_state.h"
+#include "metrics.h"
+#include "latency_histogram.h"
+#include "normalized_event.h"
+#include "sdk/channel_gap_manager.h"
+#include "sdk/product_registry.h"
+#include "sdk/state_store.h"
+#include "sdk/shm_book_publisher.h"
+#include "sdk/shm_event_publisher.h"
+#include "sdk/uds_fanout_server.h"
+#include "sdk/event_journal.h"
+#include "sdk/bar_aggregator.h"
+#include "sdk/tick_store.h"
+#include "sdk/liveness_monitor.h"
+#include "sdk/warm_up.h"
+#include "sdk/sdk_config.h"
+#include "sdk/sdk_reader.h"
+#include "sdk/update_stream.h"
+#include "messages/message_events.h"
 
 // Forward declarations for types from other modules
 namespace CoreUtils {
@@ -39,6 +64,7 @@ namespace Taifex {
  * The SDK is designed to be initialized once and then process messages sequentially.
  * It is not inherently thread-safe for concurrent calls to `process_message` or
  * state-modifying methods on the same instance without external locking.
+ * Other threads can query a live instance without locking through `create_reader()`.
  */
 class TaifexSdk {
 public:
@@ -58,14 +84,61 @@ public:
     /**
      * @brief Initializes the SDK and prepares it for message processing.
      * This method should be called once before any calls to `process_message`.
-     * Future versions might accept configuration parameters (e.g., logging settings,
+     * Future versions might accept further configuration parameters (e.g., logging settings,
      * specific operational modes).
      *
-     * @param config_params Placeholder for potential future configuration parameters.
+     * @param gap_config Sizing of the per-channel reorder buffers and the gap timeout after which
+     *                   the SDK gives up on retransmission and falls back to snapshot recovery.
      * @return True if initialization is successful, false otherwise. Errors during
      *         initialization will be logged.
      */
-    bool initialize(/* Potential config parameters */);
+    bool initialize(const GapRecoveryConfig& gap_config = GapRecoveryConfig{});
+
+    /**
+     * @brief Initializes the SDK with full configuration.
+     *
+     * If `config.product_cache` names a cache file valid for its trading date, the cached products
+     * are loaded, so order books can be created from the first I083 instead of waiting for the
+     * I010 cycle. Live I010s replace the cached records as they arrive.
+     *
+     * `config.capacity` presizes the product and book tables, allocates the reorder rings of the
+     * listed channels and the pool that order book levels are taken from, and restricts processing
+     * to the subscribed products. With the capacity filled in, steady-state I081/I083 processing
+     * does not touch the heap; `config.allocation_check` verifies that per frame.
+     */
+    bool initialize(const SdkConfig& config);
+
+    /**
+     * @brief Saves the product table to the configured product cache (e.g. at end of day).
+     *        Also done on destruction when `ProductCacheConfig::save_on_shutdown` is set.
+     * @return False if no cache is configured or the file could not be written.
+     */
+    bool save_product_cache() const;
+
+    /**
+     * @brief Keeps the product table, order books and committed channel sequences in a
+     *        memory-mapped file (see `StateStore`). Call after `initialize()` and before the first
+     *        `process_message`.
+     *
+     * If the file holds state from a previous run, it is restored: products and books are rebuilt,
+     * and each channel resumes after its last committed CHANNEL-SEQ, so only later messages are
+     * requested by gap recovery. Otherwise the file is initialised from the SDK's current state.
+     *
+     * @return False if the file could not be created or mapped; the SDK then runs without it.
+     */
+    bool attach_state_store(const StateStoreConfig& config);
+
+    /** @brief Schedules write-back of the state file to disk. No-op without a state store. */
+    void flush_state_store();
+
+    /**
+     * @brief Publishes products, top-N books and a BBO table to a POSIX shared-memory segment that
+     *        `ShmBookReader`s in other processes map (see `ShmBookPublisher`). Call after
+     *        `initialize()`; what the SDK already holds is published at once, later changes as they
+     *        are applied. The segment is closed when this instance is destroyed.
+     * @return False if the segment could not be created; the SDK then runs without it.
+     */
+    bool publish_to_shared_memory(const ShmPublicationConfig& config);
 
     /**
      * @brief Processes a single raw incoming TAIFEX market data message.
@@ -75,14 +148,18 @@ public:
      *    an error is logged, and processing for this message stops.
      * 2. Parses the common message header to identify message type, body length, channel ID, and sequence number.
      * 3. Validates channel sequence numbers using the `CHANNEL-SEQ` from the header.
-     *    Out-of-order or gap messages are logged. The SDK attempts to resynchronize on gaps.
-     *    Messages deemed invalid due to sequence (e.g., replay) may be dropped.
+     *    Replayed/duplicate messages are dropped. Messages that arrive ahead of a gap are held in
+     *    the channel's reorder buffer and the missing range is requested through the retransmission
+     *    requester (see `set_retransmission_requester`). Once the holes are filled the held messages
+     *    are applied in order. If the gap is not filled within `GapRecoveryConfig::gap_timeout`, the
+     *    SDK skips it. Order books that lost an update detect it from their PROD-MSG-SEQ.
      * 4. Dispatches to a specific message body parser based on the identified message type.
      * 5. Updates internal state:
      *    - For I010 (Product Basic Data): Product information is parsed and cached.
      *    - For I081 (Order Book Update) & I083 (Order Book Snapshot): The relevant order book is retrieved or created
-     *      (if I010 data is available for it) and updated with the message content.
-     *    - For I002 (Sequence Reset): Resets relevant order books and channel sequence tracking.
+     *      (if I010 data is available for it) and updated with the message content. A gap in an I081's
+     *      PROD-MSG-SEQ marks only that product's book stale; it ignores updates until its next I083.
+     *    - For I002 (Sequence Reset): Clears the books of that channel and resets its sequence tracking.
      *    - For I001 (Heartbeat): Primarily updates channel sequence tracking.
      *
      * Errors encountered during parsing or processing (e.g., malformed body, missing prerequisite I010 data
@@ -119,48 +196,410 @@ public:
     get_order_book(const std::string& product_id) const;
 
     /**
-     * @brief Retrieves read-only product information (I010 data) for a given product ID.
+     * @brief Retrieves product information (I010 data) for a given product ID.
      *
      * The product ID typically corresponds to the `PROD-ID-S` field from an I010 message
-     * (usually up to 10 characters, after trimming).
+     * (up to 10 characters; trimmed and space-padded forms are both accepted).
      *
      * @param product_id The product identifier (typically the `PROD-ID-S` or a key that maps to it)
      *                   for which product information is requested.
-     * @return An `std::optional<std::reference_wrapper<const SpecificMessageParsers::MessageI010>>`.
-     *         If product information for the given `product_id` is found in the cache and the SDK is initialized,
-     *         the optional will contain a const reference to the `MessageI010` struct.
-     *         Otherwise (e.g., SDK not initialized, no I010 message processed for this ID),
-     *         it returns `std::nullopt`.
-     * @note The returned reference is const. Its lifetime is tied to the `TaifexSdk` instance
-     *       and the internal `product_info_cache_`.
+     * @return A copy of the compact `ProductInfo` record, or `std::nullopt` if the SDK is not
+     *         initialized or no I010 message has been processed for this ID.
      */
-    std::optional<std::reference_wrapper<const SpecificMessageParsers::MessageI010>>
-    get_product_info(const std::string& product_id) const;
+    std::optional<ProductInfo> get_product_info(const std::string& product_id) const;
 
-    // TODO: Add callback registration mechanism if needed (e.g., for specific message types or order book updates).
+    /**
+     * @brief Product reference data by `ProductHandle`. Handles are assigned on the first I010 for a
+     *        product and stay valid for the lifetime of the SDK.
+     */
+    const ProductRegistry& products() const;
+
+    /**
+     * @brief Returns a handle for querying products and books from other threads while this
+     *        instance processes messages (see `SdkReader`). The processing thread takes no locks
+     *        for it: books are published through per-book seqlocks and the product/book index is
+     *        republished at most every `SdkConfig::reader_publish_interval`.
+     *
+     * The first call enables publishing, so it must be made on the processing thread or before
+     * processing starts; later calls may come from anywhere the first reader can be copied to.
+     */
+    SdkReader create_reader();
+
+    /**
+     * @brief Opens a stream of top-of-book updates for coroutines on `executor`, fed from the
+     *        processing thread whenever the update callback would fire (see `UpdateStream`).
+     * @param prod_ids PROD-IDs to deliver; empty for every book.
+     * @param capacity Ring size, rounded up to a power of two. Updates that find it full are dropped.
+     *
+     * Like `create_reader()`, call it on the processing thread or before processing starts. The
+     * stream is closed when this instance is destroyed; close it earlier to unsubscribe.
+     */
+    std::shared_ptr<UpdateStream> subscribe_updates(UpdateExecutor& executor, std::vector<std::string> prod_ids = {},
+                                                    size_t capacity = 1024);
+
+    /**
+     * @brief Registers the callback used to request retransmission of missing CHANNEL-SEQ ranges.
+     *
+     * `Networking::NetworkManager` registers itself here when started, so that gaps detected by
+     * the SDK are turned into DataRequest101 messages. Pass nullptr to unregister.
+     */
+    void set_retransmission_requester(ChannelGapManager::RetransmissionRequester requester);
+
+    /**
+     * @brief Fires every SDK timer that is due (see `LivenessMonitor`): gaps that waited longer
+     *        than `GapRecoveryConfig::gap_timeout` are skipped (affected books then recover from
+     *        their I083), holes are requested again every `GapRecoveryConfig::retransmission_timeout`,
+     *        and channels and books that went quiet are reported (see `monitor_liveness`).
+     *
+     * Processing a message fires due timers too; this method keeps them firing when the feed is
+     * quiet, and also publishes reader index changes that are due (see `create_reader`). `Networking::NetworkManager` calls it every `NetworkManagerConfig::timer_interval`.
+     * Timers only look at the due ones, so polling often is cheap.
+     */
+    void poll_timers();
+    /** @brief Same as `poll_timers()`. */
+    void poll_gap_timeouts();
+
+    /** @brief Current time for every SDK timer and timestamp. */
+    using TimeSource = std::function<ChannelGapManager::Clock::time_point()>;
+    /**
+     * @brief Replaces the steady clock as the SDK's notion of now (nullptr restores it), e.g. with
+     *        a virtual clock that a replay advances from INFORMATION-TIME before calling
+     *        `poll_timers()`. Armed timers are dropped and re-armed by the next messages, so set
+     *        it before processing starts.
+     */
+    void set_time_source(TimeSource time_source);
+
+    /**
+     * @brief Reports channels with no frame for `config.channel_timeout` (I001 heartbeats keep a
+     *        channel alive) and books with no I081/I083 for `config.product_timeout` to the
+     *        liveness callback, and again when they resume. Call after `initialize()`; books that
+     *        already exist are timed from the call.
+     */
+    void monitor_liveness(const LivenessConfig& config);
+    /** @brief Receives liveness events, on the thread calling `process_message` or `poll_timers`. */
+    void set_liveness_callback(LivenessMonitor::EventCallback callback);
+    /** @brief When the last frame of the channel was processed; the epoch if none was. */
+    ChannelGapManager::Clock::time_point get_channel_last_message_time(uint32_t channel_id) const;
+    /** @brief True while the channel is reported stale. */
+    bool is_channel_stale(uint32_t channel_id) const;
+
+    /**
+     * @brief Takes the first-touch costs of the session before the open rather than on its first
+     *        frames: creates the books of the subscribed products, faults in (and optionally
+     *        locks) the book pool, reorder rings, state store and shared-memory segments, and runs
+     *        synthetic frames through validation, decoding and a scratch book.
+     *
+     * Call once the I010 cycle is complete (and after attaching any state store or publisher),
+     * on the thread that processes messages. Books created here are empty until their first
+     * I083/I081; the synthetic frames reach no book, callback or consumer.
+     */
+    WarmUpReport warm_up(const WarmUpConfig& config = WarmUpConfig{});
+
+    /**
+     * @brief Per-channel sequencing state and statistics, indexed by CHANNEL-ID.
+     *
+     * `Networking::NetworkManager` stamps receive times and packet counts here from its receive
+     * threads; counters are atomics and may be read from any thread.
+     */
+    const CoreUtils::ChannelStateTable& channel_states() const;
+    CoreUtils::ChannelStateTable& channel_states();
+
+    /**
+     * @brief Callback invoked after an order book changed (I081 applied or I083 snapshot applied).
+     *        Not invoked for stale books, whose content is not trustworthy until their next snapshot.
+     */
+    using OrderBookUpdateCallback = std::function<void(const OrderBookManagement::OrderBook& order_book)>;
+
+    /**
+     * @brief Registers the order book update callback. Pass nullptr to unregister.
+     *        The callback runs on the thread calling `process_message`.
+     */
+    void set_order_book_update_callback(OrderBookUpdateCallback callback);
+
+    /**
+     * @brief Callback invoked when an I010 introduces a product or changes its reference data.
+     *        Rebroadcasts of unchanged I010 messages do not trigger it.
+     */
+    using ProductInfoCallback = std::function<void(ProductHandle handle, const ProductInfo& info)>;
+
+    /**
+     * @brief Registers the product info callback. Pass nullptr to unregister.
+     *        The callback runs on the thread calling `process_message`.
+     */
+    void set_product_info_callback(ProductInfoCallback callback);
+
+    /**
+     * @brief Callback receiving the `NormalizedEvent`s decoded from each applied I081/I083, the
+     *        BOOK_STALE of a book that detected a PROD-MSG-SEQ gap and the BOOK_CLEARs of an I002,
+     *        one frame's events per call, in feed order.
+     */
+    using EventCallback = std::function<void(std::span<const CoreUtils::NormalizedEvent> events)>;
+
+    /**
+     * @brief Registers the event callback. Pass nullptr to unregister.
+     *        The callback runs on the thread calling `process_message`.
+     */
+    void set_event_callback(EventCallback callback);
+
+    /**
+     * @brief Publishes the same events to a shared-memory ring that `ShmEventReader`s in other
+     *        processes consume at their own pace (see `ShmEventPublisher`). Call after
+     *        `initialize()`. Closed when this instance is destroyed.
+     * @return False if the ring could not be created; the SDK then runs without it.
+     */
+    bool publish_events_to_shared_memory(const ShmEventRingConfig& config);
+
+    /**
+     * @brief Serves every book's top levels to local processes over a Unix domain socket (see
+     *        `UdsFanoutServer`; clients use `UdsFanoutClient`). Call after `initialize()`; books
+     *        that already exist are announced at once.
+     * @return False if the socket could not be served; the SDK then runs without it.
+     */
+    bool start_fanout_server(const UdsFanoutConfig& config);
+    void stop_fanout_server();
+    /** @brief Clients connected to the fan-out server; 0 when it is not running. */
+    size_t get_fanout_client_count() const;
+
+    /**
+     * @brief Journals the same events to an append-only file, together with the products and books
+     *        they refer to and a checkpoint of every book each `checkpoint_interval_us` of
+     *        INFORMATION-TIME (see `EventJournalWriter`). `replay_journal` feeds such a file back
+     *        without any frame parsing. Call after `initialize()`; closed when this instance is
+     *        destroyed.
+     * @return False if the file could not be created; the SDK then runs without it.
+     */
+    bool journal_events(const EventJournalConfig& config);
+    /** @brief Writes what is buffered and closes the journal. */
+    void close_event_journal();
+
+    /**
+     * @brief Rebuilds books from a journal instead of frames. Products and books are defined from
+     *        its records and its events applied in order, with the same listener calls as live
+     *        processing (order book updates, update streams, readers, the event callback and ring).
+     * @param from_exchange_time_us Start at the last checkpoint at or before this INFORMATION-TIME
+     *        instead of the first record; 0 replays the whole file.
+     * @return False if the file is not a journal.
+     */
+    bool replay_journal(const std::string& path, uint64_t from_exchange_time_us = 0);
+
+    /**
+     * @brief Builds 1 s and 1 min bars for every book (see `BarAggregator`): the mid of each
+     *        applied I081/I083 updates the book's open bar, and bars close on INFORMATION-TIME
+     *        (book updates and I001 heartbeats), so a journal replay yields the same bars. Call
+     *        after `initialize()`; books that already exist are covered.
+     */
+    void aggregate_bars(const BarConfig& config);
+    /** @brief Receives each closed bar, on the thread calling `process_message`. */
+    void set_bar_callback(BarAggregator::BarCallback callback);
+    /**
+     * @brief Copies the book's most recent closed bars, oldest first. Same thread as
+     *        `process_message`.
+     * @return Bars copied; 0 for an unknown book or when bars are not aggregated.
+     */
+    size_t get_bars(const std::string& product_id, BarInterval interval, std::span<Bar> out) const;
+    /** @brief The bar still being built for the book, if any. */
+    std::optional<Bar> get_open_bar(const std::string& product_id, BarInterval interval) const;
+
+    /**
+     * @brief Records every book change (applied I081/I083, a PROD-MSG-SEQ gap, an I002 reset) with
+     *        the book's top `config.depth` levels into the day's columnar tick store (see
+     *        `TickStoreWriter`), written on a background thread. Read it back with `TickStoreReader`.
+     *        Call after `initialize()`; books that already exist are covered.
+     * @return False if the store could not be opened; the SDK then runs without it.
+     */
+    bool record_tick_history(const TickStoreConfig& config);
+    /** @brief Writes what is queued and closes the tick store. */
+    void stop_tick_history();
+    /** @brief Book changes not recorded because the tick store writer fell behind. */
+    uint64_t get_tick_history_dropped_count() const;
+
+    /** @brief Events the slowest registered `ShmEventReader` has yet to read; 0 without a ring. */
+    uint64_t get_event_reader_lag() const;
+
+    /** @brief Handle carried as `NormalizedEvent::book`, or `INVALID_BOOK_HANDLE` for an unknown book. */
+    BookHandle get_book_handle(const std::string& product_id) const;
+
+    /**
+     * @brief Number of I010 messages skipped without parsing because their body was byte-identical
+     *        to the previous I010 for the same product.
+     */
+    uint64_t get_unchanged_i010_skipped_count() const;
+
+    /** @brief Number of I081/I083 frames currently held because their product's I010 has not arrived. */
+    size_t get_pending_frame_count() const;
+
+    /**
+     * @brief Aggregates the process-wide feed counters (`CoreUtils::Metric`), including those
+     *        kept by the networking layer, into a snapshot. Samples the process's page faults
+     *        (`Metric::PAGE_FAULTS`, counted from `initialize()`) first. Safe to call from any thread.
+     */
+    CoreUtils::MetricsSnapshot get_metrics() const;
+
+    /** @brief True if the SDK was built with TAIFEX_ENABLE_LATENCY_STATS (CMake option of the same name). */
+    static constexpr bool latency_stats_enabled() {
+#ifdef TAIFEX_ENABLE_LATENCY_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Percentiles of one `process_message` stage for frames of the given type.
+     *        All zero if no such frame was applied or latency stats are compiled out.
+     *        Safe to call from any thread.
+     */
+    CoreUtils::LatencySummary get_latency_summary(CoreUtils::MessageType type, CoreUtils::LatencyStage stage) const;
+
+    /** @return The stage latency in nanoseconds at `percentile` (0-100), or 0 with no samples. */
+    double get_latency_percentile_ns(CoreUtils::MessageType type, CoreUtils::LatencyStage stage, double percentile) const;
+
+    /** @brief Clears all latency histograms. */
+    void reset_latency_stats();
 
 private:
+    enum class SequenceStatus {
+        IN_SEQUENCE, // Apply now.
+        HELD,        // Parked in the reorder buffer until the gap before it is filled.
+        DUPLICATE    // Already applied (replay or duplicate); drop.
+    };
+
     // --- Private Helper Methods for Message Processing ---
+    void process_frame(const unsigned char* raw_message, size_t length);
+    void report_hot_path_allocations(const unsigned char* raw_message, size_t length, uint64_t allocations);
+    void presize(const CapacityConfig& capacity, const GapRecoveryConfig& gap_config);
+    bool is_subscribed(std::string_view prod_id) const;
+    std::pmr::memory_resource* book_memory();
+    bool validate_frame(const unsigned char* raw_message, size_t length, CoreUtils::CommonHeader& out_header);
+    void apply_frame(const unsigned char* raw_message, const CoreUtils::CommonHeader& header);
     void dispatch_message_body(const unsigned char* body_ptr,
                                uint16_t body_len,
                                CoreUtils::MessageType msg_type,
-                               const CoreUtils::CommonHeader& header,
-                               const std::string& product_id_from_header);
+                               const CoreUtils::CommonHeader& header);
 
     void handle_i010(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header);
-    void handle_i081(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header, const std::string& product_id);
-    void handle_i083(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header, const std::string& product_id);
+    void handle_i081(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header);
+    void handle_i083(const unsigned char* body_ptr, uint16_t body_len, const CoreUtils::CommonHeader& header);
     void handle_i001(const CoreUtils::CommonHeader& header);
     void handle_i002(const CoreUtils::CommonHeader& header);
+    void index_book_channel(OrderBookManagement::OrderBook& order_book, uint32_t channel_id);
+    struct BookIdentity;
+    void add_channel_book(OrderBookManagement::OrderBook& order_book, BookIdentity& identity, uint32_t channel_id);
 
     OrderBookManagement::OrderBook* get_or_create_order_book(const std::string& product_id);
-    bool is_sequence_valid(const CoreUtils::CommonHeader& header);
+    SequenceStatus classify_sequence(CoreUtils::ChannelState& state, uint32_t channel_id, uint64_t channel_seq,
+                                     const unsigned char* raw_message, size_t length,
+                                     ChannelGapManager::Clock::time_point now);
+    bool drain_reorder_buffer(CoreUtils::ChannelState& state, uint32_t channel_id,
+                              ChannelGapManager::Clock::time_point now);
+    void abandon_gap(CoreUtils::ChannelState& state, uint32_t channel_id, ChannelGapManager::Clock::time_point now);
+    void register_channel(uint32_t channel_id);
+    void on_channel_timer(LivenessMonitor::ChannelTimer timer, uint32_t channel_id,
+                          ChannelGapManager::Clock::time_point now);
+    ChannelGapManager::Clock::time_point clock_now() const {
+        return time_source_ ? time_source_() : ChannelGapManager::Clock::now();
+    }
+    void notify_order_book_update(const OrderBookManagement::OrderBook& order_book);
+    void publish_update(const OrderBookManagement::OrderBook& order_book);
+    void restore_from_state_store();
+    void write_to_state_store();
+    void write_to_shared_memory();
+    void persist_book(const OrderBookManagement::OrderBook& order_book);
+    void persist_channel(uint32_t channel_id, const CoreUtils::ChannelState& state);
+    void hold_pending_frame(const std::string& product_id, uint32_t channel_id, bool is_snapshot,
+                            const unsigned char* body_ptr, uint16_t body_len);
+    void replay_pending_frames(std::string_view prod_id_s);
+    void book_changed(const OrderBookManagement::OrderBook& order_book);
+    void add_book_snapshot(const OrderBookManagement::OrderBook& order_book);
+    void publish_reader_index(ChannelGapManager::Clock::time_point now);
+    void publish_reader_index_if_due(ChannelGapManager::Clock::time_point now);
+    void register_book(const OrderBookManagement::OrderBook& order_book, ProductHandle product);
+    bool events_enabled() const { return event_callback_ || event_publisher_.is_open() || event_journal_.is_open(); }
+    static CoreUtils::NormalizedEvent event_stamp(const CoreUtils::CommonHeader& header);
+    void stamp_book(CoreUtils::NormalizedEvent& stamp, const OrderBookManagement::OrderBook& order_book) const;
+    CoreUtils::NormalizedEvent& append_event(const OrderBookManagement::OrderBook& order_book,
+                                             const CoreUtils::CommonHeader& header, CoreUtils::EventType type,
+                                             uint32_t prod_msg_seq);
+    void flush_frame_events(const OrderBookManagement::OrderBook& order_book, size_t count, bool end_of_message = true);
+    void product_changed(ProductHandle handle);
+    void write_journal_checkpoint(uint64_t exchange_time_us);
+    void append_journal_image(const OrderBookManagement::OrderBook& order_book, uint64_t exchange_time_us);
+    void apply_journal_events(OrderBookManagement::OrderBook& order_book, std::span<const CoreUtils::NormalizedEvent> events);
+    void update_bars(const OrderBookManagement::OrderBook& order_book, uint64_t exchange_time_us);
+    void record_tick(const OrderBookManagement::OrderBook& order_book, uint64_t exchange_time_us, uint8_t flags = 0);
+    void flush_events(bool end_of_message = true);
+    uint64_t run_warm_up_frames(uint32_t rounds);
 
 
     // --- State Management Data Members ---
-    std::map<std::string, SpecificMessageParsers::MessageI010> product_info_cache_;
+    ProductRegistry products_;
+    std::vector<uint64_t> i010_body_hashes_;    // FNV-1a of the last raw I010 body, by ProductHandle.
+    uint64_t unchanged_i010_skipped_ = 0;
+    std::vector<std::string> subscriptions_;   // Sorted trimmed PROD-ID-S; empty = all.
+    AllocationCheck allocation_check_ = AllocationCheck::OFF;
+    // Price levels of every book come from book_pool_, backed by book_arena_ (declared before the
+    // books, which must be destroyed first). Null until initialize().
+    std::unique_ptr<std::byte[]> book_arena_buffer_;
+    size_t book_arena_bytes_ = 0;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> book_arena_;
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> book_pool_;
+    size_t book_depth_ = 0; // Levels per side a book keeps; 0 (before initialize()) keeps all.
     std::map<std::string, OrderBookManagement::OrderBook> order_books_;
-    std::map<uint32_t, uint64_t> channel_sequences_;
+    std::string event_prod_id_; // PROD-ID of the I081/I083 being applied; keeps its capacity.
+    CoreUtils::ChannelStateTable channel_states_; // Indexed by CHANNEL-ID.
+    ChannelGapManager gap_manager_;
+    LivenessMonitor liveness_;
+    TimeSource time_source_;
+    ChannelGapManager::Clock::time_point frame_time_{}; // Now, as of the frame being processed.
+    ProductCacheConfig product_cache_config_;
+    StateStore state_store_;
+    std::unordered_map<const OrderBookManagement::OrderBook*, BookSlot> book_slots_; // Only with a state store.
+    ShmBookPublisher shm_publisher_;
+    std::unordered_map<const OrderBookManagement::OrderBook*, ShmBookIndex> shm_books_; // Only when publishing.
+    PendingFrameBuffer pending_frames_; // Book frames that arrived before their I010.
+    // SdkReader publication; null until the first create_reader().
+    std::shared_ptr<ReaderPublication> reader_publication_;
+    std::unordered_map<const OrderBookManagement::OrderBook*, std::shared_ptr<BookSnapshotSlot>> book_snapshots_;
+    ReaderBookTable published_books_;
+    ReaderProductTable published_products_;
+    std::vector<ProductHandle> reader_changed_products_; // Since the last publication.
+    std::vector<ReaderBookTable::Entry> reader_added_books_; // Since the last publication.
+    bool reader_products_dirty_ = false;
+    std::chrono::milliseconds reader_publish_interval_{10};
+    ChannelGapManager::Clock::time_point last_reader_publish_{};
+    std::vector<std::shared_ptr<UpdateStream>> update_streams_;
+    // Identity of every book, assigned at creation.
+    struct BookIdentity {
+        BookHandle handle;
+        ProductHandle product;
+        uint32_t last_channel = CoreUtils::ChannelStateTable::CHANNEL_COUNT; // None yet.
+        std::vector<uint16_t> channels{}; // Every channel the book is indexed under; usually one.
+    };
+    std::unordered_map<const OrderBookManagement::OrderBook*, BookIdentity> book_identities_;
+    // Books by the CHANNEL-ID their I081/I083 arrive on, so an I002 clears only its channel's books.
+    std::vector<std::vector<OrderBookManagement::OrderBook*>> channel_books_;
+    // I081/I083 bodies decode straight into this; the book applies it and the same events go to
+    // every consumer. Frames never exceed it; an I002 over more books is flushed in chunks.
+    std::array<CoreUtils::NormalizedEvent, SpecificMessageParsers::MAX_BOOK_MESSAGE_EVENTS> event_batch_;
+    size_t event_count_ = 0;
+    EventCallback event_callback_;
+    ShmEventPublisher event_publisher_;
+    UdsFanoutServer fanout_server_;
+    EventJournalWriter event_journal_;
+    uint64_t journal_checkpoint_interval_us_ = 0;
+    uint64_t journal_last_checkpoint_us_ = 0;
+    uint32_t journal_book_checkpoint_events_ = 0;
+    std::vector<uint32_t> journal_book_events_; // Per BookHandle: events since the book's last image.
+    std::vector<OrderBookManagement::PriceQuantityLevel> journal_levels_;
+    std::vector<CoreUtils::NormalizedEvent> journal_image_;
+    BarAggregator bars_;
+    TickStoreWriter tick_store_;
+    OrderBookUpdateCallback order_book_update_callback_;
+    ProductInfoCallback product_info_callback_;
+#ifdef TAIFEX_ENABLE_LATENCY_STATS
+    CoreUtils::LatencyProbe latency_probe_;       // Stage stamps of the frame being processed.
+    CoreUtils::LatencyRecorder latency_recorder_;
+#endif
     // std::unique_ptr<CoreUtils::Logger> logger_;
     bool initialized_ = false;
 };
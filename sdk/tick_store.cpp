@@ -0,0 +1,441 @@
+#include "sdk/tick_store.h"
+
+#include "logger.h"
+
+#include <algorithm> // For std::min, std::fill
+#include <cerrno>
+#include <chrono>
+#include <cstring>   // For std::memcpy, std::strerror
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Taifex {
+
+namespace {
+
+constexpr size_t BASE_COLUMNS = 4;
+constexpr size_t BATCH_ROWS = 4096;
+constexpr auto IDLE_WAIT = std::chrono::milliseconds(1);
+
+struct ColumnSpec {
+    std::string name;
+    size_t width;
+};
+
+// Column files of a store with `depth` levels, in `TickStoreReader` order.
+std::vector<ColumnSpec> column_specs(size_t depth) {
+    std::vector<ColumnSpec> specs = {
+        {"exchange_time_us.u64", 8}, {"book.u32", 4}, {"prod_msg_seq.u32", 4}, {"flags.u8", 1}};
+    for (size_t level = 1; level <= depth; ++level) {
+        const std::string n = std::to_string(level);
+        specs.push_back({"bid_px_" + n + ".i64", 8});
+        specs.push_back({"bid_qty_" + n + ".u64", 8});
+        specs.push_back({"ask_px_" + n + ".i64", 8});
+        specs.push_back({"ask_qty_" + n + ".u64", 8});
+    }
+    return specs;
+}
+
+bool make_directory(const std::string& path) {
+    if (::mkdir(path.c_str(), 0755) == 0 || errno == EEXIST) {
+        return true;
+    }
+    LOG_ERROR << "TickStore: cannot create " << path << ": " << std::strerror(errno);
+    return false;
+}
+
+bool write_all(int fd, const void* data, size_t length) {
+    const char* pos = static_cast<const char*>(data);
+    while (length > 0) {
+        const ssize_t written = ::write(fd, pos, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        pos += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+std::string padded_prod_id(std::string_view prod_id) {
+    std::string key(prod_id.substr(0, sizeof(TickStoreBook::prod_id)));
+    key.resize(sizeof(TickStoreBook::prod_id), ' ');
+    return key;
+}
+
+template <typename T>
+void append_value(std::vector<char>& buffer, T value) {
+    const size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+} // namespace
+
+// --- TickStoreWriter ---
+
+TickStoreWriter::~TickStoreWriter() {
+    stop();
+}
+
+bool TickStoreWriter::start(const TickStoreConfig& config) {
+    stop();
+    if (config.depth == 0 || config.depth > MAX_DEPTH || config.queue_capacity == 0 ||
+        (config.queue_capacity & (config.queue_capacity - 1)) != 0 || config.trading_date == 0) {
+        LOG_ERROR << "TickStoreWriter: needs a trading date, a depth of 1 to " << MAX_DEPTH
+                  << " and a power-of-two queue capacity.";
+        return false;
+    }
+    config_ = config;
+    directory_ = config.root_dir + "/" + std::to_string(config.trading_date);
+    if (!make_directory(config.root_dir) || !make_directory(directory_) || !open_books() || !open_columns()) {
+        close_files();
+        return false;
+    }
+    rows_ = std::make_unique<Row[]>(config.queue_capacity);
+    row_mask_ = config.queue_capacity - 1;
+    row_head_.store(0, std::memory_order_relaxed);
+    row_tail_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    written_.store(0, std::memory_order_relaxed);
+    book_ids_.clear();
+    failed_ = false;
+    stopping_.store(false, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::make_unique<std::thread>(&TickStoreWriter::run, this);
+    LOG_INFO << "TickStoreWriter: recording " << static_cast<int>(config.depth) << " levels to " << directory_;
+    return true;
+}
+
+bool TickStoreWriter::open_books() {
+    const std::string path = directory_ + "/books.dat";
+    books_fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (books_fd_ < 0) {
+        LOG_ERROR << "TickStoreWriter: cannot open " << path << ": " << std::strerror(errno);
+        return false;
+    }
+    // Books already recorded today keep their index, so rows from before a restart stay valid.
+    ids_by_prod_id_.clear();
+    TickStoreBook book;
+    uint32_t index = 0;
+    while (::pread(books_fd_, &book, sizeof(book), static_cast<off_t>(index) * sizeof(book)) ==
+           static_cast<ssize_t>(sizeof(book))) {
+        ids_by_prod_id_.emplace(std::string(book.prod_id, sizeof(book.prod_id)), index++);
+    }
+    if (::ftruncate(books_fd_, static_cast<off_t>(index) * sizeof(book)) != 0 ||
+        ::lseek(books_fd_, 0, SEEK_END) < 0) {
+        LOG_ERROR << "TickStoreWriter: cannot trim " << path << ": " << std::strerror(errno);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(books_mutex_);
+    new_books_.clear();
+    return true;
+}
+
+bool TickStoreWriter::open_columns() {
+    columns_.clear();
+    uint64_t rows = UINT64_MAX;
+    for (const ColumnSpec& spec : column_specs(config_.depth)) {
+        const std::string path = directory_ + "/" + spec.name;
+        Column column;
+        column.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        column.width = spec.width;
+        if (column.fd < 0) {
+            LOG_ERROR << "TickStoreWriter: cannot open " << path << ": " << std::strerror(errno);
+            return false;
+        }
+        struct stat st;
+        if (fstat(column.fd, &st) != 0) {
+            ::close(column.fd);
+            return false;
+        }
+        rows = std::min<uint64_t>(rows, static_cast<uint64_t>(st.st_size) / spec.width);
+        column.buffer.reserve(BATCH_ROWS * spec.width);
+        columns_.push_back(std::move(column));
+    }
+    // A crash can leave columns a partial batch apart: cut them back to the rows all of them hold.
+    for (Column& column : columns_) {
+        if (::ftruncate(column.fd, static_cast<off_t>(rows * column.width)) != 0 ||
+            ::lseek(column.fd, 0, SEEK_END) < 0) {
+            LOG_ERROR << "TickStoreWriter: cannot trim a column in " << directory_ << ": " << std::strerror(errno);
+            return false;
+        }
+    }
+    // Levels past the configured depth, left by an earlier run with a larger one, would stop
+    // growing with the others and make readers take the day for a deeper store.
+    const std::vector<ColumnSpec> deepest = column_specs(MAX_DEPTH);
+    for (size_t i = columns_.size(); i < deepest.size(); ++i) {
+        const std::string path = directory_ + "/" + deepest[i].name;
+        if (::unlink(path.c_str()) == 0) {
+            LOG_WARNING << "TickStoreWriter: removed " << path << ", deeper than the " << static_cast<int>(config_.depth)
+                        << " levels now recorded.";
+        } else if (errno != ENOENT) {
+            LOG_ERROR << "TickStoreWriter: cannot remove " << path << ": " << std::strerror(errno);
+            return false;
+        }
+    }
+    batch_rows_ = BATCH_ROWS;
+    return true;
+}
+
+void TickStoreWriter::stop() {
+    if (!thread_) {
+        return;
+    }
+    stopping_.store(true, std::memory_order_release);
+    thread_->join();
+    thread_.reset();
+    running_.store(false, std::memory_order_release);
+    close_files();
+    LOG_INFO << "TickStoreWriter: " << written_.load() << " rows written to " << directory_ << ", "
+             << dropped_.load() << " dropped.";
+}
+
+void TickStoreWriter::close_files() {
+    for (Column& column : columns_) {
+        if (column.fd >= 0) {
+            ::close(column.fd);
+        }
+    }
+    columns_.clear();
+    if (books_fd_ >= 0) {
+        ::close(books_fd_);
+        books_fd_ = -1;
+    }
+}
+
+void TickStoreWriter::add_book(BookHandle book, std::string_view prod_id, uint8_t decimal_locator) {
+    if (!is_running()) {
+        return;
+    }
+    std::string key = padded_prod_id(prod_id);
+    auto result = ids_by_prod_id_.try_emplace(std::move(key), static_cast<uint32_t>(ids_by_prod_id_.size()));
+    if (result.second) {
+        TickStoreBook record = {};
+        std::memcpy(record.prod_id, result.first->first.data(), sizeof(record.prod_id));
+        record.decimal_locator = decimal_locator;
+        std::lock_guard<std::mutex> lock(books_mutex_);
+        new_books_.push_back(record);
+    }
+    if (book >= book_ids_.size()) {
+        book_ids_.resize(book + 1, TickStore::NO_BOOK);
+    }
+    book_ids_[book] = result.first->second;
+}
+
+void TickStoreWriter::record(BookHandle book, uint64_t exchange_time_us, const OrderBookManagement::OrderBook& order_book,
+                             uint8_t flags) {
+    if (book >= book_ids_.size() || book_ids_[book] == TickStore::NO_BOOK) {
+        return;
+    }
+    const uint64_t tail = row_tail_.load(std::memory_order_relaxed);
+    if (tail - row_head_.load(std::memory_order_acquire) > row_mask_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Row& row = rows_[tail & row_mask_];
+    row.exchange_time_us = exchange_time_us;
+    row.book = book_ids_[book];
+    row.prod_msg_seq = order_book.get_last_prod_msg_seq();
+    row.flags = static_cast<uint8_t>(flags | (order_book.is_stale() ? TickStore::FLAG_STALE : 0));
+    const std::span<OrderBookManagement::PriceQuantityLevel> bids(row.bids, config_.depth);
+    const std::span<OrderBookManagement::PriceQuantityLevel> asks(row.asks, config_.depth);
+    std::fill(bids.begin() + order_book.copy_top_bids(bids), bids.end(), OrderBookManagement::PriceQuantityLevel{0, 0});
+    std::fill(asks.begin() + order_book.copy_top_asks(asks), asks.end(), OrderBookManagement::PriceQuantityLevel{0, 0});
+    row_tail_.store(tail + 1, std::memory_order_release);
+}
+
+void TickStoreWriter::run() {
+    while (true) {
+        const bool stopping = stopping_.load(std::memory_order_acquire);
+        if (drain() == 0) {
+            if (stopping) {
+                break; // Nothing was queued after the stop request was seen.
+            }
+            std::this_thread::sleep_for(IDLE_WAIT);
+        }
+    }
+}
+
+size_t TickStoreWriter::drain() {
+    {
+        std::lock_guard<std::mutex> lock(books_mutex_);
+        books_batch_.swap(new_books_);
+    }
+    if (!books_batch_.empty()) {
+        // Written before any row that refers to them.
+        if (!failed_ && !write_all(books_fd_, books_batch_.data(), books_batch_.size() * sizeof(TickStoreBook))) {
+            LOG_ERROR << "TickStoreWriter: books.dat write failed: " << std::strerror(errno);
+            failed_ = true;
+        }
+        books_batch_.clear();
+    }
+
+    const uint64_t head = row_head_.load(std::memory_order_relaxed);
+    const uint64_t tail = row_tail_.load(std::memory_order_acquire);
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(tail - head, batch_rows_));
+    if (count == 0) {
+        return 0;
+    }
+    for (uint64_t i = head; i < head + count; ++i) {
+        const Row& row = rows_[i & row_mask_];
+        append_value(columns_[0].buffer, row.exchange_time_us);
+        append_value(columns_[1].buffer, row.book);
+        append_value(columns_[2].buffer, row.prod_msg_seq);
+        append_value(columns_[3].buffer, row.flags);
+        for (size_t level = 0; level < config_.depth; ++level) {
+            Column* columns = &columns_[BASE_COLUMNS + level * 4];
+            append_value(columns[0].buffer, row.bids[level].price);
+            append_value(columns[1].buffer, row.bids[level].quantity);
+            append_value(columns[2].buffer, row.asks[level].price);
+            append_value(columns[3].buffer, row.asks[level].quantity);
+        }
+    }
+    row_head_.store(head + count, std::memory_order_release);
+    if (write_columns()) {
+        written_.fetch_add(count, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+bool TickStoreWriter::write_columns() {
+    bool ok = !failed_;
+    for (Column& column : columns_) {
+        if (ok && !write_all(column.fd, column.buffer.data(), column.buffer.size())) {
+            LOG_ERROR << "TickStoreWriter: column write failed: " << std::strerror(errno) << "; recording stopped.";
+            failed_ = true;
+            ok = false;
+        }
+        column.buffer.clear();
+    }
+    return ok;
+}
+
+// --- TickStoreReader ---
+
+TickStoreReader::~TickStoreReader() {
+    close();
+}
+
+bool TickStoreReader::open(const std::string& day_dir) {
+    close();
+    // The depth is however many levels have all four column files.
+    size_t depth = 0;
+    struct stat st;
+    while (depth < TickStoreWriter::MAX_DEPTH &&
+           ::stat((day_dir + "/ask_qty_" + std::to_string(depth + 1) + ".u64").c_str(), &st) == 0) {
+        ++depth;
+    }
+    size_t rows = SIZE_MAX;
+    for (const ColumnSpec& spec : column_specs(depth)) {
+        const std::string path = day_dir + "/" + spec.name;
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            LOG_ERROR << "TickStoreReader: cannot open " << path << ": " << std::strerror(errno);
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            close();
+            return false;
+        }
+        Mapping mapping;
+        mapping.size = static_cast<size_t>(st.st_size);
+        if (mapping.size > 0) {
+            void* data = mmap(nullptr, mapping.size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED) {
+                LOG_ERROR << "TickStoreReader: mmap of " << path << " failed: " << std::strerror(errno);
+                ::close(fd);
+                close();
+                return false;
+            }
+            mapping.data = data;
+        }
+        ::close(fd);
+        rows = std::min(rows, mapping.size / spec.width);
+        columns_.push_back(mapping);
+    }
+
+    const int books_fd = ::open((day_dir + "/books.dat").c_str(), O_RDONLY | O_CLOEXEC);
+    if (books_fd < 0 || fstat(books_fd, &st) != 0) {
+        LOG_ERROR << "TickStoreReader: " << day_dir << " has no books.dat.";
+        if (books_fd >= 0) {
+            ::close(books_fd);
+        }
+        close();
+        return false;
+    }
+    books_.resize(static_cast<size_t>(st.st_size) / sizeof(TickStoreBook));
+    const ssize_t expected = static_cast<ssize_t>(books_.size() * sizeof(TickStoreBook));
+    const bool read_ok = ::pread(books_fd, books_.data(), static_cast<size_t>(expected), 0) == expected;
+    ::close(books_fd);
+    if (!read_ok) {
+        close();
+        return false;
+    }
+    row_count_ = rows;
+    depth_ = depth;
+    return true;
+}
+
+void TickStoreReader::close() {
+    for (const Mapping& mapping : columns_) {
+        if (mapping.data) {
+            munmap(const_cast<void*>(mapping.data), mapping.size);
+        }
+    }
+    columns_.clear();
+    books_.clear();
+    row_count_ = 0;
+    depth_ = 0;
+}
+
+uint32_t TickStoreReader::find_book(std::string_view prod_id) const {
+    const std::string key = padded_prod_id(prod_id);
+    for (uint32_t i = 0; i < books_.size(); ++i) {
+        if (std::memcmp(books_[i].prod_id, key.data(), sizeof(books_[i].prod_id)) == 0) {
+            return i;
+        }
+    }
+    return TickStore::NO_BOOK;
+}
+
+size_t TickStoreReader::select(uint32_t book, uint64_t from_us, uint64_t to_us, std::vector<uint32_t>& rows) const {
+    rows.clear();
+    if (row_count_ == 0) {
+        return 0;
+    }
+    constexpr size_t BLOCK = 1024;
+    uint8_t mask[BLOCK];
+    uint32_t block[BLOCK];
+    const uint64_t* times = exchange_time_us().data();
+    const uint32_t* books = this->books().data();
+    for (size_t start = 0; start < row_count_; start += BLOCK) {
+        const size_t n = std::min(BLOCK, row_count_ - start);
+        // Filter pass: independent iterations, so the comparisons vectorize.
+        size_t matched = 0;
+        for (size_t i = 0; i < n; ++i) {
+            mask[i] = static_cast<uint8_t>((books[start + i] == book) & (times[start + i] >= from_us) &
+                                           (times[start + i] < to_us));
+            matched += mask[i];
+        }
+        if (matched == 0) {
+            continue;
+        }
+        // Compaction pass, only for blocks with a match: write every index, advance on a match.
+        size_t out = 0;
+        for (size_t i = 0; i < n; ++i) {
+            block[out] = static_cast<uint32_t>(start + i);
+            out += mask[i];
+        }
+        rows.insert(rows.end(), block, block + matched);
+    }
+    return rows.size();
+}
+
+} // namespace Taifex
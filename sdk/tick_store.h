@@ -0,0 +1,212 @@
+#ifndef TICK_STORE_H
+#define TICK_STORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "order_book/order_book.h"
+#include "sdk/product_registry.h"
+
+namespace Taifex {
+
+/** @brief Settings for `TaifexSdk::record_tick_history`. */
+struct TickStoreConfig {
+    /** @brief Parent directory; each trading date gets its own subdirectory. Created if missing. */
+    std::string root_dir;
+    /** @brief Trading date of this session, YYYYMMDD: the subdirectory written. Reopening a day appends. */
+    uint32_t trading_date = 0;
+    /** @brief Levels per side recorded for every change (1 to `TickStoreWriter::MAX_DEPTH`). */
+    uint8_t depth = 5;
+    /** @brief Rows queued from the feed thread to the writer thread; a power of two. */
+    uint32_t queue_capacity = 16384;
+};
+
+/**
+ * @brief Columnar book history: one row per book change, one file per column, one directory per
+ *        trading date. Written by `TickStoreWriter`, read by `TickStoreReader`.
+ *
+ * Every column is a flat array of fixed-width little-endian values with no header, so a file can
+ * be mapped (or loaded by any tool) as an array; row i of every column is the same change. Columns:
+ * `exchange_time_us.u64` (INFORMATION-TIME, microseconds since midnight), `book.u32` (index into
+ * `books.dat`), `prod_msg_seq.u32`, `flags.u8` (`FLAG_*`), and per level n = 1..depth
+ * `bid_px_n.i64`, `bid_qty_n.u64`, `ask_px_n.i64`, `ask_qty_n.u64` (scaled prices; 0 for an empty
+ * level). `books.dat` holds one 32-byte `TickStoreBook` per book of the day.
+ */
+namespace TickStore {
+constexpr uint8_t FLAG_STALE = 0x01; ///< The book awaits a snapshot (PROD-MSG-SEQ gap).
+constexpr uint8_t FLAG_RESET = 0x02; ///< The book was cleared by an I002.
+constexpr uint32_t NO_BOOK = std::numeric_limits<uint32_t>::max();
+} // namespace TickStore
+
+/** @brief `books.dat` record: the book a `book.u32` value refers to. */
+struct TickStoreBook {
+    char    prod_id[20]; ///< Space padded, as in I081/I083.
+    uint8_t decimal_locator;
+    uint8_t reserved[11];
+};
+static_assert(sizeof(TickStoreBook) == 32, "books.dat records are 32 bytes.");
+
+/**
+ * @brief Appends book changes to a day's tick store on a background thread.
+ *
+ * The feed thread copies the book's top levels into a preallocated single-producer/single-consumer
+ * ring and never blocks or allocates; when the ring is full the row is dropped and counted. The
+ * writer thread drains the ring into per-column buffers and writes each column with one write(2)
+ * per batch. Columns can end a partial batch apart after a crash: readers use the shortest, and
+ * reopening the day trims the others to it before appending.
+ */
+class TickStoreWriter {
+public:
+    static constexpr size_t MAX_DEPTH = 10;
+
+    TickStoreWriter() = default;
+    ~TickStoreWriter();
+
+    TickStoreWriter(const TickStoreWriter&) = delete;
+    TickStoreWriter& operator=(const TickStoreWriter&) = delete;
+
+    /** @return False if the directory or a column file could not be opened. */
+    bool start(const TickStoreConfig& config);
+    /** @brief Writes every queued row, joins the writer thread and closes the files. */
+    void stop();
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+    /** @brief Directory being written. */
+    const std::string& directory() const { return directory_; }
+
+    /** @brief Declares a book before its first `record`. Feed thread. */
+    void add_book(BookHandle book, std::string_view prod_id, uint8_t decimal_locator);
+    /** @brief Queues the book's current top levels. Feed thread; never blocks. */
+    void record(BookHandle book, uint64_t exchange_time_us, const OrderBookManagement::OrderBook& order_book,
+                uint8_t flags = 0);
+
+    /** @brief Rows lost because the writer thread fell a full queue behind. */
+    uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+    /** @brief Rows written to the column files so far. */
+    uint64_t written_count() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+    struct Row {
+        uint64_t exchange_time_us;
+        uint32_t book;
+        uint32_t prod_msg_seq;
+        uint8_t flags;
+        OrderBookManagement::PriceQuantityLevel bids[MAX_DEPTH];
+        OrderBookManagement::PriceQuantityLevel asks[MAX_DEPTH];
+    };
+
+    struct Column {
+        int fd = -1;
+        size_t width = 0;
+        std::vector<char> buffer;
+    };
+
+    bool open_columns();
+    bool open_books();
+    void run();
+    size_t drain();
+    bool write_columns();
+    void close_files();
+
+    TickStoreConfig config_;
+    std::string directory_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};
+    std::unique_ptr<std::thread> thread_;
+
+    // Feed thread -> writer thread.
+    std::unique_ptr<Row[]> rows_;
+    uint64_t row_mask_ = 0;
+    alignas(64) std::atomic<uint64_t> row_head_{0}; // Writer thread.
+    alignas(64) std::atomic<uint64_t> row_tail_{0}; // Feed thread.
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> written_{0};
+
+    // Feed thread: BookHandle -> index in books.dat (ids survive a restart on the same day).
+    std::vector<uint32_t> book_ids_;
+    std::unordered_map<std::string, uint32_t> ids_by_prod_id_;
+    std::mutex books_mutex_;                 // Guards new_books_ between the two threads.
+    std::vector<TickStoreBook> new_books_;   // Declared, not yet in books.dat.
+    std::vector<TickStoreBook> books_batch_; // Writer thread.
+    int books_fd_ = -1;
+
+    // Writer thread: exchange_time_us, book, prod_msg_seq, flags, then 4 columns per level.
+    std::vector<Column> columns_;
+    size_t batch_rows_ = 0;
+    bool failed_ = false; // A write failed; logged once.
+};
+
+/**
+ * @brief Read-only, memory-mapped view of one day of a tick store. Columns are exposed as spans
+ *        over the mapped files, so scans run over contiguous arrays.
+ */
+class TickStoreReader {
+public:
+    TickStoreReader() = default;
+    ~TickStoreReader();
+
+    TickStoreReader(const TickStoreReader&) = delete;
+    TickStoreReader& operator=(const TickStoreReader&) = delete;
+
+    /** @param day_dir A day's directory, e.g. `TickStoreWriter::directory()`. */
+    bool open(const std::string& day_dir);
+    void close();
+
+    /** @brief Complete rows: the length of the shortest column. */
+    size_t row_count() const { return row_count_; }
+    /** @brief Levels per side recorded. */
+    size_t depth() const { return depth_; }
+
+    size_t book_count() const { return books_.size(); }
+    /** @return Index of the book in `books.dat`, or `TickStore::NO_BOOK`. Trimmed or padded PROD-ID. */
+    uint32_t find_book(std::string_view prod_id) const;
+    const TickStoreBook& book(uint32_t index) const { return books_[index]; }
+
+    std::span<const uint64_t> exchange_time_us() const { return column<uint64_t>(0); }
+    std::span<const uint32_t> books() const { return column<uint32_t>(1); }
+    std::span<const uint32_t> prod_msg_seqs() const { return column<uint32_t>(2); }
+    std::span<const uint8_t> flags() const { return column<uint8_t>(3); }
+    /** @param level 1 to `depth()`. */
+    std::span<const int64_t> bid_prices(size_t level) const { return column<int64_t>(level_column(level, 0)); }
+    std::span<const uint64_t> bid_quantities(size_t level) const { return column<uint64_t>(level_column(level, 1)); }
+    std::span<const int64_t> ask_prices(size_t level) const { return column<int64_t>(level_column(level, 2)); }
+    std::span<const uint64_t> ask_quantities(size_t level) const { return column<uint64_t>(level_column(level, 3)); }
+
+    /**
+     * @brief Rows of `book` with `from_us` <= exchange_time_us < `to_us`, in row order.
+     * @details Walks the book and time columns in blocks: a branch-free pass computes a match mask,
+     *          which vectorizes, and a second pass compacts the matching indexes of blocks that have
+     *          any. Use the returned indexes to gather any other column.
+     * @return Rows appended to `rows` (which is cleared first).
+     */
+    size_t select(uint32_t book, uint64_t from_us, uint64_t to_us, std::vector<uint32_t>& rows) const;
+
+private:
+    struct Mapping {
+        const void* data = nullptr;
+        size_t size = 0;
+    };
+
+    static size_t level_column(size_t level, size_t field) { return 4 + (level - 1) * 4 + field; }
+    template <typename T>
+    std::span<const T> column(size_t index) const {
+        return {static_cast<const T*>(columns_[index].data), row_count_};
+    }
+
+    std::vector<Mapping> columns_;
+    std::vector<TickStoreBook> books_;
+    size_t row_count_ = 0;
+    size_t depth_ = 0;
+};
+
+} // namespace Taifex
+#endif // TICK_STORE_H
@@ -0,0 +1,145 @@
+#include "sdk/timer_wheel.h"
+
+#include <algorithm> // For std::max, std::min
+#include <bit>       // For std::countr_zero
+
+namespace Taifex {
+
+void TimerWheel::reset(uint64_t now_tick) {
+    clear();
+    now_ = now_tick;
+}
+
+void TimerWheel::clear() {
+    for (WheelTimer*& head : slots_) {
+        while (head) {
+            unlink(*head);
+        }
+    }
+    while (expired_) {
+        unlink(*expired_);
+    }
+    armed_ = 0;
+}
+
+void TimerWheel::schedule(WheelTimer& timer, uint64_t deadline_tick) {
+    if (timer.armed()) {
+        unlink(timer);
+    } else {
+        ++armed_;
+    }
+    timer.deadline = std::max(deadline_tick, now_ + 1);
+    link(timer);
+}
+
+void TimerWheel::cancel(WheelTimer& timer) {
+    if (timer.armed()) {
+        unlink(timer);
+        --armed_;
+    }
+}
+
+void TimerWheel::link(WheelTimer& timer) {
+    // A timer goes to the lowest level whose window (the span of one slot of the level above)
+    // holds both `now_` and its deadline. The top level wraps around: it reaches 255 of its slots
+    // ahead, and deadlines past that wait in the furthest one.
+    constexpr unsigned TOP_SHIFT = SLOT_BITS * (LEVELS - 1);
+    const uint64_t limit = ((now_ >> TOP_SHIFT) + SLOT_MASK) << TOP_SHIFT;
+    const uint64_t deadline = std::min(std::max(timer.deadline, now_), limit);
+    unsigned level = 0;
+    while (level + 1 < LEVELS && ((deadline ^ now_) >> (SLOT_BITS * (level + 1))) != 0) {
+        ++level;
+    }
+    const size_t slot = (deadline >> (SLOT_BITS * level)) & SLOT_MASK;
+    timer.slot_ = static_cast<uint16_t>(level * SLOTS + slot);
+    WheelTimer*& head = slots_[timer.slot_];
+    timer.next_ = head;
+    if (head) {
+        head->pprev_ = &timer.next_;
+    }
+    head = &timer;
+    timer.pprev_ = &head;
+    occupied_[timer.slot_ / 64] |= uint64_t{1} << (timer.slot_ % 64);
+}
+
+void TimerWheel::unlink(WheelTimer& timer) {
+    *timer.pprev_ = timer.next_;
+    if (timer.next_) {
+        timer.next_->pprev_ = timer.pprev_;
+    }
+    if (timer.slot_ != EXPIRED && !slots_[timer.slot_]) {
+        occupied_[timer.slot_ / 64] &= ~(uint64_t{1} << (timer.slot_ % 64));
+    }
+    timer.next_ = nullptr;
+    timer.pprev_ = nullptr;
+}
+
+size_t TimerWheel::next_occupied(unsigned level, size_t from) const {
+    for (size_t slot = from; slot < SLOTS; slot = (slot | 63) + 1) {
+        const size_t bit = level * SLOTS + slot;
+        const uint64_t bits = occupied_[bit / 64] >> (bit % 64);
+        if (bits != 0) {
+            return slot + static_cast<unsigned>(std::countr_zero(bits));
+        }
+    }
+    return SLOTS;
+}
+
+uint64_t TimerWheel::next_tick(uint64_t limit) const {
+    if (armed_ == 0) {
+        return limit;
+    }
+    // Timers of a level share every higher bit with `now_`, so each level's next event is its
+    // next occupied slot in the current window: a level-0 slot fires, a higher one cascades.
+    uint64_t next = limit;
+    // The top level's slots behind its current one belong to its next window.
+    for (unsigned level = 0; level < LEVELS; ++level) {
+        const unsigned shift = SLOT_BITS * level;
+        const size_t current = (now_ >> shift) & SLOT_MASK;
+        const uint64_t window = now_ & ~((uint64_t{1} << (shift + SLOT_BITS)) - 1);
+        size_t slot = next_occupied(level, current + 1);
+        if (slot < SLOTS) {
+            next = std::min(next, window | (uint64_t{slot} << shift));
+        } else if (level + 1 == LEVELS && (slot = next_occupied(level, 0)) < current) {
+            next = std::min(next, window + (uint64_t{1} << (shift + SLOT_BITS)) + (uint64_t{slot} << shift));
+        }
+    }
+    return next;
+}
+
+void TimerWheel::cascade() {
+    // Time has entered a new level-1 slot, and a new slot of every level whose lower bits are all
+    // zero too. Higher levels go first: their timers may land in the lower slots being emptied.
+    unsigned top = 1;
+    while (top + 1 < LEVELS && (now_ & ((uint64_t{1} << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+        ++top;
+    }
+    for (unsigned level = top; level >= 1; --level) {
+        const size_t index = level * SLOTS + ((now_ >> (SLOT_BITS * level)) & SLOT_MASK);
+        WheelTimer* timer = slots_[index];
+        slots_[index] = nullptr;
+        occupied_[index / 64] &= ~(uint64_t{1} << (index % 64));
+        while (timer) {
+            WheelTimer* next = timer->next_;
+            link(*timer);
+            timer = next;
+        }
+    }
+}
+
+void TimerWheel::collect() {
+    const size_t slot = now_ & SLOT_MASK;
+    WheelTimer* head = slots_[slot];
+    if (!head) {
+        return;
+    }
+    slots_[slot] = nullptr;
+    occupied_[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+    expired_ = head;
+    head->pprev_ = &expired_;
+    for (WheelTimer* timer = head; timer; timer = timer->next_) {
+        timer->slot_ = EXPIRED;
+    }
+}
+
+} // namespace Taifex
@@ -0,0 +1,126 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace Taifex {
+
+/**
+ * @brief A timer owned by its user and linked into a `TimerWheel` while armed. The wheel never
+ *        allocates: the timer itself is the list node, so it must not move while armed.
+ */
+struct WheelTimer {
+    uint64_t deadline = 0; ///< Tick the timer fires at (set by `TimerWheel::schedule`).
+    uint32_t kind = 0;     ///< Free for the owner, e.g. what the timer is for.
+    uint32_t key = 0;      ///< Free for the owner, e.g. a CHANNEL-ID or book handle.
+
+    bool armed() const { return pprev_ != nullptr; }
+
+private:
+    friend class TimerWheel;
+    WheelTimer* next_ = nullptr;
+    WheelTimer** pprev_ = nullptr; // The pointer that points at this timer; null while disarmed.
+    uint16_t slot_ = 0;            // level * SLOTS + slot, or EXPIRED.
+};
+
+/**
+ * @brief Hierarchical timer wheel: four levels of 256 slots over an integer tick count.
+ *
+ * Level 0 holds timers due within the current 256 ticks, one slot per tick; each higher level
+ * covers 256 times the span of the one below. `schedule` and `cancel` are O(1) list operations.
+ * `advance` moves the wheel's time forward: a higher-level slot is redistributed to the levels
+ * below when time enters it, and a level-0 slot fires when time reaches its tick. Time jumps
+ * straight to the next occupied slot of any level (found in per-level occupancy bitmaps) rather
+ * than walking tick by tick, so a replay can move hours ahead at once. Deadlines beyond the top
+ * level's reach (about 2^32 ticks) are parked in its furthest slot and re-placed on reaching it.
+ *
+ * Time is whatever the owner counts in (e.g. milliseconds of a real or virtual clock) and never
+ * goes backwards. Single-threaded.
+ */
+class TimerWheel {
+public:
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+
+    TimerWheel() = default;
+    ~TimerWheel() { clear(); }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /** @brief Disarms every timer and sets the current tick. */
+    void reset(uint64_t now_tick);
+    /** @brief Disarms every timer. */
+    void clear();
+
+    /** @brief Current tick: every timer due at or before it has fired. */
+    uint64_t now() const { return now_; }
+    /** @brief Timers armed. */
+    size_t armed_count() const { return armed_; }
+
+    /**
+     * @brief Arms (or re-arms) `timer` to fire at `deadline_tick`. A deadline not after `now()`
+     *        fires on the next tick.
+     */
+    void schedule(WheelTimer& timer, uint64_t deadline_tick);
+    /** @brief Disarms `timer`; a no-op if it is not armed. */
+    void cancel(WheelTimer& timer);
+
+    /**
+     * @brief Moves time forward to `now_tick` and calls `fire(WheelTimer&)` for every timer that
+     *        became due, in deadline order. `fire` may schedule or cancel any timer, including the
+     *        one firing. Ticks at or before `now()` are ignored.
+     * @return Timers fired.
+     */
+    template <typename Fire>
+    size_t advance(uint64_t now_tick, Fire&& fire) {
+        size_t fired = 0;
+        while (now_ < now_tick) {
+            now_ = next_tick(now_tick);
+            if ((now_ & SLOT_MASK) == 0) {
+                cascade();
+            }
+            collect();
+            while (WheelTimer* timer = expired_) {
+                unlink(*timer);
+                if (timer->deadline > now_) {
+                    link(*timer); // Parked beyond the wheel's reach; not due yet.
+                    continue;
+                }
+                --armed_;
+                fire(*timer);
+                ++fired;
+            }
+        }
+        return fired;
+    }
+
+private:
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+    static constexpr uint16_t EXPIRED = LEVELS * SLOTS;
+
+    // The next tick, up to `limit`, at which a level-0 slot fires or a higher slot cascades.
+    uint64_t next_tick(uint64_t limit) const;
+    // First occupied slot of `level` at or after `from`, or SLOTS.
+    size_t next_occupied(unsigned level, size_t from) const;
+    // Redistributes the higher-level slots that time has just entered.
+    void cascade();
+    // Moves the level-0 slot of `now_` to the expired list.
+    void collect();
+    // Inserts an unlinked timer at the slot for its deadline; does not count it.
+    void link(WheelTimer& timer);
+    // Removes a linked timer from its list; does not count it.
+    void unlink(WheelTimer& timer);
+
+    std::array<WheelTimer*, LEVELS * SLOTS> slots_{};
+    std::array<uint64_t, LEVELS * SLOTS / 64> occupied_{}; // Slots with timers, by level * SLOTS + slot.
+    WheelTimer* expired_ = nullptr;                // Due at `now_`, being fired.
+    uint64_t now_ = 0;
+    size_t armed_ = 0;
+};
+
+} // namespace Taifex
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,105 @@
+#include "sdk/uds_fanout_client.h"
+
+#include <cerrno>
+#include <cstring> // For std::memcpy
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Taifex {
+
+UdsFanoutClient::UdsFanoutClient(BookCallback callback)
+    : callback_(std::move(callback)),
+      decoder_(
+          [this](uint8_t, uint8_t depth) { depth_ = depth; },
+          [this](const FanoutBookDefinition& definition) {
+              if (definition.book >= definitions_.size()) {
+                  definitions_.resize(definition.book + 1);
+              }
+              definitions_[definition.book].prod_id.assign(definition.prod_id);
+              definitions_[definition.book].decimal_locator = definition.decimal_locator;
+          },
+          [this](const FanoutBookUpdate& update) {
+              if (callback_) {
+                  callback_(update);
+              }
+          }),
+      buffer_(64 * 1024) {}
+
+UdsFanoutClient::~UdsFanoutClient() {
+    disconnect();
+}
+
+bool UdsFanoutClient::connect(const std::string& path) {
+    disconnect();
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        return false;
+    }
+    if (::connect(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        disconnect();
+        return false;
+    }
+    return true;
+}
+
+void UdsFanoutClient::disconnect() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    decoder_.reset();
+    definitions_.clear();
+    depth_ = 0;
+}
+
+bool UdsFanoutClient::receive(int timeout_ms) {
+    if (fd_ < 0) {
+        return false;
+    }
+    pollfd pfd = {fd_, POLLIN, 0};
+    const int ready = poll(&pfd, 1, timeout_ms);
+    if (ready < 0) {
+        return errno == EINTR;
+    }
+    if (ready == 0) {
+        return true;
+    }
+    // Drain what is buffered without blocking again.
+    while (true) {
+        const ssize_t received = recv(fd_, buffer_.data(), buffer_.size(), MSG_DONTWAIT);
+        if (received > 0) {
+            if (!decoder_.feed(buffer_.data(), static_cast<size_t>(received))) {
+                disconnect();
+                return false;
+            }
+            if (static_cast<size_t>(received) < buffer_.size()) {
+                return true; // Drained.
+            }
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return true;
+        }
+        disconnect(); // Closed by the server, or failed.
+        return false;
+    }
+}
+
+std::string_view UdsFanoutClient::prod_id(uint32_t book) const {
+    return book < definitions_.size() ? std::string_view(definitions_[book].prod_id) : std::string_view();
+}
+
+uint8_t UdsFanoutClient::decimal_locator(uint32_t book) const {
+    return book < definitions_.size() ? definitions_[book].decimal_locator : 0;
+}
+
+} // namespace Taifex
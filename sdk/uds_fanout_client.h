@@ -0,0 +1,68 @@
+#ifndef UDS_FANOUT_CLIENT_H
+#define UDS_FANOUT_CLIENT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sdk/fanout_protocol.h"
+
+namespace Taifex {
+
+/**
+ * @brief Consumer side of `UdsFanoutServer`: connects to its socket and decodes the stream into
+ *        book images. Part of the standalone `taifex_fanout_client` library.
+ *
+ * On connect the server sends every known book and its current image, then each change. Frames
+ * flagged `FLAG_CONFLATED` follow a period in which this client read too slowly and intermediate
+ * images were skipped. Single-threaded: call `receive` from one thread.
+ */
+class UdsFanoutClient {
+public:
+    using BookCallback = std::function<void(const FanoutBookUpdate& update)>;
+
+    explicit UdsFanoutClient(BookCallback callback);
+    ~UdsFanoutClient();
+
+    UdsFanoutClient(const UdsFanoutClient&) = delete;
+    UdsFanoutClient& operator=(const UdsFanoutClient&) = delete;
+
+    bool connect(const std::string& path);
+    void disconnect();
+    bool is_connected() const { return fd_ >= 0; }
+
+    /**
+     * @brief Waits up to `timeout_ms` (0: do not wait, -1: indefinitely) for data and delivers every
+     *        complete frame received.
+     * @return False once the server closed the connection or sent a malformed frame.
+     */
+    bool receive(int timeout_ms);
+
+    /** @brief PROD-ID of a book handle, without trailing spaces; empty if not defined yet. */
+    std::string_view prod_id(uint32_t book) const;
+    /** @brief DECIMAL-LOCATOR of a book's prices; 0 if not defined yet. */
+    uint8_t decimal_locator(uint32_t book) const;
+    /** @brief Books defined by the server so far. */
+    size_t book_count() const { return definitions_.size(); }
+    /** @brief Levels per side the server sends; 0 before its HELLO. */
+    uint8_t depth() const { return depth_; }
+
+private:
+    struct Definition {
+        std::string prod_id;
+        uint8_t decimal_locator = 0;
+    };
+
+    BookCallback callback_;
+    FanoutDecoder decoder_;
+    std::vector<Definition> definitions_; // By book handle.
+    std::vector<uint8_t> buffer_;
+    int fd_ = -1;
+    uint8_t depth_ = 0;
+};
+
+} // namespace Taifex
+#endif // UDS_FANOUT_CLIENT_H
@@ -0,0 +1,466 @@
+#include "sdk/uds_fanout_server.h"
+
+#include "logger.h"
+#include "metrics.h"
+
+#include <algorithm> // For std::min, std::max, std::fill_n
+#include <bit>
+#include <cerrno>
+#include <cstring>   // For std::memcpy, strerror
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Taifex {
+
+UdsFanoutServer::~UdsFanoutServer() {
+    stop();
+}
+
+bool UdsFanoutServer::start(const UdsFanoutConfig& config) {
+    if (is_running()) {
+        LOG_WARNING << "UdsFanoutServer: already serving " << config_.path << ".";
+        return false;
+    }
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (config.path.empty() || config.path.size() >= sizeof(address.sun_path)) {
+        LOG_ERROR << "UdsFanoutServer: invalid socket path '" << config.path << "'.";
+        return false;
+    }
+    std::memcpy(address.sun_path, config.path.c_str(), config.path.size() + 1);
+
+    // A socket file left by a previous run would make bind fail; anything else is not ours to remove.
+    struct stat existing;
+    if (lstat(config.path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+        unlink(config.path.c_str());
+    }
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0 || bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, 64) != 0) {
+        LOG_ERROR << "UdsFanoutServer: cannot listen on " << config.path << ": " << strerror(errno);
+        if (listen_fd_ >= 0) {
+            close(listen_fd_);
+            listen_fd_ = -1;
+        }
+        return false;
+    }
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        LOG_ERROR << "UdsFanoutServer: eventfd failed: " << strerror(errno);
+        close(listen_fd_);
+        listen_fd_ = -1;
+        unlink(config.path.c_str());
+        return false;
+    }
+
+    config_ = config;
+    config_.depth = std::min<uint8_t>(config_.depth, FanoutBookUpdate::MAX_LEVELS);
+    books_ = std::make_unique<BookEntry[]>(config_.book_capacity);
+    const uint64_t change_capacity = std::bit_ceil(std::max<uint64_t>(config_.change_queue_capacity, 2));
+    changes_ = std::make_unique<std::atomic<BookHandle>[]>(change_capacity);
+    change_mask_ = change_capacity - 1;
+    change_head_.store(0, std::memory_order_relaxed);
+    change_tail_.store(0, std::memory_order_relaxed);
+    change_overflow_.store(false, std::memory_order_relaxed);
+    book_count_.store(0, std::memory_order_relaxed);
+    announced_books_ = 0;
+    cycle_ = 0;
+    cycle_definitions_.reserve(64 * 1024);
+    cycle_books_.reserve(64 * 1024);
+    cycle_handles_.reserve(4096);
+
+    running_.store(true, std::memory_order_release);
+    try {
+        thread_ = std::make_unique<std::thread>(&UdsFanoutServer::run, this);
+    } catch (const std::system_error& e) {
+        LOG_ERROR << "UdsFanoutServer: cannot start server thread: " << e.what();
+        running_.store(false, std::memory_order_release);
+        stop();
+        return false;
+    }
+    LOG_INFO << "UdsFanoutServer: serving " << config_.path << " (depth " << static_cast<int>(config_.depth)
+             << ", up to " << config_.max_clients << " clients).";
+    return true;
+}
+
+void UdsFanoutServer::stop() {
+    running_.store(false, std::memory_order_release);
+    if (thread_) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(wake_fd_, &one, sizeof(one));
+        if (thread_->joinable()) {
+            thread_->join();
+        }
+        thread_.reset();
+    }
+    for (auto& client : clients_) {
+        disconnect(*client);
+    }
+    clients_.clear();
+    client_count_.store(0, std::memory_order_relaxed);
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+        unlink(config_.path.c_str());
+        LOG_INFO << "UdsFanoutServer: stopped serving " << config_.path << ".";
+    }
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    books_.reset();
+    changes_.reset();
+    book_count_.store(0, std::memory_order_relaxed);
+}
+
+void UdsFanoutServer::add_book(BookHandle book, std::string_view prod_id, uint8_t decimal_locator) {
+    if (!books_ || book >= config_.book_capacity) {
+        if (books_) {
+            LOG_WARNING << "UdsFanoutServer: book capacity " << config_.book_capacity << " reached; "
+                        << prod_id << " is not fanned out.";
+        }
+        return;
+    }
+    BookEntry& entry = books_[book];
+    const size_t length = std::min(prod_id.size(), sizeof(entry.prod_id));
+    std::memcpy(entry.prod_id, prod_id.data(), length);
+    std::fill_n(entry.prod_id + length, sizeof(entry.prod_id) - length, ' ');
+    entry.decimal_locator = decimal_locator;
+    // Publishes the entry to the server thread; handles are added in increasing order.
+    if (book >= book_count_.load(std::memory_order_relaxed)) {
+        book_count_.store(book + 1, std::memory_order_release);
+    }
+    wake();
+}
+
+void UdsFanoutServer::publish(BookHandle book, const OrderBookManagement::OrderBook& order_book) {
+    if (book >= book_count_.load(std::memory_order_relaxed)) {
+        return; // Not announced (beyond capacity, or the server is stopped).
+    }
+    books_[book].snapshot.publish(order_book);
+    const uint64_t tail = change_tail_.load(std::memory_order_relaxed);
+    if (tail - change_head_.load(std::memory_order_acquire) > change_mask_) {
+        // The server thread is behind: it rescans every book's version instead.
+        change_overflow_.store(true, std::memory_order_release);
+    } else {
+        changes_[tail & change_mask_].store(book, std::memory_order_relaxed);
+        change_tail_.store(tail + 1, std::memory_order_release);
+    }
+    wake();
+}
+
+void UdsFanoutServer::wake() {
+    // Pairs with the fence in wait_for_work: either the server thread sees the change before it
+    // sleeps, or this sees it parked and writes the eventfd.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed) && parked_.exchange(false, std::memory_order_relaxed)) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+void UdsFanoutServer::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        ++cycle_;
+        cycle_definitions_.clear();
+        cycle_books_.clear();
+        cycle_handles_.clear();
+        accept_clients();
+
+        const uint32_t book_count = book_count_.load(std::memory_order_acquire);
+        for (; announced_books_ < book_count; ++announced_books_) {
+            const BookEntry& entry = books_[announced_books_];
+            append_fanout_definition(cycle_definitions_, announced_books_, entry.decimal_locator,
+                                     std::string_view(entry.prod_id, sizeof(entry.prod_id)));
+        }
+        drain_changes();
+
+        for (auto& client : clients_) {
+            flush(*client);
+        }
+        wait_for_work();
+        std::erase_if(clients_, [](const std::unique_ptr<Client>& client) { return client->fd < 0; });
+        client_count_.store(clients_.size(), std::memory_order_relaxed);
+    }
+}
+
+void UdsFanoutServer::accept_clients() {
+    while (true) {
+        const int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                LOG_WARNING << "UdsFanoutServer: accept failed: " << strerror(errno);
+            }
+            return;
+        }
+        if (clients_.size() >= config_.max_clients) {
+            LOG_WARNING << "UdsFanoutServer: " << config_.max_clients << " clients connected; connection refused.";
+            close(fd);
+            continue;
+        }
+        if (config_.socket_buffer_bytes > 0) {
+            setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &config_.socket_buffer_bytes, sizeof(config_.socket_buffer_bytes));
+        }
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+        // Initial image: every book announced so far and its latest state. Books announced in this
+        // cycle follow with the other clients' frames.
+        append_fanout_hello(client->backlog, config_.depth);
+        for (BookHandle book = 0; book < announced_books_; ++book) {
+            const BookEntry& entry = books_[book];
+            append_fanout_definition(client->backlog, book, entry.decimal_locator,
+                                     std::string_view(entry.prod_id, sizeof(entry.prod_id)));
+        }
+        for (BookHandle book = 0; book < announced_books_; ++book) {
+            encode_book(client->backlog, book, 0);
+        }
+        clients_.push_back(std::move(client));
+        client_count_.store(clients_.size(), std::memory_order_relaxed);
+        LOG_INFO << "UdsFanoutServer: client connected (" << clients_.size() << " total).";
+    }
+}
+
+void UdsFanoutServer::drain_changes() {
+    auto add = [this](BookHandle book) {
+        BookEntry& entry = books_[book];
+        if (entry.cycle == cycle_) {
+            return; // Already encoded with its latest state this cycle.
+        }
+        entry.cycle = cycle_;
+        entry.sent_version = entry.snapshot.version();
+        encode_book(cycle_books_, book, 0);
+        cycle_handles_.push_back(book);
+    };
+
+    const uint64_t head = change_head_.load(std::memory_order_relaxed);
+    const uint64_t tail = change_tail_.load(std::memory_order_acquire);
+    const bool rescan = change_overflow_.exchange(false, std::memory_order_acq_rel);
+    for (uint64_t i = head; i < tail; ++i) {
+        add(changes_[i & change_mask_].load(std::memory_order_relaxed));
+    }
+    change_head_.store(tail, std::memory_order_release);
+    if (rescan) {
+        for (BookHandle book = 0; book < announced_books_; ++book) {
+            if (books_[book].snapshot.version() != books_[book].sent_version) {
+                add(book);
+            }
+        }
+    }
+}
+
+void UdsFanoutServer::encode_book(std::vector<uint8_t>& out, BookHandle book, uint8_t flags) {
+    BookSnapshot snapshot;
+    books_[book].snapshot.read(snapshot);
+    if (snapshot.version == 0) {
+        return; // Never published.
+    }
+    FanoutBookUpdate update;
+    update.book = book;
+    update.prod_msg_seq = snapshot.last_prod_msg_seq;
+    update.flags = flags;
+    if (snapshot.stale) {
+        update.flags |= FanoutBookUpdate::FLAG_STALE;
+    }
+    update.bid_count = std::min(snapshot.bid_count, config_.depth);
+    update.ask_count = std::min(snapshot.ask_count, config_.depth);
+    for (uint8_t i = 0; i < update.bid_count; ++i) {
+        update.bids[i] = {snapshot.bids[i].price, snapshot.bids[i].quantity};
+    }
+    for (uint8_t i = 0; i < update.ask_count; ++i) {
+        update.asks[i] = {snapshot.asks[i].price, snapshot.asks[i].quantity};
+    }
+    if (snapshot.has_derived_bid) {
+        update.flags |= FanoutBookUpdate::FLAG_DERIVED_BID;
+        update.derived_bid = {snapshot.derived_bid.price, snapshot.derived_bid.quantity};
+    }
+    if (snapshot.has_derived_ask) {
+        update.flags |= FanoutBookUpdate::FLAG_DERIVED_ASK;
+        update.derived_ask = {snapshot.derived_ask.price, snapshot.derived_ask.quantity};
+    }
+    append_fanout_book(out, update);
+}
+
+// Drops `sent` bytes from the front of the client's queue.
+static void consume_backlog(std::vector<uint8_t>& backlog, size_t& offset, size_t sent) {
+    offset += sent;
+    if (offset == backlog.size()) {
+        backlog.clear();
+        offset = 0;
+    } else if (offset > backlog.size() / 2) {
+        backlog.erase(backlog.begin(), backlog.begin() + static_cast<ptrdiff_t>(offset));
+        offset = 0;
+    }
+}
+
+bool UdsFanoutServer::send_to(Client& client, const uint8_t* data, size_t length) {
+    // Whatever the socket does not take now is queued behind what is already waiting.
+    const size_t queued = client.backlog.size() - client.backlog_offset;
+    iovec iov[2];
+    int count = 0;
+    if (queued > 0) {
+        iov[count++] = {client.backlog.data() + client.backlog_offset, queued};
+    }
+    if (length > 0) {
+        iov[count++] = {const_cast<uint8_t*>(data), length};
+    }
+    if (count == 0) {
+        return true;
+    }
+    msghdr message = {};
+    message.msg_iov = iov;
+    message.msg_iovlen = count;
+    ssize_t sent = sendmsg(client.fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            disconnect(client);
+            return false;
+        }
+        sent = 0;
+    }
+    CoreUtils::incrementMetric(CoreUtils::Metric::FANOUT_BYTES_SENT, static_cast<uint64_t>(sent));
+
+    size_t written = static_cast<size_t>(sent);
+    const size_t from_backlog = std::min(written, queued);
+    consume_backlog(client.backlog, client.backlog_offset, from_backlog);
+    written -= from_backlog;
+    client.backlog.insert(client.backlog.end(), data + written, data + length);
+    return true;
+}
+
+void UdsFanoutServer::flush(Client& client) {
+    if (client.fd < 0) {
+        return;
+    }
+    if (!client.conflating) {
+        // One vectored send of the queue and both parts of this cycle (definitions first).
+        const size_t queued = client.backlog.size() - client.backlog_offset;
+        iovec iov[3];
+        int count = 0;
+        if (queued > 0) {
+            iov[count++] = {client.backlog.data() + client.backlog_offset, queued};
+        }
+        if (!cycle_definitions_.empty()) {
+            iov[count++] = {cycle_definitions_.data(), cycle_definitions_.size()};
+        }
+        if (!cycle_books_.empty()) {
+            iov[count++] = {cycle_books_.data(), cycle_books_.size()};
+        }
+        if (count == 0) {
+            return;
+        }
+        msghdr message = {};
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t sent = sendmsg(client.fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                disconnect(client);
+                return;
+            }
+            sent = 0;
+        }
+        CoreUtils::incrementMetric(CoreUtils::Metric::FANOUT_BYTES_SENT, static_cast<uint64_t>(sent));
+
+        // Queue the unsent remainder of each part.
+        size_t written = static_cast<size_t>(sent);
+        const size_t from_backlog = std::min(written, queued);
+        consume_backlog(client.backlog, client.backlog_offset, from_backlog);
+        written -= from_backlog;
+        for (const std::vector<uint8_t>* part : {&cycle_definitions_, &cycle_books_}) {
+            const size_t skip = std::min(written, part->size());
+            client.backlog.insert(client.backlog.end(), part->begin() + static_cast<ptrdiff_t>(skip), part->end());
+            written -= skip;
+        }
+        if (client.backlog.size() - client.backlog_offset > config_.conflate_after_bytes) {
+            client.conflating = true;
+            client.dirty.assign(config_.book_capacity, 0);
+            client.dirty_books.clear();
+            LOG_WARNING << "UdsFanoutServer: client lagging by " << client.backlog.size() - client.backlog_offset
+                        << " bytes; conflating its updates.";
+        }
+        return;
+    }
+
+    // Conflating: remember which books changed, keep definitions, drain the queue.
+    for (BookHandle book : cycle_handles_) {
+        if (client.dirty[book]) {
+            conflated_.fetch_add(1, std::memory_order_relaxed);
+            CoreUtils::incrementMetric(CoreUtils::Metric::FANOUT_UPDATES_CONFLATED);
+        } else {
+            client.dirty[book] = 1;
+            client.dirty_books.push_back(book);
+        }
+    }
+    if (!send_to(client, cycle_definitions_.data(), cycle_definitions_.size())) {
+        return;
+    }
+    if (client.backlog.size() != client.backlog_offset) {
+        return;
+    }
+    // Caught up: one image per changed book, in place of everything skipped.
+    std::vector<uint8_t> images;
+    images.reserve(client.dirty_books.size() * 64);
+    for (BookHandle book : client.dirty_books) {
+        client.dirty[book] = 0;
+        encode_book(images, book, FanoutBookUpdate::FLAG_CONFLATED);
+    }
+    client.dirty_books.clear();
+    client.conflating = false;
+    LOG_INFO << "UdsFanoutServer: lagging client caught up.";
+    send_to(client, images.data(), images.size());
+}
+
+void UdsFanoutServer::disconnect(Client& client) {
+    if (client.fd >= 0) {
+        close(client.fd);
+        client.fd = -1;
+        client.backlog.clear();
+        client.backlog_offset = 0;
+        CoreUtils::incrementMetric(CoreUtils::Metric::FANOUT_CLIENTS_DISCONNECTED);
+        LOG_INFO << "UdsFanoutServer: client disconnected.";
+    }
+}
+
+void UdsFanoutServer::wait_for_work() {
+    std::vector<pollfd> fds;
+    fds.reserve(clients_.size() + 2);
+    fds.push_back({wake_fd_, POLLIN, 0});
+    fds.push_back({listen_fd_, POLLIN, 0});
+    for (const auto& client : clients_) {
+        const bool queued = client->backlog.size() != client->backlog_offset;
+        fds.push_back({client->fd, static_cast<short>(POLLIN | (queued ? POLLOUT : 0)), 0});
+    }
+
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool pending = change_tail_.load(std::memory_order_relaxed) != change_head_.load(std::memory_order_relaxed) ||
+                         change_overflow_.load(std::memory_order_relaxed) ||
+                         book_count_.load(std::memory_order_relaxed) != announced_books_ ||
+                         !running_.load(std::memory_order_relaxed);
+    poll(fds.data(), fds.size(), pending ? 0 : 1000);
+    parked_.store(false, std::memory_order_relaxed);
+
+    if (fds[0].revents & POLLIN) {
+        uint64_t count;
+        [[maybe_unused]] ssize_t drained = read(wake_fd_, &count, sizeof(count));
+    }
+    for (size_t i = 0; i < clients_.size(); ++i) {
+        const short revents = fds[i + 2].revents;
+        if (revents & (POLLIN | POLLHUP | POLLERR)) {
+            // Clients do not send anything; readable means closed (or a protocol violation).
+            uint8_t discard[256];
+            const ssize_t received = recv(clients_[i]->fd, discard, sizeof(discard), MSG_DONTWAIT);
+            if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                disconnect(*clients_[i]);
+            }
+        }
+    }
+}
+
+} // namespace Taifex
@@ -0,0 +1,134 @@
+#ifndef UDS_FANOUT_SERVER_H
+#define UDS_FANOUT_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "order_book/order_book.h"
+#include "sdk/fanout_protocol.h"
+#include "sdk/product_registry.h"
+#include "sdk/sdk_reader.h" // For BookSnapshotSlot
+
+namespace Taifex {
+
+/** @brief Settings for `UdsFanoutServer`. */
+struct UdsFanoutConfig {
+    /** @brief Filesystem path of the listening socket; a stale socket file is replaced. */
+    std::string path;
+    /** @brief Levels per side sent in each BOOK frame (at most `FanoutBookUpdate::MAX_LEVELS`). */
+    uint8_t depth = 5;
+    /** @brief Books with a BookHandle beyond this are not fanned out. About 400 bytes each. */
+    uint32_t book_capacity = 16384;
+    /** @brief Book changes queued from the feed thread to the server thread; a power of two. */
+    uint32_t change_queue_capacity = 65536;
+    uint32_t max_clients = 64;
+    /**
+     * @brief Unsent bytes above which a client counts as lagging: its updates are no longer queued
+     *        but conflated, and each changed book is sent once, as its latest image, when the
+     *        client has caught up.
+     */
+    size_t conflate_after_bytes = 256 * 1024;
+    /** @brief SO_SNDBUF of each client socket; 0 keeps the system default. */
+    int socket_buffer_bytes = 0;
+};
+
+/**
+ * @brief Republishes book changes to local processes over a Unix domain stream socket, in the
+ *        compact binary format of fanout_protocol.h. Enabled by `TaifexSdk::start_fanout_server`.
+ *
+ * The feed thread only copies the book's top levels into a seqlock slot and queues the BookHandle
+ * on a lock-free ring. The server thread encodes each changed book once per cycle and sends the
+ * cycle's frames to every client with one vectored send behind whatever that client still had
+ * queued. A client whose queue exceeds `conflate_after_bytes` is switched to conflation until it
+ * drains, so a slow consumer costs memory bounded by its queue and never delays the feed or other
+ * clients.
+ */
+class UdsFanoutServer {
+public:
+    UdsFanoutServer() = default;
+    ~UdsFanoutServer();
+
+    UdsFanoutServer(const UdsFanoutServer&) = delete;
+    UdsFanoutServer& operator=(const UdsFanoutServer&) = delete;
+
+    /** @return False if the socket could not be bound or the server thread not started. */
+    bool start(const UdsFanoutConfig& config);
+    /** @brief Disconnects all clients, joins the server thread and removes the socket file. */
+    void stop();
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+    /** @brief Announces a book to clients. Feed thread, before its first `publish`. */
+    void add_book(BookHandle book, std::string_view prod_id, uint8_t decimal_locator);
+
+    /** @brief Queues the book's current top levels for fan-out. Feed thread; never blocks. */
+    void publish(BookHandle book, const OrderBookManagement::OrderBook& order_book);
+
+    /** @brief Clients connected now. */
+    size_t client_count() const { return client_count_.load(std::memory_order_relaxed); }
+    /** @brief BOOK frames not sent to some client because a later image of the book replaced them. */
+    uint64_t conflated_count() const { return conflated_.load(std::memory_order_relaxed); }
+
+private:
+    struct BookEntry {
+        BookSnapshotSlot snapshot;
+        char prod_id[20];
+        uint8_t decimal_locator;
+        uint64_t sent_version; // Server thread.
+        uint64_t cycle;        // Server thread: last cycle the book was encoded in.
+    };
+
+    struct Client {
+        int fd = -1;
+        std::vector<uint8_t> backlog; // Bytes not accepted by the socket yet.
+        size_t backlog_offset = 0;
+        bool conflating = false;
+        std::vector<uint8_t> dirty;       // Per BookHandle: changed while conflating.
+        std::vector<BookHandle> dirty_books;
+    };
+
+    void run();
+    void accept_clients();
+    void drain_changes();
+    void encode_book(std::vector<uint8_t>& out, BookHandle book, uint8_t flags);
+    void flush(Client& client);
+    bool send_to(Client& client, const uint8_t* data, size_t length);
+    void disconnect(Client& client);
+    void wait_for_work();
+    void wake();
+
+    UdsFanoutConfig config_;
+    int listen_fd_ = -1;
+    int wake_fd_ = -1; // eventfd the feed thread writes when the server thread sleeps.
+    std::atomic<bool> running_{false};
+    std::unique_ptr<std::thread> thread_;
+
+    std::unique_ptr<BookEntry[]> books_;
+    std::atomic<uint32_t> book_count_{0}; // Entries below this are announced.
+
+    // Feed thread -> server thread ring of changed BookHandles.
+    std::unique_ptr<std::atomic<BookHandle>[]> changes_;
+    uint64_t change_mask_ = 0;
+    alignas(64) std::atomic<uint64_t> change_head_{0}; // Server thread.
+    alignas(64) std::atomic<uint64_t> change_tail_{0}; // Feed thread.
+    std::atomic<bool> change_overflow_{false};          // Changes were lost: rescan every book.
+    alignas(64) std::atomic<bool> parked_{false};
+
+    // Server thread only.
+    std::vector<std::unique_ptr<Client>> clients_;
+    std::vector<uint8_t> cycle_definitions_; // DEFINITION frames of this cycle.
+    std::vector<uint8_t> cycle_books_;       // BOOK frames of this cycle.
+    std::vector<BookHandle> cycle_handles_;  // Books in cycle_books_.
+    uint32_t announced_books_ = 0;
+    uint64_t cycle_ = 0;
+    std::atomic<size_t> client_count_{0};
+    std::atomic<uint64_t> conflated_{0};
+};
+
+} // namespace Taifex
+#endif // UDS_FANOUT_SERVER_H
@@ -0,0 +1,255 @@
+#include "sdk/update_stream.h"
+
+#include "logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring> // For std::memcpy
+#include <span>
+
+namespace Taifex {
+
+namespace {
+std::string_view trim_trailing_spaces(std::string_view value) {
+    const size_t end = value.find_last_not_of(' ');
+    return end == std::string_view::npos ? std::string_view() : value.substr(0, end + 1);
+}
+} // namespace
+
+BookUpdate BookUpdate::from_book(const OrderBookManagement::OrderBook& book) {
+    BookUpdate update;
+    const std::string& prod_id = book.get_product_id();
+    std::memset(update.prod_id, ' ', PROD_ID_LENGTH);
+    std::memcpy(update.prod_id, prod_id.data(), std::min(prod_id.size(), PROD_ID_LENGTH));
+    update.last_prod_msg_seq = book.get_last_prod_msg_seq();
+    update.decimal_locator = book.get_decimal_locator();
+    update.has_bid = book.copy_top_bids(std::span(&update.best_bid, 1)) != 0;
+    update.has_ask = book.copy_top_asks(std::span(&update.best_ask, 1)) != 0;
+    return update;
+}
+
+std::string_view BookUpdate::product_id() const {
+    return trim_trailing_spaces(std::string_view(prod_id, PROD_ID_LENGTH));
+}
+
+// --- UpdateStream ---
+
+UpdateStream::UpdateStream(UpdateExecutor& executor, std::vector<std::string> prod_ids, size_t capacity)
+    : executor_(executor),
+      ring_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+      mask_(ring_.size() - 1) {
+    for (const std::string& prod_id : prod_ids) {
+        prod_ids_.emplace_back(trim_trailing_spaces(prod_id));
+    }
+    std::sort(prod_ids_.begin(), prod_ids_.end());
+    prod_ids_.erase(std::unique(prod_ids_.begin(), prod_ids_.end()), prod_ids_.end());
+}
+
+bool UpdateStream::matches(std::string_view prod_id) const {
+    if (prod_ids_.empty()) {
+        return true;
+    }
+    const std::string_view trimmed = trim_trailing_spaces(prod_id);
+    auto it = std::lower_bound(prod_ids_.begin(), prod_ids_.end(), trimmed,
+                               [](const std::string& lhs, std::string_view rhs) { return lhs < rhs; });
+    return it != prod_ids_.end() && *it == trimmed;
+}
+
+void UpdateStream::push(const BookUpdate& update) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring_[tail & mask_] = update;
+    tail_.store(tail + 1, std::memory_order_release);
+    wake_waiter();
+}
+
+void UpdateStream::wake_waiter() {
+    // Pairs with the fence in NextUpdate::await_suspend: either the consumer sees the new tail
+    // before parking, or this sees it parked.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+        executor_.wake();
+    }
+}
+
+bool UpdateStream::try_next(BookUpdate& out) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    out = ring_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool UpdateStream::empty() const {
+    return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+}
+
+void UpdateStream::close() {
+    closed_.store(true, std::memory_order_release);
+    wake_waiter();
+}
+
+bool UpdateStream::is_closed() const {
+    return closed_.load(std::memory_order_acquire);
+}
+
+uint64_t UpdateStream::dropped_count() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+bool UpdateStream::NextUpdate::await_ready() {
+    BookUpdate update;
+    if (stream_.try_next(update)) {
+        value_ = update;
+        return true;
+    }
+    return stream_.is_closed();
+}
+
+bool UpdateStream::NextUpdate::await_suspend(std::coroutine_handle<> handle) {
+    stream_.waiter_ = handle;
+    stream_.parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!stream_.empty() || stream_.is_closed()) {
+        // An update (or close) raced with parking: carry on without suspending.
+        stream_.parked_.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    stream_.executor_.park(&stream_);
+    return true;
+}
+
+std::optional<BookUpdate> UpdateStream::NextUpdate::await_resume() {
+    if (!value_) {
+        BookUpdate update;
+        if (stream_.try_next(update)) {
+            value_ = update;
+        }
+    }
+    return value_; // Empty only once the stream is closed and drained.
+}
+
+// --- UpdateTask ---
+
+UpdateTask& UpdateTask::operator=(UpdateTask&& other) noexcept {
+    if (this != &other) {
+        if (handle_) {
+            handle_.destroy();
+        }
+        handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+}
+
+UpdateTask::~UpdateTask() {
+    if (handle_) {
+        handle_.destroy();
+    }
+}
+
+// --- UpdateExecutor ---
+
+UpdateExecutor::~UpdateExecutor() {
+    for (UpdateStream* stream : parked_) {
+        stream->parked_.store(false, std::memory_order_relaxed);
+        stream->waiter_ = nullptr;
+    }
+    for (auto handle : tasks_) {
+        handle.destroy();
+    }
+}
+
+void UpdateExecutor::spawn(UpdateTask task) {
+    auto handle = std::exchange(task.handle_, nullptr);
+    if (!handle) {
+        return;
+    }
+    tasks_.push_back(handle);
+    ready_.push_back(handle);
+}
+
+void UpdateExecutor::park(UpdateStream* stream) {
+    parked_.push_back(stream);
+}
+
+void UpdateExecutor::wake() {
+    wakeups_.fetch_add(1, std::memory_order_release);
+    wakeups_.notify_one();
+}
+
+void UpdateExecutor::collect_parked() {
+    auto still_parked = std::remove_if(parked_.begin(), parked_.end(), [this](UpdateStream* stream) {
+        if (stream->empty() && !stream->is_closed()) {
+            return false;
+        }
+        stream->parked_.store(false, std::memory_order_relaxed);
+        ready_.push_back(std::exchange(stream->waiter_, nullptr));
+        return true;
+    });
+    parked_.erase(still_parked, parked_.end());
+}
+
+void UpdateExecutor::resume(std::coroutine_handle<> handle) {
+    handle.resume();
+    if (!handle.done()) {
+        return;
+    }
+    // Only top-level task frames are resumed here, so a finished frame is a finished task.
+    auto it = std::find_if(tasks_.begin(), tasks_.end(),
+                           [&](const auto& task) { return task.address() == handle.address(); });
+    if (it == tasks_.end()) {
+        return;
+    }
+    if (std::exception_ptr exception = it->promise().exception) {
+        try {
+            std::rethrow_exception(exception);
+        } catch (const std::exception& e) {
+            LOG_ERROR << "UpdateExecutor: task ended with exception: " << e.what();
+        } catch (...) {
+            LOG_ERROR << "UpdateExecutor: task ended with unknown exception.";
+        }
+    }
+    it->destroy();
+    tasks_.erase(it);
+}
+
+size_t UpdateExecutor::poll() {
+    collect_parked();
+    // One pass over what is ready now, so a busy stream cannot keep poll() from returning.
+    const size_t ready_count = ready_.size();
+    for (size_t i = 0; i < ready_count; ++i) {
+        std::coroutine_handle<> handle = ready_.front();
+        ready_.pop_front();
+        resume(handle);
+    }
+    return ready_count;
+}
+
+void UpdateExecutor::run() {
+    while (!tasks_.empty()) {
+        if (stop_.exchange(false, std::memory_order_acquire)) {
+            return;
+        }
+        // Loaded before polling: a wake-up arriving after the streams were checked changes it.
+        const uint32_t seen = wakeups_.load(std::memory_order_acquire);
+        if (poll() == 0 && ready_.empty() && !tasks_.empty()) {
+            wakeups_.wait(seen, std::memory_order_acquire);
+        }
+    }
+}
+
+void UpdateExecutor::stop() {
+    stop_.store(true, std::memory_order_release);
+    wake();
+}
+
+size_t UpdateExecutor::task_count() const {
+    return tasks_.size();
+}
+
+} // namespace Taifex
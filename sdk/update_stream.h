@@ -0,0 +1,188 @@
+#ifndef UPDATE_STREAM_H
+#define UPDATE_STREAM_H
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "order_book/order_book.h"
+
+namespace Taifex {
+
+/**
+ * @brief Top of book after a change, as delivered to an `UpdateStream`.
+ */
+struct BookUpdate {
+    static constexpr size_t PROD_ID_LENGTH = 20;
+
+    char     prod_id[PROD_ID_LENGTH] = {}; // Space padded, as in I081/I083.
+    uint32_t last_prod_msg_seq = 0;
+    uint8_t  decimal_locator = 0;
+    bool     has_bid = false;
+    bool     has_ask = false;
+    OrderBookManagement::PriceQuantityLevel best_bid = {};
+    OrderBookManagement::PriceQuantityLevel best_ask = {};
+
+    /** @brief Top of `book`, as published after a change. */
+    static BookUpdate from_book(const OrderBookManagement::OrderBook& book);
+
+    /** @brief PROD-ID without trailing spaces. */
+    std::string_view product_id() const;
+};
+
+class UpdateExecutor;
+class TaifexSdk;
+
+/**
+ * @brief Book updates for one subscriber, obtained from `TaifexSdk::subscribe_updates`.
+ *
+ * The feed thread appends to a lock-free single-producer/single-consumer ring and never blocks:
+ * when the ring is full the update is dropped and counted (`dropped_count`); the book itself
+ * stays queryable. Coroutines running on the stream's `UpdateExecutor` consume it with
+ * `co_await stream->next()`, which suspends until an update arrives.
+ */
+class UpdateStream {
+public:
+    /** @brief Awaitable returned by `next()`; yields std::nullopt once the stream is closed and drained. */
+    class NextUpdate {
+    public:
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        std::optional<BookUpdate> await_resume();
+
+    private:
+        friend class UpdateStream;
+        explicit NextUpdate(UpdateStream& stream) : stream_(stream) {}
+
+        UpdateStream& stream_;
+        std::optional<BookUpdate> value_;
+    };
+
+    UpdateStream(UpdateExecutor& executor, std::vector<std::string> prod_ids, size_t capacity);
+    UpdateStream(const UpdateStream&) = delete;
+    UpdateStream& operator=(const UpdateStream&) = delete;
+
+    /** @brief Next update, in feed order. Only from coroutines on this stream's executor. */
+    NextUpdate next() { return NextUpdate(*this); }
+
+    /** @brief Non-suspending variant of `next()` for use outside coroutines. Consumer side only. */
+    bool try_next(BookUpdate& out);
+
+    /** @brief Stops delivery. Updates already queued can still be read. Any thread. */
+    void close();
+    bool is_closed() const;
+
+    /** @brief Updates lost because the ring was full. */
+    uint64_t dropped_count() const;
+
+    /** @brief True if updates of this PROD-ID (trimmed or space padded) are delivered here. */
+    bool matches(std::string_view prod_id) const;
+
+private:
+    friend class TaifexSdk;
+    friend class UpdateExecutor;
+
+    /** @brief Feed thread: appends `update`, waking the executor if a coroutine waits for it. */
+    void push(const BookUpdate& update);
+    bool empty() const;
+    void wake_waiter();
+
+    UpdateExecutor& executor_;
+    std::vector<std::string> prod_ids_; // Sorted, trimmed; empty = every book.
+    std::vector<BookUpdate> ring_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> head_{0}; // Next slot to read; consumer.
+    alignas(64) std::atomic<uint64_t> tail_{0}; // Next slot to write; producer.
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> closed_{false};
+    alignas(64) std::atomic<bool> parked_{false}; // A coroutine waits in next().
+    std::coroutine_handle<> waiter_;              // Executor thread only.
+};
+
+/**
+ * @brief Coroutine type for strategy code run by an `UpdateExecutor`. Starts when spawned; the
+ *        executor owns the frame.
+ */
+class UpdateTask {
+public:
+    struct promise_type {
+        UpdateTask get_return_object() { return UpdateTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        std::exception_ptr exception;
+    };
+
+    UpdateTask(UpdateTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    UpdateTask& operator=(UpdateTask&& other) noexcept;
+    ~UpdateTask();
+
+private:
+    friend class UpdateExecutor;
+    explicit UpdateTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Single-threaded executor for `UpdateTask`s. Everything it resumes runs on the thread
+ *        calling `run()` / `poll()`; the feed thread only flips an atomic and, if the executor
+ *        sleeps, wakes it.
+ */
+class UpdateExecutor {
+public:
+    UpdateExecutor() = default;
+    UpdateExecutor(const UpdateExecutor&) = delete;
+    UpdateExecutor& operator=(const UpdateExecutor&) = delete;
+    /**
+     * @brief Destroys the frames of unfinished tasks. Streams bound to this executor must be closed,
+     *        or their SDK destroyed, first.
+     */
+    ~UpdateExecutor();
+
+    /** @brief Takes ownership of `task` and schedules its first step. Executor thread. */
+    void spawn(UpdateTask task);
+
+    /**
+     * @brief Runs tasks until all have finished or `stop()` is called, sleeping while every task
+     *        waits for an update.
+     */
+    void run();
+
+    /** @brief Runs whatever can make progress without waiting. @return Number of resumptions. */
+    size_t poll();
+
+    /** @brief Makes `run()` return. Any thread. */
+    void stop();
+
+    /** @brief Tasks spawned and not finished yet. */
+    size_t task_count() const;
+
+private:
+    friend class UpdateStream;
+
+    void park(UpdateStream* stream);
+    void wake();
+    void collect_parked();
+    void resume(std::coroutine_handle<> handle);
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::vector<UpdateStream*> parked_;
+    std::vector<std::coroutine_handle<UpdateTask::promise_type>> tasks_;
+    std::atomic<uint32_t> wakeups_{0};
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace Taifex
+#endif // UPDATE_STREAM_H
@@ -0,0 +1,95 @@
+#include "sdk/warm_up.h"
+
+#include "common_header.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace Taifex {
+
+static_assert(WARM_UP_PROD_ID.size() == 20, "PROD-ID is X(20)");
+
+static void put_bcd(std::vector<unsigned char>& out, uint64_t value, size_t digits) {
+    const size_t start = out.size();
+    out.resize(start + digits / 2);
+    for (size_t i = digits / 2; i-- > 0;) {
+        const unsigned low = static_cast<unsigned>(value % 10);
+        value /= 10;
+        const unsigned high = static_cast<unsigned>(value % 10);
+        value /= 10;
+        out[start + i] = static_cast<unsigned char>((high << 4) | low);
+    }
+}
+
+static std::vector<unsigned char> make_frame(char tc, char mk, uint64_t channel_seq, const std::vector<unsigned char>& body) {
+    std::vector<unsigned char> frame = {0x1B, static_cast<unsigned char>(tc), static_cast<unsigned char>(mk)};
+    frame.reserve(CoreUtils::CommonHeader::HEADER_SIZE + body.size() + 1 + 2);
+    put_bcd(frame, 90000000000ULL, 12); // INFORMATION-TIME 09:00:00.000000
+    put_bcd(frame, 0, 4);               // CHANNEL-ID
+    put_bcd(frame, channel_seq, 10);
+    frame.push_back(0x01); // VERSION-NO
+    put_bcd(frame, body.size(), 4);
+    frame.insert(frame.end(), body.begin(), body.end());
+    unsigned char checksum = 0;
+    for (size_t i = 1; i < frame.size(); ++i) {
+        checksum ^= frame[i];
+    }
+    frame.push_back(checksum);
+    frame.push_back(0x0D);
+    frame.push_back(0x0A);
+    return frame;
+}
+
+static std::vector<unsigned char> book_body(uint32_t prod_msg_seq) {
+    std::vector<unsigned char> body(WARM_UP_PROD_ID.begin(), WARM_UP_PROD_ID.end());
+    put_bcd(body, prod_msg_seq, 10);
+    return body;
+}
+
+// Bids at BASE - 2, BASE - 4, ...; asks at BASE + 2, BASE + 4, ...
+static constexpr uint64_t BASE_PRICE = 1750000;
+
+struct UpdateEntry {
+    char action;
+    char type;
+    uint64_t price;
+    uint64_t quantity;
+};
+
+static std::vector<unsigned char> make_update(uint32_t prod_msg_seq, std::initializer_list<UpdateEntry> entries) {
+    std::vector<unsigned char> body = book_body(prod_msg_seq);
+    put_bcd(body, entries.size(), 2);
+    for (const UpdateEntry& entry : entries) {
+        body.push_back(static_cast<unsigned char>(entry.action));
+        body.push_back(static_cast<unsigned char>(entry.type));
+        body.push_back('0'); // Sign
+        put_bcd(body, entry.price, 10);
+        put_bcd(body, entry.quantity, 8);
+        put_bcd(body, 1, 2); // MD-PRICE-LEVEL
+    }
+    return make_frame('2', 'A', prod_msg_seq, body);
+}
+
+WarmUpFrames make_warm_up_frames(size_t depth) {
+    depth = std::clamp<size_t>(depth, 1, 49); // NO-MD-ENTRIES is 9(2).
+    WarmUpFrames frames;
+    std::vector<unsigned char> body = book_body(1);
+    body.push_back('0'); // CALCULATED-FLAG
+    put_bcd(body, depth * 2, 2);
+    for (char type : {'0', '1'}) {
+        for (size_t level = 1; level <= depth; ++level) {
+            body.push_back(static_cast<unsigned char>(type));
+            body.push_back('0'); // Sign
+            put_bcd(body, type == '0' ? BASE_PRICE - 2 * level : BASE_PRICE + 2 * level, 10);
+            put_bcd(body, level, 8);
+            put_bcd(body, level, 2);
+        }
+    }
+    frames.snapshot = make_frame('2', 'B', 1, body);
+    frames.updates.push_back(make_update(2, {{'1', '0', BASE_PRICE - 2, 3}, {'1', '1', BASE_PRICE + 2, 3}}));
+    frames.updates.push_back(make_update(3, {{'0', '0', BASE_PRICE, 1}, {'0', '1', BASE_PRICE + 1, 1}}));
+    frames.updates.push_back(make_update(4, {{'2', '0', BASE_PRICE, 0}, {'2', '1', BASE_PRICE + 1, 0}}));
+    return frames;
+}
+
+} // namespace Taifex
@@ -0,0 +1,58 @@
+#ifndef WARM_UP_H
+#define WARM_UP_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Taifex {
+
+/** @brief Settings for `TaifexSdk::warm_up`. */
+struct WarmUpConfig {
+    /** @brief Creates the book of every subscribed product that has an I010 and no book yet. */
+    bool create_books = true;
+    /**
+     * @brief Faults in every page of the book pool, the reorder rings and the shared-memory
+     *        segments, so the first frames after the open do not take the page faults.
+     */
+    bool prefault = true;
+    /**
+     * @brief Also `mlock`s the prefaulted memory so it is never paged out. Needs a large enough
+     *        RLIMIT_MEMLOCK (or CAP_IPC_LOCK); memory that cannot be locked is logged and skipped.
+     */
+    bool lock_memory = false;
+    /**
+     * @brief Times a synthetic I083 and I081 are run through frame validation, decoding and a
+     *        scratch book, to warm the code and data they touch. 0 disables.
+     */
+    uint32_t synthetic_rounds = 64;
+};
+
+/** @brief What `TaifexSdk::warm_up` did. */
+struct WarmUpReport {
+    size_t books_created = 0;
+    size_t bytes_prefaulted = 0;
+    size_t bytes_locked = 0;
+    uint64_t synthetic_frames = 0;
+    uint64_t page_faults = 0; ///< Process page faults taken during the warm-up.
+    std::chrono::nanoseconds elapsed{0};
+};
+
+/** @brief PROD-ID of the scratch book that `TaifexSdk::warm_up` feeds; never a listed product. */
+inline constexpr std::string_view WARM_UP_PROD_ID = "#WARMUP             ";
+
+/**
+ * @brief Complete frames for `WARM_UP_PROD_ID`: an I083 with `depth` levels a side (PROD-MSG-SEQ
+ *        1), then I081s that change, insert and delete levels (PROD-MSG-SEQ 2 onwards).
+ */
+struct WarmUpFrames {
+    std::vector<unsigned char> snapshot;
+    std::vector<std::vector<unsigned char>> updates;
+};
+
+WarmUpFrames make_warm_up_frames(size_t depth);
+
+} // namespace Taifex
+#endif // WARM_UP_H
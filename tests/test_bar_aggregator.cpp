@@ -0,0 +1,173 @@
+#include "sdk/bar_aggregator.h"
+#include "sdk/taifex_sdk.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+constexpr uint64_t MS = 1000;
+constexpr uint64_t SEC = 1000 * MS;
+constexpr uint64_t NINE_AM = 9 * 3600 * SEC;
+
+void test_bars_from_quotes_and_trades() {
+    std::cout << "Running test_bars_from_quotes_and_trades..." << std::endl;
+    BarAggregator bars;
+    BarConfig config;
+    config.second_bars = 3;
+    config.minute_bars = 2;
+    config.expected_books = 2;
+    bars.configure(config);
+    assert(bars.enabled());
+
+    std::vector<std::pair<BookHandle, Bar>> closed_seconds;
+    std::vector<std::pair<BookHandle, Bar>> closed_minutes;
+    bars.set_callback([&](BookHandle book, BarInterval interval, const Bar& bar) {
+        (interval == BarInterval::SECOND ? closed_seconds : closed_minutes).emplace_back(book, bar);
+    });
+
+    bars.on_quote(0, NINE_AM + 100 * MS, 100, 102);
+    bars.on_trade(0, NINE_AM + 200 * MS, 101, 3);
+    bars.on_quote(0, NINE_AM + 300 * MS, 104, 106);
+    bars.on_trade(0, NINE_AM + 400 * MS, 99, 2);
+    bars.on_quote(0, NINE_AM + 500 * MS, 96, 98);
+    bars.on_trade(1, NINE_AM + 600 * MS, 500, 1);
+    assert(closed_seconds.empty());
+
+    const Bar* open = bars.open_bar(0, BarInterval::SECOND);
+    assert(open && open->start_time_us == NINE_AM);
+    assert(open->mid2_open == 202 && open->mid2_high == 210 && open->mid2_low == 194 && open->mid2_close == 194);
+    assert(open->open == 101 && open->high == 101 && open->low == 99 && open->close == 99);
+    assert(open->volume == 5 && open->trade_count == 2 && open->quote_count == 3);
+
+    // The first input of the next second closes both books' bars, whichever book it is for.
+    bars.on_quote(1, NINE_AM + SEC + 10 * MS, 499, 501);
+    assert(closed_seconds.size() == 2);
+    assert(closed_seconds[0].first == 0 && closed_seconds[0].second.close == 99);
+    assert(closed_seconds[1].first == 1 && closed_seconds[1].second.quote_count == 0);
+    assert(!bars.open_bar(0, BarInterval::SECOND));
+    assert(bars.open_bar(1, BarInterval::SECOND)->start_time_us == NINE_AM + SEC);
+    assert(closed_minutes.empty());
+
+    // A late input from a channel running behind lands in the open bar.
+    bars.on_trade(1, NINE_AM + 900 * MS, 498, 4);
+    assert(closed_seconds.size() == 2 && bars.open_bar(1, BarInterval::SECOND)->volume == 4);
+
+    // Quiet seconds produce no bars; the ring keeps the last three.
+    for (uint64_t s = 2; s <= 6; ++s) {
+        bars.on_trade(0, NINE_AM + s * SEC, static_cast<int64_t>(100 + s), 1);
+    }
+    bars.advance(NINE_AM + 7 * SEC);
+    Bar history[8];
+    size_t count = bars.copy_bars(0, BarInterval::SECOND, history);
+    assert(count == 3);
+    assert(history[0].start_time_us == NINE_AM + 4 * SEC && history[0].close == 104);
+    assert(history[2].start_time_us == NINE_AM + 6 * SEC && history[2].close == 106);
+    assert(bars.copy_bars(0, BarInterval::SECOND, std::span<Bar>(history, 2)) == 2 && history[1].close == 106);
+    assert(!bars.open_bar(0, BarInterval::SECOND));
+
+    // Minute bars close on INFORMATION-TIME only.
+    bars.advance(NINE_AM + 59 * SEC);
+    assert(closed_minutes.empty());
+    bars.advance(NINE_AM + 60 * SEC);
+    assert(closed_minutes.size() == 2);
+    count = bars.copy_bars(0, BarInterval::MINUTE, history);
+    assert(count == 1 && history[0].start_time_us == NINE_AM);
+    assert(history[0].open == 101 && history[0].high == 106 && history[0].low == 99 && history[0].close == 106);
+    assert(history[0].volume == 10 && history[0].mid2_high == 210);
+
+    // A clock that goes back by half a day is the next session: it closes what is open.
+    const uint64_t ten_pm = 22 * 3600 * SEC;
+    bars.on_trade(0, ten_pm, 107, 1);
+    assert(closed_minutes.size() == 2);
+    bars.on_trade(0, 100 * MS, 108, 1);
+    assert(closed_minutes.size() == 3 && closed_minutes.back().second.start_time_us == ten_pm);
+    assert(bars.open_bar(0, BarInterval::MINUTE)->start_time_us == 0);
+
+    // Books beyond the preallocated ones are added on the cold path; unknown ones are ignored.
+    bars.on_trade(7, SEC, 1, 1);
+    assert(!bars.open_bar(7, BarInterval::SECOND));
+    bars.add_book(7);
+    bars.on_trade(7, SEC, 1, 1);
+    assert(bars.open_bar(7, BarInterval::SECOND) && bars.open_bar(7, BarInterval::MINUTE));
+
+    BarAggregator off;
+    off.configure(BarConfig{0, 0, 4});
+    assert(!off.enabled());
+    off.on_trade(0, SEC, 1, 1);
+    assert(!off.open_bar(0, BarInterval::SECOND) && off.copy_bars(0, BarInterval::SECOND, history) == 0);
+    std::cout << "test_bars_from_quotes_and_trades PASSED." << std::endl;
+}
+
+// --- SDK ---
+
+void test_sdk_bars_live_and_replay() {
+    std::cout << "Running test_sdk_bars_live_and_replay..." << std::endl;
+    const std::string journal = "/tmp/taifex_test_bars_" + std::to_string(getpid());
+    const std::string tx = pad("TXFB4", 20);
+
+    TaifexSdk live;
+    live.initialize(SdkConfig{});
+    live.aggregate_bars(BarConfig{});
+    EventJournalConfig journal_config;
+    journal_config.path = journal;
+    assert(live.journal_events(journal_config));
+    std::vector<Bar> live_bars;
+    live.set_bar_callback([&](BookHandle, BarInterval interval, const Bar& bar) {
+        if (interval == BarInterval::SECOND) {
+            live_bars.push_back(bar);
+        }
+    });
+
+    feed(live, make_i010(1, "TXFB4", 1, NINE_AM));
+    feed(live, make_i083(1, 2, "TXFB4", 1, top_of_book(1750000, 1750002, 5), NINE_AM + 100 * MS));  // mid2 3500002
+    feed(live, make_i081(1, 3, "TXFB4", 2, {{'0', 1750000, 5, 1, '2'}, {'0', 1750001, 5, 1, '0'}}, NINE_AM + 400 * MS));  // 3500003
+    feed(live, make_i081(1, 4, "TXFB4", 3, {{'0', 1750001, 5, 1, '2'}, {'0', 1749999, 5, 1, '0'}}, NINE_AM + 1200 * MS)); // Closes 09:00:00; 3500001
+    feed(live, make_i001(1, 5, NINE_AM + 2500 * MS));                      // Closes 09:00:01 without a book update.
+    assert(live_bars.size() == 2);
+    assert(live_bars[0].start_time_us == NINE_AM && live_bars[0].quote_count == 2);
+    assert(live_bars[0].mid2_open == 3500002 && live_bars[0].mid2_close == 3500003);
+    assert(live_bars[1].start_time_us == NINE_AM + SEC && live_bars[1].mid2_low == 3500001);
+    assert(!live.get_open_bar(tx, BarInterval::SECOND));
+    auto minute = live.get_open_bar(tx, BarInterval::MINUTE);
+    assert(minute && minute->quote_count == 3 && minute->mid2_high == 3500003 && minute->mid2_low == 3500001);
+
+    Bar history[4];
+    assert(live.get_bars(tx, BarInterval::SECOND, history) == 2 && history[1].mid2_close == 3500001);
+    assert(live.get_bars(pad("MXFB4", 20), BarInterval::SECOND, history) == 0);
+    live.close_event_journal();
+
+    // Replaying the journal rebuilds the same bars: they follow INFORMATION-TIME, not the wall clock.
+    TaifexSdk replayed;
+    replayed.initialize(SdkConfig{});
+    replayed.aggregate_bars(BarConfig{});
+    std::vector<Bar> replayed_bars;
+    replayed.set_bar_callback([&](BookHandle, BarInterval interval, const Bar& bar) {
+        if (interval == BarInterval::SECOND) {
+            replayed_bars.push_back(bar);
+        }
+    });
+    assert(replayed.replay_journal(journal));
+    assert(replayed_bars.size() == 1); // The heartbeat is not journaled; the last bar is still open.
+    assert(replayed_bars[0].start_time_us == live_bars[0].start_time_us);
+    assert(replayed_bars[0].mid2_open == live_bars[0].mid2_open && replayed_bars[0].mid2_close == live_bars[0].mid2_close);
+    auto open = replayed.get_open_bar(tx, BarInterval::SECOND);
+    assert(open && open->mid2_close == live_bars[1].mid2_close);
+    std::remove(journal.c_str());
+    std::cout << "test_sdk_bars_live_and_replay PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_bars_from_quotes_and_trades();
+    test_sdk_bars_live_and_replay();
+    std::cout << "All bar aggregator tests completed." << std::endl;
+    return 0;
+}
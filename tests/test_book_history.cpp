@@ -0,0 +1,181 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/event_journal.h"
+#include "sdk/book_history.h"
+#include "normalized_event.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+using CoreUtils::EventType;
+using CoreUtils::NormalizedEvent;
+
+static std::string journal_path(const char* suffix) {
+    return "/tmp/taifex_test_book_history_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+// What a book looked like at some INFORMATION-TIME.
+struct BookState {
+    uint32_t prod_msg_seq = 0;
+    bool stale = false;
+    std::vector<OrderBookManagement::PriceQuantityLevel> bids;
+    std::vector<OrderBookManagement::PriceQuantityLevel> asks;
+};
+
+static BookState state_of(const OrderBookManagement::OrderBook& book) {
+    return {book.get_last_prod_msg_seq(), book.is_stale(), book.get_top_bids(10), book.get_top_asks(10)};
+}
+
+static void assert_same_state(const BookState& expected, const BookState& actual) {
+    assert(expected.prod_msg_seq == actual.prod_msg_seq);
+    assert(expected.stale == actual.stale);
+    assert(expected.bids.size() == actual.bids.size() && expected.asks.size() == actual.asks.size());
+    for (size_t i = 0; i < expected.bids.size(); ++i) {
+        assert(expected.bids[i].price == actual.bids[i].price && expected.bids[i].quantity == actual.bids[i].quantity);
+    }
+    for (size_t i = 0; i < expected.asks.size(); ++i) {
+        assert(expected.asks[i].price == actual.asks[i].price && expected.asks[i].quantity == actual.asks[i].quantity);
+    }
+}
+
+struct Observation {
+    uint64_t seconds;
+    std::string prod_id;
+    BookState state;
+};
+
+// Records a session of two books and notes each book's state after every message.
+static std::vector<Observation> record_session(TaifexSdk& sdk, const std::string& path) {
+    std::vector<Observation> observations;
+    auto observe = [&](uint64_t seconds, const std::string& prod_id) {
+        observations.push_back({seconds, prod_id, state_of(sdk.get_order_book(pad(prod_id, 20))->get())});
+    };
+    sdk.initialize(SdkConfig{});
+    feed(sdk, make_i010(1, "TXFB4", 1, info_time_us(0)));
+    feed(sdk, make_i010(2, "MXFB4", 1, info_time_us(0)));
+
+    EventJournalConfig config;
+    config.path = path;
+    config.checkpoint_interval_us = 0; // Only the opening checkpoint: the book images do the work.
+    config.book_checkpoint_events = 10;
+    assert(sdk.journal_events(config));
+
+    feed(sdk, make_i083(1, 3, "TXFB4", 1, ladder(1750000, 5), info_time_us(1)));
+    observe(1, "TXFB4");
+    feed(sdk, make_i083(1, 4, "MXFB4", 1, ladder(1760000, 5), info_time_us(2)));
+    observe(2, "MXFB4");
+    uint64_t channel_seq = 5;
+    for (uint32_t seq = 2; seq <= 80; ++seq) { // One TXFB4 update every 2 s.
+        feed(sdk, make_i081(1, channel_seq++, "TXFB4", seq, {{'0', 1750000, seq, 1, '1'}}, info_time_us(2 * seq)));
+        observe(2 * seq, "TXFB4");
+    }
+    feed(sdk, make_i081(1, channel_seq++, "MXFB4", 3, {{'0', 1760000, 9, 1, '1'}}, info_time_us(161))); // Gap: 2 was lost.
+    observe(161, "MXFB4");
+    feed(sdk, make_i081(1, channel_seq++, "TXFB4", 81, {{'0', 1750001, 4, 1, '0'}}, info_time_us(162)));
+    observe(162, "TXFB4");
+    feed(sdk, make_i083(1, channel_seq++, "MXFB4", 5, ladder(1760010, 5), info_time_us(163))); // Resync.
+    observe(163, "MXFB4");
+    feed(sdk, make_i002(1, channel_seq++, info_time_us(170))); // I002: both books cleared.
+    observe(170, "TXFB4");
+    observe(170, "MXFB4");
+    feed(sdk, make_i083(1, channel_seq++, "TXFB4", 1, ladder(1750100, 5), info_time_us(171)));
+    observe(171, "TXFB4");
+    sdk.close_event_journal();
+    return observations;
+}
+
+void test_book_checkpoints() {
+    std::cout << "Running test_book_checkpoints..." << std::endl;
+    const std::string path = journal_path("checkpoints");
+    TaifexSdk live;
+    record_session(live, path);
+
+    EventJournalReader reader;
+    assert(reader.open(path));
+    const BookHandle txf = live.get_book_handle(pad("TXFB4", 20));
+    size_t full = 0, single = 0;
+    for (size_t i = 0; i < reader.record_count(); ++i) {
+        if (reader.record_type(i) != JournalRecordType::CHECKPOINT) {
+            continue;
+        }
+        if (reader.checkpoint(i).single_book) {
+            single += reader.checkpoint(i).book == txf;
+            assert(reader.event(i + 1).book == reader.checkpoint(i).book);
+            assert(reader.event(i + 1).flags & NormalizedEvent::FLAG_CHECKPOINT);
+        } else {
+            ++full;
+        }
+    }
+    assert(full == 1);
+    assert(single >= 7); // TXFB4: 11 + 79 + 1 events, an image every 10.
+    // A replay seeks to full checkpoints only.
+    assert(reader.find_checkpoint(info_time_us(1000)) == reader.find_checkpoint(0));
+    reader.close();
+
+    // Single-book images are not replayed as feed activity.
+    TaifexSdk replayed;
+    replayed.initialize(SdkConfig{});
+    size_t updates = 0;
+    replayed.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++updates; });
+    assert(replayed.replay_journal(path));
+    assert(updates == 2 + 80 + 1 + 1); // Snapshots, TXFB4 updates, MXFB4 resync, TXFB4 after the I002.
+    assert_same_state(state_of(live.get_order_book(pad("TXFB4", 20))->get()),
+                      state_of(replayed.get_order_book(pad("TXFB4", 20))->get()));
+    std::remove(path.c_str());
+    std::cout << "test_book_checkpoints PASSED." << std::endl;
+}
+
+void test_book_as_of_matches_live() {
+    std::cout << "Running test_book_as_of_matches_live..." << std::endl;
+    const std::string path = journal_path("as_of");
+    std::vector<Observation> observations;
+    {
+        TaifexSdk live;
+        observations = record_session(live, path);
+    }
+
+    BookHistory history;
+    assert(history.open(path));
+    assert(history.book_count() == 2);
+    for (const Observation& observation : observations) {
+        // At the message and just before the next one, the book is as the live feed left it.
+        for (uint64_t offset : {0ULL, 900000ULL}) {
+            size_t applied = 0;
+            auto book = history.book_as_of(observation.prod_id, info_time_us(observation.seconds) + offset, &applied);
+            assert(book);
+            assert(book->get_product_id() == pad(observation.prod_id, 20));
+            assert_same_state(observation.state, state_of(*book));
+            assert(applied <= 11 + 10 + 1); // An image, then at most a threshold's worth of events.
+        }
+    }
+    // Trimmed and padded PROD-IDs alike.
+    assert(history.book_as_of(pad("MXFB4", 20), info_time_us(162)));
+    assert(history.book_as_of("MXFB4", info_time_us(162))->is_stale());
+    assert(!history.book_as_of("MXFB4", info_time_us(164))->is_stale());
+
+    // Before a book's first message, and books the journal never saw.
+    assert(!history.book_as_of("TXFB4", info_time_us(0)));
+    assert(!history.book_as_of("MXFB4", info_time_us(1)));
+    assert(!history.book_as_of("ZZZZZ", info_time_us(100)));
+
+    history.close();
+    assert(history.book_count() == 0);
+    assert(!history.open("/nonexistent/journal"));
+    std::remove(path.c_str());
+    std::cout << "test_book_as_of_matches_live PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_book_checkpoints();
+    test_book_as_of_matches_live();
+    std::cout << "All book history tests completed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "sdk/channel_gap_manager.h"
+#include "sdk/taifex_sdk.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+struct RecordedRequest {
+    uint32_t channel_id;
+    uint64_t begin_seq;
+    uint16_t count;
+};
+
+static void feed(TaifexSdk& sdk, uint32_t channel_id, uint64_t channel_seq) {
+    feed(sdk, make_i001(channel_id, channel_seq));
+}
+
+void test_hold_requests_missing_range() {
+    std::cout << "Running test_hold_requests_missing_range..." << std::endl;
+    std::vector<RecordedRequest> requests;
+    ChannelGapManager manager;
+    manager.set_retransmission_requester([&](uint32_t ch, uint64_t seq, uint16_t count) {
+        requests.push_back({ch, seq, count});
+    });
+    manager.register_channel(7);
+
+    const unsigned char frame[] = {0x1B, 0x01, 0x02};
+    auto now = ChannelGapManager::Clock::now();
+
+    assert(manager.hold(7, 10, 13, frame, sizeof(frame), now));
+    assert(manager.is_recovering(7));
+    assert(requests.size() == 1);
+    assert(requests[0].channel_id == 7 && requests[0].begin_seq == 10 && requests[0].count == 3);
+
+    // Seq 12 is inside the requested range: held, no new request.
+    assert(manager.hold(7, 10, 12, frame, sizeof(frame), now));
+    assert(requests.size() == 1);
+
+    // Seq 16 extends the gap: only 14..15 are requested.
+    assert(manager.hold(7, 10, 16, frame, sizeof(frame), now));
+    assert(requests.size() == 2);
+    assert(requests[1].begin_seq == 14 && requests[1].count == 2);
+
+    assert(manager.lowest_held_seq(7) == 12);
+    const std::vector<unsigned char>* held = manager.held_frame(7, 13);
+    assert(held && held->size() == sizeof(frame) && (*held)[1] == 0x01);
+    assert(manager.held_frame(7, 11) == nullptr);
+
+    std::cout << "test_hold_requests_missing_range PASSED." << std::endl;
+}
+
+void test_hold_beyond_window_and_drain() {
+    std::cout << "Running test_hold_beyond_window_and_drain..." << std::endl;
+    GapRecoveryConfig config;
+    config.reorder_capacity = 4;
+    config.gap_timeout = std::chrono::milliseconds(100);
+    ChannelGapManager manager(config);
+
+    const unsigned char frame[] = {0x1B};
+    auto now = ChannelGapManager::Clock::now();
+
+    assert(!manager.hold(1, 1, 5, frame, sizeof(frame), now)); // 5 - 1 >= capacity
+    assert(manager.hold(1, 1, 4, frame, sizeof(frame), now));
+    assert(!manager.has_timed_out(1, now));
+    assert(manager.has_timed_out(1, now + std::chrono::milliseconds(100)));
+
+    manager.release(1, 4);
+    manager.on_drained(1, 5, now);
+    assert(!manager.is_recovering(1));
+    assert(manager.recovering_channels().empty());
+
+    assert(manager.hold(1, 5, 7, frame, sizeof(frame), now));
+    manager.reset_channel(1);
+    assert(!manager.is_recovering(1));
+    assert(manager.held_frame(1, 7) == nullptr);
+
+    std::cout << "test_hold_beyond_window_and_drain PASSED." << std::endl;
+}
+
+void test_sdk_reorders_and_drains() {
+    std::cout << "Running test_sdk_reorders_and_drains..." << std::endl;
+    std::vector<RecordedRequest> requests;
+    TaifexSdk sdk;
+    sdk.initialize();
+    sdk.set_retransmission_requester([&](uint32_t ch, uint64_t seq, uint16_t count) {
+        requests.push_back({ch, seq, count});
+    });
+
+    feed(sdk, 3, 1);
+    feed(sdk, 3, 2);
+    feed(sdk, 3, 5); // Gap 3..4
+    assert(requests.size() == 1);
+    assert(requests[0].channel_id == 3 && requests[0].begin_seq == 3 && requests[0].count == 2);
+
+    feed(sdk, 3, 4); // Held, already requested
+    feed(sdk, 3, 3); // Fills the gap; 4 and 5 are drained
+    feed(sdk, 3, 6); // In sequence after the drain
+    assert(requests.size() == 1);
+
+    feed(sdk, 3, 5); // Duplicate of a drained frame
+    feed(sdk, 3, 8); // New gap: only 7 is missing
+    assert(requests.size() == 2);
+    assert(requests[1].begin_seq == 7 && requests[1].count == 1);
+
+    const CoreUtils::ChannelState* state = sdk.channel_states().find(3);
+    assert(state && state->synced && state->expected_seq == 7);
+    assert(state->gaps_detected.load() == 2);
+    assert(state->gaps_recovered.load() == 1);
+    assert(state->duplicates.load() == 1);
+    assert(sdk.channel_states().find(10000) == nullptr);
+
+    std::cout << "test_sdk_reorders_and_drains PASSED." << std::endl;
+}
+
+void test_sdk_timeout_falls_back() {
+    std::cout << "Running test_sdk_timeout_falls_back..." << std::endl;
+    std::vector<RecordedRequest> requests;
+    GapRecoveryConfig config;
+    config.gap_timeout = std::chrono::milliseconds(0); // Give up immediately
+    TaifexSdk sdk;
+    sdk.initialize(config);
+    sdk.set_retransmission_requester([&](uint32_t ch, uint64_t seq, uint16_t count) {
+        requests.push_back({ch, seq, count});
+    });
+
+    feed(sdk, 9, 10);
+    feed(sdk, 9, 15); // Requested, then skipped on timeout; channel resumes at 15
+    assert(requests.size() == 1);
+    feed(sdk, 9, 16);
+    assert(requests.size() == 1);
+    feed(sdk, 9, 18);
+    assert(requests.size() == 2);
+    assert(requests[1].begin_seq == 17 && requests[1].count == 1);
+    assert(sdk.channel_states().find(9)->gaps_abandoned.load() == 2);
+
+    std::cout << "test_sdk_timeout_falls_back PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_hold_requests_missing_range();
+    test_hold_beyond_window_and_drain();
+    test_sdk_reorders_and_drains();
+    test_sdk_timeout_falls_back();
+    std::cout << "All ChannelGapManager tests PASSED." << std::endl;
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "sdk/taifex_sdk.h"
+#include "normalized_event.h"
+#include "logger.h"
+#include "metrics.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+using CoreUtils::NormalizedEvent;
+
+static uint64_t metric(CoreUtils::Metric which) {
+    return CoreUtils::getMetricsSnapshot().get(which);
+}
+
+static const OrderBookManagement::OrderBook& book(TaifexSdk& sdk, const std::string& prod_id) {
+    auto found = sdk.get_order_book(pad(prod_id, 20));
+    assert(found);
+    return found->get();
+}
+
+void test_reset_clears_only_its_channel() {
+    std::cout << "Running test_reset_clears_only_its_channel..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    std::vector<NormalizedEvent> resets;
+    sdk.set_event_callback([&](std::span<const NormalizedEvent> events) {
+        for (const NormalizedEvent& event : events) {
+            if (event.flags & NormalizedEvent::FLAG_RESET) {
+                resets.push_back(event);
+            }
+        }
+    });
+    feed(sdk, make_i010(1, "TXFB4", 9));
+    feed(sdk, make_i010(2, "MXFB4", 9));
+    feed(sdk, make_i010(3, "TEFB4", 9));
+    feed(sdk, make_i083(1, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+    feed(sdk, make_i083(2, 1, "MXFB4", 1, top_of_book(1760000, 1760001, 1)));
+    feed(sdk, make_i083(2, 2, "TEFB4", 1, top_of_book(1770000, 1770001, 1)));
+
+    const uint64_t resets_before = metric(CoreUtils::Metric::SEQUENCE_RESETS);
+    const uint64_t books_before = metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS);
+    feed(sdk, make_i002(2, 3));
+    assert(metric(CoreUtils::Metric::SEQUENCE_RESETS) == resets_before + 1);
+    assert(metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS) == books_before + 2);
+
+    // Channel 2's books are cleared; channel 1's keeps its levels and PROD-MSG-SEQ.
+    assert(book(sdk, "MXFB4").get_last_prod_msg_seq() == 0 && book(sdk, "MXFB4").get_top_bids(1).empty());
+    assert(book(sdk, "TEFB4").get_last_prod_msg_seq() == 0 && book(sdk, "TEFB4").get_top_asks(1).empty());
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 1);
+    assert(book(sdk, "TXFB4").get_top_bids(1).size() == 1 && book(sdk, "TXFB4").get_top_bids(1)[0].price == 1750000);
+    assert(resets.size() == 2);
+    assert(resets[0].channel_id == 2 && resets[1].channel_id == 2);
+    assert(resets.back().flags & NormalizedEvent::FLAG_END_OF_MESSAGE);
+
+    // Channel 1 keeps sequencing; its book keeps applying updates.
+    feed(sdk, make_i081(1, 2, "TXFB4", 2, {{'0', 1750000, 7, 1, '1'}}));
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 2);
+    assert(book(sdk, "TXFB4").get_top_bids(1)[0].quantity == 7);
+
+    // A channel without books clears nothing.
+    feed(sdk, make_i002(5, 1));
+    assert(metric(CoreUtils::Metric::SEQUENCE_RESETS) == resets_before + 2);
+    assert(metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS) == books_before + 2);
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 2);
+    std::cout << "test_reset_clears_only_its_channel PASSED." << std::endl;
+}
+
+void test_book_on_two_channels() {
+    std::cout << "Running test_book_on_two_channels..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    feed(sdk, make_i010(1, "TXFB4", 9));
+    feed(sdk, make_i010(2, "MXFB4", 9));
+    // TXFB4 arrives on both channels, alternating; it is indexed once under each.
+    feed(sdk, make_i083(1, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+    feed(sdk, make_i083(2, 1, "MXFB4", 1, top_of_book(1760000, 1760001, 1)));
+    uint64_t seq1 = 2, seq2 = 2;
+    for (uint32_t prod_msg_seq = 2; prod_msg_seq <= 5; ++prod_msg_seq) {
+        if (prod_msg_seq % 2 == 0) {
+            feed(sdk, make_i081(2, seq2++, "TXFB4", prod_msg_seq, {{'0', 1750000, prod_msg_seq, 1, '1'}}));
+        } else {
+            feed(sdk, make_i081(1, seq1++, "TXFB4", prod_msg_seq, {{'0', 1750000, prod_msg_seq, 1, '1'}}));
+        }
+    }
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 5);
+
+    const uint64_t books_before = metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS);
+    feed(sdk, make_i002(2, seq2++));
+    assert(metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS) == books_before + 2);
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 0);
+    assert(book(sdk, "MXFB4").get_last_prod_msg_seq() == 0);
+
+    // Rebuilt, then reset from channel 1: only TXFB4 was ever seen there.
+    feed(sdk, make_i083(1, seq1++, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+    feed(sdk, make_i083(2, 1, "MXFB4", 1, top_of_book(1760000, 1760001, 1)));
+    feed(sdk, make_i002(1, seq1++));
+    assert(metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS) == books_before + 3);
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 0);
+    assert(book(sdk, "MXFB4").get_last_prod_msg_seq() == 1);
+    std::cout << "test_book_on_two_channels PASSED." << std::endl;
+}
+
+void test_reset_keeps_other_channels_pending_frames() {
+    std::cout << "Running test_reset_keeps_other_channels_pending_frames..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    // Snapshots ahead of their I010, on two channels.
+    feed(sdk, make_i083(1, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+    feed(sdk, make_i083(2, 1, "MXFB4", 1, top_of_book(1760000, 1760001, 1)));
+    assert(sdk.get_pending_frame_count() == 2);
+
+    feed(sdk, make_i002(2, 2));
+    assert(sdk.get_pending_frame_count() == 1); // Only channel 2's frame is obsolete.
+
+    feed(sdk, make_i010(1, "TXFB4", 9));
+    feed(sdk, make_i010(2, "MXFB4", 9));
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 1);
+    assert(book(sdk, "TXFB4").get_top_bids(1)[0].price == 1750000);
+    assert(!sdk.get_order_book(pad("MXFB4", 20)));
+    assert(sdk.get_pending_frame_count() == 0);
+    std::cout << "test_reset_keeps_other_channels_pending_frames PASSED." << std::endl;
+}
+
+void test_reset_keeps_other_channels_gaps() {
+    std::cout << "Running test_reset_keeps_other_channels_gaps..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    std::vector<uint32_t> requested_channels;
+    sdk.set_retransmission_requester([&](uint32_t channel_id, uint64_t begin_seq, uint16_t count) {
+        assert(channel_id != 1 || (begin_seq == 2 && count == 1));
+        requested_channels.push_back(channel_id);
+    });
+    feed(sdk, make_i010(1, "TXFB4", 9));
+    feed(sdk, make_i010(2, "MXFB4", 9));
+    feed(sdk, make_i083(1, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+    feed(sdk, make_i083(2, 1, "MXFB4", 1, top_of_book(1760000, 1760001, 1)));
+
+    // Channel 1 loses seq 2: seq 3 is held and seq 2 requested.
+    feed(sdk, make_i081(1, 3, "TXFB4", 3, {{'0', 1750000, 9, 1, '1'}}));
+    assert(requested_channels == std::vector<uint32_t>{1});
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 1);
+
+    // An I002 on channel 2 while the gap is open leaves channel 1's held frame alone.
+    feed(sdk, make_i002(2, 2));
+    assert(book(sdk, "MXFB4").get_last_prod_msg_seq() == 0 && book(sdk, "MXFB4").get_top_bids(1).empty());
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 1 && book(sdk, "TXFB4").get_top_bids(1)[0].quantity == 1);
+
+    // The retransmitted seq 2 fills the gap and the held seq 3 follows it.
+    feed(sdk, make_i081(1, 2, "TXFB4", 2, {{'0', 1750000, 5, 1, '1'}}));
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 3 && !book(sdk, "TXFB4").is_stale());
+    assert(book(sdk, "TXFB4").get_top_bids(1)[0].quantity == 9);
+    feed(sdk, make_i081(2, 1, "MXFB4", 1, {{'0', 1760000, 4, 1, '0'}})); // Channel 2 restarts at seq 1.
+    assert(book(sdk, "MXFB4").get_top_bids(1)[0].quantity == 4);
+    assert(requested_channels == std::vector<uint32_t>{1});
+    std::cout << "test_reset_keeps_other_channels_gaps PASSED." << std::endl;
+}
+
+void test_reset_after_restart() {
+    std::cout << "Running test_reset_after_restart..." << std::endl;
+    StateStoreConfig config;
+    config.path = "/tmp/taifex_channel_reset_test_" + std::to_string(getpid()) + ".dat";
+    config.product_capacity = 16;
+    config.book_capacity = 16;
+    std::remove(config.path.c_str());
+    {
+        TaifexSdk sdk;
+        sdk.initialize(SdkConfig{});
+        assert(sdk.attach_state_store(config));
+        feed(sdk, make_i010(1, "TXFB4", 9));
+        feed(sdk, make_i010(2, "MXFB4", 9));
+        feed(sdk, make_i083(2, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+        feed(sdk, make_i081(2, 2, "TXFB4", 2, {{'0', 1750000, 7, 1, '1'}}));
+        feed(sdk, make_i083(1, 1, "MXFB4", 1, top_of_book(1760000, 1760001, 1)));
+    } // Restart.
+
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    assert(sdk.attach_state_store(config));
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 2);
+
+    // The I002 comes before any frame of the restored book: it is still cleared, and the
+    // exchange's restarted PROD-MSG-SEQ applies.
+    const uint64_t books_before = metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS);
+    feed(sdk, make_i002(2, 3));
+    assert(metric(CoreUtils::Metric::SEQUENCE_RESET_BOOKS) == books_before + 1);
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 0 && book(sdk, "TXFB4").get_top_bids(1).empty());
+    assert(book(sdk, "MXFB4").get_last_prod_msg_seq() == 1);
+    feed(sdk, make_i081(2, 1, "TXFB4", 1, {{'0', 1740000, 9, 1, '1'}})); // Not a duplicate of the pre-reset seq 1.
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 1 && !book(sdk, "TXFB4").is_stale());
+    feed(sdk, make_i083(2, 2, "TXFB4", 2, top_of_book(1740000, 1740001, 1)));
+    assert(book(sdk, "TXFB4").get_last_prod_msg_seq() == 2);
+    assert(book(sdk, "TXFB4").get_top_bids(1)[0].price == 1740000);
+    std::remove(config.path.c_str());
+    std::cout << "test_reset_after_restart PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_reset_clears_only_its_channel();
+    test_book_on_two_channels();
+    test_reset_keeps_other_channels_pending_frames();
+    test_reset_keeps_other_channels_gaps();
+    test_reset_after_restart();
+    std::cout << "All channel reset tests completed." << std::endl;
+    return 0;
+}
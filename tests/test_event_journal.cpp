@@ -0,0 +1,168 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/event_journal.h"
+#include "normalized_event.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+using CoreUtils::EventType;
+using CoreUtils::NormalizedEvent;
+
+static std::string journal_path(const char* suffix) {
+    return "/tmp/taifex_test_journal_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+static void assert_same_book(TaifexSdk& expected, TaifexSdk& actual, const std::string& prod_id) {
+    auto lhs = expected.get_order_book(pad(prod_id, 20));
+    auto rhs = actual.get_order_book(pad(prod_id, 20));
+    assert(lhs && rhs);
+    const auto& a = lhs->get();
+    const auto& b = rhs->get();
+    assert(a.get_last_prod_msg_seq() == b.get_last_prod_msg_seq());
+    assert(a.is_stale() == b.is_stale());
+    assert(a.get_decimal_locator() == b.get_decimal_locator());
+    const auto a_bids = a.get_top_bids(10), b_bids = b.get_top_bids(10);
+    const auto a_asks = a.get_top_asks(10), b_asks = b.get_top_asks(10);
+    assert(a_bids.size() == b_bids.size() && a_asks.size() == b_asks.size());
+    for (size_t i = 0; i < a_bids.size(); ++i) {
+        assert(a_bids[i].price == b_bids[i].price && a_bids[i].quantity == b_bids[i].quantity);
+    }
+    for (size_t i = 0; i < a_asks.size(); ++i) {
+        assert(a_asks[i].price == b_asks[i].price && a_asks[i].quantity == b_asks[i].quantity);
+    }
+}
+
+// Records a session: two books, updates across two checkpoint intervals, a gap and its resync.
+static void record_session(TaifexSdk& sdk, const std::string& path) {
+    sdk.initialize(SdkConfig{});
+    feed(sdk, make_i010(1, "TXFB4", 1, info_time_us(0)));
+    feed(sdk, make_i010(2, "MXFB4", 1, info_time_us(0)));
+    feed(sdk, make_i083(1, 3, "TXFB4", 1, ladder(1750000, 5), info_time_us(1))); // Book exists before the journal.
+
+    EventJournalConfig config;
+    config.path = path;
+    config.checkpoint_interval_us = 60 * 1000000ULL;
+    config.buffer_bytes = 4096; // Several writes.
+    assert(sdk.journal_events(config));
+
+    feed(sdk, make_i083(1, 4, "MXFB4", 1, ladder(1760000, 5), info_time_us(2)));
+    uint64_t channel_seq = 5;
+    for (uint32_t seq = 2; seq <= 80; ++seq) { // One update every 2 s: checkpoints at 60 s and 120 s.
+        feed(sdk, make_i081(1, channel_seq++, "TXFB4", seq, {{'0', 1750000, seq, 1, '1'}}, info_time_us(2 * seq)));
+    }
+    feed(sdk, make_i081(1, channel_seq++, "MXFB4", 3, {{'0', 1760000, 9, 1, '1'}}, info_time_us(161))); // Gap: 2 was lost.
+    feed(sdk, make_i081(1, channel_seq++, "TXFB4", 81, {{'0', 1750001, 4, 1, '0'}}, info_time_us(162)));
+    feed(sdk, make_i083(1, channel_seq++, "MXFB4", 5, ladder(1760010, 5), info_time_us(163))); // Resync.
+    sdk.close_event_journal();
+}
+
+void test_journal_records() {
+    std::cout << "Running test_journal_records..." << std::endl;
+    const std::string path = journal_path("records");
+    {
+        TaifexSdk sdk;
+        record_session(sdk, path);
+    }
+
+    EventJournalReader reader;
+    assert(reader.open(path));
+    size_t products = 0, books = 0, checkpoints = 0, events = 0, checkpoint_events = 0;
+    for (size_t i = 0; i < reader.record_count(); ++i) {
+        switch (reader.record_type(i)) {
+            case JournalRecordType::PRODUCT: ++products; break;
+            case JournalRecordType::BOOK: ++books; break;
+            case JournalRecordType::CHECKPOINT: ++checkpoints; break;
+            case JournalRecordType::EVENT:
+                if (reader.event(i).flags & NormalizedEvent::FLAG_CHECKPOINT) {
+                    ++checkpoint_events;
+                } else {
+                    ++events;
+                }
+                break;
+        }
+    }
+    assert(products == 2);
+    assert(books == 2);
+    assert(checkpoints == 3); // At open, then after 60 s and 120 s of INFORMATION-TIME.
+    // MXFB4 snapshot 11, 79 TXFB4 updates, BOOK_STALE, one update, resync snapshot 11.
+    assert(events == 11 + 79 + 1 + 1 + 11);
+    assert(checkpoint_events > 0);
+
+    // The opening checkpoint holds the TXFB4 book as it was when journaling started.
+    const size_t first = reader.find_checkpoint(0);
+    assert(first != EventJournalReader::NPOS);
+    assert(reader.checkpoint(first).exchange_time_us == 0 && reader.checkpoint(first).book_count == 1);
+    assert(reader.event(first + 1).type == EventType::BOOK_CLEAR);
+    assert(reader.event(first + 1).flags & NormalizedEvent::FLAG_CHECKPOINT);
+    assert(reader.event(first + 1).prod_msg_seq == 1);
+
+    const size_t later = reader.find_checkpoint(info_time_us(130));
+    assert(later != EventJournalReader::NPOS && later > first);
+    assert(reader.checkpoint(later).exchange_time_us >= info_time_us(120));
+    assert(reader.checkpoint(later).book_count == 2);
+    assert(reader.find_checkpoint(info_time_us(130)) == reader.find_checkpoint(info_time_us(1000)));
+
+    reader.close();
+    EventJournalReader not_a_journal;
+    assert(!not_a_journal.open("/nonexistent/journal"));
+    std::remove(path.c_str());
+    std::cout << "test_journal_records PASSED." << std::endl;
+}
+
+void test_replay_matches_live() {
+    std::cout << "Running test_replay_matches_live..." << std::endl;
+    const std::string path = journal_path("replay");
+    TaifexSdk live;
+    record_session(live, path);
+
+    TaifexSdk replayed;
+    replayed.initialize(SdkConfig{});
+    size_t updates = 0;
+    std::vector<NormalizedEvent> events;
+    replayed.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++updates; });
+    replayed.set_event_callback([&](std::span<const NormalizedEvent> batch) {
+        events.insert(events.end(), batch.begin(), batch.end());
+    });
+    assert(replayed.replay_journal(path));
+
+    assert_same_book(live, replayed, "TXFB4");
+    assert_same_book(live, replayed, "MXFB4");
+    assert(replayed.get_product_info("TXFB4"));
+    // Checkpoint image of TXFB4, then the feed: 2 snapshots and 80 updates (the gap only marks stale).
+    assert(updates == 1 + 2 + 80);
+    assert(events.front().flags & NormalizedEvent::FLAG_CHECKPOINT);
+    assert(events.back().type == EventType::SNAPSHOT_LEVEL);
+    assert(events.back().flags & NormalizedEvent::FLAG_END_OF_MESSAGE);
+    assert(events.back().book == replayed.get_book_handle(pad("MXFB4", 20)));
+    assert(events.back().exchange_time_us == info_time_us(163));
+
+    // Starting at the 120 s checkpoint replays only what followed it, to the same books.
+    TaifexSdk seeked;
+    seeked.initialize(SdkConfig{});
+    size_t seeked_updates = 0;
+    seeked.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++seeked_updates; });
+    assert(seeked.replay_journal(path, info_time_us(125)));
+    assert_same_book(live, seeked, "TXFB4");
+    assert_same_book(live, seeked, "MXFB4");
+    assert(seeked_updates < updates / 2);
+
+    assert(!seeked.replay_journal("/nonexistent/journal"));
+    std::remove(path.c_str());
+    std::cout << "test_replay_matches_live PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_journal_records();
+    test_replay_matches_live();
+    std::cout << "All event journal tests completed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+#ifndef TEST_FRAMES_H
+#define TEST_FRAMES_H
+
+#include "sdk/taifex_sdk.h"
+#include "pack_bcd.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Builders for complete TAIFEX frames, shared by the SDK tests. Every field is encoded as
+ *        on the wire; callers pick channels, sequence numbers, times and levels.
+ */
+namespace TestFrames {
+
+inline void append_bcd(std::vector<unsigned char>& out, const std::string& digits) {
+    auto bcd = CoreUtils::asciiToPackBcd(digits);
+    out.insert(out.end(), bcd.begin(), bcd.end());
+}
+
+/** @brief `value` zero-padded to `width` decimal digits. */
+inline std::string digits(uint64_t value, int width) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "%0*llu", width, static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+/** @brief `value` space-padded to `width`, as X(n) fields are. */
+inline std::string pad(const std::string& value, size_t width) {
+    return value + std::string(width - value.size(), ' ');
+}
+
+/** @brief 09:00:00 plus `seconds`, as INFORMATION-TIME microseconds since midnight. */
+inline uint64_t info_time_us(uint64_t seconds) {
+    return (9 * 3600 + seconds) * 1000000ULL;
+}
+
+/**
+ * @brief Wraps a body into a complete frame: ESC, header, body, XOR checksum and CR LF.
+ * @param time_us INFORMATION-TIME in microseconds since midnight.
+ */
+inline std::vector<unsigned char> make_frame(char tc, char mk, uint32_t channel, uint64_t channel_seq,
+                                             const std::vector<unsigned char>& body, uint64_t time_us = 0) {
+    std::vector<unsigned char> frame = {0x1B, static_cast<unsigned char>(tc), static_cast<unsigned char>(mk)};
+    const uint64_t seconds = time_us / 1000000;
+    append_bcd(frame, digits(seconds / 3600, 2) + digits(seconds / 60 % 60, 2) + digits(seconds % 60, 2) +
+                          digits(time_us % 1000000, 6));
+    append_bcd(frame, digits(channel, 4));
+    append_bcd(frame, digits(channel_seq, 10));
+    frame.push_back(0x01); // VERSION-NO
+    append_bcd(frame, digits(body.size(), 4));
+    frame.insert(frame.end(), body.begin(), body.end());
+    unsigned char checksum = 0;
+    for (size_t i = 1; i < frame.size(); ++i) {
+        checksum ^= frame[i];
+    }
+    frame.push_back(checksum);
+    frame.push_back(0x0D);
+    frame.push_back(0x0A);
+    return frame;
+}
+
+/** @brief I001 heartbeat. */
+inline std::vector<unsigned char> make_i001(uint32_t channel, uint64_t channel_seq, uint64_t time_us = 0) {
+    return make_frame('0', '1', channel, channel_seq, {}, time_us);
+}
+
+/** @brief I002 sequence reset. */
+inline std::vector<unsigned char> make_i002(uint32_t channel, uint64_t channel_seq, uint64_t time_us = 0) {
+    return make_frame('0', '2', channel, channel_seq, {}, time_us);
+}
+
+/** @brief I010 body: an index future with DECIMAL-LOCATOR 2, dynamic banding on. */
+inline std::vector<unsigned char> i010_body(const std::string& prod_id_s, uint64_t reference_price = 1750000) {
+    const std::string id = pad(prod_id_s, 10);
+    std::vector<unsigned char> body(id.begin(), id.end());
+    append_bcd(body, digits(reference_price, 10)); // REFERENCE-PRICE
+    body.push_back('I');
+    append_bcd(body, "02");
+    append_bcd(body, "00");
+    append_bcd(body, "20240117");
+    append_bcd(body, "20240221");
+    append_bcd(body, "01");
+    append_bcd(body, "20240221");
+    body.push_back('Y');
+    return body;
+}
+
+/** @brief I010 for `prod_id_s` (see `i010_body`). */
+inline std::vector<unsigned char> make_i010(uint64_t channel_seq, const std::string& prod_id_s, uint32_t channel = 1,
+                                            uint64_t time_us = 0, uint64_t reference_price = 1750000) {
+    return make_frame('1', '1', channel, channel_seq, i010_body(prod_id_s, reference_price), time_us);
+}
+
+/** @brief One I083 entry, or one I081 entry with its MD-UPDATE-ACTION. Prices are positive. */
+struct BookEntry {
+    char type; ///< MD-ENTRY-TYPE: '0' bid, '1' ask, 'E' / 'F' derived.
+    uint64_t price;
+    uint64_t quantity;
+    uint32_t level;
+    char action = '0'; ///< I081 only: '0' new, '1' change, '2' delete, '5' overlay.
+};
+
+/** @brief `depth` bids from `base` down and `depth` asks from `base` + 1 up; level n has n lots. */
+inline std::vector<BookEntry> ladder(uint64_t base, uint32_t depth) {
+    std::vector<BookEntry> entries;
+    for (char type : {'0', '1'}) {
+        for (uint32_t level = 1; level <= depth; ++level) {
+            entries.push_back({type, type == '0' ? base + 1 - level : base + level, level, level});
+        }
+    }
+    return entries;
+}
+
+/** @brief A best bid and a best ask of `quantity` lots each. */
+inline std::vector<BookEntry> top_of_book(uint64_t bid, uint64_t ask, uint64_t quantity) {
+    return {{'0', bid, quantity, 1}, {'1', ask, quantity, 1}};
+}
+
+/** @brief I083 body for `prod_id` with CALCULATED-FLAG '0' and `entries` in order. */
+inline std::vector<unsigned char> i083_body(const std::string& prod_id, uint32_t prod_msg_seq,
+                                            const std::vector<BookEntry>& entries) {
+    const std::string id = pad(prod_id, 20);
+    std::vector<unsigned char> body(id.begin(), id.end());
+    append_bcd(body, digits(prod_msg_seq, 10));
+    body.push_back('0'); // CALCULATED-FLAG
+    append_bcd(body, digits(entries.size(), 2));
+    for (const BookEntry& entry : entries) {
+        body.push_back(static_cast<unsigned char>(entry.type));
+        body.push_back('0'); // Sign
+        append_bcd(body, digits(entry.price, 10));
+        append_bcd(body, digits(entry.quantity, 8));
+        append_bcd(body, digits(entry.level, 2));
+    }
+    return body;
+}
+
+/** @brief I083 (see `i083_body`). */
+inline std::vector<unsigned char> make_i083(uint32_t channel, uint64_t channel_seq, const std::string& prod_id,
+                                            uint32_t prod_msg_seq, const std::vector<BookEntry>& entries,
+                                            uint64_t time_us = 0) {
+    return make_frame('2', 'B', channel, channel_seq, i083_body(prod_id, prod_msg_seq, entries), time_us);
+}
+
+/** @brief I081 body for `prod_id` applying `entries` in order. */
+inline std::vector<unsigned char> i081_body(const std::string& prod_id, uint32_t prod_msg_seq,
+                                            const std::vector<BookEntry>& entries) {
+    const std::string id = pad(prod_id, 20);
+    std::vector<unsigned char> body(id.begin(), id.end());
+    append_bcd(body, digits(prod_msg_seq, 10));
+    append_bcd(body, digits(entries.size(), 2));
+    for (const BookEntry& entry : entries) {
+        body.push_back(static_cast<unsigned char>(entry.action));
+        body.push_back(static_cast<unsigned char>(entry.type));
+        body.push_back('0'); // Sign
+        append_bcd(body, digits(entry.price, 10));
+        append_bcd(body, digits(entry.quantity, 8));
+        append_bcd(body, digits(entry.level, 2));
+    }
+    return body;
+}
+
+/** @brief I081 (see `i081_body`). */
+inline std::vector<unsigned char> make_i081(uint32_t channel, uint64_t channel_seq, const std::string& prod_id,
+                                            uint32_t prod_msg_seq, const std::vector<BookEntry>& entries,
+                                            uint64_t time_us = 0) {
+    return make_frame('2', 'A', channel, channel_seq, i081_body(prod_id, prod_msg_seq, entries), time_us);
+}
+
+inline void feed(Taifex::TaifexSdk& sdk, const std::vector<unsigned char>& frame) {
+    sdk.process_message(frame.data(), frame.size());
+}
+
+} // namespace TestFrames
+
+#endif // TEST_FRAMES_H
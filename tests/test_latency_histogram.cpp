@@ -0,0 +1,113 @@
+#include "latency_histogram.h"
+#include "sdk/taifex_sdk.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using CoreUtils::LatencyHistogram;
+using CoreUtils::LatencyStage;
+using CoreUtils::MessageType;
+using namespace TestFrames;
+
+void test_bucket_mapping() {
+    std::cout << "Running test_bucket_mapping..." << std::endl;
+    for (uint64_t v = 0; v < 32; ++v) {
+        assert(LatencyHistogram::bucket_index(v) == v);
+    }
+    // Every value maps to a bucket whose upper bound is >= the value and within ~6% of it.
+    for (uint64_t v = 32; v < (1ull << 20); v = v * 9 / 8 + 1) {
+        size_t index = LatencyHistogram::bucket_index(v);
+        uint64_t upper = LatencyHistogram::bucket_upper_value(index);
+        assert(upper >= v);
+        assert(upper - v <= v / 16);
+        assert(LatencyHistogram::bucket_index(upper) == index);
+        assert(LatencyHistogram::bucket_index(upper + 1) == index + 1);
+    }
+    assert(LatencyHistogram::bucket_index(~0ull) == LatencyHistogram::BUCKET_COUNT - 1);
+    std::cout << "test_bucket_mapping PASSED." << std::endl;
+}
+
+void test_percentiles() {
+    std::cout << "Running test_percentiles..." << std::endl;
+    LatencyHistogram hist;
+    assert(hist.value_at_percentile(50) == 0);
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        hist.record(v);
+    }
+    assert(hist.count() == 1000);
+    assert(hist.max() == 1000);
+    uint64_t p50 = hist.value_at_percentile(50);
+    uint64_t p99 = hist.value_at_percentile(99);
+    assert(p50 >= 500 && p50 <= 500 + 500 / 16);
+    assert(p99 >= 990 && p99 <= 1000);
+    assert(hist.value_at_percentile(100) == 1000);
+    assert(hist.value_at_percentile(0) == 1);
+
+    hist.reset();
+    assert(hist.count() == 0 && hist.max() == 0);
+    std::cout << "test_percentiles PASSED." << std::endl;
+}
+
+void test_recorder_commits_marked_stages() {
+    std::cout << "Running test_recorder_commits_marked_stages..." << std::endl;
+    CoreUtils::LatencyRecorder recorder;
+    CoreUtils::LatencyProbe probe;
+    assert(recorder.histogram(MessageType::I081_ORDER_BOOK_UPDATE, LatencyStage::TOTAL) == nullptr);
+
+    probe.begin();
+    probe.mark(LatencyStage::VALIDATION);
+    probe.mark(LatencyStage::BODY_PARSE);
+    recorder.commit(MessageType::I081_ORDER_BOOK_UPDATE, probe);
+    probe.mark(LatencyStage::HEADER_DECODE); // Next frame starts timing from the commit.
+    recorder.commit(MessageType::I081_ORDER_BOOK_UPDATE, probe);
+
+    auto count = [&](LatencyStage stage) {
+        return recorder.histogram(MessageType::I081_ORDER_BOOK_UPDATE, stage)->count();
+    };
+    assert(count(LatencyStage::VALIDATION) == 1);
+    assert(count(LatencyStage::BODY_PARSE) == 1);
+    assert(count(LatencyStage::HEADER_DECODE) == 1);
+    assert(count(LatencyStage::BOOK_APPLY) == 0);
+    assert(count(LatencyStage::TOTAL) == 2);
+    assert(recorder.summary(MessageType::I081_ORDER_BOOK_UPDATE, LatencyStage::TOTAL).count == 2);
+
+    recorder.reset();
+    assert(count(LatencyStage::TOTAL) == 0);
+    std::cout << "test_recorder_commits_marked_stages PASSED." << std::endl;
+}
+
+void test_sdk_stage_latencies() {
+    std::cout << "Running test_sdk_stage_latencies..." << std::endl;
+    Taifex::TaifexSdk sdk;
+    sdk.initialize();
+    for (uint64_t seq = 1; seq <= 10; ++seq) {
+        auto frame = make_i001(1, seq);
+        sdk.process_message(frame.data(), frame.size());
+    }
+    auto total = sdk.get_latency_summary(MessageType::I001_HEARTBEAT, LatencyStage::TOTAL);
+    if (Taifex::TaifexSdk::latency_stats_enabled()) {
+        assert(total.count == 10);
+        assert(total.max_ns >= total.p50_ns);
+        assert(sdk.get_latency_summary(MessageType::I001_HEARTBEAT, LatencyStage::VALIDATION).count == 10);
+        assert(sdk.get_latency_summary(MessageType::I001_HEARTBEAT, LatencyStage::DISPATCH).count == 10);
+        assert(sdk.get_latency_summary(MessageType::I001_HEARTBEAT, LatencyStage::BODY_PARSE).count == 0);
+        sdk.reset_latency_stats();
+        assert(sdk.get_latency_summary(MessageType::I001_HEARTBEAT, LatencyStage::TOTAL).count == 0);
+    } else {
+        assert(total.count == 0);
+    }
+    std::cout << "test_sdk_stage_latencies PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_bucket_mapping();
+    test_percentiles();
+    test_recorder_commits_marked_stages();
+    test_sdk_stage_latencies();
+    std::cout << "All LatencyHistogram tests PASSED." << std::endl;
+    return 0;
+}
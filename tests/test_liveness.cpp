@@ -0,0 +1,188 @@
+#include "sdk/taifex_sdk.h"
+#include "normalized_event.h"
+#include "logger.h"
+#include "metrics.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+using namespace Taifex;
+using namespace TestFrames;
+using CoreUtils::NormalizedEvent;
+
+static uint64_t metric(CoreUtils::Metric which) {
+    return CoreUtils::getMetricsSnapshot().get(which);
+}
+
+using Clock = ChannelGapManager::Clock;
+using std::chrono::milliseconds;
+
+// A clock the test moves by hand, as a replay would from INFORMATION-TIME.
+struct VirtualClock {
+    Clock::time_point now{std::chrono::hours(1)};
+    void advance(milliseconds by) { now += by; }
+};
+
+void test_channel_stale_and_resumed() {
+    std::cout << "Running test_channel_stale_and_resumed..." << std::endl;
+    VirtualClock clock;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    sdk.set_time_source([&clock]() { return clock.now; });
+    LivenessConfig config;
+    config.channel_timeout = milliseconds(1000);
+    sdk.monitor_liveness(config);
+    std::vector<LivenessEvent> events;
+    sdk.set_liveness_callback([&](const LivenessEvent& event) { events.push_back(event); });
+    const uint64_t stale_before = metric(CoreUtils::Metric::STALE_CHANNELS);
+
+    feed(sdk, make_i001(5, 1));
+    assert(sdk.get_channel_last_message_time(5) == clock.now);
+    // Heartbeats every 600 ms keep the channel alive well past one timeout.
+    for (uint64_t seq = 2; seq <= 6; ++seq) {
+        clock.advance(milliseconds(600));
+        sdk.poll_timers();
+        feed(sdk, make_i001(5, seq));
+    }
+    assert(events.empty() && !sdk.is_channel_stale(5));
+
+    const Clock::time_point last = clock.now;
+    clock.advance(milliseconds(999));
+    sdk.poll_timers();
+    assert(events.empty());
+    clock.advance(milliseconds(1));
+    sdk.poll_timers();
+    assert(events.size() == 1);
+    assert(events[0].type == LivenessEventType::CHANNEL_STALE && events[0].channel_id == 5);
+    assert(events[0].last_message == last);
+    assert(sdk.is_channel_stale(5));
+    assert(metric(CoreUtils::Metric::STALE_CHANNELS) == stale_before + 1);
+
+    // Reported once, however long it stays quiet; a jump of hours is one poll.
+    clock.advance(milliseconds(3 * 3600 * 1000));
+    sdk.poll_timers();
+    assert(events.size() == 1);
+
+    feed(sdk, make_i001(5, 7));
+    assert(events.size() == 2 && events[1].type == LivenessEventType::CHANNEL_RESUMED);
+    assert(!sdk.is_channel_stale(5));
+    clock.advance(milliseconds(1000));
+    sdk.poll_timers();
+    assert(events.size() == 3 && events[2].type == LivenessEventType::CHANNEL_STALE);
+
+    std::cout << "test_channel_stale_and_resumed PASSED." << std::endl;
+}
+
+void test_product_stale() {
+    std::cout << "Running test_product_stale..." << std::endl;
+    VirtualClock clock;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    sdk.set_time_source([&clock]() { return clock.now; });
+    feed(sdk, make_i010(1, "TXFB4", 9));
+    feed(sdk, make_i010(2, "MXFB4", 9));
+    feed(sdk, make_i083(3, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1))); // Before monitoring: still covered.
+    LivenessConfig config;
+    config.product_timeout = milliseconds(500);
+    sdk.monitor_liveness(config);
+    std::vector<LivenessEvent> events;
+    sdk.set_liveness_callback([&](const LivenessEvent& event) { events.push_back(event); });
+
+    feed(sdk, make_i083(3, 2, "MXFB4", 1, top_of_book(1760000, 1760001, 1)));
+    // Only MXFB4 keeps updating.
+    for (uint32_t i = 0; i < 4; ++i) {
+        clock.advance(milliseconds(300));
+        feed(sdk, make_i083(3, 3 + i, "MXFB4", 2 + i, top_of_book(1760000, 1760001, 1)));
+    }
+    const BookHandle txf = sdk.get_book_handle(std::string("TXFB4") + std::string(15, ' '));
+    assert(txf != INVALID_BOOK_HANDLE);
+    assert(events.size() == 1);
+    assert(events[0].type == LivenessEventType::PRODUCT_STALE && events[0].book == txf && events[0].channel_id == 3);
+
+    feed(sdk, make_i083(3, 7, "TXFB4", 2, top_of_book(1750000, 1750001, 1)));
+    assert(events.size() == 2 && events[1].type == LivenessEventType::PRODUCT_RESUMED && events[1].book == txf);
+    std::cout << "test_product_stale PASSED." << std::endl;
+}
+
+struct RecordedRequest {
+    uint32_t channel_id;
+    uint64_t begin_seq;
+    uint16_t count;
+};
+
+void test_gap_timeout_on_quiet_channel() {
+    std::cout << "Running test_gap_timeout_on_quiet_channel..." << std::endl;
+    VirtualClock clock;
+    SdkConfig sdk_config;
+    sdk_config.gap_recovery.gap_timeout = milliseconds(200);
+    TaifexSdk sdk;
+    sdk.initialize(sdk_config);
+    sdk.set_time_source([&clock]() { return clock.now; });
+    std::vector<RecordedRequest> requests;
+    sdk.set_retransmission_requester([&](uint32_t ch, uint64_t seq, uint16_t count) {
+        requests.push_back({ch, seq, count});
+    });
+
+    feed(sdk, make_i001(7, 10));
+    feed(sdk, make_i001(7, 13)); // 11-12 missing; 13 held.
+    assert(requests.size() == 1 && requests[0].begin_seq == 11 && requests[0].count == 2);
+    const CoreUtils::ChannelState& state = *sdk.channel_states().find(7);
+    clock.advance(milliseconds(199));
+    sdk.poll_timers();
+    assert(state.gaps_abandoned.load() == 0);
+    clock.advance(milliseconds(1));
+    sdk.poll_timers(); // No frame arrives: the timer alone skips the gap.
+    assert(state.gaps_abandoned.load() == 1);
+    assert(state.expected_seq == 14);
+    std::cout << "test_gap_timeout_on_quiet_channel PASSED." << std::endl;
+}
+
+void test_retransmission_retries() {
+    std::cout << "Running test_retransmission_retries..." << std::endl;
+    VirtualClock clock;
+    SdkConfig sdk_config;
+    sdk_config.gap_recovery.gap_timeout = milliseconds(1000);
+    sdk_config.gap_recovery.retransmission_timeout = milliseconds(300);
+    TaifexSdk sdk;
+    sdk.initialize(sdk_config);
+    sdk.set_time_source([&clock]() { return clock.now; });
+    std::vector<RecordedRequest> requests;
+    sdk.set_retransmission_requester([&](uint32_t ch, uint64_t seq, uint16_t count) {
+        requests.push_back({ch, seq, count});
+    });
+    const uint64_t retries_before = metric(CoreUtils::Metric::RETRANSMISSION_RETRIES);
+
+    feed(sdk, make_i001(8, 1));
+    feed(sdk, make_i001(8, 5));  // 2-4 missing.
+    feed(sdk, make_i001(8, 3));  // Retransmitted: 2 and 4 still missing.
+    assert(requests.size() == 1 && requests[0].begin_seq == 2 && requests[0].count == 3);
+
+    clock.advance(milliseconds(300));
+    sdk.poll_timers();
+    assert(requests.size() == 3);
+    assert(requests[1].begin_seq == 2 && requests[1].count == 1);
+    assert(requests[2].begin_seq == 4 && requests[2].count == 1);
+    assert(metric(CoreUtils::Metric::RETRANSMISSION_RETRIES) == retries_before + 2);
+
+    feed(sdk, make_i001(8, 2));
+    feed(sdk, make_i001(8, 4)); // Gap closed: no more retries.
+    assert(sdk.channel_states().find(8)->expected_seq == 6);
+    clock.advance(milliseconds(2000));
+    sdk.poll_timers();
+    assert(requests.size() == 3);
+    assert(sdk.channel_states().find(8)->gaps_abandoned.load() == 0);
+    std::cout << "test_retransmission_retries PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_channel_stale_and_resumed();
+    test_product_stale();
+    test_gap_timeout_on_quiet_channel();
+    test_retransmission_retries();
+    std::cout << "All liveness tests completed." << std::endl;
+    return 0;
+}
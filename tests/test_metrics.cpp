@@ -0,0 +1,87 @@
+#include "metrics.h"
+#include "sdk/taifex_sdk.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <vector>
+#include <string>
+
+using CoreUtils::Metric;
+using CoreUtils::MessageType;
+using namespace TestFrames;
+
+void test_message_type_slots() {
+    std::cout << "Running test_message_type_slots..." << std::endl;
+    assert(CoreUtils::messageTypeSlot(MessageType::UNKNOWN) == 0);
+    assert(CoreUtils::messageTypeSlot(MessageType::I001_HEARTBEAT) == 1);
+    assert(CoreUtils::messageTypeSlot(MessageType::I140_SYSTEM_MESSAGE) == CoreUtils::MESSAGE_TYPE_SLOTS - 1);
+    assert(CoreUtils::messageTypeSlot(static_cast<MessageType>(1141)) == 0);
+    assert(std::string(CoreUtils::metricName(Metric::CHECKSUM_FAILURES)) == "checksum_failures");
+    std::cout << "test_message_type_slots PASSED." << std::endl;
+}
+
+void test_aggregates_across_threads() {
+    std::cout << "Running test_aggregates_across_threads..." << std::endl;
+    CoreUtils::resetMetrics();
+    constexpr int THREADS = 4;
+    constexpr int INCREMENTS = 10000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([] {
+            for (int i = 0; i < INCREMENTS; ++i) {
+                CoreUtils::incrementMetric(Metric::MULTICAST_PACKETS_RECEIVED);
+                CoreUtils::incrementMetric(Metric::MULTICAST_BYTES_RECEIVED, 100);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    // Exited threads' counts are kept.
+    CoreUtils::MetricsSnapshot snapshot = CoreUtils::getMetricsSnapshot();
+    assert(snapshot.get(Metric::MULTICAST_PACKETS_RECEIVED) == THREADS * INCREMENTS);
+    assert(snapshot.get(Metric::MULTICAST_BYTES_RECEIVED) == 100ull * THREADS * INCREMENTS);
+
+    CoreUtils::resetMetrics();
+    assert(CoreUtils::getMetricsSnapshot().get(Metric::MULTICAST_PACKETS_RECEIVED) == 0);
+    std::cout << "test_aggregates_across_threads PASSED." << std::endl;
+}
+
+void test_sdk_counts() {
+    std::cout << "Running test_sdk_counts..." << std::endl;
+    CoreUtils::resetMetrics();
+    Taifex::TaifexSdk sdk;
+    sdk.initialize();
+
+    auto first = make_i001(1, 1);
+    sdk.process_message(first.data(), first.size());
+    sdk.process_message(first.data(), first.size()); // Duplicate CHANNEL-SEQ
+    auto gap = make_i001(1, 3);
+    sdk.process_message(gap.data(), gap.size());     // Held behind seq 2
+    auto corrupt = make_i001(1, 2);
+    corrupt[corrupt.size() - 3] ^= 0xFF;
+    sdk.process_message(corrupt.data(), corrupt.size());
+    sdk.process_message(corrupt.data(), corrupt.size() - 1); // Truncated
+
+    CoreUtils::MetricsSnapshot snapshot = sdk.get_metrics();
+    assert(snapshot.messages(MessageType::I001_HEARTBEAT) == 1);
+    assert(snapshot.total_messages() == 1);
+    assert(snapshot.get(Metric::BYTES_PROCESSED) == first.size());
+    assert(snapshot.get(Metric::SEQUENCE_DUPLICATES) == 1);
+    assert(snapshot.get(Metric::SEQUENCE_GAPS) == 1);
+    assert(snapshot.get(Metric::CHECKSUM_FAILURES) == 1);
+    assert(snapshot.get(Metric::LENGTH_MISMATCHES) == 1);
+    std::cout << "test_sdk_counts PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_message_type_slots();
+    test_aggregates_across_threads();
+    test_sdk_counts();
+    std::cout << "All Metrics tests PASSED." << std::endl;
+    return 0;
+}
@@ -1,10 +1,13 @@
 #include "order_book/order_book.h"
 #include "messages/message_i083.h" // For SpecificMessageParsers::MessageI083
 #include "messages/message_i010.h" // For SpecificMessageParsers::MessageI010 (though only decimal_locator used for OB constructor)
+#include "messages/message_events.h" // For decode_i081_events / decode_i083_events
 #include <iostream>
 #include <cassert>
 #include <vector>
 #include <optional> // For checking derived quotes
+#include <algorithm> // For std::copy
+#include <span>
 
 // Using namespaces for brevity in test functions
 using namespace OrderBookManagement;
@@ -17,6 +20,9 @@ void test_apply_update_delete();
 void test_apply_update_overlay_derived();
 void test_apply_update_sequential();
 void test_apply_update_sequence_number();
+void test_apply_update_gap_marks_stale();
+void test_decoded_events_apply();
+void test_max_depth_drops_deeper_levels();
 
 // Helper to create a MessageI010 with a specific decimal locator for tests
 // Not strictly needed if OrderBook constructor takes decimal_locator directly
@@ -197,6 +203,9 @@ int main() {
     test_apply_update_overlay_derived();
     test_apply_update_sequential();
     test_apply_update_sequence_number();
+    test_apply_update_gap_marks_stale();
+    test_decoded_events_apply();
+    test_max_depth_drops_deeper_levels();
 
     std::cout << "All OrderBook tests completed." << std::endl;
     return 0;
@@ -383,3 +392,176 @@ void test_apply_update_sequence_number() {
 
     std::cout << "test_apply_update_sequence_number PASSED." << std::endl;
 }
+
+void test_apply_update_gap_marks_stale() {
+    std::cout << "Running test_apply_update_gap_marks_stale..." << std::endl;
+    OrderBook ob("GAPPROD", 2);
+
+    MessageI083 snapshot;
+    snapshot.prod_id = "GAPPROD";
+    snapshot.prod_msg_seq = 5;
+    snapshot.calculated_flag = '0';
+    snapshot.no_md_entries = 1;
+    snapshot.md_entries.push_back({'0', '0', 10000, 10, 1});
+    assert(ob.apply_snapshot(snapshot));
+
+    MessageI081 next;
+    next.prod_id = "GAPPROD";
+    next.prod_msg_seq = 6;
+    next.no_md_entries = 1;
+    next.md_entries.push_back({'0', '1', '0', 10100, 5, 1}); // New Ask
+    assert(ob.apply_update(next) == UpdateResult::APPLIED);
+    assert(!ob.is_stale());
+
+    MessageI081 skipped;
+    skipped.prod_id = "GAPPROD";
+    skipped.prod_msg_seq = 8; // 7 was lost
+    skipped.no_md_entries = 1;
+    skipped.md_entries.push_back({'1', '0', '0', 10000, 20, 1}); // Change Bid
+    assert(ob.apply_update(skipped) == UpdateResult::GAP_DETECTED);
+    assert(ob.is_stale());
+    assert(ob.get_last_prod_msg_seq() == 6);
+    assert(ob.get_top_bids(1)[0].quantity == 10); // Update not applied
+
+    MessageI081 after_gap = skipped;
+    after_gap.prod_msg_seq = 9;
+    assert(ob.apply_update(after_gap) == UpdateResult::IGNORED_STALE);
+
+    // An outdated snapshot is ignored by an in-sync book but accepted by a stale one.
+    snapshot.prod_msg_seq = 9;
+    snapshot.md_entries[0].md_entry_size = 20;
+    assert(ob.apply_snapshot(snapshot));
+    assert(!ob.is_stale());
+    assert(ob.get_last_prod_msg_seq() == 9);
+    assert(ob.get_top_bids(1)[0].quantity == 20);
+    snapshot.prod_msg_seq = 8;
+    assert(!ob.apply_snapshot(snapshot));
+    assert(ob.get_last_prod_msg_seq() == 9);
+
+    MessageI081 resumed = next;
+    resumed.prod_msg_seq = 10;
+    assert(ob.apply_update(resumed) == UpdateResult::APPLIED);
+    assert(ob.apply_update(resumed) == UpdateResult::DUPLICATE);
+
+    std::cout << "test_apply_update_gap_marks_stale PASSED." << std::endl;
+}
+
+// --- Normalized events decoded straight from I081/I083 bodies ---
+
+void test_decoded_events_apply() {
+    std::cout << "Running test_decoded_events_apply..." << std::endl;
+    CoreUtils::NormalizedEvent stamp{};
+    stamp.channel_seq = 42;
+    stamp.channel_id = 7;
+    CoreUtils::NormalizedEvent events[MAX_BOOK_MESSAGE_EVENTS];
+    BookMessageEvents decoded;
+
+    // I083, CALCULATED-FLAG 0, PROD-MSG-SEQ 5: bid 10000x10, ask -250x3, derived bid 9990x1.
+    const unsigned char snapshot_body[] = {
+        'E', 'V', 'T', 'P', 'R', 'O', 'D', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
+        0x00, 0x00, 0x00, 0x00, 0x05, '0', 0x03,
+        '0', '0', 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x01,
+        '1', '-', 0x00, 0x00, 0x00, 0x02, 0x50, 0x00, 0x00, 0x00, 0x03, 0x01,
+        'E', '0', 0x00, 0x00, 0x00, 0x99, 0x90, 0x00, 0x00, 0x00, 0x01, 0x01,
+    };
+    assert(decode_i083_events(snapshot_body, sizeof(snapshot_body), stamp, events, decoded));
+    assert(decoded.prod_id == "EVTPROD             ");
+    assert(decoded.prod_msg_seq == 5);
+    assert(decoded.event_count == 4);
+    assert(events[0].type == CoreUtils::EventType::BOOK_CLEAR);
+    assert(events[1].type == CoreUtils::EventType::SNAPSHOT_LEVEL);
+    assert(events[1].side == CoreUtils::EventSide::BID && events[1].price == 10000 && events[1].quantity == 10);
+    assert(events[2].side == CoreUtils::EventSide::ASK && events[2].price == -250 && events[2].level == 1);
+    assert(events[3].channel_seq == 42 && events[3].channel_id == 7 && events[3].prod_msg_seq == 5);
+    assert((events[3].flags & CoreUtils::NormalizedEvent::FLAG_CALCULATED) == 0);
+
+    OrderBook ob("EVTPROD", 2);
+    assert(ob.apply_snapshot(decoded.prod_msg_seq, std::span(events, decoded.event_count)));
+    assert(ob.get_top_bids(1)[0].price == 10000);
+    assert(ob.get_top_asks(1)[0].price == -250);
+    assert(ob.get_derived_bid() && ob.get_derived_bid()->price == 9990);
+
+    // I081, PROD-MSG-SEQ 6: change bid to 20, an unknown action (skipped), delete the ask.
+    const unsigned char update_body[] = {
+        'E', 'V', 'T', 'P', 'R', 'O', 'D', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
+        0x00, 0x00, 0x00, 0x00, 0x06, 0x03,
+        '1', '0', '0', 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x01,
+        '9', '0', '0', 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x01,
+        '2', '1', '-', 0x00, 0x00, 0x00, 0x02, 0x50, 0x00, 0x00, 0x00, 0x00, 0x01,
+    };
+    assert(decode_i081_events(update_body, sizeof(update_body), stamp, events, decoded));
+    assert(decoded.prod_msg_seq == 6 && decoded.event_count == 2);
+    assert(events[0].type == CoreUtils::EventType::LEVEL_CHANGE && events[0].quantity == 20);
+    assert(events[1].type == CoreUtils::EventType::LEVEL_DELETE && events[1].side == CoreUtils::EventSide::ASK);
+
+    // The same update through MessageI081 must leave an identical book.
+    OrderBook reference("EVTPROD", 2);
+    MessageI083 snapshot_msg;
+    assert(parse_i083_body(snapshot_body, sizeof(snapshot_body), snapshot_msg));
+    assert(reference.apply_snapshot(snapshot_msg));
+    MessageI081 update_msg;
+    assert(parse_i081_body(update_body, sizeof(update_body), update_msg));
+    assert(reference.apply_update(update_msg) == UpdateResult::APPLIED);
+
+    assert(ob.apply_update(decoded.prod_msg_seq, std::span(events, decoded.event_count)) == UpdateResult::APPLIED);
+    assert(ob.get_top_bids(5).size() == reference.get_top_bids(5).size());
+    assert(ob.get_top_bids(1)[0].quantity == 20 && reference.get_top_bids(1)[0].quantity == 20);
+    assert(ob.get_top_asks(5).empty() && reference.get_top_asks(5).empty());
+    assert(ob.apply_update(decoded.prod_msg_seq, std::span(events, decoded.event_count)) == UpdateResult::DUPLICATE);
+
+    // A trial-matching snapshot flags every event and drops derived quotes.
+    unsigned char calculated_body[sizeof(snapshot_body)];
+    std::copy(std::begin(snapshot_body), std::end(snapshot_body), calculated_body);
+    calculated_body[24] = 0x07;
+    calculated_body[25] = '1';
+    assert(decode_i083_events(calculated_body, sizeof(calculated_body), stamp, events, decoded));
+    for (size_t i = 0; i < decoded.event_count; ++i) {
+        assert(events[i].flags & CoreUtils::NormalizedEvent::FLAG_CALCULATED);
+    }
+    assert(ob.apply_snapshot(decoded.prod_msg_seq, std::span(events, decoded.event_count)));
+    assert(!ob.get_derived_bid());
+
+    // Truncated entries, a non-BCD digit or too small an output fail.
+    assert(!decode_i081_events(update_body, sizeof(update_body) - 1, stamp, events, decoded));
+    assert(!decode_i083_events(snapshot_body, sizeof(snapshot_body), stamp, std::span(events, 3), decoded));
+    unsigned char bad_body[sizeof(update_body)];
+    std::copy(std::begin(update_body), std::end(update_body), bad_body);
+    bad_body[29] = 0x0A;
+    assert(!decode_i081_events(bad_body, sizeof(bad_body), stamp, events, decoded));
+
+    std::cout << "test_decoded_events_apply PASSED." << std::endl;
+}
+
+void test_max_depth_drops_deeper_levels() {
+    std::cout << "Running test_max_depth_drops_deeper_levels..." << std::endl;
+    OrderBook ob("DEPTHPROD", 2, std::pmr::get_default_resource(), 3);
+    MessageI083 snapshot;
+    snapshot.prod_msg_seq = 1;
+    for (int64_t level = 1; level <= 5; ++level) {
+        snapshot.md_entries.push_back({'0', '0', 10000 - level, 1, static_cast<uint8_t>(level)});
+        snapshot.md_entries.push_back({'1', '0', 10000 + level, 1, static_cast<uint8_t>(level)});
+    }
+    assert(ob.apply_snapshot(snapshot));
+    assert(ob.get_top_bids(10).size() == 3 && ob.get_top_asks(10).size() == 3);
+    assert(ob.get_top_bids(10)[2].price == 9997 && ob.get_top_asks(10)[2].price == 10003);
+
+    // New best prices push levels out of the view; no delete comes for them.
+    for (uint32_t seq = 2; seq < 100; ++seq) {
+        MessageI081 msg;
+        msg.prod_msg_seq = seq;
+        msg.md_entries.push_back({'0', '0', '0', 10000 + seq, 1, 1});
+        assert(ob.apply_update(msg) == UpdateResult::APPLIED);
+    }
+    auto bids = ob.get_top_bids(10);
+    assert(bids.size() == 3 && bids[0].price == 10099 && bids[2].price == 10097);
+
+    // The best level leaves and the exchange brings the next one into view with a New at the bottom.
+    MessageI081 msg;
+    msg.prod_msg_seq = 100;
+    msg.md_entries.push_back({'2', '0', '0', 10099, 1, 1});
+    msg.md_entries.push_back({'0', '0', '0', 10096, 1, 3});
+    assert(ob.apply_update(msg) == UpdateResult::APPLIED);
+    bids = ob.get_top_bids(10);
+    assert(bids.size() == 3 && bids[0].price == 10098 && bids[2].price == 10096);
+    std::cout << "test_max_depth_drops_deeper_levels PASSED." << std::endl;
+}
@@ -0,0 +1,101 @@
+#include "sdk/pending_frame_buffer.h"
+#include "sdk/taifex_sdk.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static const std::string PROD_ID = "TXFB4               "; // X(20)
+
+void test_buffer_bounds() {
+    std::cout << "Running test_buffer_bounds..." << std::endl;
+    PendingFrameConfig config;
+    config.max_frames_per_product = 2;
+    config.max_products = 1;
+    PendingFrameBuffer buffer(config);
+    const unsigned char a[] = {1}, b[] = {2}, c[] = {3}, s[] = {4};
+
+    assert(buffer.push("TXFB4", 1, false, a, 1));
+    assert(buffer.push("TXFB4", 1, false, b, 1));
+    assert(buffer.push("TXFB4", 1, false, c, 1)); // Oldest dropped.
+    assert(buffer.frame_count() == 2 && buffer.dropped_count() == 1);
+    assert(!buffer.push("MXFB4", 1, false, a, 1)); // Product bound.
+    assert(buffer.dropped_count() == 2 && !buffer.has_pending("MXFB4"));
+
+    auto frames = buffer.take("TXFB4");
+    assert(frames.size() == 2 && frames[0][0] == 2 && frames[1][0] == 3);
+    assert(buffer.empty() && buffer.frame_count() == 0);
+
+    // A snapshot supersedes what was held before it.
+    assert(buffer.push("TXFB4", 1, false, a, 1));
+    assert(buffer.push("TXFB4", 1, true, s, 1));
+    assert(buffer.push("TXFB4", 1, false, b, 1));
+    frames = buffer.take("TXFB4");
+    assert(frames.size() == 2 && frames[0][0] == 4 && frames[1][0] == 2);
+    assert(buffer.dropped_count() == 2);
+    std::cout << "test_buffer_bounds PASSED." << std::endl;
+}
+
+void test_clear_channel() {
+    std::cout << "Running test_clear_channel..." << std::endl;
+    PendingFrameBuffer buffer;
+    const unsigned char a[] = {1}, b[] = {2}, c[] = {3};
+    assert(buffer.push("TXFB4", 1, false, a, 1));
+    assert(buffer.push("TXFB4", 2, false, b, 1));
+    assert(buffer.push("MXFB4", 2, false, c, 1));
+    buffer.clear_channel(2);
+    assert(buffer.frame_count() == 1 && buffer.product_count() == 1);
+    assert(!buffer.has_pending("MXFB4"));
+    auto frames = buffer.take("TXFB4");
+    assert(frames.size() == 1 && frames[0][0] == 1);
+    std::cout << "test_clear_channel PASSED." << std::endl;
+}
+
+void test_replay_on_i010() {
+    std::cout << "Running test_replay_on_i010..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize();
+    const auto before = sdk.get_metrics();
+
+    auto i081_early = make_i081(1, 1, PROD_ID, 1, {{'0', 1749000, 5, 1}}); // Superseded by the I083 below.
+    auto i083 = make_i083(1, 2, PROD_ID, 5, {{'0', 1750000, 3, 1}});
+    auto i081 = make_i081(1, 3, PROD_ID, 6, {{'0', 1750100, 5, 1}});
+    sdk.process_message(i081_early.data(), i081_early.size());
+    sdk.process_message(i083.data(), i083.size());
+    sdk.process_message(i081.data(), i081.size());
+    assert(!sdk.get_order_book(PROD_ID));
+    assert(sdk.get_pending_frame_count() == 2);
+
+    int updates = 0;
+    sdk.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++updates; });
+    auto i010 = make_i010(4, "TXFB4");
+    sdk.process_message(i010.data(), i010.size());
+
+    auto book = sdk.get_order_book(PROD_ID);
+    assert(book);
+    assert(book->get().get_last_prod_msg_seq() == 6 && !book->get().is_stale());
+    auto bids = book->get().get_top_bids(2);
+    assert(bids.size() == 2 && bids[0].price == 1750100 && bids[1].price == 1750000);
+    assert(updates == 2);
+    assert(sdk.get_pending_frame_count() == 0);
+
+    const auto after = sdk.get_metrics();
+    assert(after.get(CoreUtils::Metric::PENDING_FRAMES_QUEUED) - before.get(CoreUtils::Metric::PENDING_FRAMES_QUEUED) == 3);
+    assert(after.get(CoreUtils::Metric::PENDING_FRAMES_REPLAYED) - before.get(CoreUtils::Metric::PENDING_FRAMES_REPLAYED) == 2);
+    std::cout << "test_replay_on_i010 PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_buffer_bounds();
+    test_clear_channel();
+    test_replay_on_i010();
+    std::cout << "All PendingFrameBuffer tests PASSED." << std::endl;
+    return 0;
+}
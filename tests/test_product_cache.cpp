@@ -0,0 +1,76 @@
+#include "sdk/product_cache.h"
+#include "sdk/taifex_sdk.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static const std::string PROD_ID = "TXFB4               "; // X(20)
+
+static SdkConfig make_config(const std::string& path, uint32_t trading_date) {
+    SdkConfig config;
+    config.product_cache.path = path;
+    config.product_cache.trading_date = trading_date;
+    return config;
+}
+
+void test_cold_start_from_cache() {
+    std::cout << "Running test_cold_start_from_cache..." << std::endl;
+    const std::string path = "/tmp/taifex_product_cache_test_" + std::to_string(getpid()) + ".bin";
+    std::remove(path.c_str());
+
+    {
+        TaifexSdk sdk;
+        sdk.initialize(make_config(path, 20240117));
+        auto i010 = make_i010(1, "TXFB4");
+        sdk.process_message(i010.data(), i010.size());
+    } // Saved on shutdown.
+
+    {
+        // Next trading day: the first I083 builds the book without waiting for I010.
+        TaifexSdk sdk;
+        SdkConfig config = make_config(path, 20240118);
+        config.product_cache.save_on_shutdown = false;
+        sdk.initialize(config);
+        auto info = sdk.get_product_info("TXFB4");
+        assert(info && info->decimal_locator == 2 && info->reference_price == 1750000);
+        auto i083 = make_i083(1, 1, PROD_ID, 1, {{'0', 1750000, 3, 1}});
+        sdk.process_message(i083.data(), i083.size());
+        auto book = sdk.get_order_book(PROD_ID);
+        assert(book && book->get().get_top_bids(1).size() == 1);
+    }
+
+    std::vector<ProductInfo> loaded;
+    assert(load_product_cache(path, 20240124, 7, loaded) && loaded.size() == 1);
+    assert(!load_product_cache(path, 20240125, 7, loaded));  // Older than max_age_days
+    assert(!load_product_cache(path, 20240116, 7, loaded));  // Saved for a later date
+    assert(load_product_cache(path, 20240222, 60, loaded));  // Accepted, but TXFB4 has expired
+    assert(loaded.empty());
+    assert(!load_product_cache(path + ".missing", 20240118, 7, loaded));
+
+    // A truncated file is rejected.
+    {
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        assert(file);
+        assert(ftruncate(fileno(file), 40) == 0);
+        std::fclose(file);
+    }
+    assert(!load_product_cache(path, 20240118, 7, loaded));
+
+    std::remove(path.c_str());
+    std::cout << "test_cold_start_from_cache PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_cold_start_from_cache();
+    std::cout << "All ProductCache tests PASSED." << std::endl;
+    return 0;
+}
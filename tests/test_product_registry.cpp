@@ -0,0 +1,157 @@
+#include "sdk/product_registry.h"
+#include "sdk/taifex_sdk.h"
+#include "messages/message_i010.h"
+#include "pack_bcd.h"
+#include "logger.h"
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+using namespace Taifex;
+using SpecificMessageParsers::MessageI010;
+
+static MessageI010 make_i010(const std::string& prod_id_s, uint8_t decimal_locator) {
+    MessageI010 msg;
+    msg.prod_id_s = prod_id_s;
+    msg.reference_price = 1750000;
+    msg.prod_kind = 'I';
+    msg.decimal_locator = decimal_locator;
+    msg.strike_price_decimal_locator = 0;
+    msg.begin_date = "20240117";
+    msg.end_date = "20240221";
+    msg.flow_group = 1;
+    msg.delivery_date = "20240221";
+    msg.dynamic_banding = 'Y';
+    return msg;
+}
+
+void test_product_info_from_message() {
+    std::cout << "Running test_product_info_from_message..." << std::endl;
+    ProductInfo info;
+    assert(ProductInfo::from_message(make_i010("TXFB4     ", 2), info));
+    assert(info.id() == "TXFB4");
+    assert(info.prod_kind == 'I');
+    assert(info.decimal_locator == 2);
+    assert(info.reference_price == 1750000);
+    assert(info.begin_date == 20240117);
+    assert(info.delivery_date == 20240221);
+    assert(info.has_dynamic_banding());
+
+    MessageI010 bad = make_i010("TXFB4     ", 2);
+    bad.end_date = "2024022X";
+    assert(!ProductInfo::from_message(bad, info));
+    std::cout << "test_product_info_from_message PASSED." << std::endl;
+}
+
+void test_registry_upsert_and_find() {
+    std::cout << "Running test_registry_upsert_and_find..." << std::endl;
+    ProductRegistry registry;
+    ProductInfo txf, mxf;
+    assert(ProductInfo::from_message(make_i010("TXFB4     ", 2), txf));
+    assert(ProductInfo::from_message(make_i010("MXFB4     ", 2), mxf));
+
+    bool changed = false;
+    ProductHandle h_txf = registry.upsert(txf, changed);
+    assert(changed && h_txf == 0);
+    ProductHandle h_mxf = registry.upsert(mxf, changed);
+    assert(changed && h_mxf == 1);
+
+    // Repeated identical I010: same handle, no change.
+    assert(registry.upsert(txf, changed) == h_txf);
+    assert(!changed);
+
+    ProductInfo txf_updated = txf;
+    txf_updated.reference_price = 1760000;
+    assert(registry.upsert(txf_updated, changed) == h_txf);
+    assert(changed);
+    assert(registry.get(h_txf)->reference_price == 1760000);
+
+    assert(registry.find("TXFB4") == h_txf);
+    assert(registry.find("TXFB4     ") == h_txf);
+    assert(registry.find("TXO") == INVALID_PRODUCT_HANDLE);
+    assert(registry.get(INVALID_PRODUCT_HANDLE) == nullptr);
+    assert(registry.size() == 2);
+    std::cout << "test_registry_upsert_and_find PASSED." << std::endl;
+}
+
+// Builds a complete I010 frame (TC '1', MK '1') on channel 1 with the given CHANNEL-SEQ.
+static std::vector<unsigned char> make_i010_frame(uint64_t channel_seq, const std::string& prod_id_s,
+                                                  const std::string& reference_price_digits) {
+    std::vector<unsigned char> body(prod_id_s.begin(), prod_id_s.end());
+    body.resize(ProductInfo::PROD_ID_S_LENGTH, ' ');
+    auto append_bcd = [&body](const std::string& digits) {
+        auto bcd = CoreUtils::asciiToPackBcd(digits);
+        body.insert(body.end(), bcd.begin(), bcd.end());
+    };
+    append_bcd(reference_price_digits); // REFERENCE-PRICE 9(9), 10 digits incl. leading pad
+    body.push_back('I');                // PROD-KIND
+    append_bcd("02");                   // DECIMAL-LOCATOR
+    append_bcd("00");                   // STRIKE-PRICE-DECIMAL-LOCATOR
+    append_bcd("20240117");             // BEGIN-DATE
+    append_bcd("20240221");             // END-DATE
+    append_bcd("01");                   // FLOW-GROUP
+    append_bcd("20240221");             // DELIVERY-DATE
+    body.push_back('Y');                // DYNAMIC-BANDING
+
+    char seq_digits[11];
+    std::snprintf(seq_digits, sizeof(seq_digits), "%010llu", static_cast<unsigned long long>(channel_seq));
+    char length_digits[5];
+    std::snprintf(length_digits, sizeof(length_digits), "%04zu", body.size());
+
+    std::vector<unsigned char> frame = {0x1B, '1', '1', 0, 0, 0, 0, 0, 0, 0x00, 0x01};
+    auto seq_bcd = CoreUtils::asciiToPackBcd(seq_digits);
+    frame.insert(frame.end(), seq_bcd.begin(), seq_bcd.end());
+    frame.push_back(0x01); // VERSION-NO
+    auto len_bcd = CoreUtils::asciiToPackBcd(length_digits);
+    frame.insert(frame.end(), len_bcd.begin(), len_bcd.end());
+    frame.insert(frame.end(), body.begin(), body.end());
+    unsigned char checksum = 0;
+    for (size_t i = 1; i < frame.size(); ++i) {
+        checksum ^= frame[i];
+    }
+    frame.push_back(checksum);
+    frame.push_back(0x0D);
+    frame.push_back(0x0A);
+    return frame;
+}
+
+void test_sdk_skips_unchanged_i010() {
+    std::cout << "Running test_sdk_skips_unchanged_i010..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize();
+    int notifications = 0;
+    sdk.set_product_info_callback([&](ProductHandle, const ProductInfo& info) {
+        ++notifications;
+        assert(info.id() == "TXFB4");
+    });
+
+    auto first = make_i010_frame(1, "TXFB4", "0001750000");
+    sdk.process_message(first.data(), first.size());
+    assert(notifications == 1);
+    auto info = sdk.get_product_info("TXFB4");
+    assert(info && info->reference_price == 1750000 && info->decimal_locator == 2);
+
+    auto repeat = make_i010_frame(2, "TXFB4", "0001750000");
+    sdk.process_message(repeat.data(), repeat.size());
+    assert(notifications == 1);
+    assert(sdk.get_unchanged_i010_skipped_count() == 1);
+
+    auto changed = make_i010_frame(3, "TXFB4", "0001760000");
+    sdk.process_message(changed.data(), changed.size());
+    assert(notifications == 2);
+    assert(sdk.get_unchanged_i010_skipped_count() == 1);
+    assert(sdk.get_product_info("TXFB4")->reference_price == 1760000);
+    std::cout << "test_sdk_skips_unchanged_i010 PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_product_info_from_message();
+    test_registry_upsert_and_find();
+    test_sdk_skips_unchanged_i010();
+    std::cout << "All ProductRegistry tests PASSED." << std::endl;
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "networking/retransmission_client.h"
+#include "networking/retransmission_protocol.h"
+#include "networking/endian_utils.h"
+#include "logger.h"
+
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include <set>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace Networking;
+using namespace TaifexRetransmission;
+
+/** @brief A one-connection retransmission server on 127.0.0.1 that logs the client in. */
+class FakeRetransmissionServer {
+public:
+    FakeRetransmissionServer() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert(bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        assert(listen(listen_fd_, 1) == 0);
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    ~FakeRetransmissionServer() {
+        if (fd_ >= 0) close(fd_);
+        close(listen_fd_);
+    }
+
+    uint16_t port() const { return port_; }
+
+    /** @brief Accepts the client, reads its LoginRequest020 and answers with RetransmissionStart050. */
+    void accept_and_log_in() {
+        fd_ = accept(listen_fd_, nullptr, nullptr);
+        assert(fd_ >= 0);
+        std::vector<unsigned char> login = read_message();
+        RetransmissionMsgHeader header;
+        size_t offset = 0;
+        assert(header.deserialize(login.data(), offset, login.size()));
+        assert(header.msg_type == LoginRequest020::MESSAGE_TYPE && header.msg_seq_num == 0);
+        RetransmissionStart050 start{};
+        send_message(start);
+    }
+
+    template <typename Message>
+    void send_message(const Message& message) {
+        std::vector<unsigned char> buffer;
+        message.serialize(buffer);
+        assert(send(fd_, buffer.data(), buffer.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(buffer.size()));
+    }
+
+    /** @brief One complete message: MsgSize, the MsgSize bytes it counts, and the CheckSum. */
+    std::vector<unsigned char> read_message() {
+        std::vector<unsigned char> message = read_exactly(sizeof(uint16_t));
+        uint16_t msg_size;
+        std::memcpy(&msg_size, message.data(), sizeof(msg_size));
+        std::vector<unsigned char> rest = read_exactly(NetworkingUtils::network_to_host_short(msg_size) + 1);
+        message.insert(message.end(), rest.begin(), rest.end());
+        return message;
+    }
+
+private:
+    std::vector<unsigned char> read_exactly(size_t length) {
+        std::vector<unsigned char> out(length);
+        size_t done = 0;
+        while (done < length) {
+            ssize_t received = recv(fd_, out.data() + done, length - done, 0);
+            assert(received > 0);
+            done += static_cast<size_t>(received);
+        }
+        return out;
+    }
+
+    int listen_fd_ = -1;
+    int fd_ = -1;
+    uint16_t port_ = 0;
+};
+
+void test_concurrent_requests_and_heartbeats() {
+    std::cout << "Running test_concurrent_requests_and_heartbeats..." << std::endl;
+    FakeRetransmissionServer server;
+    std::atomic<bool> logged_in{false};
+    RetransmissionClient client("127.0.0.1", server.port(), 7, "1234", nullptr, nullptr, nullptr, nullptr,
+                                [&]() { logged_in = true; });
+    assert(client.start());
+    server.accept_and_log_in();
+    while (!logged_in.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Requests from several threads while the client's own thread answers server heartbeats.
+    constexpr int THREADS = 4;
+    constexpr int REQUESTS_PER_THREAD = 200;
+    constexpr int HEARTBEATS = 100;
+    std::vector<std::thread> requesters;
+    for (int t = 0; t < THREADS; ++t) {
+        requesters.emplace_back([&client, t]() {
+            for (int i = 0; i < REQUESTS_PER_THREAD; ++i) {
+                assert(client.request_retransmission(static_cast<uint16_t>(t + 1), static_cast<uint32_t>(i + 1), 1));
+            }
+        });
+    }
+    for (int i = 0; i < HEARTBEATS; ++i) {
+        server.send_message(HeartbeatServer104{});
+    }
+
+    // Every message arrives whole, and MsgSeqNum runs 1, 2, ... without a repeat or a hole.
+    std::set<uint32_t> seq_nums;
+    std::vector<int> requests_per_channel(THREADS + 1, 0);
+    int heartbeats = 0;
+    for (int i = 0; i < THREADS * REQUESTS_PER_THREAD + HEARTBEATS; ++i) {
+        std::vector<unsigned char> message = server.read_message();
+        RetransmissionMsgHeader header;
+        size_t offset = 0;
+        assert(header.deserialize(message.data(), offset, message.size()));
+        if (header.msg_type == DataRequest101::MESSAGE_TYPE) {
+            DataRequest101 request;
+            assert(request.deserialize(message.data(), message.size()));
+            assert(request.channel_id >= 1 && request.channel_id <= THREADS);
+            ++requests_per_channel[request.channel_id];
+        } else {
+            HeartbeatClient105 heartbeat;
+            assert(heartbeat.deserialize(message.data(), message.size()));
+            ++heartbeats;
+        }
+        assert(seq_nums.insert(header.msg_seq_num).second);
+    }
+    for (auto& requester : requesters) {
+        requester.join();
+    }
+    assert(heartbeats == HEARTBEATS);
+    for (int channel = 1; channel <= THREADS; ++channel) {
+        assert(requests_per_channel[channel] == REQUESTS_PER_THREAD);
+    }
+    assert(*seq_nums.begin() == 1 && *seq_nums.rbegin() == seq_nums.size());
+
+    client.stop();
+    std::cout << "test_concurrent_requests_and_heartbeats PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_concurrent_requests_and_heartbeats();
+    std::cout << "All RetransmissionClient tests PASSED." << std::endl;
+    return 0;
+}
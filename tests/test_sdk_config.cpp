@@ -0,0 +1,145 @@
+#include "sdk/taifex_sdk.h"
+#include "allocation_tracker.h"
+#include "metrics.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static uint64_t metric(CoreUtils::Metric which) {
+    return CoreUtils::getMetricsSnapshot().get(which);
+}
+
+static SdkConfig presized_config() {
+    SdkConfig config;
+    config.capacity.expected_products = 4;
+    config.capacity.expected_books = 4;
+    config.capacity.channels = {1};
+    config.allocation_check = AllocationCheck::REPORT;
+    return config;
+}
+
+void test_steady_state_without_allocations() {
+    std::cout << "Running test_steady_state_without_allocations..." << std::endl;
+    assert(CoreUtils::allocationHooksInstalled());
+    TaifexSdk sdk;
+    sdk.initialize(presized_config());
+    uint64_t updates = 0;
+    sdk.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++updates; });
+
+    // Built up front: only process_message runs inside the checked scope.
+    std::vector<std::vector<unsigned char>> frames;
+    frames.push_back(make_i010(1, "TXFB4"));
+    frames.push_back(make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+    uint64_t channel_seq = 3;
+    uint32_t prod_msg_seq = 2;
+    for (int i = 0; i < 500; ++i) {
+        // A new best bid pushes the others down, then leaves again.
+        frames.push_back(make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '0'}}));
+        frames.push_back(make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '2'}}));
+    }
+    frames.push_back(make_i010(channel_seq++, "TXFB4")); // Unchanged rebroadcast.
+
+    const uint64_t reported_before = metric(CoreUtils::Metric::HOT_PATH_ALLOCATIONS);
+    const uint64_t counted_before = CoreUtils::hotPathAllocations();
+    for (const auto& frame : frames) {
+        feed(sdk, frame);
+    }
+    assert(CoreUtils::hotPathAllocations() == counted_before);
+    assert(metric(CoreUtils::Metric::HOT_PATH_ALLOCATIONS) == reported_before);
+
+    assert(updates == 1001 && sdk.get_unchanged_i010_skipped_count() == 1);
+    const auto& book = sdk.get_order_book(pad("TXFB4", 20))->get();
+    assert(!book.is_stale() && book.get_last_prod_msg_seq() == prod_msg_seq - 1);
+    auto bids = book.get_top_bids(10);
+    assert(bids.size() == 5 && bids[0].price == 1750000 && bids[4].price == 1749996);
+    std::cout << "test_steady_state_without_allocations PASSED." << std::endl;
+}
+
+void test_levels_pushed_out_of_view() {
+    std::cout << "Running test_levels_pushed_out_of_view..." << std::endl;
+    TaifexSdk sdk;
+    SdkConfig config = presized_config();
+    config.capacity.max_depth = 5;
+    sdk.initialize(config);
+
+    // Every I081 adds a new best bid and never deletes: without trimming, the book would outgrow
+    // its share of the pool and fall back to the heap.
+    std::vector<std::vector<unsigned char>> frames;
+    frames.push_back(make_i010(1, "TXFB4"));
+    frames.push_back(make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+    for (uint32_t i = 0; i < 2000; ++i) {
+        frames.push_back(make_i081(1, 3 + i, "TXFB4", 2 + i, {{'0', 1750001 + i, 7, 1, '0'}}));
+    }
+    const uint64_t counted_before = CoreUtils::hotPathAllocations();
+    for (const auto& frame : frames) {
+        feed(sdk, frame);
+    }
+    assert(CoreUtils::hotPathAllocations() == counted_before);
+
+    const auto& book = sdk.get_order_book(pad("TXFB4", 20))->get();
+    auto bids = book.get_top_bids(100);
+    assert(book.get_max_depth() == 5 && bids.size() == 5);
+    assert(bids[0].price == 1752000 && bids[4].price == 1751996);
+    std::cout << "test_levels_pushed_out_of_view PASSED." << std::endl;
+}
+
+void test_allocation_reported() {
+    std::cout << "Running test_allocation_reported..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(presized_config());
+    std::vector<std::string> seen;
+    sdk.set_order_book_update_callback([&](const OrderBookManagement::OrderBook& book) {
+        seen.push_back(book.get_product_id() + " updated"); // Allocates on the processing thread.
+    });
+    const auto i010 = make_i010(1, "TXFB4");
+    const auto i083 = make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5));
+    const auto i081 = make_i081(1, 3, "TXFB4", 2, {{'0', 1750001, 7, 1, '0'}});
+    feed(sdk, i010);
+    feed(sdk, i083);
+
+    const uint64_t before = metric(CoreUtils::Metric::HOT_PATH_ALLOCATIONS);
+    feed(sdk, i081);
+    assert(seen.size() == 2);
+    assert(metric(CoreUtils::Metric::HOT_PATH_ALLOCATIONS) > before);
+    std::cout << "test_allocation_reported PASSED." << std::endl;
+}
+
+void test_subscriptions() {
+    std::cout << "Running test_subscriptions..." << std::endl;
+    TaifexSdk sdk;
+    SdkConfig config = presized_config();
+    config.capacity.subscriptions = {"TXFB4     "};
+    sdk.initialize(config);
+
+    const uint64_t filtered_before = metric(CoreUtils::Metric::FILTERED_MESSAGES);
+    feed(sdk, make_i083(1, 1, "MXFB4", 1, ladder(1750000, 5))); // Not subscribed: dropped, not held for its I010.
+    feed(sdk, make_i010(2, "MXFB4"));
+    feed(sdk, make_i010(3, "TXFB4"));
+    feed(sdk, make_i083(1, 4, "TXFB4", 1, ladder(1750000, 5)));
+    feed(sdk, make_i083(1, 5, "TXFB4/MXFB4", 1, ladder(1750000, 5))); // Complex products follow their first leg.
+    feed(sdk, make_i081(1, 6, "MXFB4", 2, {{'0', 1750001, 7, 1, '0'}}));
+
+    assert(metric(CoreUtils::Metric::FILTERED_MESSAGES) - filtered_before == 3);
+    assert(sdk.get_pending_frame_count() == 0);
+    assert(!sdk.get_product_info("MXFB4") && sdk.get_product_info("TXFB4"));
+    assert(!sdk.get_order_book(pad("MXFB4", 20)));
+    assert(sdk.get_order_book(pad("TXFB4", 20)) && sdk.get_order_book(pad("TXFB4/MXFB4", 20)));
+    std::cout << "test_subscriptions PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_steady_state_without_allocations();
+    test_levels_pushed_out_of_view();
+    test_allocation_reported();
+    test_subscriptions();
+    std::cout << "All SdkConfig tests PASSED." << std::endl;
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include "sdk/sdk_reader.h"
+#include "sdk/taifex_sdk.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static const std::string PROD_ID = "TXFB4               "; // X(20)
+
+// I083 with one bid at `bid_px` and one ask one tick above, both for `bid_px % 97 + 1` lots.
+static std::vector<unsigned char> make_i083(uint64_t channel_seq, uint32_t prod_msg_seq, uint64_t bid_px) {
+    return TestFrames::make_i083(1, channel_seq, PROD_ID, prod_msg_seq, top_of_book(bid_px, bid_px + 1, bid_px % 97 + 1));
+}
+
+static ProductInfo make_product(uint32_t number, int64_t reference_price) {
+    ProductInfo info;
+    std::memset(&info, 0, sizeof(info));
+    char prod_id_s[ProductInfo::PROD_ID_S_LENGTH + 1];
+    std::snprintf(prod_id_s, sizeof(prod_id_s), "P%-9u", number); // Space padded.
+    std::memcpy(info.prod_id_s, prod_id_s, ProductInfo::PROD_ID_S_LENGTH);
+    info.prod_kind = 'F';
+    info.reference_price = reference_price;
+    return info;
+}
+
+void test_product_table_update() {
+    std::cout << "Running test_product_table_update..." << std::endl;
+    ProductRegistry registry;
+    bool changed = false;
+    constexpr uint32_t COUNT = ReaderProductTable::CHUNK_SIZE + 44;
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        registry.upsert(make_product(i, 100 + i), changed);
+    }
+    const ReaderProductTable first = ReaderProductTable::update(ReaderProductTable(), registry, {});
+    assert(first.size() == COUNT && first.find("P300") == INVALID_PRODUCT_HANDLE);
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        const ProductHandle handle = first.find(make_product(i, 0).id());
+        assert(handle == i && first.get(handle)->reference_price == 100 + i);
+    }
+
+    // One change in the first chunk and one new product; the earlier table is left as it was.
+    const ProductHandle changed_handle = registry.upsert(make_product(5, 999), changed);
+    registry.upsert(make_product(COUNT, 7), changed);
+    const std::vector<ProductHandle> changed_handles = {changed_handle, changed_handle};
+    const ReaderProductTable second = ReaderProductTable::update(first, registry, changed_handles);
+    assert(second.size() == COUNT + 1 && second.get(5)->reference_price == 999);
+    assert(second.find("P300      ") == COUNT && second.get(COUNT)->reference_price == 7);
+    assert(second.get(COUNT - 1)->reference_price == 100 + COUNT - 1 && second.find("P299") == COUNT - 1);
+    assert(first.get(5)->reference_price == 105 && first.size() == COUNT && !first.get(COUNT));
+    std::cout << "test_product_table_update PASSED." << std::endl;
+}
+
+void test_book_table_update() {
+    std::cout << "Running test_book_table_update..." << std::endl;
+    std::vector<ReaderBookTable::Entry> added;
+    for (uint32_t i = 0; i < 200; ++i) {
+        added.emplace_back("P" + std::to_string(i) + "   ", std::make_shared<BookSnapshotSlot>());
+    }
+    const ReaderBookTable first = ReaderBookTable::update(ReaderBookTable(), added);
+    assert(first.size() == 200 && !first.find("P200"));
+    for (uint32_t i = 0; i < 200; ++i) {
+        assert(first.find("P" + std::to_string(i)) == added[i].second.get());
+    }
+
+    // One new book and one replaced slot; the earlier table is left as it was.
+    const std::vector<ReaderBookTable::Entry> more = {{"P200", std::make_shared<BookSnapshotSlot>()},
+                                                      {"P7", std::make_shared<BookSnapshotSlot>()}};
+    const ReaderBookTable second = ReaderBookTable::update(first, more);
+    assert(second.size() == 201 && second.find("P200  ") == more[0].second.get());
+    assert(second.find("P7") == more[1].second.get() && second.find("P8") == added[8].second.get());
+    assert(first.size() == 200 && !first.find("P200") && first.find("P7") == added[7].second.get());
+    std::cout << "test_book_table_update PASSED." << std::endl;
+}
+
+void test_published_state() {
+    std::cout << "Running test_published_state..." << std::endl;
+    TaifexSdk sdk;
+    SdkConfig config;
+    config.reader_publish_interval = std::chrono::milliseconds(0);
+    sdk.initialize(config);
+
+    SdkReader reader = sdk.create_reader();
+    BookSnapshot snapshot;
+    assert(!reader.get_product_info("TXFB4") && reader.product_count() == 0);
+    assert(!reader.get_order_book(PROD_ID, snapshot));
+    assert(!SdkReader().get_product_info("TXFB4"));
+
+    feed(sdk, make_i010(1, "TXFB4", 1, 0, 1750000));
+    auto info = reader.get_product_info("TXFB4     ");
+    assert(info && info->reference_price == 1750000 && reader.product_count() == 1);
+
+    feed(sdk, make_i083(2, 1, 1750000));
+    assert(reader.get_order_book("TXFB4", snapshot));
+    assert(snapshot.version == 2 && snapshot.last_prod_msg_seq == 1 && !snapshot.stale);
+    assert(snapshot.decimal_locator == 2 && snapshot.bid_count == 1 && snapshot.ask_count == 1);
+    assert(snapshot.bids[0].price == 1750000 && snapshot.asks[0].price == 1750001);
+
+    // A reader made later shares the publication.
+    SdkReader second = sdk.create_reader();
+    feed(sdk, make_i010(3, "TXFB4", 1, 0, 1760000));
+    assert(second.get_product_info("TXFB4")->reference_price == 1760000);
+    std::cout << "test_published_state PASSED." << std::endl;
+}
+
+void test_publish_interval() {
+    std::cout << "Running test_publish_interval..." << std::endl;
+    TaifexSdk sdk;
+    SdkConfig config;
+    config.reader_publish_interval = std::chrono::hours(1);
+    sdk.initialize(config);
+    feed(sdk, make_i010(1, "TXFB4", 1, 0, 1750000));
+
+    // Existing state is published when the first reader is created; later index changes wait for
+    // the interval, while books already in the index update on every change.
+    SdkReader reader = sdk.create_reader();
+    feed(sdk, make_i083(2, 1, 1750000));
+    BookSnapshot snapshot;
+    assert(reader.get_product_info("TXFB4") && !reader.get_order_book(PROD_ID, snapshot));
+
+    // With the feed quiet, the timer publishes the new book once the interval is up.
+    auto now = ChannelGapManager::Clock::now();
+    sdk.set_time_source([&now]() { return now; });
+    sdk.poll_timers();
+    assert(!reader.get_order_book(PROD_ID, snapshot));
+    now += std::chrono::hours(2);
+    sdk.poll_timers();
+    assert(reader.get_order_book(PROD_ID, snapshot) && snapshot.bids[0].price == 1750000);
+    std::cout << "test_publish_interval PASSED." << std::endl;
+}
+
+void test_concurrent_reads() {
+    std::cout << "Running test_concurrent_reads..." << std::endl;
+    TaifexSdk sdk;
+    SdkConfig config;
+    config.reader_publish_interval = std::chrono::milliseconds(0);
+    sdk.initialize(config);
+    SdkReader reader = sdk.create_reader();
+    feed(sdk, make_i010(1, "TXFB4", 1, 0, 1750000));
+    feed(sdk, make_i083(2, 1, 1000));
+
+    constexpr uint32_t UPDATES = 20000;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::thread strategy([&]() {
+        BookSnapshot snapshot;
+        uint32_t last_seq = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            assert(reader.get_order_book(PROD_ID, snapshot));
+            // Never a mix of two publications, and never going backwards.
+            assert(snapshot.bid_count == 1 && snapshot.ask_count == 1);
+            assert(snapshot.asks[0].price == snapshot.bids[0].price + 1);
+            assert(snapshot.bids[0].quantity == static_cast<uint64_t>(snapshot.bids[0].price % 97 + 1));
+            assert(snapshot.asks[0].quantity == snapshot.bids[0].quantity);
+            assert(snapshot.last_prod_msg_seq >= last_seq);
+            assert(snapshot.bids[0].price == 1000 + snapshot.last_prod_msg_seq - 1);
+            last_seq = snapshot.last_prod_msg_seq;
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (uint32_t i = 2; i <= UPDATES; ++i) {
+        feed(sdk, make_i083(i + 1, i, 1000 + i - 1));
+    }
+    while (reads.load(std::memory_order_relaxed) < 1000) {
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    strategy.join();
+
+    BookSnapshot snapshot;
+    assert(reader.get_order_book(PROD_ID, snapshot) && snapshot.last_prod_msg_seq == UPDATES);
+    std::cout << "test_concurrent_reads PASSED." << std::endl;
+}
+
+void test_concurrent_index_reads() {
+    std::cout << "Running test_concurrent_index_reads..." << std::endl;
+    TaifexSdk sdk;
+    SdkConfig config;
+    config.reader_publish_interval = std::chrono::milliseconds(0);
+    sdk.initialize(config);
+    SdkReader reader = sdk.create_reader();
+    feed(sdk, make_i010(1, "TXFB4", 1, 0, 1750000));
+
+    // Every I010 replaces the index while the reader is using earlier ones; each replaced index
+    // must stay valid until the reader lets go of it.
+    constexpr uint32_t UPDATES = 5000;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::thread strategy([&]() {
+        int64_t last_price = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            auto info = reader.get_product_info("TXFB4");
+            assert(info && info->reference_price >= last_price);
+            assert(info->reference_price >= 1750000 && info->reference_price < 1750000 + UPDATES);
+            last_price = info->reference_price;
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (uint32_t i = 1; i < UPDATES; ++i) {
+        feed(sdk, make_i010(i + 1, "TXFB4", 1, 0, 1750000 + i));
+    }
+    while (reads.load(std::memory_order_relaxed) < 1000) {
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    strategy.join();
+
+    assert(reader.get_product_info("TXFB4")->reference_price == 1750000 + UPDATES - 1);
+    std::cout << "test_concurrent_index_reads PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_product_table_update();
+    test_book_table_update();
+    test_published_state();
+    test_publish_interval();
+    test_concurrent_reads();
+    test_concurrent_index_reads();
+    std::cout << "All SdkReader tests PASSED." << std::endl;
+    return 0;
+}
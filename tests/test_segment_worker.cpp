@@ -0,0 +1,149 @@
+#define ENABLE_TEST_HOOKS
+#include "networking/network_manager.h"
+#include "networking/segment_worker.h"
+#include "sdk/taifex_sdk.h"
+#include "message_identifier.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static std::vector<unsigned char> make_i010(char tc, uint32_t channel_id, uint64_t channel_seq, const std::string& prod_id_s) {
+    return make_frame(tc, '1', channel_id, channel_seq, i010_body(prod_id_s));
+}
+
+static std::vector<unsigned char> make_i083(char tc, uint32_t channel_id, uint64_t channel_seq, const std::string& prod_id) {
+    return make_frame(tc, 'B', channel_id, channel_seq, i083_body(prod_id, 1, {{'0', 1750000, 3, 1}}));
+}
+
+void test_market_segment() {
+    std::cout << "Running test_market_segment..." << std::endl;
+    CoreUtils::CommonHeader header;
+    const char codes[] = {'0', '1', '2', '3', '4', '5', '9'};
+    const CoreUtils::MarketSegment expected[] = {
+        CoreUtils::MarketSegment::NONE, CoreUtils::MarketSegment::FUTURES, CoreUtils::MarketSegment::FUTURES,
+        CoreUtils::MarketSegment::FUTURES, CoreUtils::MarketSegment::OPTIONS, CoreUtils::MarketSegment::OPTIONS,
+        CoreUtils::MarketSegment::NONE};
+    for (size_t i = 0; i < sizeof(codes); ++i) {
+        header.transmission_code = static_cast<unsigned char>(codes[i]);
+        assert(CoreUtils::identifyMarketSegment(header) == expected[i]);
+    }
+    std::cout << "test_market_segment PASSED." << std::endl;
+}
+
+void test_worker_order_and_overflow() {
+    std::cout << "Running test_worker_order_and_overflow..." << std::endl;
+    std::vector<unsigned char> seen;
+    Networking::SegmentWorker worker("test", 4, 16, [&](const unsigned char* data, size_t length) {
+        assert(length == 1);
+        seen.push_back(data[0]);
+    });
+
+    // Not started yet: the queue fills up and rejects further frames.
+    for (unsigned char i = 0; i < 6; ++i) {
+        const bool queued = worker.submit(&i, 1);
+        assert(queued == (i < 4));
+    }
+    assert(worker.dropped_count() == 2);
+
+    worker.start();
+    worker.wait_until_idle();
+    for (unsigned char i = 10; i < 110; ++i) {
+        while (!worker.submit(&i, 1)) {
+            std::this_thread::yield();
+        }
+    }
+    worker.wait_until_idle();
+    worker.stop();
+
+    assert(seen.size() == 104 && worker.processed_count() == 104);
+    assert(seen[0] == 0 && seen[3] == 3 && seen[4] == 10 && seen[103] == 109);
+    std::cout << "test_worker_order_and_overflow PASSED." << std::endl;
+}
+
+void test_worker_ticks() {
+    std::cout << "Running test_worker_ticks..." << std::endl;
+    std::atomic<int> ticks{0};
+    Networking::SegmentWorker worker("test", 4, 16, [](const unsigned char*, size_t) {}, [&]() { ++ticks; });
+    worker.post_tick();
+    worker.post_tick(); // Coalesces with the one not yet run.
+    worker.start();
+    for (int i = 0; i < 10000 && ticks.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(ticks.load() == 1);
+    worker.post_tick(); // Wakes the idle worker.
+    for (int i = 0; i < 10000 && ticks.load() == 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    worker.stop();
+    assert(ticks.load() == 2);
+    std::cout << "test_worker_ticks PASSED." << std::endl;
+}
+
+void test_segment_parallel_engines() {
+    std::cout << "Running test_segment_parallel_engines..." << std::endl;
+    TaifexSdk futures;
+    TaifexSdk options;
+    futures.initialize();
+    options.initialize();
+    std::atomic<int> futures_updates{0};
+    std::atomic<int> options_updates{0}; // Callbacks run on the engines' worker threads.
+    futures.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++futures_updates; });
+    options.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++options_updates; });
+
+    const uint32_t FUT_CHANNEL = 1;
+    const uint32_t OPT_CHANNEL = 2;
+    std::vector<std::vector<unsigned char>> frames = {
+        make_i001(OPT_CHANNEL, 1),                      // Segment of channel 2 not known yet: dropped.
+        make_i010('1', FUT_CHANNEL, 1, "TXFB4"),
+        make_i010('4', OPT_CHANNEL, 2, "TXO17500B4"),
+        make_i001(OPT_CHANNEL, 3),                      // Routed to the options engine.
+        make_i083('2', FUT_CHANNEL, 2, "TXFB4"),
+        make_i083('5', OPT_CHANNEL, 4, "TXO17500B4"),
+    };
+
+    {
+        Networking::NetworkManager manager(&futures, &options);
+        Networking::NetworkManagerConfig config;
+        config.segment_queue_capacity = 16;
+        assert(manager.configure_and_start(config));
+        for (const auto& frame : frames) {
+            manager.on_primary_multicast_data_for_test(frame.data(), frame.size(), "", 0);
+        }
+        // The I083 is the last frame of each segment.
+        for (int i = 0; i < 10000 && (futures_updates.load() == 0 || options_updates.load() == 0); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        manager.stop(); // Joins the workers; the engines may be read from here on.
+    }
+    assert(futures_updates.load() == 1 && options_updates.load() == 1);
+
+    assert(futures.get_product_info("TXFB4") && !futures.get_product_info("TXO17500B4"));
+    assert(options.get_product_info("TXO17500B4") && !options.get_product_info("TXFB4"));
+    assert(futures.get_order_book(pad("TXFB4", 20)) && !futures.get_order_book(pad("TXO17500B4", 20)));
+    assert(options.get_order_book(pad("TXO17500B4", 20)) && !options.get_order_book(pad("TXFB4", 20)));
+    assert(!futures.channel_states().find(OPT_CHANNEL)->synced);
+    assert(!options.channel_states().find(FUT_CHANNEL)->synced);
+    assert(options.channel_states().find(OPT_CHANNEL)->expected_seq == 5);
+    assert(futures.channel_states().find(FUT_CHANNEL)->expected_seq == 3);
+    std::cout << "test_segment_parallel_engines PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_market_segment();
+    test_worker_order_and_overflow();
+    test_worker_ticks();
+    test_segment_parallel_engines();
+    std::cout << "All SegmentWorker tests PASSED." << std::endl;
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/shm_book_reader.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static std::string segment_name(const char* suffix) {
+    return "/taifex_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+static ShmPublicationConfig shm_config(const std::string& name) {
+    ShmPublicationConfig config;
+    config.name = name;
+    config.product_capacity = 16;
+    config.book_capacity = 16;
+    config.depth = 3;
+    return config;
+}
+
+void test_publish_and_read() {
+    std::cout << "Running test_publish_and_read..." << std::endl;
+    const std::string name = segment_name("read");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    feed(sdk, make_i010(1, "TXFB4"));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+    assert(sdk.publish_to_shared_memory(shm_config(name))); // Existing state is published at once.
+
+    ShmBookReader reader;
+    assert(reader.open(name) && reader.publisher_alive() && reader.depth() == 3);
+    assert(reader.product_count() == 1 && reader.book_count() == 1);
+    auto info = reader.get_product_info("TXFB4");
+    assert(info && info->id() == "TXFB4" && info->reference_price == 1750000);
+
+    const ShmBookIndex tx = reader.find_book(pad("TXFB4", 20));
+    assert(tx != INVALID_SHM_BOOK_INDEX && reader.book_prod_id(tx) == "TXFB4" && reader.book_product(tx) == 0);
+    BookSnapshot snapshot;
+    assert(reader.read_book(tx, snapshot));
+    assert(snapshot.version == 1 && snapshot.last_prod_msg_seq == 1 && !snapshot.stale);
+    assert(snapshot.bid_count == 3 && snapshot.ask_count == 3); // Depth-limited.
+    assert(snapshot.bids[0].price == 1750000 && snapshot.bids[2].price == 1749998 && snapshot.asks[0].price == 1750001);
+
+    feed(sdk, make_i081(1, 3, "TXFB4", 2, {{'0', 1750001, 7, 1, '0'}}));
+    ShmBbo bbo;
+    assert(reader.read_bbo(tx, bbo) && bbo.last_prod_msg_seq == 2 && bbo.has_bid && bbo.has_ask);
+    assert(bbo.bid.price == 1750001 && bbo.bid.quantity == 7 && bbo.ask.price == 1750001);
+    assert(reader.get_order_book("TXFB4", snapshot) && snapshot.version == 2 && snapshot.bids[1].price == 1750000);
+
+    // New entries are readable by index at once and by name after refresh().
+    feed(sdk, make_i010(4, "MXFB4"));
+    feed(sdk, make_i083(1, 5, "MXFB4", 1, ladder(1750000, 5)));
+    assert(reader.book_count() == 2 && reader.find_book("MXFB4") == INVALID_SHM_BOOK_INDEX);
+    assert(reader.refresh() == 2);
+    assert(reader.find_book("MXFB4") == 1 && reader.book_product(1) == 1 && reader.get_product_info("MXFB4"));
+
+    // Another process sees the same state.
+    pid_t child = fork();
+    if (child == 0) {
+        ShmBookReader other;
+        BookSnapshot copy;
+        const bool ok = other.open(name) && other.get_order_book("TXFB4", copy) && copy.bids[0].price == 1750001 &&
+                        other.get_product_info("MXFB4").has_value();
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    assert(waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    std::cout << "test_publish_and_read PASSED." << std::endl;
+}
+
+void test_concurrent_reader() {
+    std::cout << "Running test_concurrent_reader..." << std::endl;
+    const std::string name = segment_name("concurrent");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    assert(sdk.publish_to_shared_memory(shm_config(name)));
+    feed(sdk, make_i010(1, "TXFB4"));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+
+    std::atomic<bool> done{false};
+    bool consistent = true;
+    uint64_t reads = 0;
+    std::thread reader_thread([&] {
+        ShmBookReader reader;
+        assert(reader.open(name));
+        const ShmBookIndex tx = reader.find_book("TXFB4");
+        uint64_t last_version = 0;
+        BookSnapshot snapshot;
+        while (!done.load(std::memory_order_acquire)) {
+            if (!reader.read_book(tx, snapshot)) {
+                continue;
+            }
+            ++reads;
+            // Every published state is a run of consecutive bid prices; a torn copy is not.
+            consistent = consistent && snapshot.version >= last_version && snapshot.bid_count == 3;
+            for (size_t i = 1; i < snapshot.bid_count; ++i) {
+                consistent = consistent && snapshot.bids[i].price == snapshot.bids[0].price - static_cast<int64_t>(i);
+            }
+            last_version = snapshot.version;
+        }
+    });
+
+    uint64_t channel_seq = 3;
+    uint32_t prod_msg_seq = 2;
+    for (int i = 0; i < 20000; ++i) {
+        feed(sdk, make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '0'}}));
+        feed(sdk, make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '2'}}));
+    }
+    done.store(true, std::memory_order_release);
+    reader_thread.join();
+    assert(consistent && reads > 0);
+    std::cout << "test_concurrent_reader PASSED." << std::endl;
+}
+
+void test_lifecycle() {
+    std::cout << "Running test_lifecycle..." << std::endl;
+    const std::string name = segment_name("lifecycle");
+    ShmBookReader reader;
+    {
+        TaifexSdk sdk;
+        sdk.initialize(SdkConfig{});
+        assert(sdk.publish_to_shared_memory(shm_config(name)));
+        feed(sdk, make_i010(1, "TXFB4"));
+        feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+
+        TaifexSdk second;
+        second.initialize(SdkConfig{});
+        assert(!second.publish_to_shared_memory(shm_config(name))); // Held by a live publisher.
+
+        assert(reader.open(name) && reader.publisher_alive());
+    }
+    // Closed and unlinked: the mapping keeps the last state, new readers find nothing.
+    assert(!reader.publisher_alive());
+    BookSnapshot snapshot;
+    assert(reader.get_order_book("TXFB4", snapshot) && snapshot.bids[0].price == 1750000);
+    ShmBookReader late;
+    assert(!late.open(name) && !late.is_open());
+    assert(!late.get_order_book("TXFB4", snapshot) && !late.get_product_info("TXFB4"));
+    std::cout << "test_lifecycle PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_publish_and_read();
+    test_concurrent_reader();
+    test_lifecycle();
+    std::cout << "All shared-memory book tests PASSED." << std::endl;
+    return 0;
+}
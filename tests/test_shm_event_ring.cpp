@@ -0,0 +1,229 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/shm_event_reader.h"
+#include "normalized_event.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+using CoreUtils::EventSide;
+using CoreUtils::EventType;
+using CoreUtils::NormalizedEvent;
+
+// INFORMATION-TIME of every frame: 09:30:00.123456.
+static constexpr uint64_t INFO_TIME_US = (9 * 3600 + 30 * 60) * 1000000ULL + 123456;
+
+static std::string segment_name(const char* suffix) {
+    return "/taifex_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+static ShmEventRingConfig ring_config(const std::string& name, uint32_t capacity = 1024) {
+    ShmEventRingConfig config;
+    config.name = name;
+    config.capacity = capacity;
+    config.book_capacity = 16;
+    config.max_readers = 4;
+    return config;
+}
+
+void test_events_from_messages() {
+    std::cout << "Running test_events_from_messages..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    std::vector<NormalizedEvent> events;
+    size_t batches = 0;
+    sdk.set_event_callback([&](std::span<const NormalizedEvent> batch) {
+        events.insert(events.end(), batch.begin(), batch.end());
+        ++batches;
+    });
+
+    feed(sdk, make_i010(1, "TXFB4", 1, INFO_TIME_US)); // No book change, no event.
+    assert(events.empty());
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5), INFO_TIME_US));
+    assert(batches == 1 && events.size() == 11);
+    const BookHandle tx = sdk.get_book_handle(pad("TXFB4", 20));
+    assert(tx == 0);
+    assert(events[0].type == EventType::BOOK_CLEAR && events[0].side == EventSide::NONE && events[0].level == 0);
+    for (const NormalizedEvent& event : events) {
+        assert(event.book == tx && event.product == 0 && event.channel_id == 1 && event.channel_seq == 2);
+        assert(event.prod_msg_seq == 1 && event.exchange_time_us == INFO_TIME_US && event.decimal_locator == 2);
+    }
+    assert(events[1].type == EventType::SNAPSHOT_LEVEL && events[1].side == EventSide::BID);
+    assert(events[1].price == 1750000 && events[1].quantity == 1 && events[1].level == 1);
+    assert(events[10].side == EventSide::ASK && events[10].price == 1750005 && events[10].level == 5);
+    for (size_t i = 0; i < events.size(); ++i) {
+        assert(((events[i].flags & NormalizedEvent::FLAG_END_OF_MESSAGE) != 0) == (i == 10));
+    }
+
+    events.clear();
+    feed(sdk, make_i081(1, 3, "TXFB4", 2, {{'0', 1750001, 7, 1, '0'}}, INFO_TIME_US));
+    feed(sdk, make_i081(1, 4, "TXFB4", 2, {{'0', 1750001, 7, 1, '2'}}, INFO_TIME_US)); // Duplicate PROD-MSG-SEQ: no event.
+    assert(events.size() == 1);
+    assert(events[0].type == EventType::LEVEL_NEW && events[0].side == EventSide::BID && events[0].price == 1750001);
+    assert(events[0].quantity == 7 && events[0].level == 1 && events[0].channel_seq == 3);
+    assert(events[0].flags == NormalizedEvent::FLAG_END_OF_MESSAGE);
+
+    events.clear();
+    feed(sdk, make_i081(1, 5, "TXFB4", 9, {{'0', 1750001, 7, 1, '2'}}, INFO_TIME_US)); // PROD-MSG-SEQ gap.
+    assert(events.size() == 1 && events[0].type == EventType::BOOK_STALE && events[0].prod_msg_seq == 9);
+    feed(sdk, make_i081(1, 6, "TXFB4", 10, {{'0', 1750001, 7, 1, '2'}}, INFO_TIME_US)); // Ignored while stale.
+    assert(events.size() == 1);
+
+    // A second book gets the next handle; I002 clears both in one batch.
+    feed(sdk, make_i083(1, 7, "TXFB4/MXFB4", 1, ladder(1750000, 5), INFO_TIME_US));
+    assert(sdk.get_book_handle(pad("TXFB4/MXFB4", 20)) == 1 && events.back().book == 1);
+    events.clear();
+    batches = 0;
+    feed(sdk, make_i002(1, 8, INFO_TIME_US));
+    assert(batches == 1 && events.size() == 2);
+    for (const NormalizedEvent& event : events) {
+        assert(event.type == EventType::BOOK_CLEAR && (event.flags & NormalizedEvent::FLAG_RESET));
+    }
+    assert(events[0].book != events[1].book && (events[1].flags & NormalizedEvent::FLAG_END_OF_MESSAGE));
+    std::cout << "test_events_from_messages PASSED." << std::endl;
+}
+
+void test_ring_readers() {
+    std::cout << "Running test_ring_readers..." << std::endl;
+    const std::string name = segment_name("events");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    feed(sdk, make_i010(1, "TXFB4", 1, INFO_TIME_US));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5), INFO_TIME_US));
+    assert(sdk.publish_events_to_shared_memory(ring_config(name)));
+
+    ShmEventReader first;
+    assert(first.open(name) && first.publisher_alive() && first.cursor() == 0);
+    assert(first.book_prod_id(0) == "TXFB4" && first.book_product(0) == 0); // Books existing before the ring.
+    assert(first.book_prod_id(1).empty());
+
+    feed(sdk, make_i081(1, 3, "TXFB4", 2, {{'0', 1750001, 7, 1, '0'}}, INFO_TIME_US));
+    ShmEventReader second;
+    assert(second.open(name)); // Starts after the event above.
+    feed(sdk, make_i083(1, 4, "TXFB4/MXFB4", 1, ladder(1750000, 5), INFO_TIME_US));
+    assert(first.book_prod_id(1) == "TXFB4/MXFB4");
+
+    std::vector<NormalizedEvent> out(64);
+    assert(first.available() == 12 && sdk.get_event_reader_lag() == 12);
+    assert(first.poll(std::span(out).first(1)) == 1 && out[0].type == EventType::LEVEL_NEW);
+    assert(first.poll(out) == 11 && out[0].type == EventType::BOOK_CLEAR && out[0].book == 1);
+    assert(first.poll(out) == 0 && first.cursor() == 12);
+    assert(sdk.get_event_reader_lag() == 11); // The second reader has not read yet.
+    assert(second.poll(out) == 11 && out[10].flags == NormalizedEvent::FLAG_END_OF_MESSAGE);
+    assert(sdk.get_event_reader_lag() == 0);
+    assert(first.overrun_count() == 0 && second.overrun_count() == 0);
+
+    TaifexSdk other;
+    other.initialize(SdkConfig{});
+    assert(!other.publish_events_to_shared_memory(ring_config(name))); // Held by a live publisher.
+    std::cout << "test_ring_readers PASSED." << std::endl;
+}
+
+void test_overrun() {
+    std::cout << "Running test_overrun..." << std::endl;
+    const std::string name = segment_name("overrun");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    assert(sdk.publish_events_to_shared_memory(ring_config(name, 16)));
+    ShmEventReader reader;
+    assert(reader.open(name, ShmEventReader::StartAt::OLDEST));
+    feed(sdk, make_i010(1, "TXFB4", 1, INFO_TIME_US));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5), INFO_TIME_US)); // 11 events.
+    feed(sdk, make_i083(1, 3, "TXFB4", 2, ladder(1750000, 5), INFO_TIME_US)); // 11 more: the first 6 are overwritten.
+
+    std::vector<NormalizedEvent> out(64);
+    assert(reader.available() == 16);
+    assert(reader.poll(out) == 16 && reader.overrun_count() == 6);
+    assert(out[0].type == EventType::SNAPSHOT_LEVEL && out[0].prod_msg_seq == 1 && out[0].side == EventSide::ASK);
+    assert(out[5].type == EventType::BOOK_CLEAR && out[5].prod_msg_seq == 2);
+
+    ShmEventReader oldest;
+    assert(oldest.open(name, ShmEventReader::StartAt::OLDEST) && oldest.cursor() == 6);
+    std::cout << "test_overrun PASSED." << std::endl;
+}
+
+void test_concurrent_reader() {
+    std::cout << "Running test_concurrent_reader..." << std::endl;
+    const std::string name = segment_name("concurrent");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    assert(sdk.publish_events_to_shared_memory(ring_config(name, 256)));
+    feed(sdk, make_i010(1, "TXFB4", 1, INFO_TIME_US));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5), INFO_TIME_US));
+
+    std::atomic<bool> done{false};
+    bool ordered = true;
+    uint64_t read = 0;
+    uint64_t overruns = 0;
+    std::thread reader_thread([&] {
+        ShmEventReader reader;
+        assert(reader.open(name, ShmEventReader::StartAt::OLDEST));
+        std::vector<NormalizedEvent> out(32);
+        uint64_t last_channel_seq = 0;
+        while (true) {
+            const bool finished = done.load(std::memory_order_acquire);
+            const size_t count = reader.poll(out);
+            for (size_t i = 0; i < count; ++i) {
+                // Each event is intact and channel order never goes back, even across overruns.
+                ordered = ordered && out[i].channel_seq >= last_channel_seq && out[i].book == 0 &&
+                          out[i].exchange_time_us == INFO_TIME_US;
+                last_channel_seq = out[i].channel_seq;
+            }
+            read += count;
+            if (finished && count == 0) {
+                break;
+            }
+        }
+        overruns = reader.overrun_count();
+    });
+
+    uint64_t channel_seq = 3;
+    uint32_t prod_msg_seq = 2;
+    for (int i = 0; i < 20000; ++i) {
+        feed(sdk, make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '0'}}, INFO_TIME_US));
+        feed(sdk, make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '2'}}, INFO_TIME_US));
+    }
+    done.store(true, std::memory_order_release);
+    reader_thread.join();
+    assert(ordered && read + overruns == 11 + 40000);
+    std::cout << "test_concurrent_reader PASSED." << std::endl;
+}
+
+void test_lifecycle() {
+    std::cout << "Running test_lifecycle..." << std::endl;
+    const std::string name = segment_name("lifecycle");
+    ShmEventReader reader;
+    {
+        TaifexSdk sdk;
+        sdk.initialize(SdkConfig{});
+        assert(sdk.publish_events_to_shared_memory(ring_config(name)));
+        assert(reader.open(name) && reader.publisher_alive());
+        feed(sdk, make_i010(1, "TXFB4", 1, INFO_TIME_US));
+        feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5), INFO_TIME_US));
+    }
+    // The mapping keeps the events published before the close; new readers find nothing.
+    assert(!reader.publisher_alive() && reader.available() == 11);
+    ShmEventReader late;
+    assert(!late.open(name) && !late.is_open());
+    std::cout << "test_lifecycle PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_events_from_messages();
+    test_ring_readers();
+    test_overrun();
+    test_concurrent_reader();
+    test_lifecycle();
+    std::cout << "All shared-memory event ring tests PASSED." << std::endl;
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "sdk/state_store.h"
+#include "sdk/taifex_sdk.h"
+#include "order_book/order_book.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+struct RecordedRequest {
+    uint32_t channel_id;
+    uint64_t begin_seq;
+    uint16_t count;
+};
+
+static const std::string PROD_ID = "TXFB4               "; // X(20)
+
+static std::string temp_path() {
+    return "/tmp/taifex_state_store_test_" + std::to_string(getpid()) + ".dat";
+}
+
+void test_reattach_restores_state() {
+    std::cout << "Running test_reattach_restores_state..." << std::endl;
+    StateStoreConfig config;
+    config.path = temp_path();
+    config.product_capacity = 16;
+    config.book_capacity = 16;
+    std::remove(config.path.c_str());
+
+    {
+        TaifexSdk sdk;
+        sdk.initialize();
+        assert(sdk.attach_state_store(config));
+        feed(sdk, make_i010(1, "TXFB4"));
+        feed(sdk, make_i083(1, 2, PROD_ID, 5, {{'0', 100, 3, 1}, {'0', 99, 2, 2}, {'1', 101, 4, 3}, {'E', 98, 1, 4}}));
+        feed(sdk, make_i081(1, 3, PROD_ID, 6, {{'0', 100, 7, 1, '1'}}));
+        assert(sdk.get_order_book(PROD_ID)->get().get_top_bids(1)[0].quantity == 7);
+    } // The process "exits" without any shutdown step; the mapping is the only state kept.
+
+    std::vector<RecordedRequest> requests;
+    TaifexSdk sdk;
+    sdk.initialize();
+    sdk.set_retransmission_requester([&](uint32_t ch, uint64_t seq, uint16_t count) {
+        requests.push_back({ch, seq, count});
+    });
+    assert(sdk.attach_state_store(config));
+
+    auto info = sdk.get_product_info("TXFB4");
+    assert(info && info->reference_price == 1750000 && info->decimal_locator == 2);
+    auto book = sdk.get_order_book(PROD_ID);
+    assert(book);
+    const OrderBookManagement::OrderBook& ob = book->get();
+    assert(ob.get_last_prod_msg_seq() == 6);
+    assert(ob.get_decimal_locator() == 2);
+    assert(!ob.is_stale());
+    auto bids = ob.get_top_bids(5);
+    assert(bids.size() == 2 && bids[0].price == 100 && bids[0].quantity == 7 && bids[1].price == 99);
+    auto asks = ob.get_top_asks(5);
+    assert(asks.size() == 1 && asks[0].price == 101 && asks[0].quantity == 4);
+    assert(ob.get_derived_bid() && ob.get_derived_bid()->price == 98);
+    assert(!ob.get_derived_ask());
+
+    const CoreUtils::ChannelState* state = sdk.channel_states().find(1);
+    assert(state->synced && state->expected_seq == 4);
+
+    // Messages 4 and 5 were missed while the process was down: only they are requested.
+    feed(sdk, make_i081(1, 6, PROD_ID, 9, {{'0', 100, 8, 1, '1'}}));
+    assert(requests.size() == 1 && requests[0].channel_id == 1 && requests[0].begin_seq == 4 && requests[0].count == 2);
+    feed(sdk, make_i081(1, 4, PROD_ID, 7, {{'0', 99, 5, 1, '1'}}));
+    feed(sdk, make_i081(1, 5, PROD_ID, 8, {{'1', 101, 0, 1, '2'}}));
+    assert(ob.get_last_prod_msg_seq() == 9);
+    assert(ob.get_top_bids(1)[0].quantity == 8);
+    assert(ob.get_top_asks(1).empty());
+
+    std::remove(config.path.c_str());
+    std::cout << "test_reattach_restores_state PASSED." << std::endl;
+}
+
+void test_layout_mismatch_starts_fresh() {
+    std::cout << "Running test_layout_mismatch_starts_fresh..." << std::endl;
+    StateStoreConfig config;
+    config.path = temp_path();
+    config.product_capacity = 8;
+    config.book_capacity = 8;
+    std::remove(config.path.c_str());
+
+    bool reattached = true;
+    {
+        StateStore store;
+        assert(store.open(config, reattached) && !reattached);
+        store.commit_channel(3, 42);
+        ProductInfo info{};
+        std::memcpy(info.prod_id_s, "MXFB4     ", ProductInfo::PROD_ID_S_LENGTH);
+        store.store_product(0, info);
+        store.store_product(8, info); // Beyond capacity: ignored.
+    }
+    {
+        StateStore store;
+        assert(store.open(config, reattached) && reattached);
+        assert(store.committed_seq(3) == 42);
+        assert(store.product_count() == 1);
+        ProductInfo loaded;
+        assert(store.load_product(0, loaded) && loaded.id() == "MXFB4");
+        assert(!store.load_product(1, loaded));
+    }
+    config.book_capacity = 9;
+    {
+        StateStore store;
+        assert(store.open(config, reattached) && !reattached);
+        assert(store.committed_seq(3) == 0 && store.product_count() == 0);
+    }
+    std::remove(config.path.c_str());
+    std::cout << "test_layout_mismatch_starts_fresh PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_reattach_restores_state();
+    test_layout_mismatch_starts_fresh();
+    std::cout << "All StateStore tests PASSED." << std::endl;
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/tick_store.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <fstream>
+
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static TickStoreConfig store_config(const std::string& root) {
+    TickStoreConfig config;
+    config.root_dir = root;
+    config.trading_date = 20240117;
+    config.depth = 5;
+    config.queue_capacity = 1024;
+    return config;
+}
+
+void test_records_book_changes() {
+    std::cout << "Running test_records_book_changes..." << std::endl;
+    const std::string root = "/tmp/taifex_test_ticks_" + std::to_string(getpid());
+    {
+        TaifexSdk sdk;
+        sdk.initialize(SdkConfig{});
+        feed(sdk, make_i010(1, "TXFB4", 1, info_time_us(0)));
+        feed(sdk, make_i010(2, "MXFB4", 1, info_time_us(0)));
+        feed(sdk, make_i083(1, 3, "TXFB4", 1, ladder(1750000, 5), info_time_us(1))); // Before recording starts: not recorded.
+        assert(sdk.record_tick_history(store_config(root)));
+        for (uint32_t seq = 2; seq <= 11; ++seq) {
+            feed(sdk, make_i081(1, seq + 2, "TXFB4", seq, {{'0', 1750000, seq, 1, '1'}}, info_time_us(seq)));
+        }
+        feed(sdk, make_i083(1, 14, "MXFB4", 1, ladder(1760000, 5), info_time_us(20)));
+        feed(sdk, make_i081(1, 15, "MXFB4", 3, {{'0', 1760000, 9, 1, '1'}}, info_time_us(21))); // Gap: the book turns stale.
+        feed(sdk, make_i002(1, 16, info_time_us(22))); // I002: both books cleared.
+        sdk.stop_tick_history();
+        assert(sdk.get_tick_history_dropped_count() == 0);
+        feed(sdk, make_i083(1, 1, "TXFB4", 1, ladder(1750000, 5), info_time_us(23))); // After stopping: not recorded.
+    }
+
+    TickStoreReader reader;
+    assert(reader.open(root + "/20240117"));
+    assert(reader.depth() == 5);
+    assert(reader.row_count() == 10 + 1 + 1 + 2);
+    assert(reader.book_count() == 2);
+    const uint32_t tx = reader.find_book("TXFB4");
+    const uint32_t mx = reader.find_book(pad("MXFB4", 20));
+    assert(tx != TickStore::NO_BOOK && mx != TickStore::NO_BOOK && tx != mx);
+    assert(reader.find_book("TXFC4") == TickStore::NO_BOOK);
+    assert(reader.book(mx).decimal_locator == 2);
+
+    std::vector<uint32_t> rows;
+    assert(reader.select(tx, info_time_us(4), info_time_us(8), rows) == 4);
+    for (uint32_t row : rows) {
+        const uint64_t seconds = reader.exchange_time_us()[row] / 1000000 - 9 * 3600;
+        assert(reader.books()[row] == tx && reader.prod_msg_seqs()[row] == seconds);
+        assert(reader.bid_prices(1)[row] == 1750000 && reader.bid_quantities(1)[row] == seconds);
+        assert(reader.bid_prices(5)[row] == 1749996 && reader.ask_prices(5)[row] == 1750005);
+        assert(reader.ask_quantities(3)[row] == 3 && reader.flags()[row] == 0);
+    }
+
+    assert(reader.select(mx, 0, UINT64_MAX, rows) == 3);
+    assert(reader.flags()[rows[0]] == 0 && reader.ask_prices(1)[rows[0]] == 1760001);
+    assert(reader.flags()[rows[1]] == TickStore::FLAG_STALE);
+    assert(reader.flags()[rows[2]] == TickStore::FLAG_RESET && reader.bid_prices(1)[rows[2]] == 0);
+    assert(reader.ask_quantities(1)[rows[2]] == 0 && reader.prod_msg_seqs()[rows[2]] == 0);
+    reader.close();
+
+    // A restart on the same day appends and keeps the book indexes, whatever order books appear in.
+    {
+        std::ofstream torn(root + "/20240117/bid_px_1.i64", std::ios::binary | std::ios::app);
+        torn.write("abc", 3); // A column a partial row ahead, as after a crash.
+    }
+    assert(reader.open(root + "/20240117") && reader.row_count() == 14);
+    reader.close();
+    {
+        TaifexSdk sdk;
+        sdk.initialize(SdkConfig{});
+        feed(sdk, make_i010(1, "MXFB4", 1, info_time_us(0)));
+        feed(sdk, make_i010(2, "TXFB4", 1, info_time_us(0)));
+        assert(sdk.record_tick_history(store_config(root)));
+        feed(sdk, make_i083(1, 3, "MXFB4", 1, ladder(1770000, 5), info_time_us(30)));
+        feed(sdk, make_i083(1, 4, "TXFB4", 1, ladder(1780000, 5), info_time_us(31)));
+    }
+    assert(reader.open(root + "/20240117"));
+    assert(reader.row_count() == 16 && reader.book_count() == 2);
+    assert(reader.books()[14] == mx && reader.bid_prices(1)[14] == 1770000);
+    assert(reader.books()[15] == tx && reader.bid_prices(1)[15] == 1780000);
+    assert(reader.select(tx, info_time_us(30), info_time_us(40), rows) == 1 && rows[0] == 15);
+    reader.close();
+
+    // A restart with fewer levels drops the deeper columns; the day then reads at the new depth.
+    {
+        TaifexSdk sdk;
+        sdk.initialize(SdkConfig{});
+        feed(sdk, make_i010(1, "MXFB4", 1, info_time_us(0)));
+        feed(sdk, make_i010(2, "TXFB4", 1, info_time_us(0)));
+        TickStoreConfig shallow = store_config(root);
+        shallow.depth = 3;
+        assert(sdk.record_tick_history(shallow));
+        feed(sdk, make_i083(1, 3, "MXFB4", 1, ladder(1770000, 5), info_time_us(40)));
+        feed(sdk, make_i083(1, 4, "TXFB4", 1, ladder(1780000, 5), info_time_us(40)));
+        // Enough rows for several select blocks, the books interleaved.
+        for (uint32_t i = 0; i < 1000; ++i) {
+            const std::string prod_id = i % 2 == 0 ? "MXFB4" : "TXFB4";
+            feed(sdk, make_i081(1, 5 + i, prod_id, 2 + i / 2, {{'0', 1770000, 1 + i, 1, '1'}}, info_time_us(41 + i)));
+        }
+        sdk.stop_tick_history();
+        assert(sdk.get_tick_history_dropped_count() == 0);
+    }
+    assert(access((root + "/20240117/bid_px_4.i64").c_str(), F_OK) != 0);
+    assert(access((root + "/20240117/ask_qty_5.u64").c_str(), F_OK) != 0);
+    assert(reader.open(root + "/20240117"));
+    assert(reader.depth() == 3 && reader.row_count() == 16 + 2 + 1000);
+    assert(reader.bid_prices(3)[15] == 1779998 && reader.ask_prices(3)[17] == 1780003);
+    assert(reader.select(tx, info_time_us(41), UINT64_MAX, rows) == 500);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        assert(rows[i] == 18 + 2 * i + 1 && reader.books()[rows[i]] == tx);
+    }
+    assert(reader.select(mx, 0, UINT64_MAX, rows) == 3 + 1 + 1 + 500 && rows.back() == 18 + 998);
+    reader.close();
+
+    TickStoreWriter writer;
+    TickStoreConfig bad = store_config(root);
+    bad.depth = 0;
+    assert(!writer.start(bad));
+    bad = store_config(root);
+    bad.queue_capacity = 1000;
+    assert(!writer.start(bad));
+    assert(!reader.open(root + "/20240118"));
+
+    assert(std::system(("rm -rf " + root).c_str()) == 0);
+    std::cout << "test_records_book_changes PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_records_book_changes();
+    std::cout << "All tick store tests completed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "sdk/timer_wheel.h"
+#include "logger.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <cstdint>
+
+using namespace Taifex;
+
+struct Fired {
+    uint32_t key;
+    uint64_t deadline;
+    uint64_t at;
+};
+
+static void test_fires_in_deadline_order() {
+    TimerWheel wheel;
+    wheel.reset(1000);
+    // Deadlines in level 0, level 1, level 2 and level 3 of the wheel, scheduled out of order.
+    const std::vector<uint64_t> deadlines = {1000 + 70000, 1005, 1000 + 300, 1000 + 20000000, 1255, 1256, 1001};
+    std::vector<WheelTimer> timers(deadlines.size());
+    for (size_t i = 0; i < timers.size(); ++i) {
+        timers[i].key = static_cast<uint32_t>(i);
+        wheel.schedule(timers[i], deadlines[i]);
+    }
+    assert(wheel.armed_count() == timers.size());
+
+    std::vector<Fired> fired;
+    auto record = [&](WheelTimer& timer) { fired.push_back({timer.key, timer.deadline, wheel.now()}); };
+    assert(wheel.advance(1004, record) == 1);
+    assert(fired[0].key == 6 && fired[0].at == 1001);
+    assert(wheel.now() == 1004);
+
+    assert(wheel.advance(1000 + 30000000, record) == timers.size() - 1);
+    assert(wheel.armed_count() == 0);
+    for (size_t i = 0; i < fired.size(); ++i) {
+        assert(fired[i].at == fired[i].deadline);
+        assert(!timers[fired[i].key].armed());
+        if (i > 0) {
+            assert(fired[i - 1].deadline < fired[i].deadline);
+        }
+    }
+    std::cout << "test_fires_in_deadline_order PASSED." << std::endl;
+}
+
+static void test_cancel_and_reschedule() {
+    TimerWheel wheel;
+    wheel.reset(0);
+    WheelTimer a, b, c;
+    wheel.schedule(a, 10);
+    wheel.schedule(b, 10);
+    wheel.schedule(c, 5000);
+    wheel.cancel(b);
+    wheel.cancel(b); // No-op.
+    assert(!b.armed() && wheel.armed_count() == 2);
+    wheel.schedule(c, 20); // Moves from level 1 to level 0.
+    wheel.schedule(a, 0);  // In the past: fires on the next tick.
+    assert(a.deadline == 1 && wheel.armed_count() == 2);
+
+    std::vector<WheelTimer*> fired;
+    wheel.advance(4999, [&](WheelTimer& timer) { fired.push_back(&timer); });
+    assert(fired.size() == 2 && fired[0] == &a && fired[1] == &c);
+    std::cout << "test_cancel_and_reschedule PASSED." << std::endl;
+}
+
+static void test_fire_may_rearm_and_cancel() {
+    TimerWheel wheel;
+    wheel.reset(0);
+    WheelTimer periodic, victim;
+    periodic.key = 1;
+    victim.key = 2;
+    wheel.schedule(periodic, 100);
+    wheel.schedule(victim, 100); // Due with `periodic`, cancelled by it before it fires.
+    size_t periodic_fires = 0;
+    size_t victim_fires = 0;
+    wheel.advance(1050, [&](WheelTimer& timer) {
+        if (timer.key == 1) {
+            ++periodic_fires;
+            wheel.cancel(victim);
+            wheel.schedule(timer, wheel.now() + 100);
+        } else {
+            ++victim_fires;
+        }
+    });
+    // `periodic` is fired first or second among the two due at 100; either way `victim` fires at
+    // most once and `periodic` keeps firing every 100 ticks.
+    assert(periodic_fires == 10);
+    assert(victim_fires <= 1);
+    assert(periodic.armed() && periodic.deadline == 1100);
+    assert(!victim.armed());
+    assert(wheel.armed_count() == 1);
+    std::cout << "test_fire_may_rearm_and_cancel PASSED." << std::endl;
+}
+
+static void test_far_deadline_and_long_jump() {
+    TimerWheel wheel;
+    const uint64_t start = (uint64_t{1} << 32) - 7; // Just before a top-level window boundary.
+    wheel.reset(start);
+    WheelTimer far, near;
+    wheel.schedule(far, start + (uint64_t{1} << 33)); // Beyond the wheel's reach: parked.
+    wheel.schedule(near, start + 10);
+
+    size_t fired = 0;
+    auto count = [&](WheelTimer&) { ++fired; };
+    wheel.advance(start + (uint64_t{1} << 33) - 1, count);
+    assert(fired == 1 && !near.armed() && far.armed());
+    wheel.advance(start + (uint64_t{1} << 33), count);
+    assert(fired == 2 && !far.armed());
+    assert(wheel.armed_count() == 0);
+
+    // With nothing armed, time jumps straight to the target.
+    wheel.advance(wheel.now() + 1000000000, count);
+    assert(wheel.now() == start + (uint64_t{1} << 33) + 1000000000);
+    std::cout << "test_far_deadline_and_long_jump PASSED." << std::endl;
+}
+
+static void test_many_timers_against_model() {
+    TimerWheel wheel;
+    wheel.reset(12345);
+    std::vector<WheelTimer> timers(2000);
+    uint64_t seed = 42;
+    auto next_random = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return seed >> 33;
+    };
+    for (size_t i = 0; i < timers.size(); ++i) {
+        timers[i].key = static_cast<uint32_t>(i);
+        wheel.schedule(timers[i], wheel.now() + 1 + next_random() % 200000);
+    }
+    uint64_t last_deadline = 0;
+    size_t fired = 0;
+    while (wheel.armed_count() > 0) {
+        wheel.advance(wheel.now() + 1 + next_random() % 5000, [&](WheelTimer& timer) {
+            assert(timer.deadline == wheel.now());
+            assert(timer.deadline >= last_deadline);
+            last_deadline = timer.deadline;
+            ++fired;
+            if (timer.key % 3 == 0 && fired < 4000) {
+                wheel.schedule(timer, wheel.now() + 1 + next_random() % 70000); // Re-arm a third.
+            }
+        });
+    }
+    assert(fired >= timers.size());
+    std::cout << "test_many_timers_against_model PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_fires_in_deadline_order();
+    test_cancel_and_reschedule();
+    test_fire_may_rearm_and_cancel();
+    test_far_deadline_and_long_jump();
+    test_many_timers_against_model();
+    std::cout << "All timer wheel tests completed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/uds_fanout_client.h"
+#include "sdk/fanout_protocol.h"
+#include "metrics.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+static uint64_t metric(CoreUtils::Metric which) {
+    return CoreUtils::getMetricsSnapshot().get(which);
+}
+
+static std::string socket_path(const char* suffix) {
+    return "/tmp/taifex_fanout_test_" + std::to_string(getpid()) + "_" + suffix + ".sock";
+}
+
+// Polls `done` until it holds or five seconds pass.
+static bool wait_until(const std::function<bool()>& done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Receives until `done` holds or five seconds pass.
+static bool receive_until(UdsFanoutClient& client, const std::function<bool()>& done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline || !client.receive(10)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_codec() {
+    std::cout << "Running test_codec..." << std::endl;
+    FanoutBookUpdate update;
+    update.book = 300;
+    update.prod_msg_seq = 123456;
+    update.flags = FanoutBookUpdate::FLAG_STALE | FanoutBookUpdate::FLAG_DERIVED_ASK;
+    update.bid_count = 3;
+    update.ask_count = 2;
+    update.bids[0] = {-150, 4};      // Negative prices (spreads) round-trip.
+    update.bids[1] = {-151, 1000000};
+    update.bids[2] = {-160, 1};
+    update.asks[0] = {-149, 2};
+    update.asks[1] = {-140, 3};
+    update.derived_ask = {-145, 9};
+
+    std::vector<uint8_t> bytes;
+    append_fanout_hello(bytes, 5);
+    append_fanout_definition(bytes, 300, 2, "TXO17500B4          ");
+    const size_t book_start = bytes.size();
+    append_fanout_book(bytes, update);
+    // Each level after the first costs a one-byte price delta plus its quantity.
+    assert(bytes.size() - book_start < 32);
+
+    uint8_t depth = 0;
+    std::string prod_id;
+    std::vector<FanoutBookUpdate> decoded;
+    FanoutDecoder decoder([&](uint8_t version, uint8_t d) { assert(version == FANOUT_PROTOCOL_VERSION); depth = d; },
+                          [&](const FanoutBookDefinition& definition) {
+                              assert(definition.book == 300 && definition.decimal_locator == 2);
+                              prod_id.assign(definition.prod_id);
+                          },
+                          [&](const FanoutBookUpdate& u) { decoded.push_back(u); });
+    for (uint8_t byte : bytes) { // Split at every possible point.
+        assert(decoder.feed(&byte, 1));
+    }
+    assert(decoder.feed(bytes.data(), bytes.size())); // And all at once.
+    assert(depth == 5 && prod_id == "TXO17500B4" && decoded.size() == 2 && decoder.frame_count() == 6);
+    for (const FanoutBookUpdate& u : decoded) {
+        assert(u.book == 300 && u.prod_msg_seq == 123456 && u.stale() && !u.conflated());
+        assert(u.bid_count == 3 && u.ask_count == 2);
+        for (size_t i = 0; i < 3; ++i) {
+            assert(u.bids[i].price == update.bids[i].price && u.bids[i].quantity == update.bids[i].quantity);
+        }
+        assert(u.asks[0].price == -149 && u.asks[1].price == -140 && u.asks[1].quantity == 3);
+        assert(u.derived_ask.price == -145 && u.derived_ask.quantity == 9 && u.derived_bid.price == 0);
+    }
+
+    const uint8_t malformed[] = {2, 0, 9, 0}; // Unknown frame type.
+    FanoutDecoder strict(nullptr, nullptr, nullptr);
+    assert(!strict.feed(malformed, sizeof(malformed)));
+    std::cout << "test_codec PASSED." << std::endl;
+}
+
+void test_fanout() {
+    std::cout << "Running test_fanout..." << std::endl;
+    const std::string path = socket_path("fanout");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    feed(sdk, make_i010(1, "TXFB4"));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+    UdsFanoutConfig config;
+    config.path = path;
+    config.depth = 3;
+    assert(sdk.start_fanout_server(config));
+
+    std::vector<FanoutBookUpdate> updates;
+    UdsFanoutClient client([&](const FanoutBookUpdate& update) { updates.push_back(update); });
+    assert(client.connect(path));
+    assert(wait_until([&] { return sdk.get_fanout_client_count() == 1; }));
+
+    // Initial image of the book that existed before the client connected.
+    assert(receive_until(client, [&] { return !updates.empty(); }));
+    assert(client.depth() == 3 && client.book_count() == 1);
+    assert(client.prod_id(0) == "TXFB4" && client.decimal_locator(0) == 2);
+    assert(updates[0].book == 0 && updates[0].prod_msg_seq == 1 && !updates[0].stale());
+    assert(updates[0].bid_count == 3 && updates[0].ask_count == 3);
+    assert(updates[0].bids[0].price == 1750000 && updates[0].bids[2].price == 1749998 && updates[0].bids[2].quantity == 3);
+    assert(updates[0].asks[0].price == 1750001 && updates[0].asks[2].price == 1750003);
+
+    // Changes follow; a new book is defined before its first image.
+    feed(sdk, make_i081(1, 3, "TXFB4", 2, {{'0', 1750001, 7, 1, '0'}}));
+    feed(sdk, make_i083(1, 4, "TXFB4/MXFB4", 1, ladder(1750000, 5)));
+    assert(receive_until(client, [&] { return client.book_count() == 2 && updates.back().book == 1; }));
+    assert(client.prod_id(1) == "TXFB4/MXFB4");
+    const FanoutBookUpdate* tx = nullptr;
+    for (const FanoutBookUpdate& update : updates) {
+        if (update.book == 0) {
+            tx = &update;
+        }
+    }
+    assert(tx && tx->prod_msg_seq == 2 && tx->bids[0].price == 1750001 && tx->bids[0].quantity == 7);
+
+    // A stale book is flagged.
+    feed(sdk, make_i081(1, 5, "TXFB4", 9, {{'0', 1750001, 7, 1, '2'}}));
+    assert(receive_until(client, [&] { return updates.back().book == 0 && updates.back().stale(); }));
+
+    // Server side closes: the client sees the end of the stream.
+    const uint64_t disconnected_before = metric(CoreUtils::Metric::FANOUT_CLIENTS_DISCONNECTED);
+    sdk.stop_fanout_server();
+    assert(!receive_until(client, [] { return false; }) && !client.is_connected());
+    assert(metric(CoreUtils::Metric::FANOUT_CLIENTS_DISCONNECTED) == disconnected_before + 1);
+    assert(access(path.c_str(), F_OK) != 0); // Socket file removed.
+    std::cout << "test_fanout PASSED." << std::endl;
+}
+
+void test_conflation() {
+    std::cout << "Running test_conflation..." << std::endl;
+    const std::string path = socket_path("conflation");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    UdsFanoutConfig config;
+    config.path = path;
+    config.conflate_after_bytes = 1024;
+    config.socket_buffer_bytes = 4096;
+    assert(sdk.start_fanout_server(config));
+    feed(sdk, make_i010(1, "TXFB4"));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+
+    std::vector<FanoutBookUpdate> updates;
+    UdsFanoutClient slow([&](const FanoutBookUpdate& update) { updates.push_back(update); });
+    assert(slow.connect(path));
+    assert(wait_until([&] { return sdk.get_fanout_client_count() == 1; }));
+
+    // The client does not read while the book keeps changing, until the server conflates.
+    const uint64_t conflated_before = metric(CoreUtils::Metric::FANOUT_UPDATES_CONFLATED);
+    uint64_t channel_seq = 3;
+    uint32_t prod_msg_seq = 2;
+    const bool conflated = wait_until([&] {
+        for (int i = 0; i < 50; ++i) {
+            feed(sdk, make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '0'}}));
+            feed(sdk, make_i081(1, channel_seq++, "TXFB4", prod_msg_seq++, {{'0', 1750001, 7, 1, '2'}}));
+        }
+        return metric(CoreUtils::Metric::FANOUT_UPDATES_CONFLATED) > conflated_before;
+    });
+    assert(conflated);
+    const uint32_t last = prod_msg_seq - 1;
+
+    // Once it reads again it catches up to the latest image, flagged as conflated.
+    assert(receive_until(slow, [&] { return !updates.empty() && updates.back().prod_msg_seq == last; }));
+    bool flagged = false;
+    for (size_t i = 1; i < updates.size(); ++i) {
+        assert(updates[i].prod_msg_seq >= updates[i - 1].prod_msg_seq); // Never goes back.
+        flagged = flagged || updates[i].conflated();
+    }
+    assert(flagged && updates.size() < last);
+    const FanoutBookUpdate& latest = updates.back();
+    assert(latest.bids[0].price == 1750000 && latest.bid_count == 5 && latest.ask_count == 5);
+    assert(sdk.get_fanout_client_count() == 1); // Slow, not dropped.
+    std::cout << "test_conflation PASSED." << std::endl;
+}
+
+void test_client_limit() {
+    std::cout << "Running test_client_limit..." << std::endl;
+    const std::string path = socket_path("limit");
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    UdsFanoutConfig config;
+    config.path = path;
+    config.max_clients = 1;
+    assert(sdk.start_fanout_server(config));
+
+    UdsFanoutClient first(nullptr);
+    assert(first.connect(path));
+    assert(wait_until([&] { return sdk.get_fanout_client_count() == 1; }));
+    UdsFanoutClient second(nullptr);
+    assert(second.connect(path)); // Accepted by the kernel, then closed by the server.
+    assert(!receive_until(second, [] { return false; }) && !second.is_connected());
+    assert(receive_until(first, [&] { return first.depth() == 5; }));
+
+    first.disconnect();
+    assert(wait_until([&] { return sdk.get_fanout_client_count() == 0; }));
+    std::cout << "test_client_limit PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_codec();
+    test_fanout();
+    test_conflation();
+    test_client_limit();
+    std::cout << "All fan-out tests PASSED." << std::endl;
+    return 0;
+}
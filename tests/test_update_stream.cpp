@@ -0,0 +1,172 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/update_stream.h"
+#include "logger.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <thread>
+
+using namespace Taifex;
+using namespace TestFrames;
+
+// Collects updates until `count` have arrived or the stream closes.
+static UpdateTask collect(std::shared_ptr<UpdateStream> stream, std::vector<BookUpdate>* received, size_t count) {
+    while (received->size() < count) {
+        std::optional<BookUpdate> update = co_await stream->next();
+        if (!update) {
+            co_return;
+        }
+        received->push_back(*update);
+    }
+}
+
+// Consumes until PROD-MSG-SEQ `last` is seen, checking that sequence numbers only grow.
+static UpdateTask follow(std::shared_ptr<UpdateStream> stream, uint32_t last, size_t* received, bool* ordered) {
+    uint32_t previous = 0;
+    while (auto update = co_await stream->next()) {
+        *ordered = *ordered && update->last_prod_msg_seq > previous;
+        previous = update->last_prod_msg_seq;
+        ++*received;
+        if (previous == last) {
+            co_return;
+        }
+    }
+}
+
+static UpdateTask fail_after_first(std::shared_ptr<UpdateStream> stream) {
+    co_await stream->next();
+    throw std::runtime_error("strategy error");
+}
+
+void test_same_thread() {
+    std::cout << "Running test_same_thread..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    UpdateExecutor executor;
+    std::vector<BookUpdate> received;
+    executor.spawn(collect(sdk.subscribe_updates(executor), &received, 2));
+    assert(executor.poll() == 1 && received.empty()); // Ran up to its first co_await.
+    assert(executor.poll() == 0);
+
+    feed(sdk, make_i010(1, "TXFB4"));
+    feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+    assert(received.empty()); // Nothing runs on the feed thread.
+    assert(executor.poll() == 1 && received.size() == 1);
+    feed(sdk, make_i081(1, 3, "TXFB4", 2, {{'0', 1750001, 7, 1, '0'}}));
+    assert(executor.poll() == 1 && received.size() == 2);
+    assert(executor.task_count() == 0);
+
+    assert(received[0].product_id() == "TXFB4" && received[0].last_prod_msg_seq == 1);
+    assert(received[0].has_bid && received[0].best_bid.price == 1750000 && received[0].best_bid.quantity == 1);
+    assert(received[0].has_ask && received[0].best_ask.price == 1750001);
+    assert(received[1].last_prod_msg_seq == 2 && received[1].best_bid.price == 1750001 && received[1].best_bid.quantity == 7);
+    std::cout << "test_same_thread PASSED." << std::endl;
+}
+
+void test_filter_and_overflow() {
+    std::cout << "Running test_filter_and_overflow..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    UpdateExecutor executor;
+    auto stream = sdk.subscribe_updates(executor, {pad("TXFB4", 20)}, 3); // Rounded up to 4.
+    feed(sdk, make_i010(1, "TXFB4"));
+    feed(sdk, make_i010(2, "MXFB4"));
+    feed(sdk, make_i083(1, 3, "TXFB4", 1, ladder(1750000, 5)));
+    feed(sdk, make_i083(1, 4, "MXFB4", 1, ladder(1750000, 5)));
+    uint64_t channel_seq = 5;
+    for (uint32_t prod_msg_seq = 2; prod_msg_seq <= 10; ++prod_msg_seq) {
+        feed(sdk, make_i081(1, channel_seq++, "TXFB4", prod_msg_seq, {{'0', 1750000, 7, 1, '1'}}));
+    }
+
+    BookUpdate update;
+    std::vector<uint32_t> seqs;
+    while (stream->try_next(update)) {
+        assert(update.product_id() == "TXFB4");
+        seqs.push_back(update.last_prod_msg_seq);
+    }
+    assert((seqs == std::vector<uint32_t>{1, 2, 3, 4}));
+    assert(stream->dropped_count() == 6);
+
+    // Room again: delivery resumes with the current top of book.
+    feed(sdk, make_i081(1, channel_seq++, "TXFB4", 11, {{'0', 1750000, 7, 1, '1'}}));
+    assert(stream->try_next(update) && update.last_prod_msg_seq == 11);
+
+    stream->close();
+    feed(sdk, make_i081(1, channel_seq++, "TXFB4", 12, {{'0', 1750000, 7, 1, '1'}}));
+    assert(!stream->try_next(update) && stream->dropped_count() == 6);
+    std::cout << "test_filter_and_overflow PASSED." << std::endl;
+}
+
+void test_cross_thread() {
+    std::cout << "Running test_cross_thread..." << std::endl;
+    constexpr uint32_t LAST_SEQ = 20001;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    UpdateExecutor executor;
+    size_t received = 0;
+    bool ordered = true;
+    executor.spawn(follow(sdk.subscribe_updates(executor, {"TXFB4"}, 1 << 15), LAST_SEQ, &received, &ordered));
+
+    std::vector<std::vector<unsigned char>> frames;
+    frames.push_back(make_i010(1, "TXFB4"));
+    frames.push_back(make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+    uint64_t channel_seq = 3;
+    for (uint32_t prod_msg_seq = 2; prod_msg_seq <= LAST_SEQ; prod_msg_seq += 2) {
+        frames.push_back(make_i081(1, channel_seq++, "TXFB4", prod_msg_seq, {{'0', 1750001, 7, 1, '0'}}));
+        frames.push_back(make_i081(1, channel_seq++, "TXFB4", prod_msg_seq + 1, {{'0', 1750001, 7, 1, '2'}}));
+    }
+
+    std::thread strategy([&] { executor.run(); }); // Returns once the task has seen LAST_SEQ.
+    for (size_t i = 0; i < frames.size(); ++i) {
+        feed(sdk, frames[i]);
+        if (i % 1000 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    strategy.join();
+    assert(ordered && received == LAST_SEQ && executor.task_count() == 0);
+    std::cout << "test_cross_thread PASSED." << std::endl;
+}
+
+void test_close_and_errors() {
+    std::cout << "Running test_close_and_errors..." << std::endl;
+    UpdateExecutor executor;
+    std::vector<BookUpdate> received;
+    {
+        TaifexSdk sdk;
+        sdk.initialize(SdkConfig{});
+        executor.spawn(collect(sdk.subscribe_updates(executor), &received, 10));
+        executor.spawn(fail_after_first(sdk.subscribe_updates(executor)));
+        executor.poll();
+        feed(sdk, make_i010(1, "TXFB4"));
+        feed(sdk, make_i083(1, 2, "TXFB4", 1, ladder(1750000, 5)));
+        executor.poll(); // The failing task ends; its exception is logged.
+        assert(executor.task_count() == 1 && received.size() == 1);
+    }
+    // The SDK closed the stream: the waiting task sees the end and finishes.
+    assert(executor.poll() == 1 && executor.task_count() == 0 && received.size() == 1);
+
+    // Stopping returns from run() with tasks left, which the executor destroys.
+    UpdateExecutor stopped;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    stopped.spawn(collect(sdk.subscribe_updates(stopped), &received, 10));
+    std::thread stopper([&] { stopped.stop(); });
+    stopper.join();
+    stopped.run();
+    assert(stopped.task_count() == 1);
+    std::cout << "test_close_and_errors PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_same_thread();
+    test_filter_and_overflow();
+    test_cross_thread();
+    test_close_and_errors();
+    std::cout << "All UpdateStream tests PASSED." << std::endl;
+    return 0;
+}
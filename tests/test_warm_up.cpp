@@ -0,0 +1,141 @@
+#include "sdk/taifex_sdk.h"
+#include "sdk/warm_up.h"
+#include "normalized_event.h"
+#include "logger.h"
+#include "metrics.h"
+#include "memory_utils.h"
+#include "test_frames.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <cstring>
+
+using namespace Taifex;
+using namespace TestFrames;
+using CoreUtils::NormalizedEvent;
+
+static uint64_t metric(CoreUtils::Metric which) {
+    return CoreUtils::getMetricsSnapshot().get(which);
+}
+
+static SdkConfig presized_config() {
+    SdkConfig config;
+    config.capacity.expected_products = 4;
+    config.capacity.expected_books = 4;
+    config.capacity.max_depth = 5;
+    config.capacity.channels = {3};
+    config.capacity.subscriptions = {"TXFB4", "MXFB4"};
+    config.gap_recovery.reorder_capacity = 16;
+    return config;
+}
+
+void test_warm_up_creates_books_and_prefaults() {
+    std::cout << "Running test_warm_up_creates_books_and_prefaults..." << std::endl;
+    TaifexSdk sdk;
+    const SdkConfig config = presized_config();
+    sdk.initialize(config);
+    size_t book_updates = 0;
+    size_t events = 0;
+    sdk.set_order_book_update_callback([&](const OrderBookManagement::OrderBook&) { ++book_updates; });
+    sdk.set_event_callback([&](std::span<const NormalizedEvent> batch) { events += batch.size(); });
+    feed(sdk, make_i010(1, "TXFB4", 9));
+    feed(sdk, make_i010(2, "MXFB4", 9));
+    feed(sdk, make_i010(3, "TEFB4", 9)); // Not subscribed: no book.
+    const uint64_t created_before = metric(CoreUtils::Metric::ORDER_BOOKS_CREATED);
+    const uint64_t checksum_failures_before = metric(CoreUtils::Metric::CHECKSUM_FAILURES);
+    const uint64_t bytes_before = metric(CoreUtils::Metric::BYTES_PROCESSED);
+
+    const WarmUpReport report = sdk.warm_up();
+    assert(report.books_created == 2);
+    assert(metric(CoreUtils::Metric::ORDER_BOOKS_CREATED) == created_before + 2);
+    assert(sdk.get_order_book(pad("TXFB4", 20)).has_value());
+    assert(sdk.get_order_book(pad("MXFB4", 20)).has_value());
+    assert(!sdk.get_order_book(pad("TEFB4", 20)).has_value());
+    assert(!sdk.get_order_book(std::string(WARM_UP_PROD_ID)).has_value());
+    const auto& book = sdk.get_order_book(pad("TXFB4", 20))->get();
+    assert(book.get_top_bids(5).empty() && book.get_top_asks(5).empty() && book.get_last_prod_msg_seq() == 0);
+
+    // Book pool (4 books, 5 levels) plus one channel's ring of 16 frames.
+    const size_t pool_bytes = 4 * 2 * 5 * 64 * 2;
+    const size_t ring_bytes = 16 * config.gap_recovery.max_frame_length;
+    assert(report.bytes_prefaulted >= pool_bytes + ring_bytes);
+    assert(report.bytes_locked == 0);
+    assert(report.synthetic_frames == WarmUpConfig{}.synthetic_rounds * 4);
+    // The synthetic frames reach no consumer and are not counted as processed.
+    assert(book_updates == 0 && events == 0);
+    assert(metric(CoreUtils::Metric::CHECKSUM_FAILURES) == checksum_failures_before);
+    assert(metric(CoreUtils::Metric::BYTES_PROCESSED) == bytes_before);
+
+    // A second warm-up has no books left to create.
+    WarmUpConfig again;
+    again.synthetic_rounds = 0;
+    const WarmUpReport second = sdk.warm_up(again);
+    assert(second.books_created == 0 && second.synthetic_frames == 0);
+
+    // The warmed-up book takes its first snapshot as usual.
+    feed(sdk, make_i083(3, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+    assert(book_updates == 1 && events > 0);
+    assert(book.get_top_bids(5).size() == 1 && book.get_top_bids(5)[0].price == 1750000);
+    std::cout << "test_warm_up_creates_books_and_prefaults PASSED." << std::endl;
+}
+
+void test_warm_up_without_capacity() {
+    std::cout << "Running test_warm_up_without_capacity..." << std::endl;
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{}); // No book pool, no channels: books and synthetic frames only.
+    feed(sdk, make_i010(1, "TXFB4", 9));
+    WarmUpConfig config;
+    config.lock_memory = true;
+    config.synthetic_rounds = 3;
+    const WarmUpReport report = sdk.warm_up(config);
+    assert(report.books_created == 1);
+    assert(report.synthetic_frames == 12);
+    assert(report.bytes_locked <= report.bytes_prefaulted);
+    feed(sdk, make_i083(3, 1, "TXFB4", 1, top_of_book(1750000, 1750001, 1)));
+    assert(sdk.get_order_book(pad("TXFB4", 20))->get().get_top_asks(5)[0].price == 1750001);
+    std::cout << "test_warm_up_without_capacity PASSED." << std::endl;
+}
+
+void test_prefault_keeps_contents() {
+    std::cout << "Running test_prefault_keeps_contents..." << std::endl;
+    std::vector<unsigned char> buffer(3 * 4096 + 100);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<unsigned char>(i * 7);
+    }
+    const std::vector<unsigned char> copy = buffer;
+    assert(CoreUtils::prefaultMemory(buffer.data() + 3, buffer.size() - 3) == buffer.size() - 3);
+    assert(buffer == copy);
+    assert(CoreUtils::prefaultMemory(nullptr, 100) == 0);
+    std::cout << "test_prefault_keeps_contents PASSED." << std::endl;
+}
+
+void test_page_fault_metric() {
+    std::cout << "Running test_page_fault_metric..." << std::endl;
+    assert(std::strcmp(CoreUtils::metricName(CoreUtils::Metric::PAGE_FAULTS), "page_faults") == 0);
+    TaifexSdk sdk;
+    sdk.initialize(SdkConfig{});
+    const uint64_t before = sdk.get_metrics().get(CoreUtils::Metric::PAGE_FAULTS);
+    {
+        // Large enough to be mapped fresh: every page faults on first write.
+        std::vector<unsigned char> fresh(16 << 20);
+        for (size_t i = 0; i < fresh.size(); i += 4096) {
+            fresh[i] = 1;
+        }
+        assert(fresh[4096] == 1);
+    }
+    const uint64_t after = sdk.get_metrics().get(CoreUtils::Metric::PAGE_FAULTS);
+    assert(after > before); // One fault per page, or per huge page.
+    std::cout << "test_page_fault_metric PASSED." << std::endl;
+}
+
+int main() {
+    CoreUtils::setLogLevel(CoreUtils::LogLevel::ERROR);
+    test_warm_up_creates_books_and_prefaults();
+    test_warm_up_without_capacity();
+    test_prefault_keeps_contents();
+    test_page_fault_metric();
+    std::cout << "All warm-up tests completed." << std::endl;
+    return 0;
+}